@@ -0,0 +1,156 @@
+#include "Bench.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+
+void AppendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// Reads the string starting at text[pos] (the opening quote); pos ends past
+// the closing quote. Handles the escapes AppendJsonString() writes for
+// quotes and backslashes.
+bool ParseJsonString(std::string_view text, size_t& pos, std::string& out) {
+    if (pos >= text.size() || text[pos] != '"') return false;
+    out.clear();
+    for (++pos; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if (c == '"') {
+            ++pos;
+            return true;
+        }
+        if (c == '\\' && pos + 1 < text.size()) c = text[++pos];
+        out += c;
+    }
+    return false;
+}
+
+// The timings of a file written by WriteJson(): the "name" and "ns_per_call"
+// of every benchmark object. Not a general JSON reader: names must not
+// contain braces or brackets, which no benchmark name does.
+bool ParseBaseline(std::string_view text, std::unordered_map<std::string, double>& out) {
+    const size_t benchmarks = text.find("\"benchmarks\"");
+    if (benchmarks == std::string_view::npos) return false;
+    const size_t end = text.find(']', benchmarks);
+    if (end == std::string_view::npos) return false;
+
+    std::string name;
+    for (size_t pos = text.find('{', benchmarks); pos < end; pos = text.find('{', pos)) {
+        const size_t close = text.find('}', pos);
+        if (close == std::string_view::npos) return false;
+        const std::string_view object = text.substr(pos, close - pos);
+
+        const size_t nameKey = object.find("\"name\"");
+        const size_t nsKey   = object.find("\"ns_per_call\"");
+        if (nameKey == std::string_view::npos || nsKey == std::string_view::npos) return false;
+
+        size_t nameValue = object.find('"', object.find(':', nameKey));
+        if (!ParseJsonString(object, nameValue, name)) return false;
+
+        const std::string number(object.substr(object.find(':', nsKey) + 1));
+        char*             parsedEnd = nullptr;
+        const double      ns        = std::strtod(number.c_str(), &parsedEnd);
+        if (parsedEnd == number.c_str() || !std::isfinite(ns)) return false;
+
+        out[name] = ns;
+        pos       = close;
+    }
+    return true;
+}
+
+} // namespace
+
+bool BenchRunner::Finish() const {
+    bool ok = true;
+    if (!mOptions.jsonPath.empty() && !WriteJson(mOptions.jsonPath)) {
+        std::fprintf(stderr, "Failed to write %s\n", mOptions.jsonPath.c_str());
+        ok = false;
+    }
+    if (!mOptions.baselinePath.empty()) ok = CompareBaseline(mOptions.baselinePath) && ok;
+    return ok;
+}
+
+bool BenchRunner::WriteJson(const std::string& path) const {
+    std::string out = "{\n  \"benchmarks\": [";
+    char        number[128];
+    bool        first = true;
+    for (const Result& r : mResults) {
+        if (!r.timing) continue;
+        out += first ? "\n    { \"name\": " : ",\n    { \"name\": ";
+        first = false;
+        AppendJsonString(out, r.name);
+        std::snprintf(number, sizeof(number), ", \"ns_per_call\": %.3f, \"items_per_second\": %.6e, \"calls\": %llu }",
+                      r.value, r.perSec, static_cast<unsigned long long>(r.calls));
+        out += number;
+    }
+    out += "\n  ],\n  \"metrics\": [";
+    first = true;
+    for (const Result& r : mResults) {
+        if (r.timing) continue;
+        out += first ? "\n    { \"name\": " : ",\n    { \"name\": ";
+        first = false;
+        AppendJsonString(out, r.name);
+        std::snprintf(number, sizeof(number), ", \"value\": %.9g, \"unit\": ",
+                      std::isfinite(r.value) ? r.value : 0.0);
+        out += number;
+        AppendJsonString(out, r.unit);
+        out += " }";
+    }
+    out += "\n  ]\n}\n";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool BenchRunner::CompareBaseline(const std::string& path) const {
+    std::ifstream file(path, std::ios::binary);
+    std::string   text;
+    if (file) text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    std::unordered_map<std::string, double> baseline;
+    if (text.empty() || !ParseBaseline(text, baseline)) {
+        std::fprintf(stderr, "Failed to read baseline %s\n", path.c_str());
+        return false;
+    }
+
+    std::printf("\n%-48s %14s %14s %9s\n", "vs baseline", "baseline ns", "current ns", "change");
+    uint32_t regressions = 0, compared = 0;
+    for (const Result& r : mResults) {
+        if (!r.timing) continue;
+        const auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0.0) {
+            std::printf("%-48s %14s %14.1f %9s\n", r.name.c_str(), "-", r.value, "new");
+            continue;
+        }
+
+        const double change    = r.value / it->second - 1.0;
+        const bool   regressed = change > mOptions.tolerance;
+        std::printf("%-48s %14.1f %14.1f %+8.1f%%%s\n", r.name.c_str(), it->second, r.value,
+                    100.0 * change, regressed ? "  REGRESSION" : "");
+        regressions += regressed;
+        ++compared;
+    }
+    std::printf("%u of %u benchmarks regressed by more than %.0f%%\n", regressions, compared,
+                100.0 * mOptions.tolerance);
+    return regressions == 0;
+}
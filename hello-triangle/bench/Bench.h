@@ -0,0 +1,147 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // _ReadWriteBarrier
+#endif
+
+// ---------------------------------------------------------------------------
+// Minimal micro-benchmark harness.
+//
+// Run() calls the body repeatedly until kMinDuration has elapsed (after one
+// untimed warm-up call) and prints ns per call plus throughput. Metric()
+// prints a value that is not a timing, e.g. a ratio or a quality score.
+// Names are matched against an optional substring filter; suites skip the
+// setup of benchmarks it excludes.
+//
+// For CI, Finish() writes every result as JSON and/or compares the timings
+// with a baseline written by an earlier run (same machine): a benchmark
+// slower than baseline * (1 + tolerance) is a regression. Metrics are
+// recorded but not compared.
+// ---------------------------------------------------------------------------
+class BenchRunner {
+public:
+    struct Options {
+        std::string filter;
+        std::string jsonPath;         // write results here
+        std::string baselinePath;     // an earlier jsonPath file
+        double      tolerance = 0.10; // allowed slowdown, as a fraction
+    };
+
+    explicit BenchRunner(Options options) : mOptions(std::move(options)) {}
+
+    [[nodiscard]] bool Enabled(std::string_view name) const {
+        return mOptions.filter.empty() || name.find(mOptions.filter) != std::string_view::npos;
+    }
+
+    // True when any of `names` passes the filter. Suites check it before
+    // building data that only those benchmarks use.
+    [[nodiscard]] bool AnyEnabled(std::initializer_list<std::string_view> names) const {
+        for (std::string_view name : names) {
+            if (Enabled(name)) return true;
+        }
+        return false;
+    }
+
+    // `items` is the work done per call (objects, bytes, pixels...); it only
+    // scales the throughput column. Returns ns per call, 0 when filtered out.
+    template <class Fn>
+    double Run(std::string_view name, uint64_t items, Fn&& body) {
+        if (!Enabled(name)) return 0.0;
+
+        using Clock = std::chrono::steady_clock;
+        body(); // warm-up: page faults, caches, lazy init
+
+        uint64_t         calls = 0;
+        const auto       start = Clock::now();
+        Clock::duration  elapsed{};
+        do {
+            body();
+            ++calls;
+            elapsed = Clock::now() - start;
+        } while (elapsed < kMinDuration);
+
+        const double ns      = std::chrono::duration<double, std::nano>(elapsed).count();
+        const double nsCall  = ns / static_cast<double>(calls);
+        const double perSec  = static_cast<double>(items) * 1e9 / nsCall;
+        std::printf("%-48s %14.1f ns/call %14.3e items/s  (%llu calls)\n",
+                    std::string(name).c_str(), nsCall, perSec,
+                    static_cast<unsigned long long>(calls));
+        mResults.push_back({ std::string(name), nsCall, "ns/call", perSec, calls, true });
+        return nsCall;
+    }
+
+    void Metric(std::string_view name, double value, std::string_view unit) {
+        if (!Enabled(name)) return;
+        std::printf("%-48s %14.4f %s\n", std::string(name).c_str(), value,
+                    std::string(unit).c_str());
+        mResults.push_back({ std::string(name), value, std::string(unit), 0.0, 0, false });
+    }
+
+    // Writes the JSON file and runs the baseline comparison, as configured.
+    // False when either fails or a benchmark regressed.
+    [[nodiscard]] bool Finish() const;
+
+private:
+    static constexpr std::chrono::milliseconds kMinDuration{ 200 };
+
+    struct Result {
+        std::string name;
+        double      value  = 0.0;   // ns per call for timings
+        std::string unit;
+        double      perSec = 0.0;   // timings only
+        uint64_t    calls  = 0;
+        bool        timing = false;
+    };
+
+    [[nodiscard]] bool WriteJson(const std::string& path) const;
+    [[nodiscard]] bool CompareBaseline(const std::string& path) const;
+
+    Options             mOptions;
+    std::vector<Result> mResults;
+};
+
+// Keeps the optimiser from discarding a computed value: the empty asm reads
+// `value` (from a register or from memory) and clobbers memory, so the value
+// is materialized and stores before the call are kept. MSVC has no inline
+// asm on x64; publishing the address through a volatile and a compiler
+// barrier has the same effect there.
+template <class T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+// --- Suites (one translation unit each) ---
+void RunJobSystemBenches(BenchRunner& runner);
+void RunRasterBenches(BenchRunner& runner);
+void RunDescriptorBenches(BenchRunner& runner);
+void RunPipelineCacheBenches(BenchRunner& runner);
+void RunRenderGraphBenches(BenchRunner& runner);
+void RunShaderArchiveBenches(BenchRunner& runner);
+void RunCullingBenches(BenchRunner& runner);
+void RunMeshOptimizerBenches(BenchRunner& runner);
+void RunMeshPackBenches(BenchRunner& runner);
+void RunMeshletBenches(BenchRunner& runner);
+void RunMipGenBenches(BenchRunner& runner);
+void RunBlockCompressBenches(BenchRunner& runner);
+void RunFrameBenches(BenchRunner& runner);
+void RunProfilerBenches(BenchRunner& runner);
+void RunTextureStreamBenches(BenchRunner& runner);
+void RunInstanceBatchBenches(BenchRunner& runner);
+void RunTlsfBenches(BenchRunner& runner);
+void RunUploadBenches(BenchRunner& runner);
+void RunVertexFormatBenches(BenchRunner& runner);
@@ -0,0 +1,64 @@
+#include "Bench.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+bool ParseOptions(int argc, char** argv, BenchRunner::Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg   = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (arg[0] != '-') {
+            if (!opt.filter.empty()) return false;
+            opt.filter = arg;
+            continue;
+        }
+        if (!value) return false;
+
+        if      (std::strcmp(arg, "--json")      == 0) opt.jsonPath     = value;
+        else if (std::strcmp(arg, "--baseline")  == 0) opt.baselinePath = value;
+        else if (std::strcmp(arg, "--tolerance") == 0) opt.tolerance    = std::atof(value);
+        else return false;
+        ++i;
+    }
+    return opt.tolerance >= 0.0;
+}
+
+} // namespace
+
+// Usage: hello-triangle-bench [--json out.json] [--baseline base.json]
+//                             [--tolerance 0.10] [name-filter]
+// Exits with 1 when a benchmark regressed against the baseline.
+int main(int argc, char** argv) {
+    BenchRunner::Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+            "usage: hello-triangle-bench [--json out.json] [--baseline base.json]"
+            " [--tolerance 0.10] [name-filter]\n");
+        return 2;
+    }
+    BenchRunner runner(std::move(options));
+
+    RunFrameBenches(runner);
+    RunJobSystemBenches(runner);
+    RunRasterBenches(runner);
+    RunDescriptorBenches(runner);
+    RunPipelineCacheBenches(runner);
+    RunRenderGraphBenches(runner);
+    RunShaderArchiveBenches(runner);
+    RunInstanceBatchBenches(runner);
+    RunCullingBenches(runner);
+    RunMeshOptimizerBenches(runner);
+    RunMeshPackBenches(runner);
+    RunMeshletBenches(runner);
+    RunMipGenBenches(runner);
+    RunBlockCompressBenches(runner);
+    RunProfilerBenches(runner);
+    RunTextureStreamBenches(runner);
+    RunTlsfBenches(runner);
+    RunUploadBenches(runner);
+    RunVertexFormatBenches(runner);
+    return runner.Finish() ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#include "Bench.h"
+
+#include "BlockCompressor.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kSize = 1024;
+
+// Gradients, a ripple, hard-edged tiles and mild noise, with an alpha
+// channel that has both ramps and cut-outs.
+std::vector<std::byte> MakeImage() {
+    std::mt19937                       rng(9);
+    std::uniform_int_distribution<int> noise(-3, 3);
+    std::vector<std::byte>             image(size_t(kSize) * kSize * 4);
+    for (uint32_t y = 0; y < kSize; ++y) {
+        for (uint32_t x = 0; x < kSize; ++x) {
+            const bool tile  = ((x / 37) + (y / 53)) % 5 == 0;
+            const int  px[4] = {
+                tile ? 230 : int(x * 255 / kSize),
+                tile ? 40 : int(y * 255 / kSize),
+                int(128 + 90 * std::sin(x * 0.05) * std::cos(y * 0.03)),
+                ((x / 64) + (y / 64)) % 3 == 0 ? 0 : int(255 - (x + y) * 255 / (2 * kSize)),
+            };
+            for (int c = 0; c < 4; ++c) {
+                const int v = c < 3 ? px[c] + noise(rng) : px[c];
+                image[(size_t(y) * kSize + x) * 4 + c] = static_cast<std::byte>(std::clamp(v, 0, 255));
+            }
+        }
+    }
+    return image;
+}
+
+double Psnr(const std::vector<std::byte>& a, const std::vector<std::byte>& b, int channels) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (int c = 0; c < channels; ++c) {
+            const double d = std::to_integer<int>(a[i + c]) - std::to_integer<int>(b[i + c]);
+            sum += d * d;
+        }
+    }
+    const double mse = sum / (double(a.size() / 4) * channels);
+    return mse == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+struct Case {
+    const char* name;
+    BcFormat    format;
+    BcQuality   quality;
+};
+
+} // namespace
+
+void RunBlockCompressBenches(BenchRunner& runner) {
+    const Case cases[] = {
+        { "bc1_fast", BcFormat::Bc1, BcQuality::Fast }, { "bc1_quality", BcFormat::Bc1, BcQuality::Quality },
+        { "bc3_fast", BcFormat::Bc3, BcQuality::Fast }, { "bc3_quality", BcFormat::Bc3, BcQuality::Quality },
+        { "bc7_fast", BcFormat::Bc7, BcQuality::Fast }, { "bc7_quality", BcFormat::Bc7, BcQuality::Quality },
+    };
+
+    const uint32_t hw       = std::max(2u, std::thread::hardware_concurrency());
+    const auto     prefixOf = [](const Case& c) { return std::string("bc/") + c.name + "_1024"; };
+    const auto     enabled  = [&](const std::string& prefix) {
+        // A timing's name is a prefix of its /throughput metric.
+        return runner.AnyEnabled({ prefix + "/threads=1/throughput",
+                                   prefix + "/threads=" + std::to_string(hw) + "/throughput",
+                                   prefix + "/psnr_rgb", prefix + "/psnr_rgba" });
+    };
+    if (std::none_of(std::begin(cases), std::end(cases), [&](const Case& c) { return enabled(prefixOf(c)); }))
+        return;
+
+    const std::vector<std::byte> image  = MakeImage();
+    const uint64_t               pixels = uint64_t(kSize) * kSize;
+    std::vector<std::byte>       decoded(image.size());
+
+    JobSystem  jobs;
+    const bool haveJobs = jobs.Init(hw - 1);
+
+    for (const Case& c : cases) {
+        const std::string prefix = prefixOf(c);
+        if (!enabled(prefix)) continue;
+        std::vector<std::byte> blocks(BcImageBytes(c.format, kSize, kSize));
+
+        const auto run = [&](const std::string& name, JobSystem* js) {
+            const double ns = runner.Run(name, pixels, [&] {
+                const bool ok = CompressImage(image, kSize, kSize, c.format, c.quality, blocks, js);
+                DoNotOptimize(ok);
+            });
+            if (ns > 0.0) runner.Metric(name + "/throughput", double(pixels) / ns * 1e3, "MP/s");
+        };
+        run(prefix + "/threads=1", nullptr);
+        if (haveJobs) run(prefix + "/threads=" + std::to_string(hw), &jobs);
+
+        // --- Quality against the source (BC1 has no alpha to compare) ---
+        const std::string psnrName = prefix + "/psnr";
+        if (!runner.AnyEnabled({ psnrName + "_rgb", psnrName + "_rgba" })) continue;
+        if (!CompressImage(image, kSize, kSize, c.format, c.quality, blocks) ||
+            !DecompressImage(blocks, kSize, kSize, c.format, decoded)) {
+            continue;
+        }
+        runner.Metric(psnrName + "_rgb", Psnr(image, decoded, 3), "dB");
+        if (c.format != BcFormat::Bc1) runner.Metric(psnrName + "_rgba", Psnr(image, decoded, 4), "dB");
+    }
+}
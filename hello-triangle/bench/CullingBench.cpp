@@ -0,0 +1,60 @@
+#include "Bench.h"
+
+#include "FrustumCuller.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Boxes of 0.5-4 units scattered through a 1000-unit cube around a camera at
+// the origin looking down +z; about a fifth of them end up in the frustum.
+void FillScene(FrustumCuller& culler, uint32_t count) {
+    uint32_t state = 2024;
+    const auto next = [&state] {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / static_cast<float>(1u << 24); // [0, 1)
+    };
+    culler.Clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        const Float3 c = { next() * 1000.f - 500.f, next() * 1000.f - 500.f, next() * 1000.f - 500.f };
+        const float  h = 0.25f + next() * 1.75f;
+        culler.Add({ { c.x - h, c.y - h, c.z - h }, { c.x + h, c.y + h, c.z + h } });
+    }
+}
+
+} // namespace
+
+void RunCullingBenches(BenchRunner& runner) {
+    const Float4x4 view     = MatrixLookAtLH({ 0.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 1.f, 0.f });
+    const Float4x4 proj     = MatrixPerspectiveFovLH(kPi / 3.f, 16.f / 9.f, 0.1f, 500.f);
+    const Frustum  frustum  = Frustum::FromViewProjection(MatrixMultiply(view, proj));
+
+    FrustumCuller         culler;
+    std::vector<uint32_t> visible;
+
+    for (const uint32_t count : { 10'000u, 100'000u, 1'000'000u }) {
+        const std::string suffix = "/" + std::to_string(count / 1000) + "k";
+        // Skip building 1M boxes for filtered-out cases. A timing's name is
+        // a prefix of its /throughput metric.
+        if (!runner.AnyEnabled({ "cull/linear_sphere" + suffix + "/throughput",
+                                 "cull/linear_box" + suffix + "/throughput", "cull/visible" + suffix,
+                                 "cull/bvh" + suffix + "/throughput", "cull/bvh_nodes" + suffix }))
+            continue;
+        FillScene(culler, count);
+
+        // Objects per nanosecond = count / (ns per call).
+        const auto run = [&](const std::string& name, auto&& body) {
+            const double ns = runner.Run("cull/" + name + suffix, count, body);
+            if (ns > 0.0) runner.Metric("cull/" + name + suffix + "/throughput", count / ns, "objects/ns");
+        };
+
+        run("linear_sphere", [&] { culler.CullLinear(frustum, CullShape::Sphere, visible); DoNotOptimize(visible.size()); });
+        run("linear_box",    [&] { culler.CullLinear(frustum, CullShape::Box,    visible); DoNotOptimize(visible.size()); });
+        runner.Metric("cull/visible" + suffix, 100.0 * visible.size() / count, "% visible");
+
+        culler.BuildBvh();
+        run("bvh", [&] { culler.CullHierarchical(frustum, visible); DoNotOptimize(visible.size()); });
+        runner.Metric("cull/bvh_nodes" + suffix, culler.BvhNodeCount(), "nodes");
+    }
+}
@@ -0,0 +1,63 @@
+#include "Bench.h"
+
+#include "DescriptorAllocator.h"
+#include "FramePacer.h"
+
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kPersistentSlots = 1u << 16;
+constexpr uint32_t kTransientSlots  = 1u << 16;
+constexpr uint32_t kTablesPerFrame  = 4096; // e.g. one table per draw
+constexpr uint32_t kTableSize       = 4;    // descriptors per table
+constexpr uint32_t kChurnBatch      = 1024;
+
+} // namespace
+
+void RunDescriptorBenches(BenchRunner& runner) {
+    const bool transient = runner.AnyEnabled({ "descriptors/transient/frame", "descriptors/transient/high_water",
+                                               "descriptors/transient/failed_allocations" });
+    if (!transient && !runner.Enabled("descriptors/persistent/free+alloc")) return;
+
+    DescriptorAllocator descriptors;
+    if (!descriptors.Init(kPersistentSlots, kTransientSlots)) return;
+
+    // --- Persistent region: free a batch of slots, allocate them again ---
+    if (runner.Enabled("descriptors/persistent/free+alloc")) {
+        std::vector<uint32_t> slots(kChurnBatch);
+        for (uint32_t& slot : slots) slot = descriptors.AllocatePersistent();
+
+        runner.Run("descriptors/persistent/free+alloc", kChurnBatch, [&] {
+            for (uint32_t slot : slots) descriptors.FreePersistent(slot);
+            for (uint32_t& slot : slots) slot = descriptors.AllocatePersistent();
+        });
+    }
+
+    // --- Transient ring: a frame of tables, fenced through a simulated
+    //     queue that retires two frames late ---
+    if (!transient) return;
+    SimulatedFenceQueue queue(2);
+    FramePacer          pacer;
+    if (!pacer.Init(&queue, 3)) return;
+
+    uint32_t slot = 0;
+    runner.Run("descriptors/transient/frame", kTablesPerFrame, [&] {
+        pacer.BeginFrame(slot);
+        descriptors.Retire(pacer.CompletedValue());
+
+        uint32_t first = 0;
+        for (uint32_t t = 0; t < kTablesPerFrame; ++t) {
+            if (descriptors.AllocateTransient(kTableSize, first)) DoNotOptimize(first);
+        }
+
+        if (!pacer.EndFrame()) return;
+        descriptors.EndFrame(pacer.LastSignaledValue());
+        slot = (slot + 1) % 3;
+    });
+
+    runner.Metric("descriptors/transient/high_water",
+                  static_cast<double>(descriptors.TransientHighWater()) / kTransientSlots, "of ring");
+    runner.Metric("descriptors/transient/failed_allocations",
+                  static_cast<double>(descriptors.FailedAllocations()), "");
+}
@@ -0,0 +1,57 @@
+#include "Bench.h"
+
+#include "Checkerboard.h"
+#include "CpuMath.h"
+#include "QuadGrid.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr float kDt = 1.f / 60.f;
+
+} // namespace
+
+// CPU work of one frame outside the subsystems with suites of their own:
+// the matrices and grid culling / batching Update() does, and the texels of
+// CreateCheckerboardTexture().
+// CB packing is in instance_batch/per_object_cb_*, loose-file reads
+// (ReadBinaryFile) in shader_archive/read_files_*.
+void RunFrameBenches(BenchRunner& runner) {
+    // --- MVP as in SoftwareRenderer::Update / D3D12App::Update ---
+    float angle = 0.f;
+    runner.Run("frame/mvp", 1, [&] {
+        angle += kDt;
+        if (angle > kTwoPi) angle -= kTwoPi;
+
+        const Float4x4 model = MatrixRotationY(angle);
+        const Float4x4 view  = MatrixLookAtLH({ 0.f, 0.f, -2.f }, { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f });
+        const Float4x4 proj  = MatrixPerspectiveFovLH(kPi / 4.f, 16.f / 9.f, 0.1f, 100.f);
+        DoNotOptimize(MatrixTranspose(MatrixMultiply(MatrixMultiply(model, view), proj)));
+    });
+
+    // --- D3DApp::Update's scene work: cull the grid, batch the visible
+    //     quads (QuadGrid is the code D3DApp runs, minus the uploads) ---
+    if (runner.Enabled("frame/quad_grid_update")) {
+        QuadGrid grid;
+        grid.Init();
+        const Float4x4 viewProj = QuadGrid::ViewProjection(16.f / 9.f);
+        runner.Run("frame/quad_grid_update", QuadGrid::kQuadCount, [&] {
+            angle += kDt;
+            if (angle > kTwoPi) angle -= kTwoPi;
+            grid.Update(viewProj, angle);
+            DoNotOptimize(grid.Instances().data());
+        });
+    }
+
+    // --- Texel generation as in CreateCheckerboardTexture ---
+    for (const int size : { 64, 1024 }) {
+        const std::string name = "frame/checkerboard_" + std::to_string(size);
+        if (!runner.Enabled(name)) continue;
+        std::vector<uint32_t> pixels(size_t(size) * size);
+        runner.Run(name, pixels.size(), [&] {
+            DoNotOptimize(GenerateCheckerboard(pixels, size, 8));
+        });
+    }
+}
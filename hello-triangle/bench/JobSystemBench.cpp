@@ -0,0 +1,74 @@
+#include "Bench.h"
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kItems     = 1u << 20;
+constexpr uint32_t kGrain     = 4096;
+constexpr uint32_t kEmptyJobs = 10000;
+constexpr uint32_t kFanOut    = 64;
+
+// A few hundred cycles of independent ALU work per item.
+float Work(uint32_t i) {
+    float x = static_cast<float>(i) * 0.001f;
+    for (int k = 0; k < 16; ++k) x = std::sqrt(x * x + 1.f) - 0.5f;
+    return x;
+}
+
+} // namespace
+
+void RunJobSystemBenches(BenchRunner& runner) {
+    std::vector<float> out(kItems);
+
+    // --- Scaling: the same parallel-for with 0..hw-1 workers ---
+    const uint32_t hw         = std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t maxWorkers = std::max(hw - 1, 3u);
+    for (uint32_t workers = 0; workers <= maxWorkers; ++workers) {
+        const std::string name = "jobs/parallel_for/threads=" + std::to_string(workers + 1);
+        if (!runner.Enabled(name)) continue;
+        JobSystem jobs;
+        if (!jobs.Init(workers)) continue;
+
+        runner.Run(name, kItems, [&] {
+            jobs.ParallelFor(kItems, kGrain, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) out[i] = Work(i);
+            });
+        });
+    }
+
+    if (!runner.AnyEnabled({ "jobs/run_wait_empty", "jobs/nested_fan_out", "jobs/steals" })) return;
+    JobSystem jobs;
+    if (!jobs.Init()) return;
+
+    // --- Per-job overhead: empty jobs pushed from one thread ---
+    runner.Run("jobs/run_wait_empty", kEmptyJobs, [&] {
+        JobCounter counter;
+        for (uint32_t i = 0; i < kEmptyJobs; ++i) jobs.Run([] {}, &counter);
+        jobs.Wait(counter);
+    });
+
+    // --- Nested spawning: every job fans out, forcing steals ---
+    runner.Run("jobs/nested_fan_out", kFanOut * kFanOut, [&] {
+        JobCounter outer;
+        for (uint32_t i = 0; i < kFanOut; ++i) {
+            jobs.Run([&jobs, &out, i] {
+                JobCounter inner;
+                for (uint32_t j = 0; j < kFanOut; ++j) {
+                    jobs.Run([&out, i, j] { out[i * kFanOut + j] = Work(j); }, &inner);
+                }
+                jobs.Wait(inner);
+            }, &outer);
+        }
+        jobs.Wait(outer);
+    });
+    runner.Metric("jobs/steals", static_cast<double>(jobs.StealCount()), "jobs stolen");
+
+    DoNotOptimize(out);
+}
@@ -0,0 +1,115 @@
+#include "Bench.h"
+
+#include "CpuMath.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// UV sphere as a flat triangle list (every triangle carries its own three
+// vertices), triangles shuffled like an exporter that ignores the cache.
+std::vector<Vertex> MakeSphereTriangles(uint32_t slices, uint32_t stacks) {
+    std::vector<Vertex> grid((slices + 1) * (stacks + 1));
+    for (uint32_t y = 0; y <= stacks; ++y) {
+        for (uint32_t x = 0; x <= slices; ++x) {
+            const float u = float(x) / float(slices), v = float(y) / float(stacks);
+            const float theta = u * kTwoPi, phi = v * kPi;
+            grid[y * (slices + 1) + x] = { { std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) },
+                                           { 1.f, 1.f, 1.f, 1.f }, { u, v } };
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> tris;
+    for (uint32_t y = 0; y < stacks; ++y) {
+        for (uint32_t x = 0; x < slices; ++x) {
+            const uint32_t a = y * (slices + 1) + x, b = a + 1, c = a + slices + 1, d = c + 1;
+            tris.push_back({ a, b, c });
+            tris.push_back({ b, d, c });
+        }
+    }
+    std::shuffle(tris.begin(), tris.end(), std::mt19937(7));
+
+    std::vector<Vertex> list;
+    list.reserve(tris.size() * 3);
+    for (const auto& t : tris) {
+        for (uint32_t i : t) list.push_back(grid[i]);
+    }
+    return list;
+}
+
+// Prefix of the vertex cache metrics after `stage`.
+std::string CacheMetric(const char* stage, uint32_t cacheSize) {
+    return std::string("meshopt/") + stage + "/fifo" + std::to_string(cacheSize);
+}
+
+} // namespace
+
+void RunMeshOptimizerBenches(BenchRunner& runner) {
+    // Every case works on the same sphere, each stage on the previous one's
+    // output; skip building it when the filter excludes them all.
+    bool enabled = runner.AnyEnabled({ "meshopt/index_65k_tris", "meshopt/dedup_ratio", "meshopt/vertex_cache_65k_tris",
+                                       "meshopt/overdraw_65k_tris", "meshopt/vertex_fetch_65k_tris" });
+    for (const char* stage : { "unoptimized", "vertex_cache", "overdraw" }) {
+        for (uint32_t cacheSize : { 16u, 32u }) {
+            const std::string name = CacheMetric(stage, cacheSize);
+            enabled = enabled || runner.AnyEnabled({ name + "/acmr", name + "/atvr" });
+        }
+    }
+    if (!enabled) return;
+
+    const std::vector<Vertex> triangles = MakeSphereTriangles(256, 128); // 65k triangles
+    const uint64_t            triCount  = triangles.size() / 3;
+
+    std::vector<Vertex>   vertices;
+    std::vector<uint32_t> indices;
+
+    runner.Run("meshopt/index_65k_tris", triCount, [&] { GenerateIndexBuffer(triangles, vertices, indices); });
+    GenerateIndexBuffer(triangles, vertices, indices);
+    const std::vector<uint32_t> shuffled = indices;
+    const uint32_t              vertexCount = static_cast<uint32_t>(vertices.size());
+
+    runner.Metric("meshopt/dedup_ratio", double(triangles.size()) / vertexCount, "input vertices per unique vertex");
+
+    const auto report = [&](const char* stage) {
+        for (uint32_t cacheSize : { 16u, 32u }) {
+            const VertexCacheStats s = AnalyzeVertexCache(indices, vertexCount, cacheSize);
+            const std::string name = CacheMetric(stage, cacheSize);
+            runner.Metric(name + "/acmr", s.acmr, "vertices/triangle");
+            runner.Metric(name + "/atvr", s.atvr, "transforms/vertex");
+        }
+    };
+    report("unoptimized");
+
+    // Each stage runs once more outside the clock, so the next one starts
+    // from its output even when its timing is filtered out.
+    const auto vertexCache = [&] {
+        indices = shuffled;
+        OptimizeVertexCache(indices, vertexCount);
+    };
+    runner.Run("meshopt/vertex_cache_65k_tris", triCount, vertexCache);
+    vertexCache();
+    report("vertex_cache");
+    const std::vector<uint32_t> cacheOrdered = indices;
+
+    const auto overdraw = [&] {
+        indices = cacheOrdered;
+        OptimizeOverdraw(indices, vertices);
+    };
+    runner.Run("meshopt/overdraw_65k_tris", triCount, overdraw);
+    overdraw();
+    report("overdraw");
+
+    std::vector<Vertex> fetchVertices = vertices;
+    const std::vector<uint32_t> overdrawOrdered = indices;
+    runner.Run("meshopt/vertex_fetch_65k_tris", triCount, [&] {
+        fetchVertices = vertices;
+        indices       = overdrawOrdered;
+        DoNotOptimize(OptimizeVertexFetch(fetchVertices, indices));
+    });
+}
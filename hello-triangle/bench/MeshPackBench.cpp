@@ -0,0 +1,122 @@
+#include "Bench.h"
+
+#include "CpuMath.h"
+#include "MeshOptimizer.h"
+#include "MeshPack.h"
+#include "MeshletBuilder.h"
+#include "ObjFile.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+// UV sphere, indexed, in the order the converter would store it.
+void MakeSphere(uint32_t slices, uint32_t stacks, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::vector<Vertex> list;
+    for (uint32_t y = 0; y < stacks; ++y) {
+        for (uint32_t x = 0; x < slices; ++x) {
+            const auto corner = [&](uint32_t cx, uint32_t cy) {
+                const float u = float(cx) / float(slices), v = float(cy) / float(stacks);
+                const float theta = u * kTwoPi, phi = v * kPi;
+                return Vertex{ { std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) },
+                               { u, v, 1.f - u, 1.f }, { u, v } };
+            };
+            const Vertex a = corner(x, y), b = corner(x + 1, y), c = corner(x, y + 1), d = corner(x + 1, y + 1);
+            list.insert(list.end(), { a, b, c, b, d, c });
+        }
+    }
+    OptimizeMesh(list, vertices, indices);
+}
+
+std::vector<char> ReadTextFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return {};
+
+    const std::streampos end = file.tellg();
+    if (end <= 0) return {};
+    std::vector<char> buf(static_cast<size_t>(end));
+    file.seekg(0, std::ios::beg);
+    if (!file.read(buf.data(), static_cast<std::streamsize>(buf.size()))) return {};
+    return buf;
+}
+
+} // namespace
+
+void RunMeshPackBenches(BenchRunner& runner) {
+    if (!runner.AnyEnabled({ "mesh_pack/load_obj_130k_tris", "mesh_pack/load_mpk_130k_tris",
+                             "mesh_pack/load_mpk_compact_130k_tris", "mesh_pack/file_size" }))
+        return;
+
+    std::error_code             ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "hello-triangle-mesh-pack-bench";
+    std::filesystem::remove_all(dir, ec);
+    if (!std::filesystem::create_directories(dir, ec)) {
+        std::fprintf(stderr, "mesh_pack: cannot create %s\n", dir.string().c_str());
+        return;
+    }
+
+    // --- One sphere as OBJ text and as packs in both vertex formats ---
+    std::vector<Vertex>   vertices;
+    std::vector<uint32_t> indices;
+    MeshletMesh           meshlets;
+    MakeSphere(256, 256, vertices, indices); // 130k triangles
+    BuildMeshlets(vertices, indices, meshlets);
+    const uint64_t triCount = indices.size() / 3;
+
+    const std::filesystem::path objPath     = dir / "sphere.obj";
+    const std::filesystem::path packPath    = dir / "sphere.mpk";
+    const std::filesystem::path compactPath = dir / "sphere_compact.mpk";
+    {
+        const std::string text = FormatObj(vertices, indices);
+        std::ofstream(objPath, std::ios::binary).write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    MeshPackBuilder full, compact;
+    if (!full.Add("sphere", vertices, indices, kFullVertexFormat, &meshlets) || !full.Write(packPath) ||
+        !compact.Add("sphere", vertices, indices, kCompactVertexFormat, &meshlets) || !compact.Write(compactPath)) {
+        std::fprintf(stderr, "mesh_pack: cannot write packs\n");
+        std::filesystem::remove_all(dir, ec);
+        return;
+    }
+
+    // Both paths end with vertex + index bytes in "upload memory", the way
+    // Mesh::Create() or a D3D12 upload heap takes them.
+    std::vector<std::byte> upload(vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t));
+
+    // --- Text: read, parse, re-index, copy ---
+    runner.Run("mesh_pack/load_obj_130k_tris", triCount, [&] {
+        const std::vector<char> text = ReadTextFile(objPath);
+        std::vector<Vertex>     list, unique;
+        std::vector<uint32_t>   index;
+        if (ParseObj({ text.data(), text.size() }, list)) GenerateIndexBuffer(list, unique, index);
+        std::memcpy(upload.data(), unique.data(), unique.size() * sizeof(Vertex));
+        std::memcpy(upload.data() + unique.size() * sizeof(Vertex), index.data(), index.size() * sizeof(uint32_t));
+        DoNotOptimize(upload);
+    });
+
+    // --- Pack: map, find, copy the sections ---
+    const auto loadPack = [&](const std::filesystem::path& path) {
+        MeshPack pack;
+        if (!pack.Open(path)) return;
+        const MeshPackMesh* m = pack.Find("sphere");
+        if (!m) return;
+        std::memcpy(upload.data(), m->vertexData.data(), m->vertexData.size());
+        std::memcpy(upload.data() + m->vertexData.size(), m->indices.data(), m->indices.size_bytes());
+        DoNotOptimize(upload);
+    };
+    runner.Run("mesh_pack/load_mpk_130k_tris", triCount, [&] { loadPack(packPath); });
+    runner.Run("mesh_pack/load_mpk_compact_130k_tris", triCount, [&] { loadPack(compactPath); });
+
+    runner.Metric("mesh_pack/file_size", static_cast<double>(std::filesystem::file_size(compactPath, ec)) /
+                                             static_cast<double>(std::filesystem::file_size(objPath, ec)),
+                  "compact pack bytes per OBJ byte (pack includes meshlets)");
+
+    std::filesystem::remove_all(dir, ec);
+}
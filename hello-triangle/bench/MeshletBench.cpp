@@ -0,0 +1,119 @@
+#include "Bench.h"
+
+#include "CpuMath.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include "MeshOptimizer.h"
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct IndexedMesh {
+    std::vector<Vertex>   vertices;
+    std::vector<uint32_t> indices;
+};
+
+// Unit UV sphere, indexed and vertex-cache optimized like OptimizeMesh()
+// output. Triangles are CW seen from outside.
+IndexedMesh MakeSphere(uint32_t slices, uint32_t stacks) {
+    IndexedMesh m;
+    m.vertices.resize((slices + 1) * (stacks + 1));
+    for (uint32_t y = 0; y <= stacks; ++y) {
+        for (uint32_t x = 0; x <= slices; ++x) {
+            const float u = float(x) / float(slices), v = float(y) / float(stacks);
+            const float theta = u * kTwoPi, phi = v * kPi;
+            m.vertices[y * (slices + 1) + x] = { { std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) },
+                                                 { 1.f, 1.f, 1.f, 1.f }, { u, v } };
+        }
+    }
+    for (uint32_t y = 0; y < stacks; ++y) {
+        for (uint32_t x = 0; x < slices; ++x) {
+            const uint32_t a = y * (slices + 1) + x, b = a + 1, c = a + slices + 1, d = c + 1;
+            m.indices.insert(m.indices.end(), { a, b, c, b, d, c });
+        }
+    }
+    OptimizeVertexCache(m.indices, static_cast<uint32_t>(m.vertices.size()));
+    return m;
+}
+
+} // namespace
+
+void RunMeshletBenches(BenchRunner& runner) {
+    constexpr uint32_t kMeshCount = 64;
+    const uint32_t     hw         = std::max(2u, std::thread::hardware_concurrency());
+    const std::string  build      = "meshlet/build_" + std::to_string(kMeshCount) + "_meshes";
+    const bool         fill       = runner.AnyEnabled({ "meshlet/meshlets", "meshlet/vertex_fill",
+                                                        "meshlet/triangle_fill", "meshlet/vertices_per_triangle" });
+    const bool         cull       = runner.AnyEnabled({ "meshlet/cull_reference", "meshlet/cull_reference/visible" });
+    if (!fill && !cull && !runner.AnyEnabled({ build + "/threads=1", build + "/threads=" + std::to_string(hw),
+                                               build + "/speedup" }))
+        return; // skip generating the spheres
+
+    // --- A scene's worth of meshes: 64 spheres from 2k to 33k triangles ---
+    std::vector<IndexedMesh> meshes;
+    std::vector<MeshletSource> sources;
+    uint64_t                 triangles = 0;
+    for (uint32_t i = 0; i < kMeshCount; ++i) {
+        const uint32_t slices = 32 + 4 * (i % 32);
+        meshes.push_back(MakeSphere(slices, slices / 2));
+        triangles += meshes.back().indices.size() / 3;
+    }
+    for (const IndexedMesh& m : meshes) sources.push_back({ m.vertices, m.indices });
+
+    std::vector<MeshletMesh> built(kMeshCount);
+
+    const double serialNs = runner.Run(build + "/threads=1", triangles, [&] {
+        for (uint32_t i = 0; i < kMeshCount; ++i) BuildMeshlets(sources[i].vertices, sources[i].indices, built[i]);
+    });
+
+    JobSystem jobs;
+    if (runner.AnyEnabled({ build + "/threads=" + std::to_string(hw), build + "/speedup" }) && jobs.Init(hw - 1)) {
+        const double parallelNs = runner.Run(build + "/threads=" + std::to_string(hw), triangles,
+                                             [&] { BuildMeshlets(jobs, sources, built); });
+        if (serialNs > 0.0 && parallelNs > 0.0) {
+            runner.Metric(build + "/speedup", serialNs / parallelNs, "x");
+        }
+    }
+
+    // --- Cluster fill over the whole set ---
+    if (fill) {
+        double   vertexFill = 0.0, triangleFill = 0.0, verticesPerTri = 0.0;
+        uint64_t meshletCount = 0;
+        for (uint32_t i = 0; i < kMeshCount; ++i) {
+            BuildMeshlets(sources[i].vertices, sources[i].indices, built[i]);
+            const MeshletStats s = AnalyzeMeshlets(built[i]);
+            meshletCount   += s.meshletCount;
+            vertexFill     += double(s.vertexFill) * s.meshletCount;
+            triangleFill   += double(s.triangleFill) * s.meshletCount;
+            verticesPerTri += double(s.verticesPerTri) * (built[i].triangles.size() / 3);
+        }
+        runner.Metric("meshlet/meshlets", double(meshletCount), "clusters");
+        runner.Metric("meshlet/vertex_fill", 100.0 * vertexFill / meshletCount, "% of 64");
+        runner.Metric("meshlet/triangle_fill", 100.0 * triangleFill / meshletCount, "% of 124");
+        runner.Metric("meshlet/vertices_per_triangle", verticesPerTri / triangles, "");
+    }
+
+    // --- CPU cluster culling: camera outside the largest sphere, which
+    //     fills part of the view ---
+    if (!cull) return;
+    MeshletMesh& target = built[31];
+    BuildMeshlets(sources[31].vertices, sources[31].indices, target); // the builds above may be filtered out
+    const Float3       eye    = { 0.4f, 0.3f, -2.5f };
+    const Float4x4     view   = MatrixLookAtLH(eye, { 0.5f, 0.f, 0.f }, { 0.f, 1.f, 0.f });
+    const Float4x4     proj   = MatrixPerspectiveFovLH(kPi / 4.f, 16.f / 9.f, 0.1f, 100.f);
+    const Frustum      frustum = Frustum::FromViewProjection(MatrixMultiply(view, proj));
+
+    std::vector<uint32_t> visible;
+    runner.Run("meshlet/cull_reference", target.meshlets.size(), [&] {
+        CullMeshlets(target, frustum, eye, visible);
+        DoNotOptimize(visible.data());
+    });
+    CullMeshlets(target, frustum, eye, visible);
+    runner.Metric("meshlet/cull_reference/visible", 100.0 * visible.size() / target.meshlets.size(), "% of clusters");
+}
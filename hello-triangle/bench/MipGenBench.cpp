@@ -0,0 +1,89 @@
+#include "Bench.h"
+
+#include "JobSystem.h"
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kSize = 2048;
+
+// Smooth gradients plus noise, so no kernel can shortcut flat areas.
+std::vector<std::byte> MakeImage(MipFormat format) {
+    std::mt19937                          rng(5);
+    std::uniform_real_distribution<float> noise(-0.1f, 0.1f);
+    const uint32_t                        bpp = MipBytesPerPixel(format);
+    std::vector<std::byte>                image(size_t(kSize) * kSize * bpp);
+    for (uint32_t y = 0; y < kSize; ++y) {
+        for (uint32_t x = 0; x < kSize; ++x) {
+            float px[4] = { float(x) / kSize, float(y) / kSize, 0.5f, 1.f };
+            for (float& c : px) c = std::clamp(c + noise(rng), 0.f, 1.f);
+            std::byte* dst = image.data() + (size_t(y) * kSize + x) * bpp;
+            if (format == MipFormat::Rgba32Float) {
+                std::memcpy(dst, px, sizeof(px));
+            } else {
+                for (int c = 0; c < 4; ++c) dst[c] = static_cast<std::byte>(px[c] * 255.f + 0.5f);
+            }
+        }
+    }
+    return image;
+}
+
+struct Case {
+    const char* name;
+    MipFormat   format;
+    MipFilter   filter;
+};
+
+} // namespace
+
+void RunMipGenBenches(BenchRunner& runner) {
+    const Case cases[] = {
+        { "rgba8_box",         MipFormat::Rgba8Unorm,     MipFilter::Box },
+        { "rgba8_srgb_box",    MipFormat::Rgba8UnormSrgb, MipFilter::Box },
+        { "rgba8_srgb_lanczos", MipFormat::Rgba8UnormSrgb, MipFilter::Lanczos },
+        { "rgba32f_box",       MipFormat::Rgba32Float,    MipFilter::Box },
+        { "rgba32f_lanczos",   MipFormat::Rgba32Float,    MipFilter::Lanczos },
+    };
+
+    const uint32_t hw       = std::max(2u, std::thread::hardware_concurrency());
+    const auto     prefixOf = [](const Case& c) { return std::string("mipgen/") + c.name + "_2048"; };
+    const auto     enabled  = [&](const std::string& prefix) {
+        // A timing's name is a prefix of its /throughput metric.
+        return runner.AnyEnabled({ prefix + "/threads=1/throughput",
+                                   prefix + "/threads=" + std::to_string(hw) + "/throughput" });
+    };
+    if (std::none_of(std::begin(cases), std::end(cases), [&](const Case& c) { return enabled(prefixOf(c)); }))
+        return;
+
+    JobSystem  jobs;
+    const bool haveJobs = jobs.Init(hw - 1);
+
+    // Items are source pixels: megapixels/s of level 0 turned into a chain.
+    const uint64_t pixels = uint64_t(kSize) * kSize;
+    MipChain       chain;
+    for (const Case& c : cases) {
+        const std::string prefix = prefixOf(c);
+        if (!enabled(prefix)) continue; // skip the 2048x2048 source image
+
+        const std::vector<std::byte> image   = MakeImage(c.format);
+        const MipOptions             options = { c.filter, MipAddress::Wrap, 0 };
+
+        const auto report = [&](const std::string& name, JobSystem* js) {
+            const double ns = runner.Run(name, pixels, [&] {
+                const bool ok = GenerateMipChain(image, kSize, kSize, c.format, options, chain, js);
+                DoNotOptimize(ok);
+            });
+            if (ns > 0.0) runner.Metric(name + "/throughput", double(pixels) / ns * 1e3, "MP/s");
+        };
+        report(prefix + "/threads=1", nullptr);
+        if (haveJobs) report(prefix + "/threads=" + std::to_string(hw), &jobs);
+    }
+}
@@ -0,0 +1,72 @@
+#include "Bench.h"
+
+#include "PipelineCache.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+constexpr size_t   kVsBytes         = 4u << 10;  // typical small DXBC containers
+constexpr size_t   kPsBytes         = 8u << 10;
+constexpr uint32_t kCacheEntries    = 256;       // shader permutations
+constexpr size_t   kDriverBlobBytes = 16u << 10; // per compiled PSO
+
+std::vector<std::byte> FakeBytecode(size_t size, uint32_t seed) {
+    std::vector<std::byte> bytes(size);
+    uint32_t state = seed * 2654435761u + 1;
+    for (std::byte& b : bytes) {
+        state = state * 1664525u + 1013904223u;
+        b     = static_cast<std::byte>(state >> 24);
+    }
+    return bytes;
+}
+
+} // namespace
+
+void RunPipelineCacheBenches(BenchRunner& runner) {
+    // --- Key derivation for the hello-triangle PSO shape ---
+    const std::vector<std::byte> vs = FakeBytecode(kVsBytes, 1);
+    const std::vector<std::byte> ps = FakeBytecode(kPsBytes, 2);
+    const PipelineInputElement layout[] = {
+        { "POSITION", 0, 6, 0, 0, 0, 0 },                     // R32G32B32_FLOAT
+        { "COLOR",    0, 2, 0, kAppendAlignedElement, 0, 0 }, // R32G32B32A32_FLOAT
+    };
+
+    GraphicsPipelineDesc desc;
+    desc.vs               = vs;
+    desc.ps               = ps;
+    desc.inputLayout      = layout;
+    desc.depthEnable      = false;
+    desc.numRenderTargets = 1;
+    desc.rtvFormats[0]    = 28; // R8G8B8A8_UNORM
+
+    runner.Run("pipeline_cache/hash_pipeline", kVsBytes + kPsBytes, [&] {
+        DoNotOptimize(HashGraphicsPipeline(desc));
+    });
+
+    // --- Image round trip: the work added to startup and shutdown ---
+    if (!runner.AnyEnabled({ "pipeline_cache/serialize_256", "pipeline_cache/deserialize_256",
+                             "pipeline_cache/round_trip_entries" }))
+        return; // skip generating 4 MiB of driver blobs
+    PipelineCache cache;
+    for (uint32_t i = 0; i < kCacheEntries; ++i) {
+        const std::vector<std::byte> blob = FakeBytecode(kDriverBlobBytes, i);
+        cache.Store(HashRootSignature(blob), blob);
+    }
+
+    constexpr uint64_t kDeviceId   = 0x1234;
+    constexpr uint64_t kImageBytes = uint64_t{ kCacheEntries } * kDriverBlobBytes;
+    runner.Run("pipeline_cache/serialize_256", kImageBytes, [&] {
+        DoNotOptimize(cache.Serialize(kDeviceId));
+    });
+
+    const std::vector<std::byte> image = cache.Serialize(kDeviceId);
+    PipelineCache               loaded;
+    runner.Run("pipeline_cache/deserialize_256", kImageBytes, [&] {
+        DoNotOptimize(loaded.Deserialize(image, kDeviceId));
+    });
+
+    runner.Metric("pipeline_cache/round_trip_entries",
+                  static_cast<double>(loaded.EntryCount()), "entries");
+}
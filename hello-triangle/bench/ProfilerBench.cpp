@@ -0,0 +1,73 @@
+#include "Bench.h"
+
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kZones = 1024; // per call; well under Profiler::kRingCapacity
+
+// Work small enough that the zone around it dominates.
+uint32_t gCounter = 0;
+
+void ZoneLoop() {
+    for (uint32_t i = 0; i < kZones; ++i) {
+        PROFILE_ZONE("bench zone");
+        DoNotOptimize(++gCounter);
+    }
+}
+
+} // namespace
+
+void RunProfilerBenches(BenchRunner& runner) {
+    runner.Run("profiler/ticks", 1, [] { DoNotOptimize(Profiler::Ticks()); });
+
+    // --- Per-zone cost, recording off and on ---
+    Profiler::SetEnabled(false);
+    runner.Run("profiler/zone_x1024/disabled", kZones, ZoneLoop);
+
+    std::vector<ProfileZone> zones;
+    zones.reserve(kZones);
+    Profiler::SetEnabled(true);
+    runner.Run("profiler/zone_x1024/enabled+collect", kZones, [&] {
+        ZoneLoop();
+        zones.clear();
+        Profiler::Collect(zones);
+    });
+
+    // Recording alone: time the zones, drain the ring outside the clock.
+    if (runner.Enabled("profiler/zone/enabled")) {
+        using Clock = std::chrono::steady_clock;
+        Clock::duration recording{};
+        const auto      start = Clock::now();
+        uint64_t        calls = 0;
+        while (Clock::now() - start < std::chrono::milliseconds(200)) {
+            const auto begin = Clock::now();
+            ZoneLoop();
+            recording += Clock::now() - begin;
+            ++calls;
+            zones.clear();
+            Profiler::Collect(zones);
+        }
+        const double ns = std::chrono::duration<double, std::nano>(recording).count();
+        runner.Metric("profiler/zone/enabled", ns / static_cast<double>(calls * kZones), "ns per zone");
+    }
+    Profiler::SetEnabled(false);
+
+    // --- Export, off the hot path ---
+    if (runner.AnyEnabled({ "profiler/chrome_trace/16k_zones", "profiler/summarize/16k_zones" })) {
+        std::vector<ProfileZone> trace(16384);
+        for (size_t i = 0; i < trace.size(); ++i) trace[i] = { "bench zone", 1, i * 1000, 500 };
+        runner.Run("profiler/chrome_trace/16k_zones", trace.size(), [&] {
+            DoNotOptimize(Profiler::FormatChromeTrace(trace));
+        });
+        runner.Run("profiler/summarize/16k_zones", trace.size(), [&] {
+            DoNotOptimize(Profiler::Summarize(trace));
+        });
+    }
+
+    runner.Metric("profiler/dropped", static_cast<double>(Profiler::DroppedCount()), "zones (ring full)");
+}
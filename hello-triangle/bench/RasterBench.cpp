@@ -0,0 +1,35 @@
+#include "Bench.h"
+
+#include "JobSystem.h"
+#include "SoftwareRenderer.h"
+
+#include <string>
+
+void RunRasterBenches(BenchRunner& runner) {
+    struct Resolution { int width, height; };
+    constexpr Resolution kResolutions[] = { { 640, 360 }, { 1280, 720 }, { 1920, 1080 } };
+
+    const auto name = [](const Resolution& res, bool parallel) {
+        return "soft/render/" + std::to_string(res.width) + "x" + std::to_string(res.height) +
+               (parallel ? "/parallel" : "/serial");
+    };
+    bool parallel = false; // the worker threads only when a parallel case runs
+    for (const Resolution& res : kResolutions) parallel = parallel || runner.Enabled(name(res, true));
+
+    JobSystem jobs;
+    if (parallel && !jobs.Init()) return;
+
+    for (const Resolution& res : kResolutions) {
+        const uint64_t pixels = static_cast<uint64_t>(res.width) * res.height;
+
+        // Serial vs. tile-parallel: frames/s is 1e9 / ns, throughput is pixels/s.
+        for (JobSystem* pool : { static_cast<JobSystem*>(nullptr), &jobs }) {
+            if (!runner.Enabled(name(res, pool != nullptr))) continue; // skip the framebuffer
+            SoftwareRenderer renderer;
+            if (!renderer.Init(res.width, res.height, pool)) continue;
+            renderer.Update(0.3f); // rotated, partly foreshortened quad
+
+            runner.Run(name(res, pool != nullptr), pixels, [&] { renderer.Render(); });
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "Bench.h"
+
+#include "RenderGraph.h"
+
+#include <string>
+
+namespace {
+
+constexpr uint32_t kReadWindow      = 64; // reads pick among the last N transients
+constexpr uint32_t kSideEffectEvery = 16; // every Nth pass also writes the back buffer
+
+// Deterministic stand-in for a real frame: every pass creates and writes one
+// transient, reads two recent transients, and every kSideEffectEvery-th pass
+// composites into the imported back buffer. Passes whose outputs never reach
+// a compositing pass are culled.
+void BuildSyntheticGraph(RenderGraph& graph, uint32_t passCount) {
+    graph.Reset();
+    const ResourceHandle backBuffer = graph.ImportTexture("BackBuffer", { 1280, 720, 1, 1, 28 });
+
+    uint32_t rng = 0x9E3779B9u;
+    const auto next = [&rng] {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    uint32_t firstTransient = backBuffer.index + 1;
+    for (uint32_t p = 0; p < passCount; ++p) {
+        const uint32_t created = graph.ResourceCount() - firstTransient;
+        const uint32_t window  = created < kReadWindow ? created : kReadWindow;
+        const uint32_t readA   = created ? firstTransient + created - 1 - next() % window : 0;
+        const uint32_t readB   = created ? firstTransient + created - 1 - next() % window : 0;
+        const bool     present = (p + 1) % kSideEffectEvery == 0;
+
+        graph.AddPass("Synthetic", [&](RenderGraphBuilder& builder) {
+            if (created) {
+                builder.Read({ readA });
+                builder.Read({ readB });
+            }
+            builder.Write(builder.CreateTexture("Target", { 640, 360, 1, 1, 10 }));
+            if (present) builder.Write(backBuffer);
+        });
+    }
+}
+
+} // namespace
+
+void RunRenderGraphBenches(BenchRunner& runner) {
+    for (uint32_t passes : { 256u, 1024u, 4096u, 16384u }) {
+        const std::string suffix = "/passes=" + std::to_string(passes);
+        if (!runner.AnyEnabled({ "render_graph/build+compile" + suffix, "render_graph/compile" + suffix,
+                                 "render_graph/culled_fraction" + suffix, "render_graph/levels" + suffix,
+                                 "render_graph/edges_per_pass" + suffix }))
+            continue;
+        RenderGraph graph;
+
+        runner.Run("render_graph/build+compile" + suffix, passes, [&] {
+            BuildSyntheticGraph(graph, passes);
+            const bool ok = graph.Compile();
+            DoNotOptimize(ok);
+        });
+
+        BuildSyntheticGraph(graph, passes);
+        runner.Run("render_graph/compile" + suffix, passes, [&] {
+            const bool ok = graph.Compile();
+            DoNotOptimize(ok);
+        });
+
+        if (!graph.Compile()) continue;
+        runner.Metric("render_graph/culled_fraction" + suffix,
+                      static_cast<double>(graph.CulledPassCount()) / passes, "");
+        runner.Metric("render_graph/levels" + suffix, graph.LevelCount(), "");
+        runner.Metric("render_graph/edges_per_pass" + suffix,
+                      static_cast<double>(graph.EdgeCount()) / (passes - graph.CulledPassCount()), "");
+    }
+}
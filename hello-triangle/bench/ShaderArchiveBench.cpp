@@ -0,0 +1,120 @@
+#include "Bench.h"
+
+#include "ShaderArchive.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kEntries  = 4096;      // a large permutation set
+constexpr size_t   kMinBytes = 2u << 10;  // small DXBC containers...
+constexpr size_t   kMaxBytes = 12u << 10; // ...up to uber-shader sizes
+
+std::vector<std::byte> FakeBytecode(size_t size, uint32_t seed) {
+    std::vector<std::byte> bytes(size);
+    uint32_t state = seed * 2654435761u + 1;
+    for (std::byte& b : bytes) {
+        state = state * 1664525u + 1013904223u;
+        b     = static_cast<std::byte>(state >> 24);
+    }
+    return bytes;
+}
+
+// The loose-file loader the archive replaces: open, seek to the end for the
+// size, seek back, read into a fresh vector.
+std::vector<std::byte> ReadBinaryFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return {};
+
+    const std::streampos end = file.tellg();
+    if (end <= 0) return {};
+    std::vector<std::byte> buf(static_cast<size_t>(end));
+    file.seekg(0, std::ios::beg);
+    if (!file.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(buf.size())))
+        return {};
+    return buf;
+}
+
+} // namespace
+
+void RunShaderArchiveBenches(BenchRunner& runner) {
+    // Skip writing thousands of files when the filter excludes every case.
+    if (!runner.AnyEnabled({ "shader_archive/read_files_4096", "shader_archive/map_and_find_4096",
+                             "shader_archive/find_4096", "shader_archive/size_overhead" }))
+        return;
+
+    std::error_code             ec;
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path(ec) / "hello-triangle-shader-archive-bench";
+    std::filesystem::remove_all(dir, ec);
+    if (!std::filesystem::create_directories(dir, ec)) {
+        std::fprintf(stderr, "shader_archive: cannot create %s\n", dir.string().c_str());
+        return;
+    }
+
+    // --- The same shaders as loose files and as one archive ---
+    std::vector<std::string> names;
+    ShaderArchiveBuilder     builder;
+    uint64_t                 payload = 0;
+    for (uint32_t i = 0; i < kEntries; ++i) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "shader_%04u.cso", i);
+        names.emplace_back(name);
+
+        const size_t                 size = kMinBytes + (i * 2654435761u) % (kMaxBytes - kMinBytes);
+        const std::vector<std::byte> blob = FakeBytecode(size, i);
+        payload += size;
+
+        std::ofstream(dir / name, std::ios::binary)
+            .write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(size));
+        (void)builder.Add(name, blob);
+    }
+    const std::filesystem::path archivePath = dir / "shaders.shar";
+    if (!builder.Write(archivePath)) {
+        std::fprintf(stderr, "shader_archive: cannot write %s\n", archivePath.string().c_str());
+        std::filesystem::remove_all(dir, ec);
+        return;
+    }
+
+    // --- Load every shader: per-file open + read vs. one mapping + lookups ---
+    runner.Run("shader_archive/read_files_4096", kEntries, [&] {
+        size_t bytes = 0;
+        for (const std::string& name : names) bytes += ReadBinaryFile(dir / name).size();
+        DoNotOptimize(bytes);
+    });
+
+    runner.Run("shader_archive/map_and_find_4096", kEntries, [&] {
+        ShaderArchive archive;
+        size_t        bytes = 0;
+        if (archive.Open(archivePath)) {
+            for (const std::string& name : names) {
+                const std::span<const std::byte> blob = archive.Find(name);
+                bytes += blob.size() + static_cast<size_t>(blob.front()); // touch the page
+            }
+        }
+        DoNotOptimize(bytes);
+    });
+
+    ShaderArchive archive;
+    if (archive.Open(archivePath)) {
+        runner.Run("shader_archive/find_4096", kEntries, [&] {
+            size_t bytes = 0;
+            for (const std::string& name : names) bytes += archive.Find(name).size();
+            DoNotOptimize(bytes);
+        });
+    }
+
+    runner.Metric("shader_archive/size_overhead",
+                  100.0 * static_cast<double>(std::filesystem::file_size(archivePath, ec) - payload) /
+                      static_cast<double>(payload),
+                  "% (header, index, names, padding)");
+
+    archive.Close();
+    std::filesystem::remove_all(dir, ec);
+}
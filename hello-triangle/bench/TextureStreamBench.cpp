@@ -0,0 +1,163 @@
+#include "Bench.h"
+
+#include "TextureFile.h"
+#include "TextureStreamer.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kFiles       = 64;   // 1024^2 BC1 with mips: ~683 KiB each
+constexpr uint32_t kSize        = 1024;
+constexpr uint32_t kTailMips    = 5;    // 64x64 and down: what a first frame needs
+constexpr uint32_t kStreamed    = 4096; // textures under the scheduler
+constexpr uint64_t kFrameUpload = 4u << 20;
+
+TextureDesc Bc1Desc() {
+    TextureDesc desc;
+    desc.format   = 71; // BC1_UNORM
+    desc.width    = kSize;
+    desc.height   = kSize;
+    desc.mipCount = 11;
+    return desc;
+}
+
+std::vector<std::byte> FakeTexels(size_t size, uint32_t seed) {
+    std::vector<std::byte> bytes(size);
+    uint32_t state = seed * 2654435761u + 1;
+    for (std::byte& b : bytes) {
+        state = state * 1664525u + 1013904223u;
+        b     = static_cast<std::byte>(state >> 24);
+    }
+    return bytes;
+}
+
+// The whole-file loader a mapping replaces.
+std::vector<std::byte> ReadBinaryFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return {};
+
+    const std::streampos end = file.tellg();
+    if (end <= 0) return {};
+    std::vector<std::byte> buf(static_cast<size_t>(end));
+    file.seekg(0, std::ios::beg);
+    if (!file.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(buf.size())))
+        return {};
+    return buf;
+}
+
+// Sums one byte per 4 KiB of the mip tail, faulting in just those pages.
+size_t TouchTail(const TextureFile& file) {
+    size_t sum = 0;
+    for (uint32_t mip = file.MipCount() - kTailMips; mip < file.MipCount(); ++mip) {
+        const std::span<const std::byte> data = file.Subresource(mip).data;
+        for (size_t i = 0; i < data.size(); i += 4096) sum += static_cast<size_t>(data[i]);
+    }
+    return sum;
+}
+
+} // namespace
+
+void RunTextureStreamBenches(BenchRunner& runner) {
+    if (!runner.AnyEnabled({ "texture_file/parse_dds", "texture_file/parse_ktx2", "texture_file/read_64",
+                             "texture_file/map_tail_64", "texture_file/first_frame_bytes",
+                             "texture_streamer/update_4096", "texture_streamer/resident" }))
+        return; // skip building the 1024x1024 images
+
+    const TextureDesc            desc   = Bc1Desc();
+    const std::vector<std::byte> texels = FakeTexels(TextureDataBytes(desc), 1);
+    const std::vector<std::byte> dds    = BuildDds(desc, texels);
+    const std::vector<std::byte> ktx2   = BuildKtx2(desc, texels);
+
+    // --- Header parsing alone ---
+    runner.Run("texture_file/parse_dds", 1, [&] {
+        TextureFile file;
+        DoNotOptimize(file.OpenMemory(dds));
+    });
+    runner.Run("texture_file/parse_ktx2", 1, [&] {
+        TextureFile file;
+        DoNotOptimize(file.OpenMemory(ktx2));
+    });
+
+    // --- Load 64 files: read everything vs. map and touch the mip tail ---
+    if (runner.AnyEnabled({ "texture_file/read_64", "texture_file/map_tail_64" })) {
+        std::error_code             ec;
+        const std::filesystem::path dir =
+            std::filesystem::temp_directory_path(ec) / "hello-triangle-texture-bench";
+        std::filesystem::remove_all(dir, ec);
+        if (!std::filesystem::create_directories(dir, ec)) {
+            std::fprintf(stderr, "texture_file: cannot create %s\n", dir.string().c_str());
+            return;
+        }
+
+        std::vector<std::filesystem::path> paths;
+        for (uint32_t i = 0; i < kFiles; ++i) {
+            paths.push_back(dir / ("texture_" + std::to_string(i) + ".dds"));
+            std::ofstream(paths.back(), std::ios::binary)
+                .write(reinterpret_cast<const char*>(dds.data()), static_cast<std::streamsize>(dds.size()));
+        }
+
+        runner.Run("texture_file/read_64", kFiles, [&] {
+            size_t sum = 0;
+            for (const std::filesystem::path& path : paths) {
+                const std::vector<std::byte> image = ReadBinaryFile(path);
+                TextureFile                  file;
+                if (file.OpenMemory(image)) sum += TouchTail(file);
+            }
+            DoNotOptimize(sum);
+        });
+
+        runner.Run("texture_file/map_tail_64", kFiles, [&] {
+            size_t sum = 0;
+            for (const std::filesystem::path& path : paths) {
+                TextureFile file;
+                if (file.Open(path)) sum += TouchTail(file);
+            }
+            DoNotOptimize(sum);
+        });
+
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    TextureFile probe;
+    if (probe.OpenMemory(dds)) {
+        uint64_t tail = 0;
+        for (uint32_t mip = probe.MipCount() - kTailMips; mip < probe.MipCount(); ++mip) tail += probe.MipBytes(mip);
+        runner.Metric("texture_file/first_frame_bytes", 100.0 * static_cast<double>(tail) /
+                                                            static_cast<double>(dds.size()),
+                      "% of the file touched for the mip tail");
+    }
+
+    // --- Scheduler: 4096 textures, 64 change their wanted mip per frame ---
+    if (runner.AnyEnabled({ "texture_streamer/update_4096", "texture_streamer/resident" })) {
+        auto files = std::make_unique<TextureFile[]>(kStreamed);
+        TextureStreamer streamer(256ull << 20);
+        for (uint32_t i = 0; i < kStreamed; ++i) {
+            if (!files[i].OpenMemory(dds)) return;
+            (void)streamer.Add(files[i]);
+        }
+
+        std::vector<StreamRequest> requests;
+        uint32_t                   state = 12345;
+        uint64_t                   count = 0;
+        runner.Run("texture_streamer/update_4096", kStreamed, [&] {
+            for (uint32_t i = 0; i < 64; ++i) {
+                state = state * 1664525u + 1013904223u;
+                streamer.SetWantedMip(state % kStreamed, (state >> 16) % desc.mipCount);
+            }
+            requests.clear();
+            streamer.Update(kFrameUpload, requests);
+            count += requests.size();
+        });
+        DoNotOptimize(count);
+        runner.Metric("texture_streamer/resident", static_cast<double>(streamer.ResidentBytes()) / (1 << 20),
+                      "MiB (256 MiB budget)");
+    }
+}
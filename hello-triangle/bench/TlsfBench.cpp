@@ -0,0 +1,101 @@
+#include "Bench.h"
+
+#include "TlsfAllocator.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kHeapBytes    = 256ull << 20;
+constexpr uint32_t kLiveTarget   = 256;  // allocations alive during churn (~55% of the heap)
+constexpr uint32_t kChurnWarmup  = 200000;
+
+struct Rng {
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    uint64_t Next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// A resource mix in the three placement classes: mostly small buffers and
+// textures, some mid-size render targets, a few large MSAA targets.
+void NextRequest(Rng& rng, uint64_t& size, uint64_t& alignment) {
+    const uint64_t r = rng.Next();
+    switch (r % 16) {
+    case 0:
+        size      = (1ull << 20) + (r >> 8) % (8ull << 20);
+        alignment = kMsaaPlacementAlignment;
+        break;
+    case 1: case 2: case 3:
+        size      = (256ull << 10) + (r >> 8) % (2ull << 20);
+        alignment = kDefaultPlacementAlignment;
+        break;
+    case 4: case 5: case 6: case 7: case 8:
+        size      = (4ull << 10) + (r >> 8) % (60ull << 10);
+        alignment = kSmallTexturePlacementAlignment;
+        break;
+    default:
+        size      = 256 + (r >> 8) % (64ull << 10);
+        alignment = kDefaultPlacementAlignment;
+        break;
+    }
+}
+
+// Keeps about kLiveTarget allocations alive: each step frees a random one
+// (when at the target) and allocates a new one.
+struct Churn {
+    TlsfAllocator               tlsf;
+    std::vector<TlsfAllocation> live;
+    Rng                         rng;
+    uint64_t                    failures = 0;
+
+    void Step() {
+        if (live.size() >= kLiveTarget) {
+            const size_t victim = rng.Next() % live.size();
+            tlsf.Free(live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
+        }
+        uint64_t size, alignment;
+        NextRequest(rng, size, alignment);
+        TlsfAllocation a;
+        if (tlsf.Allocate(size, alignment, a)) live.push_back(a);
+        else ++failures;
+    }
+};
+
+} // namespace
+
+void RunTlsfBenches(BenchRunner& runner) {
+    // --- Latency: allocate + free of one block in an empty heap ---
+    if (runner.Enabled("tlsf/alloc_free/empty_heap")) {
+        TlsfAllocator tlsf;
+        if (!tlsf.Init(kHeapBytes)) return;
+        runner.Run("tlsf/alloc_free/empty_heap", 1, [&] {
+            TlsfAllocation a;
+            if (tlsf.Allocate(64ull << 10, kDefaultPlacementAlignment, a)) tlsf.Free(a);
+            DoNotOptimize(a);
+        });
+    }
+
+    // --- Latency and fragmentation under steady-state churn ---
+    if (!runner.AnyEnabled({ "tlsf/churn/free+alloc", "tlsf/churn/occupancy", "tlsf/churn/fragmentation",
+                             "tlsf/churn/failed_allocations", "tlsf/churn/valid" }))
+        return; // skip the 200k-step warm-up
+    Churn churn;
+    if (!churn.tlsf.Init(kHeapBytes)) return;
+    for (uint32_t i = 0; i < kChurnWarmup; ++i) churn.Step();
+
+    runner.Run("tlsf/churn/free+alloc", 1, [&] { churn.Step(); });
+
+    runner.Metric("tlsf/churn/occupancy",
+                  static_cast<double>(churn.tlsf.UsedBytes()) / churn.tlsf.Capacity(), "of heap");
+    runner.Metric("tlsf/churn/fragmentation", churn.tlsf.Fragmentation(), "1 - largest/free");
+    runner.Metric("tlsf/churn/failed_allocations", static_cast<double>(churn.failures), "");
+    runner.Metric("tlsf/churn/valid", churn.tlsf.Validate() ? 1.0 : 0.0, "invariants hold");
+}
@@ -0,0 +1,84 @@
+#include "Bench.h"
+
+#include "UploadScheduler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kStagingBytes = 4ull << 20;
+constexpr uint64_t kFrameBudget  = 1ull << 20;
+constexpr uint32_t kSmallCount   = 4096; // 256-byte pieces of one 1 MiB buffer
+constexpr uint32_t kSmallBytes   = 256;
+constexpr uint32_t kTextureCount = 64;   // 256x256 RGBA8 subresources
+constexpr uint32_t kTextureSize  = 256;
+
+// Queues everything, then runs frames until the last ticket completes, with
+// the simulated copy engine two frames behind. Returns the frames taken.
+template <class Enqueue>
+uint32_t RunUploads(std::vector<std::byte>& staging, Enqueue&& enqueue, uint64_t& batches, uint64_t& copies) {
+    SimulatedCopyQueue queue(staging.data(), 2);
+    UploadScheduler    scheduler;
+    if (!scheduler.Init(&queue, staging.data(), staging.size(), kFrameBudget)) return 0;
+
+    const uint64_t last   = enqueue(scheduler);
+    uint32_t       frames = 0;
+    while (!scheduler.IsComplete(last)) {
+        if (!scheduler.Update()) return 0;
+        queue.CompleteUpTo(queue.CompletedValue() + 1);
+        ++frames;
+    }
+    batches = scheduler.BatchCount();
+    copies  = scheduler.CopyCount();
+    return frames;
+}
+
+} // namespace
+
+void RunUploadBenches(BenchRunner& runner) {
+    const bool small    = runner.Enabled("upload/small_buffers_4096");
+    const bool textured = runner.Enabled("upload/textures_64x256k");
+    if (!small && !textured) return; // skip allocating the staging, source and destination memory
+
+    std::vector<std::byte> staging(kStagingBytes);
+    std::vector<std::byte> source(kSmallCount * kSmallBytes, std::byte{ 0x5A });
+    std::vector<std::byte> buffer(source.size());
+    std::vector<std::byte> texels(size_t(kTextureSize) * kTextureSize * 4, std::byte{ 0xA5 });
+    std::vector<std::byte> textures(texels.size() * kTextureCount);
+
+    uint64_t batches = 0, copies = 0;
+    const auto enqueueSmall = [&](UploadScheduler& s) {
+        uint64_t ticket = 0;
+        for (uint32_t i = 0; i < kSmallCount; ++i) {
+            ticket = s.UploadBuffer(reinterpret_cast<uintptr_t>(buffer.data()), uint64_t{ i } * kSmallBytes,
+                                    std::span(source).subspan(size_t(i) * kSmallBytes, kSmallBytes));
+        }
+        return ticket;
+    };
+    const auto enqueueTextures = [&](UploadScheduler& s) {
+        uint64_t ticket = 0;
+        for (uint32_t i = 0; i < kTextureCount; ++i) {
+            ticket = s.UploadTexture(reinterpret_cast<uintptr_t>(textures.data() + i * texels.size()), 0, texels,
+                                     kTextureSize * 4, kTextureSize);
+        }
+        return ticket;
+    };
+
+    // --- Scheduling cost per request, including the simulated copies ---
+    runner.Run("upload/small_buffers_4096", kSmallCount, [&] {
+        DoNotOptimize(RunUploads(staging, enqueueSmall, batches, copies));
+    });
+    if (small) {
+        runner.Metric("upload/small_buffers_batches", double(batches), "submissions (one per request unbatched)");
+        runner.Metric("upload/small_buffers_copies", double(copies), "copy commands after coalescing");
+    }
+
+    runner.Run("upload/textures_64x256k", kTextureCount, [&] {
+        DoNotOptimize(RunUploads(staging, enqueueTextures, batches, copies));
+    });
+    if (textured) {
+        runner.Metric("upload/textures_batches", double(batches), "submissions at a 1 MiB frame budget");
+    }
+}
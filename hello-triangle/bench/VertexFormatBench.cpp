@@ -0,0 +1,95 @@
+#include "Bench.h"
+
+#include "VertexFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Scattered vertices over a 200-unit scene block, UVs tiled up to 8x.
+std::vector<Vertex> MakeVertices(size_t count) {
+    std::mt19937                          rng(11);
+    std::uniform_real_distribution<float> pos(-100.f, 100.f), unit(0.f, 1.f), uv(0.f, 8.f);
+    std::vector<Vertex>                   v(count);
+    for (Vertex& x : v) {
+        x = { { pos(rng), pos(rng) * 0.25f, pos(rng) + 40.f },
+              { unit(rng), unit(rng), unit(rng), 1.f },
+              { uv(rng), uv(rng) } };
+    }
+    return v;
+}
+
+struct NamedFormat {
+    const char*  name;
+    VertexFormat format;
+};
+
+} // namespace
+
+void RunVertexFormatBenches(BenchRunner& runner) {
+    const NamedFormat formats[] = {
+        { "full",         kFullVertexFormat },
+        { "compact",      kCompactVertexFormat },
+        { "half_pos",     { PositionEncoding::Half4, ColorEncoding::Unorm8x4, TexCoordEncoding::Half2 } },
+        { "unorm16_uv",   { PositionEncoding::Unorm16x4, ColorEncoding::Unorm8x4, TexCoordEncoding::Unorm16x2 } },
+    };
+    const auto prefixOf = [](const NamedFormat& f) { return std::string("vertex_format/") + f.name; };
+    const auto enabled  = [&](const std::string& prefix) {
+        return runner.AnyEnabled({ prefix + "/encode_1m", prefix + "/stride", prefix + "/bytes_saved",
+                                   prefix + "/max_error_ratio" });
+    };
+    if (std::none_of(std::begin(formats), std::end(formats), [&](const NamedFormat& f) { return enabled(prefixOf(f)); }))
+        return; // skip generating 1M vertices
+
+    constexpr size_t          kCount = 1 << 20;
+    const std::vector<Vertex> vertices = MakeVertices(kCount);
+    float                     maxTexCoord = 0.f;
+    for (const Vertex& v : vertices) maxTexCoord = std::max({ maxTexCoord, std::fabs(v.uv[0]), std::fabs(v.uv[1]) });
+
+    std::vector<std::byte> encoded(kCount * sizeof(Vertex));
+    std::vector<Vertex>    decoded(kCount);
+
+    for (const NamedFormat& f : formats) {
+        const std::string prefix = prefixOf(f);
+        if (!enabled(prefix)) continue;
+
+        const VertexLayout    layout  = MakeVertexLayout(f.format);
+        const PositionDequant dequant = ComputePositionDequant(vertices, f.format.position);
+
+        runner.Run(prefix + "/encode_1m", kCount, [&] {
+            const bool ok = EncodeVertices(vertices, f.format, dequant, encoded);
+            DoNotOptimize(ok);
+        });
+        runner.Metric(prefix + "/stride", layout.stride, "bytes");
+        runner.Metric(prefix + "/bytes_saved", 100.0 * (1.0 - double(layout.stride) / sizeof(Vertex)), "%");
+
+        // --- Measured error against the format's guarantee (ratio <= 1) ---
+        if (!runner.Enabled(prefix + "/max_error_ratio")) continue;
+        if (!EncodeVertices(vertices, f.format, dequant, encoded) ||
+            !DecodeVertices(encoded, f.format, dequant, decoded)) {
+            continue;
+        }
+        const VertexErrorBounds bounds = VertexFormatErrorBounds(f.format, dequant, maxTexCoord);
+        double                  worst  = 0.0;
+        const auto check = [&](float a, float b, float bound) {
+            const double err = std::fabs(double(a) - double(b));
+            worst = std::max(worst, bound > 0.f ? err / bound : (err > 0.0 ? 1e9 : 0.0));
+        };
+        for (size_t i = 0; i < kCount; ++i) {
+            for (int c = 0; c < 3; ++c) check(vertices[i].pos[c], decoded[i].pos[c], bounds.position[c]);
+            for (int c = 0; c < 4; ++c) check(vertices[i].col[c], decoded[i].col[c], bounds.color);
+            for (int c = 0; c < 2; ++c) {
+                // UNORM16 UVs are defined for [0, 1]; the tiled ones clamp.
+                const float expected = f.format.texCoord == TexCoordEncoding::Unorm16x2
+                                     ? std::clamp(vertices[i].uv[c], 0.f, 1.f) : vertices[i].uv[c];
+                check(expected, decoded[i].uv[c], bounds.texCoord);
+            }
+        }
+        runner.Metric(prefix + "/max_error_ratio", worst, "of bound");
+    }
+}
@@ -2,9 +2,8 @@ Texture2D    gAlbedo  : register(t0);
 SamplerState gSampler : register(s0);
 
 cbuffer PerFrame : register(b1) {
-    float  time;       // accumulated time in seconds
-    float  deltaTime;  // last frame duration in seconds
-    float2 padding;    // explicit padding to satisfy 16-byte cbuffer alignment
+    float time;      // accumulated time in seconds
+    float deltaTime; // last frame duration in seconds
 };
 
 struct PSInput {
@@ -1,12 +1,18 @@
-cbuffer PerObject : register(b0) {
-    float4x4 mvpMatrix; // pre-transposed on CPU (row-major -> column-major)
-    float4   tintColor;
+cbuffer PerView : register(b0) {
+    float4x4 viewProjMatrix; // pre-transposed on CPU (row-major -> column-major)
 };
 
 struct VSInput {
+    // Per vertex (slot 0)
     float3 position : POSITION;
     float4 color    : COLOR;
     float2 texCoord : TEXCOORD;
+
+    // Per instance (slot 1): columns 0-2 of the world matrix, then the tint
+    float4 world0   : INSTANCE_WORLD0;
+    float4 world1   : INSTANCE_WORLD1;
+    float4 world2   : INSTANCE_WORLD2;
+    float4 tint     : INSTANCE_TINT;
 };
 
 struct VSOutput {
@@ -16,9 +22,14 @@ struct VSOutput {
 };
 
 VSOutput VSMain(VSInput input) {
+    float4 objectPos = float4(input.position, 1.0);
+    float3 worldPos  = float3(dot(objectPos, input.world0),
+                              dot(objectPos, input.world1),
+                              dot(objectPos, input.world2));
+
     VSOutput output;
-    output.position = mul(mvpMatrix, float4(input.position, 1.0));
-    output.color    = input.color * tintColor;
+    output.position = mul(viewProjMatrix, float4(worldPos, 1.0));
+    output.color    = input.color * input.tint;
     output.uv       = input.texCoord;
     return output;
 }
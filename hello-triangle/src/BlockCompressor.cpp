@@ -0,0 +1,582 @@
+#include "BlockCompressor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "JobSystem.h"
+#include "Simd.h"
+
+namespace {
+
+// Blocks per row-range job.
+constexpr uint32_t kBlocksPerJob = 256;
+
+// Refinement rounds of the quality mode; each stops early once the error
+// stops improving.
+constexpr int kRefineIterations = 3;
+
+constexpr float kBc1Weights[4]  = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f }; // index -> position on c0..c1
+constexpr int   kBc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// ---------------------------------------------------------------------------
+// A 4x4 block as channel planes (R, G, B, A), 0..255; each plane is two
+// Float8.
+// ---------------------------------------------------------------------------
+
+struct Block {
+    alignas(32) float c[4][16];
+};
+
+void LoadBlock(const std::byte* image, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, Block& b) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        const uint32_t sy = std::min(by * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t   sx = std::min(bx * 4 + x, width - 1);
+            const std::byte* p  = image + (size_t(sy) * width + sx) * 4;
+            for (int c = 0; c < 4; ++c) b.c[c][y * 4 + x] = std::to_integer<uint8_t>(p[c]);
+        }
+    }
+}
+
+float Sum(Float8 v) {
+    alignas(32) float t[kSimdWidth];
+    v.Store(t);
+    return ((t[0] + t[1]) + (t[2] + t[3])) + ((t[4] + t[5]) + (t[6] + t[7]));
+}
+
+float MinOf(Float8 v) {
+    alignas(32) float t[kSimdWidth];
+    v.Store(t);
+    return *std::min_element(t, t + kSimdWidth);
+}
+
+float MaxOf(Float8 v) {
+    alignas(32) float t[kSimdWidth];
+    v.Store(t);
+    return *std::max_element(t, t + kSimdWidth);
+}
+
+// ---------------------------------------------------------------------------
+// Endpoint search
+// ---------------------------------------------------------------------------
+
+// Extremes of the texels projected onto the principal axis of their
+// colours (first `channels` channels).
+void PrincipalEndpoints(const Block& b, int channels, float e0[4], float e1[4]) {
+    Float8 centered[4][2];
+    float  mean[4] = {};
+    for (int c = 0; c < channels; ++c) {
+        const Float8 lo = Float8::Load(b.c[c]), hi = Float8::Load(b.c[c] + 8);
+        mean[c]         = (Sum(lo) + Sum(hi)) * (1.f / 16.f);
+        centered[c][0]  = lo - Float8(mean[c]);
+        centered[c][1]  = hi - Float8(mean[c]);
+    }
+
+    float cov[4][4] = {};
+    for (int i = 0; i < channels; ++i) {
+        for (int j = i; j < channels; ++j) {
+            cov[i][j] = cov[j][i] = Sum(centered[i][0] * centered[j][0] + centered[i][1] * centered[j][1]);
+        }
+    }
+
+    // Power iteration, seeded with the covariance row of the widest channel
+    // (already inside the dominant subspace).
+    int widest = 0;
+    for (int c = 1; c < channels; ++c) widest = cov[c][c] > cov[widest][widest] ? c : widest;
+    float axis[4] = {};
+    for (int c = 0; c < channels; ++c) axis[c] = cov[widest][c];
+    for (int iter = 0; iter < 8; ++iter) {
+        float next[4] = {}, scale = 0.f;
+        for (int i = 0; i < channels; ++i) {
+            for (int j = 0; j < channels; ++j) next[i] += cov[i][j] * axis[j];
+            scale = std::max(scale, std::fabs(next[i]));
+        }
+        if (scale == 0.f) break;
+        for (int c = 0; c < channels; ++c) axis[c] = next[c] / scale;
+    }
+    float lengthSq = 0.f;
+    for (int c = 0; c < channels; ++c) lengthSq += axis[c] * axis[c];
+    if (lengthSq > 0.f) {
+        for (int c = 0; c < channels; ++c) axis[c] /= std::sqrt(lengthSq);
+    }
+
+    Float8 t[2] = { Float8(0.f), Float8(0.f) };
+    for (int c = 0; c < channels; ++c) {
+        t[0] = t[0] + centered[c][0] * Float8(axis[c]);
+        t[1] = t[1] + centered[c][1] * Float8(axis[c]);
+    }
+    const float tMin = MinOf(Min(t[0], t[1])), tMax = MaxOf(Max(t[0], t[1]));
+    for (int c = 0; c < channels; ++c) {
+        e0[c] = std::clamp(mean[c] + tMin * axis[c], 0.f, 255.f);
+        e1[c] = std::clamp(mean[c] + tMax * axis[c], 0.f, 255.f);
+    }
+}
+
+// Least-squares endpoints for fixed indices: texel ~ (1 - w) e0 + w e1
+// with w = weights[index]. False when the indices do not constrain both.
+bool RefineEndpoints(const Block& b, int firstChannel, int channels, const uint8_t idx[16], const float* weights,
+                     float e0[4], float e1[4]) {
+    float aa = 0.f, ab = 0.f, bb = 0.f, ax[4] = {}, bx[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        const float w = weights[idx[i]], a = 1.f - w;
+        aa += a * a;
+        ab += a * w;
+        bb += w * w;
+        for (int c = 0; c < channels; ++c) {
+            ax[c] += a * b.c[firstChannel + c][i];
+            bx[c] += w * b.c[firstChannel + c][i];
+        }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+    for (int c = 0; c < channels; ++c) {
+        e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / det, 0.f, 255.f);
+        e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / det, 0.f, 255.f);
+    }
+    return true;
+}
+
+// Nearest of `count` palette entries for every texel, all texels at once;
+// returns the total squared error.
+float AssignIndices(const Block& b, int firstChannel, int channels, const float (*palette)[4], int count,
+                    uint8_t idx[16]) {
+    float error = 0.f;
+    for (int half = 0; half < 2; ++half) {
+        Float8 texel[4];
+        for (int c = 0; c < channels; ++c) texel[c] = Float8::Load(b.c[firstChannel + c] + half * 8);
+
+        Float8 best(FLT_MAX), bestIndex(0.f);
+        for (int k = 0; k < count; ++k) {
+            Float8 d(0.f);
+            for (int c = 0; c < channels; ++c) {
+                const Float8 diff = texel[c] - Float8(palette[k][c]);
+                d = d + diff * diff;
+            }
+            const Float8 closer = CmpLt(d, best);
+            best      = Select(closer, d, best);
+            bestIndex = Select(closer, Float8(static_cast<float>(k)), bestIndex);
+        }
+        error += Sum(best);
+
+        int32_t q[kSimdWidth];
+        StoreInt(bestIndex, q);
+        for (int i = 0; i < kSimdWidth; ++i) idx[half * 8 + i] = static_cast<uint8_t>(q[i]);
+    }
+    return error;
+}
+
+// ---------------------------------------------------------------------------
+// Bit packing (little endian, LSB first)
+// ---------------------------------------------------------------------------
+
+struct Bits128 {
+    uint64_t word[2] = {};
+    uint32_t pos     = 0;
+
+    void Put(uint32_t value, uint32_t bits) {
+        for (uint32_t i = 0; i < bits; ++i, ++pos) word[pos >> 6] |= uint64_t((value >> i) & 1) << (pos & 63);
+    }
+    uint32_t Get(uint32_t bits) {
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < bits; ++i, ++pos) v |= uint32_t((word[pos >> 6] >> (pos & 63)) & 1) << i;
+        return v;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// BC1 colour
+// ---------------------------------------------------------------------------
+
+uint16_t To565(const float e[3]) {
+    const auto q = [](float v, int max) { return std::clamp(static_cast<int>(std::lround(v * max / 255.f)), 0, max); };
+    return static_cast<uint16_t>((q(e[0], 31) << 11) | (q(e[1], 63) << 5) | q(e[2], 31));
+}
+
+void From565(uint16_t c, int out[3]) {
+    const int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Four-colour palette of c0..c1 in index order (what the decoder builds
+// once c0 > c1).
+void Bc1Palette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+    From565(c0, palette[0]);
+    From565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+}
+
+struct Bc1Candidate {
+    uint16_t c0 = 0, c1 = 0;
+    uint8_t  idx[16] = {};
+    float    error   = FLT_MAX;
+};
+
+Bc1Candidate EvalBc1(const Block& b, const float e0[3], const float e1[3]) {
+    Bc1Candidate r;
+    r.c0 = To565(e0);
+    r.c1 = To565(e1);
+
+    int   palette[4][3];
+    float paletteF[4][4] = {};
+    Bc1Palette(r.c0, r.c1, palette);
+    for (int k = 0; k < 4; ++k) {
+        for (int c = 0; c < 3; ++c) paletteF[k][c] = static_cast<float>(palette[k][c]);
+    }
+    r.error = AssignIndices(b, 0, 3, paletteF, r.c0 == r.c1 ? 1 : 4, r.idx);
+    return r;
+}
+
+uint64_t EncodeBc1(const Block& b, BcQuality quality) {
+    float e0[4], e1[4];
+    PrincipalEndpoints(b, 3, e0, e1);
+    Bc1Candidate best = EvalBc1(b, e0, e1);
+
+    if (quality == BcQuality::Quality) {
+        for (int iter = 0; iter < kRefineIterations; ++iter) {
+            if (!RefineEndpoints(b, 0, 3, best.idx, kBc1Weights, e0, e1)) break;
+            const Bc1Candidate c = EvalBc1(b, e0, e1);
+            if (c.error >= best.error) break;
+            best = c;
+        }
+    }
+
+    // Four-colour mode needs c0 > c1: swap the endpoints and mirror the
+    // indices (0 <-> 1, 2 <-> 3). Equal endpoints: every texel is c0.
+    if (best.c0 < best.c1) {
+        std::swap(best.c0, best.c1);
+        for (uint8_t& i : best.idx) i ^= 1;
+    }
+    uint64_t block = uint64_t(best.c0) | (uint64_t(best.c1) << 16);
+    if (best.c0 != best.c1) {
+        for (int i = 0; i < 16; ++i) block |= uint64_t(best.idx[i]) << (32 + 2 * i);
+    }
+    return block;
+}
+
+void DecodeBc1(const std::byte* src, bool forceFourColor, uint8_t out[16][4]) {
+    uint64_t block;
+    std::memcpy(&block, src, sizeof(block));
+    const uint16_t c0 = static_cast<uint16_t>(block), c1 = static_cast<uint16_t>(block >> 16);
+
+    int palette[4][3], alpha[4] = { 255, 255, 255, 255 };
+    Bc1Palette(c0, c1, palette);
+    if (c0 <= c1 && !forceFourColor) {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+        alpha[3] = 0;
+    }
+    for (int i = 0; i < 16; ++i) {
+        const int k = (block >> (32 + 2 * i)) & 3;
+        for (int c = 0; c < 3; ++c) out[i][c] = static_cast<uint8_t>(palette[k][c]);
+        out[i][3] = static_cast<uint8_t>(alpha[k]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// BC4 alpha (the second half of BC3)
+// ---------------------------------------------------------------------------
+
+// Eight-value mode when a0 > a1, otherwise six values plus 0 and 255.
+void Bc4Palette(int a0, int a1, float palette[8][4]) {
+    palette[0][0] = float(a0);
+    palette[1][0] = float(a1);
+    if (a0 > a1) {
+        for (int i = 2; i < 8; ++i) palette[i][0] = float(((8 - i) * a0 + (i - 1) * a1) / 7);
+    } else {
+        for (int i = 2; i < 6; ++i) palette[i][0] = float(((6 - i) * a0 + (i - 1) * a1) / 5);
+        palette[6][0] = 0.f;
+        palette[7][0] = 255.f;
+    }
+}
+
+uint64_t EncodeBc4(const Block& b, BcQuality quality) {
+    constexpr int kAlpha = 3;
+    const float*  a      = b.c[kAlpha];
+
+    struct Candidate {
+        int     a0 = 0, a1 = 0;
+        uint8_t idx[16] = {};
+        float   error   = FLT_MAX;
+    };
+    const auto eval = [&](int a0, int a1) {
+        Candidate c;
+        c.a0 = a0;
+        c.a1 = a1;
+        float palette[8][4] = {};
+        Bc4Palette(a0, a1, palette);
+        c.error = AssignIndices(b, kAlpha, 1, palette, 8, c.idx);
+        return c;
+    };
+
+    const int lo = static_cast<int>(*std::min_element(a, a + 16));
+    const int hi = static_cast<int>(*std::max_element(a, a + 16));
+    Candidate best = eval(hi, lo); // eight values across the range (or constant)
+
+    if (quality == BcQuality::Quality && lo != hi) {
+        // Six values over the texels that are not exactly 0 or 255, which
+        // the mode reproduces for free.
+        int innerLo = 255, innerHi = 0;
+        for (int i = 0; i < 16; ++i) {
+            const int v = static_cast<int>(a[i]);
+            if (v == 0 || v == 255) continue;
+            innerLo = std::min(innerLo, v);
+            innerHi = std::max(innerHi, v);
+        }
+        if (innerLo > innerHi) innerLo = innerHi = 0;
+        const Candidate six = eval(innerLo, innerHi);
+        if (six.error < best.error) best = six;
+    }
+
+    uint64_t block = uint64_t(best.a0) | (uint64_t(best.a1) << 8);
+    for (int i = 0; i < 16; ++i) block |= uint64_t(best.idx[i]) << (16 + 3 * i);
+    return block;
+}
+
+void DecodeBc4(const std::byte* src, uint8_t out[16][4]) {
+    uint64_t block;
+    std::memcpy(&block, src, sizeof(block));
+    float palette[8][4] = {};
+    Bc4Palette(block & 0xFF, (block >> 8) & 0xFF, palette);
+    for (int i = 0; i < 16; ++i) out[i][3] = static_cast<uint8_t>(palette[(block >> (16 + 3 * i)) & 7][0]);
+}
+
+// ---------------------------------------------------------------------------
+// BC7 mode 6
+// ---------------------------------------------------------------------------
+
+struct Bc7Candidate {
+    int     q0[4] = {}, q1[4] = {}; // 7-bit endpoints
+    int     p0 = 0, p1 = 0;         // p-bits
+    uint8_t idx[16] = {};
+    float   error   = FLT_MAX;
+};
+
+void QuantizeBc7(const float e[4], int p, int q[4]) {
+    for (int c = 0; c < 4; ++c) q[c] = std::clamp(static_cast<int>(std::lround((e[c] - p) * 0.5f)), 0, 127);
+}
+
+float Bc7EndpointError(const float e[4], int p) {
+    int   q[4];
+    float err = 0.f;
+    QuantizeBc7(e, p, q);
+    for (int c = 0; c < 4; ++c) {
+        const float d = float(q[c] * 2 + p) - e[c];
+        err += d * d;
+    }
+    return err;
+}
+
+void Bc7Palette(const int q0[4], int p0, const int q1[4], int p1, float palette[16][4]) {
+    for (int c = 0; c < 4; ++c) {
+        const int v0 = q0[c] * 2 + p0, v1 = q1[c] * 2 + p1;
+        for (int k = 0; k < 16; ++k) {
+            palette[k][c] = float(((64 - kBc7Weights[k]) * v0 + kBc7Weights[k] * v1 + 32) >> 6);
+        }
+    }
+}
+
+Bc7Candidate EvalBc7(const Block& b, const float e0[4], int p0, const float e1[4], int p1) {
+    Bc7Candidate r;
+    r.p0 = p0;
+    r.p1 = p1;
+    QuantizeBc7(e0, p0, r.q0);
+    QuantizeBc7(e1, p1, r.q1);
+    float palette[16][4];
+    Bc7Palette(r.q0, p0, r.q1, p1, palette);
+    r.error = AssignIndices(b, 0, 4, palette, 16, r.idx);
+    return r;
+}
+
+// Fast: each endpoint's own best p-bit. Quality: all four pairs.
+Bc7Candidate BestBc7(const Block& b, const float e0[4], const float e1[4], BcQuality quality) {
+    if (quality == BcQuality::Fast) {
+        const int p0 = Bc7EndpointError(e0, 1) < Bc7EndpointError(e0, 0);
+        const int p1 = Bc7EndpointError(e1, 1) < Bc7EndpointError(e1, 0);
+        return EvalBc7(b, e0, p0, e1, p1);
+    }
+    Bc7Candidate best;
+    for (int p = 0; p < 4; ++p) {
+        const Bc7Candidate c = EvalBc7(b, e0, p & 1, e1, p >> 1);
+        if (c.error < best.error) best = c;
+    }
+    return best;
+}
+
+void EncodeBc7(const Block& b, BcQuality quality, std::byte* dst) {
+    static const float kWeights[16] = { 0 / 64.f,  4 / 64.f,  9 / 64.f,  13 / 64.f, 17 / 64.f, 21 / 64.f,
+                                        26 / 64.f, 30 / 64.f, 34 / 64.f, 38 / 64.f, 43 / 64.f, 47 / 64.f,
+                                        51 / 64.f, 55 / 64.f, 60 / 64.f, 64 / 64.f };
+    float e0[4], e1[4];
+    PrincipalEndpoints(b, 4, e0, e1);
+    Bc7Candidate best = BestBc7(b, e0, e1, quality);
+
+    if (quality == BcQuality::Quality) {
+        for (int iter = 0; iter < kRefineIterations; ++iter) {
+            if (!RefineEndpoints(b, 0, 4, best.idx, kWeights, e0, e1)) break;
+            const Bc7Candidate c = BestBc7(b, e0, e1, quality);
+            if (c.error >= best.error) break;
+            best = c;
+        }
+    }
+
+    // The anchor (texel 0) index has an implicit 0 MSB.
+    if (best.idx[0] >= 8) {
+        std::swap(best.q0, best.q1);
+        std::swap(best.p0, best.p1);
+        for (uint8_t& i : best.idx) i = static_cast<uint8_t>(15 - i);
+    }
+
+    Bits128 bits;
+    bits.Put(1u << 6, 7); // mode 6
+    for (int c = 0; c < 4; ++c) {
+        bits.Put(best.q0[c], 7);
+        bits.Put(best.q1[c], 7);
+    }
+    bits.Put(best.p0, 1);
+    bits.Put(best.p1, 1);
+    bits.Put(best.idx[0], 3);
+    for (int i = 1; i < 16; ++i) bits.Put(best.idx[i], 4);
+    std::memcpy(dst, bits.word, sizeof(bits.word));
+}
+
+bool DecodeBc7(const std::byte* src, uint8_t out[16][4]) {
+    Bits128 bits;
+    std::memcpy(bits.word, src, sizeof(bits.word));
+    if ((bits.word[0] & 0x7F) != 0x40) { // not mode 6
+        std::memset(out, 0, 16 * 4);
+        return false;
+    }
+    bits.pos = 7;
+    int q0[4], q1[4];
+    for (int c = 0; c < 4; ++c) {
+        q0[c] = static_cast<int>(bits.Get(7));
+        q1[c] = static_cast<int>(bits.Get(7));
+    }
+    const int p0 = static_cast<int>(bits.Get(1)), p1 = static_cast<int>(bits.Get(1));
+    float palette[16][4];
+    Bc7Palette(q0, p0, q1, p1, palette);
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t k = bits.Get(i == 0 ? 3 : 4);
+        for (int c = 0; c < 4; ++c) out[i][c] = static_cast<uint8_t>(palette[k][c]);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Per block
+// ---------------------------------------------------------------------------
+
+void EncodeBlock(const Block& b, BcFormat format, BcQuality quality, std::byte* dst) {
+    switch (format) {
+    case BcFormat::Bc1: {
+        const uint64_t color = EncodeBc1(b, quality);
+        std::memcpy(dst, &color, sizeof(color));
+        break;
+    }
+    case BcFormat::Bc3: {
+        const uint64_t alpha = EncodeBc4(b, quality), color = EncodeBc1(b, quality);
+        std::memcpy(dst, &alpha, sizeof(alpha));
+        std::memcpy(dst + 8, &color, sizeof(color));
+        break;
+    }
+    case BcFormat::Bc7:
+        EncodeBc7(b, quality, dst);
+        break;
+    }
+}
+
+bool DecodeBlock(const std::byte* src, BcFormat format, uint8_t out[16][4]) {
+    switch (format) {
+    case BcFormat::Bc1:
+        DecodeBc1(src, false, out);
+        return true;
+    case BcFormat::Bc3:
+        DecodeBc1(src + 8, true, out); // BC3 colour is always four-colour
+        DecodeBc4(src, out);
+        return true;
+    case BcFormat::Bc7:
+        return DecodeBc7(src, out);
+    }
+    return false;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Images
+// ---------------------------------------------------------------------------
+
+bool CompressImage(std::span<const std::byte> rgba8, uint32_t width, uint32_t height, BcFormat format,
+                   BcQuality quality, std::span<std::byte> out, JobSystem* jobs) {
+    if (width == 0 || height == 0 || rgba8.size() < size_t(width) * height * 4) return false;
+    if (out.size() < BcImageBytes(format, width, height)) return false;
+
+    const uint32_t blocksWide = (width + 3) / 4, blocksHigh = (height + 3) / 4;
+    const uint32_t blockBytes = BcBlockBytes(format);
+    const auto rows = [&](uint32_t begin, uint32_t end) {
+        Block b;
+        for (uint32_t by = begin; by < end; ++by) {
+            for (uint32_t bx = 0; bx < blocksWide; ++bx) {
+                LoadBlock(rgba8.data(), width, height, bx, by, b);
+                EncodeBlock(b, format, quality, out.data() + (size_t(by) * blocksWide + bx) * blockBytes);
+            }
+        }
+    };
+    if (jobs) {
+        jobs->ParallelFor(blocksHigh, std::max(1u, kBlocksPerJob / blocksWide), rows);
+    } else {
+        rows(0, blocksHigh);
+    }
+    return true;
+}
+
+bool DecompressImage(std::span<const std::byte> blocks, uint32_t width, uint32_t height, BcFormat format,
+                     std::span<std::byte> rgba8) {
+    if (blocks.size() < BcImageBytes(format, width, height) || rgba8.size() < size_t(width) * height * 4) {
+        return false;
+    }
+    const uint32_t blocksWide = (width + 3) / 4, blocksHigh = (height + 3) / 4;
+    bool           ok         = true;
+    uint8_t        texels[16][4];
+    for (uint32_t by = 0; by < blocksHigh; ++by) {
+        for (uint32_t bx = 0; bx < blocksWide; ++bx) {
+            ok &= DecodeBlock(blocks.data() + (size_t(by) * blocksWide + bx) * BcBlockBytes(format), format, texels);
+            for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                    std::memcpy(rgba8.data() + ((size_t(by) * 4 + y) * width + bx * 4 + x) * 4, texels[y * 4 + x], 4);
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+bool CompressMipChain(const MipChain& chain, BcFormat format, BcQuality quality, BcTexture& out, JobSystem* jobs) {
+    if (chain.format == MipFormat::Rgba32Float) return false;
+
+    out.format = format;
+    out.levels.clear();
+    size_t bytes = 0;
+    for (const MipLevel& level : chain.levels) {
+        const uint32_t rowPitch = (level.width + 3) / 4 * BcBlockBytes(format);
+        out.levels.push_back({ level.width, level.height, bytes, rowPitch });
+        bytes += BcImageBytes(format, level.width, level.height);
+    }
+    out.data.resize(bytes);
+
+    for (uint32_t i = 0; i < chain.levels.size(); ++i) {
+        const MipLevel& level = out.levels[i];
+        const std::span dst(out.data.data() + level.offset, BcImageBytes(format, level.width, level.height));
+        if (!CompressImage(chain.Level(i), level.width, level.height, format, quality, dst, jobs)) return false;
+    }
+    return true;
+}
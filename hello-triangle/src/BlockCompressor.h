@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "MipGenerator.h" // MipChain, MipLevel
+
+class JobSystem;
+
+// ---------------------------------------------------------------------------
+// BlockCompressor — BC1 / BC3 / BC7 encoding of RGBA8 images, so textures
+// can be created in block-compressed formats (4x4 texels per 8 or 16-byte
+// block: 1/8 or 1/4 of RGBA8).
+//
+//   BC1  RGB, two RGB565 endpoints + 2-bit indices          8 bytes / block
+//   BC3  BC1 colour + interpolated alpha (BC4) block         16 bytes / block
+//   BC7  mode 6 only: RGBA 7.7.7.7 + p-bit endpoints and     16 bytes / block
+//        4-bit indices. One subset, so sharp two-region
+//        blocks are softer than a full mode search gets them.
+//
+// Endpoints come from the principal axis of the block's colours (power
+// iteration on the covariance), with the 16 texels held as two Float8 per
+// channel; index selection tests every palette entry for all texels at once.
+//   Fast:    principal-axis extremes, nearest-palette indices
+//   Quality: plus least-squares endpoint refinement from the chosen
+//            indices, and for BC7 every p-bit pair / for BC3 both alpha
+//            modes; the candidate with the smallest squared error wins
+//
+// The encoder works on the stored bytes: sRGB data stays sRGB (create the
+// texture with the matching _SRGB format). Edge blocks of sizes that are not
+// multiples of 4 repeat the last row / column.
+// ---------------------------------------------------------------------------
+
+enum class BcFormat : uint8_t { Bc1, Bc3, Bc7 };
+enum class BcQuality : uint8_t { Fast, Quality };
+
+[[nodiscard]] constexpr uint32_t BcBlockBytes(BcFormat f) { return f == BcFormat::Bc1 ? 8 : 16; }
+
+// DXGI_FORMAT_BC1_UNORM / BC3_UNORM / BC7_UNORM, plus 1 for the _SRGB twin.
+[[nodiscard]] constexpr uint32_t BcDxgiFormat(BcFormat f) {
+    return f == BcFormat::Bc1 ? 71 : f == BcFormat::Bc3 ? 77 : 98;
+}
+
+// Bytes of a width x height image: whole blocks, rows of blocks back to back.
+[[nodiscard]] constexpr size_t BcImageBytes(BcFormat f, uint32_t width, uint32_t height) {
+    return size_t((width + 3) / 4) * ((height + 3) / 4) * BcBlockBytes(f);
+}
+
+// `rgba8` is width x height tightly packed texels; `out` needs
+// BcImageBytes(). Block rows are split across `jobs` when given.
+[[nodiscard]] bool CompressImage(std::span<const std::byte> rgba8, uint32_t width, uint32_t height,
+                                 BcFormat format, BcQuality quality, std::span<std::byte> out,
+                                 JobSystem* jobs = nullptr);
+
+// The inverse, for verification. BC7 blocks in modes other than 6 decode to
+// zero and make the call return false.
+[[nodiscard]] bool DecompressImage(std::span<const std::byte> blocks, uint32_t width, uint32_t height,
+                                   BcFormat format, std::span<std::byte> rgba8);
+
+// ---------------------------------------------------------------------------
+// Whole mip chains. MipLevel::rowPitch is the size of one row of blocks.
+// ---------------------------------------------------------------------------
+struct BcTexture {
+    BcFormat               format = BcFormat::Bc1;
+    std::vector<MipLevel>  levels;
+    std::vector<std::byte> data;
+
+    [[nodiscard]] std::span<const std::byte> Level(uint32_t i) const {
+        return { data.data() + levels[i].offset, BcImageBytes(format, levels[i].width, levels[i].height) };
+    }
+};
+
+// `chain` must be RGBA8 (Rgba8Unorm or Rgba8UnormSrgb).
+[[nodiscard]] bool CompressMipChain(const MipChain& chain, BcFormat format, BcQuality quality, BcTexture& out,
+                                    JobSystem* jobs = nullptr);
@@ -0,0 +1,16 @@
+#include "Checkerboard.h"
+
+bool GenerateCheckerboard(std::span<uint32_t> pixels, int size, int cellSize) {
+    if (size <= 0 || cellSize <= 0) return false;
+    if (pixels.size() < static_cast<size_t>(size) * static_cast<size_t>(size)) return false;
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            const bool even = ((x / cellSize) + (y / cellSize)) % 2 == 0;
+            pixels[static_cast<size_t>(y) * size + x] = even
+                ? PackRGBA(255, 255, 255)   // white
+                : PackRGBA(100, 149, 237);  // cornflower blue
+        }
+    }
+    return true;
+}
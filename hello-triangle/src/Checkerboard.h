@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// Pack RGBA into a uint32_t whose byte layout matches DXGI_FORMAT_R8G8B8A8_UNORM.
+// On little-endian systems the bytes land as [R][G][B][A] in memory.
+constexpr uint32_t PackRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 0xFF) {
+    return static_cast<uint32_t>(r)
+         | (static_cast<uint32_t>(g) <<  8)
+         | (static_cast<uint32_t>(b) << 16)
+         | (static_cast<uint32_t>(a) << 24);
+}
+
+// Fill `pixels` (size x size, row-major RGBA8) with the Phase 1-5 checkerboard:
+// `cellSize`-texel cells alternating white / cornflower blue.
+// Returns false if `pixels` is too small.
+[[nodiscard]] bool GenerateCheckerboard(std::span<uint32_t> pixels, int size, int cellSize);
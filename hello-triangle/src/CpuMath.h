@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+// CpuMath — the handful of DirectXMath operations the samples use, written
+// in portable C++ so CPU-only code (software backend, benchmarks) builds
+// without the Windows SDK.
+//
+// Conventions match DirectXMath exactly: row-major storage, row vectors
+// (v' = v * M), left-handed view space, D3D clip depth in [0, 1]. Values
+// agree with DirectXMath to float rounding, not bit for bit (XMScalarSinCos
+// uses its own polynomial).
+// ---------------------------------------------------------------------------
+
+struct Float3 {
+    float x, y, z;
+};
+
+struct Float4x4 {
+    float m[4][4];
+};
+
+constexpr float kPi    = 3.14159265358979323846f;
+constexpr float kTwoPi = 2.f * kPi;
+
+// --- Vector helpers ---
+
+inline Float3 Sub(const Float3& a, const Float3& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+inline float  Dot(const Float3& a, const Float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+inline Float3 Cross(const Float3& a, const Float3& b) {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+inline Float3 Normalize(const Float3& v) {
+    const float len = std::sqrt(Dot(v, v));
+    return len > 0.f ? Float3{ v.x / len, v.y / len, v.z / len } : v;
+}
+
+// --- Matrices ---
+
+inline Float4x4 MatrixIdentity() {
+    return { { { 1.f, 0.f, 0.f, 0.f },
+               { 0.f, 1.f, 0.f, 0.f },
+               { 0.f, 0.f, 1.f, 0.f },
+               { 0.f, 0.f, 0.f, 1.f } } };
+}
+
+inline Float4x4 MatrixMultiply(const Float4x4& a, const Float4x4& b) {
+    Float4x4 r;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            r.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j]
+                      + a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+        }
+    }
+    return r;
+}
+
+inline Float4x4 MatrixTranspose(const Float4x4& a) {
+    Float4x4 r;
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            r.m[i][j] = a.m[j][i];
+    return r;
+}
+
+// XMMatrixRotationY
+inline Float4x4 MatrixRotationY(float angle) {
+    const float s = std::sin(angle);
+    const float c = std::cos(angle);
+    return { { { c,   0.f, -s,  0.f },
+               { 0.f, 1.f, 0.f, 0.f },
+               { s,   0.f, c,   0.f },
+               { 0.f, 0.f, 0.f, 1.f } } };
+}
+
+// XMMatrixLookAtLH
+inline Float4x4 MatrixLookAtLH(const Float3& eye, const Float3& target, const Float3& up) {
+    const Float3 r2 = Normalize(Sub(target, eye));
+    const Float3 r0 = Normalize(Cross(up, r2));
+    const Float3 r1 = Cross(r2, r0);
+    return { { { r0.x, r1.x, r2.x, 0.f },
+               { r0.y, r1.y, r2.y, 0.f },
+               { r0.z, r1.z, r2.z, 0.f },
+               { -Dot(r0, eye), -Dot(r1, eye), -Dot(r2, eye), 1.f } } };
+}
+
+// XMMatrixPerspectiveFovLH
+inline Float4x4 MatrixPerspectiveFovLH(float fovY, float aspect, float nearZ, float farZ) {
+    const float h     = std::cos(0.5f * fovY) / std::sin(0.5f * fovY);
+    const float w     = h / aspect;
+    const float range = farZ / (farZ - nearZ);
+    return { { { w,   0.f, 0.f,             0.f },
+               { 0.f, h,   0.f,             0.f },
+               { 0.f, 0.f, range,           1.f },
+               { 0.f, 0.f, -range * nearZ,  0.f } } };
+}
@@ -1,12 +1,16 @@
 #include "D3D12App.h"
 
-#include <d3dcompiler.h>    // D3DReadFileToBlob
 #include <DirectXMath.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <span>
 #include <vector>
 
-#pragma comment(lib, "d3dcompiler.lib")
+#include "Profiler.h"
+#include "ShaderReflection.h"
 
 namespace {
 
@@ -20,42 +24,33 @@ struct Vertex {
 
 // ---------------------------------------------------------------------------
 // Constant buffer mirroring cbuffer PerObject : register(b0) in vertex12.hlsl.
-// D3D12 requires CBV buffers to be a multiple of 256 bytes.
+// Size: 64 + 16 = 80 bytes. The 256-byte CBV placement alignment is applied
+// by UploadRing per allocation, so the struct itself carries no padding.
 // ---------------------------------------------------------------------------
 struct PerObjectCB {
     DirectX::XMFLOAT4X4 mvpMatrix; // 64 bytes
     DirectX::XMFLOAT4   tintColor; // 16 bytes
-    uint8_t              _pad[176]; // 176 bytes padding  ->  total = 256 bytes
 };
-static_assert(sizeof(PerObjectCB) == 256,
-    "PerObjectCB must be exactly 256 bytes (D3D12 CBV alignment)");
-
-// ---------------------------------------------------------------------------
-// Transition a resource between two states.
-// ---------------------------------------------------------------------------
-void Transition(ID3D12GraphicsCommandList* list,
-                ID3D12Resource*            res,
-                D3D12_RESOURCE_STATES      before,
-                D3D12_RESOURCE_STATES      after)
-{
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource   = res;
-    barrier.Transition.StateBefore = before;
-    barrier.Transition.StateAfter  = after;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    list->ResourceBarrier(1, &barrier);
-}
+static_assert(sizeof(PerObjectCB) % 16 == 0,
+    "PerObjectCB must be a multiple of 16 bytes");
 
-// ---------------------------------------------------------------------------
-// Load a compiled shader (.cso) from disk into a blob.
-// ---------------------------------------------------------------------------
-[[nodiscard]] bool LoadCso(const std::filesystem::path& path,
-                            Microsoft::WRL::ComPtr<ID3DBlob>& out)
-{
-    return SUCCEEDED(D3DReadFileToBlob(path.c_str(), out.GetAddressOf()));
-}
+// Checked against vertex12.cso's reflection data in CreateRootSignatureAndPso().
+constexpr MirrorField kVertexFields[] = {
+    { "POSITION", offsetof(Vertex, pos), sizeof(Vertex::pos) },
+    { "COLOR",    offsetof(Vertex, col), sizeof(Vertex::col) },
+};
+// Static triangle; uploaded from here by the copy queue, so it lives as
+// long as the app.
+constexpr Vertex kTriangle[] = {
+    { { 0.0f,  0.5f, 0.0f}, {1.f, 0.f, 0.f, 1.f} }, // top   — red
+    { { 0.5f, -0.5f, 0.0f}, {0.f, 1.f, 0.f, 1.f} }, // right — green
+    { {-0.5f, -0.5f, 0.0f}, {0.f, 0.f, 1.f, 1.f} }, // left  — blue
+};
+
+constexpr MirrorField kPerObjectFields[] = {
+    { "mvpMatrix", offsetof(PerObjectCB, mvpMatrix), sizeof(PerObjectCB::mvpMatrix) },
+    { "tintColor", offsetof(PerObjectCB, tintColor), sizeof(PerObjectCB::tintColor) },
+};
 
 } // namespace
 
@@ -64,11 +59,9 @@ void Transition(ID3D12GraphicsCommandList* list,
 // ---------------------------------------------------------------------------
 
 D3D12App::~D3D12App() {
-    WaitForGPU(); // ensure GPU is idle before releasing resources
-    if (mFenceEvent) {
-        CloseHandle(mFenceEvent);
-        mFenceEvent = nullptr;
-    }
+    (void)mInitTasks.WaitAll(); // background init tasks reference members
+    WaitForGPU();               // ensure GPU is idle before releasing resources
+    (void)mUploads.Finish();    // ...and the copy queue
 }
 
 // ---------------------------------------------------------------------------
@@ -79,25 +72,70 @@ bool D3D12App::Init(HWND hwnd, int width, int height) {
     mWidth  = width;
     mHeight = height;
 
-    if (!CreateDeviceAndQueue())                     return false;
-    if (!CreateSwapChain(hwnd))                      return false;
-    if (!CreateRtvHeapAndViews())                    return false;
-    if (!CreateCommandInfrastructure())              return false;
-    if (!CreateGeometryAndConstantBuffer())          return false;
-    if (!CreateFence())                              return false;
-
-    // Locate compiled shaders next to the exe.
+    // Locate compiled shaders and the pipeline cache next to the exe.
     wchar_t exePath[MAX_PATH] = {};
     const DWORD len = GetModuleFileNameW(nullptr, exePath, MAX_PATH);
     if (len == 0 || len == MAX_PATH) return false;
-    const auto shaderDir = std::filesystem::path(exePath).parent_path() / L"shaders";
-
-    if (!CreateRootSignatureAndPso(shaderDir))       return false;
+    const auto exeDir = std::filesystem::path(exePath).parent_path();
+
+    if (!mJobs.Init()) return false;
+
+    // --- Init steps as a dependency graph ---
+    // Independent steps run concurrently on mJobs (the device is
+    // free-threaded); the swap chain is created on this, the window's,
+    // thread. Init() returns once a cleared frame can be presented; the
+    // shaders, pipeline and geometry finish in the background and Render()
+    // starts drawing when mSceneTask is done.
+    TaskGraph& g = mInitTasks;
+    g.Reset();
+
+    const uint32_t device    = g.Add("device",         [this] { return CreateDeviceAndQueue(); });
+    const uint32_t shaders   = g.Add("map shaders",    [this, exeDir] { return LoadShaders(exeDir / L"shaders"); });
+    const uint32_t swapChain = g.Add("swap chain",     [this, hwnd] { return CreateSwapChain(hwnd); },
+                                     { device }, TaskAffinity::Main);
+    const uint32_t views     = g.Add("descriptors",    [this] { return CreateDescriptorHeapsAndViews(); }, { swapChain });
+    const uint32_t commands  = g.Add("command lists",  [this] { return CreateCommandInfrastructure(); }, { device });
+    const uint32_t fence     = g.Add("fence",          [this] { return CreateFence(); }, { device });
+    const uint32_t geometry  = g.Add("geometry",       [this] { return CreateGeometryAndConstantBuffer(); }, { device });
+    const uint32_t cacheLoad = g.Add("pso cache load", [this, exeDir] {
+        return mPipelineCache.Init(mDevice.Get(), mFactory.Get(), exeDir / L"pipeline.cache");
+    }, { device });
+    const uint32_t pipeline  = g.Add("root sig + pso", [this] { return CreateRootSignatureAndPso(); },
+                                     { shaders, cacheLoad });
+    g.Add("pso cache save", [this] {
+        (void)mPipelineCache.Save(); // a failed write only costs the next launch its warm start
+        return true;
+    }, { pipeline });
+
+    const uint32_t firstFrame = g.Add("first frame", {}, { views, commands, fence });
+    mSceneTask                = g.Add("scene",       {}, { geometry, pipeline });
+
+    g.Start(mJobs);
+    if (!g.Wait(firstFrame)) return false;
 
     UpdateViewportScissor();
     return true;
 }
 
+// ---------------------------------------------------------------------------
+// PollInit — called every frame until the init graph has finished: picks up
+// the background scene resources and reports the init timings once.
+// ---------------------------------------------------------------------------
+
+void D3D12App::PollInit() {
+    if (mInitReported) return;
+
+    mInitTasks.Poll();
+    if (!mSceneReady && !mInitFailed && mInitTasks.IsDone(mSceneTask)) {
+        mSceneReady = mInitTasks.Succeeded(mSceneTask);
+        mInitFailed = !mSceneReady;
+    }
+    if (mInitTasks.AllDone()) {
+        OutputDebugStringA(mInitTasks.FormatReport("D3D12App::Init").c_str());
+        mInitReported = true;
+    }
+}
+
 // ---------------------------------------------------------------------------
 // CreateDeviceAndQueue
 // ---------------------------------------------------------------------------
@@ -170,30 +208,26 @@ bool D3D12App::CreateSwapChain(HWND hwnd) {
 }
 
 // ---------------------------------------------------------------------------
-// CreateRtvHeapAndViews
+// CreateDescriptorHeapsAndViews — the bindless CBV/SRV/UAV heap, the RTV/DSV
+// staging heaps, and one RTV per swap-chain buffer.
 // ---------------------------------------------------------------------------
 
-bool D3D12App::CreateRtvHeapAndViews() {
-    D3D12_DESCRIPTOR_HEAP_DESC hd = {};
-    hd.NumDescriptors = kFrameCount;
-    hd.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-    hd.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-    if (FAILED(mDevice->CreateDescriptorHeap(&hd,
-            IID_PPV_ARGS(mRtvHeap.GetAddressOf()))))
-        return false;
-
-    mRtvDescSize = mDevice->GetDescriptorHandleIncrementSize(
-        D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-
-    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle =
-        mRtvHeap->GetCPUDescriptorHandleForHeapStart();
+bool D3D12App::CreateDescriptorHeapsAndViews() {
+    if (!mDescriptors.Init(mDevice.Get(), D3D12DescriptorManager::Desc{})) return false;
 
     for (UINT i = 0; i < kFrameCount; ++i) {
+        mRtvIndices[i] = mDescriptors.AllocateRtv();
+        if (mRtvIndices[i] == D3D12DescriptorManager::kInvalid) return false;
+
         if (FAILED(mSwapChain->GetBuffer(i,
                 IID_PPV_ARGS(mRenderTargets[i].GetAddressOf()))))
             return false;
-        mDevice->CreateRenderTargetView(mRenderTargets[i].Get(), nullptr, rtvHandle);
-        rtvHandle.ptr += mRtvDescSize;
+        mDevice->CreateRenderTargetView(mRenderTargets[i].Get(), nullptr,
+                                        mDescriptors.RtvHandle(mRtvIndices[i]));
+
+        // Swap-chain buffers start out in PRESENT.
+        mRenderTargetIds[i] = mStateTracker.Register(
+            mRenderTargets[i].Get(), 1, kResourceStatePresent);
     }
     return true;
 }
@@ -203,16 +237,36 @@ bool D3D12App::CreateRtvHeapAndViews() {
 // ---------------------------------------------------------------------------
 
 bool D3D12App::CreateCommandInfrastructure() {
-    if (FAILED(mDevice->CreateCommandAllocator(
-            D3D12_COMMAND_LIST_TYPE_DIRECT,
-            IID_PPV_ARGS(mCommandAllocator.GetAddressOf()))))
-        return false;
+    // One allocator per frame slot (and per parallel list): an allocator may
+    // only be reset once the GPU has finished every list recorded from it.
+    for (FrameResources& frame : mFrames) {
+        if (FAILED(mDevice->CreateCommandAllocator(
+                D3D12_COMMAND_LIST_TYPE_DIRECT,
+                IID_PPV_ARGS(frame.commandAllocator.GetAddressOf()))))
+            return false;
+        for (auto& allocator : frame.recordAllocators) {
+            if (FAILED(mDevice->CreateCommandAllocator(
+                    D3D12_COMMAND_LIST_TYPE_DIRECT,
+                    IID_PPV_ARGS(allocator.GetAddressOf()))))
+                return false;
+        }
+    }
+
+    // Parallel-mode lists, also created closed.
+    for (UINT i = 0; i < kRecordLists; ++i) {
+        if (FAILED(mDevice->CreateCommandList(
+                0, D3D12_COMMAND_LIST_TYPE_DIRECT,
+                mFrames[0].recordAllocators[i].Get(), nullptr,
+                IID_PPV_ARGS(mRecordLists[i].GetAddressOf()))))
+            return false;
+        if (FAILED(mRecordLists[i]->Close())) return false;
+    }
 
     // Command list is created in closed state; opened in Render().
     if (FAILED(mDevice->CreateCommandList(
             0,
             D3D12_COMMAND_LIST_TYPE_DIRECT,
-            mCommandAllocator.Get(),
+            mFrames[0].commandAllocator.Get(),
             nullptr,                          // PSO set later in Render()
             IID_PPV_ARGS(mCommandList.GetAddressOf()))))
         return false;
@@ -220,11 +274,20 @@ bool D3D12App::CreateCommandInfrastructure() {
     return SUCCEEDED(mCommandList->Close());
 }
 
+// ---------------------------------------------------------------------------
+// LoadShaders — maps the shader archive; no device needed, so it runs
+// before the device exists. The PSO reads the bytecode in place.
+// ---------------------------------------------------------------------------
+
+bool D3D12App::LoadShaders(const std::filesystem::path& shaderDir) {
+    return mShaderArchive.Open(shaderDir / L"shaders12.shar");
+}
+
 // ---------------------------------------------------------------------------
 // CreateRootSignatureAndPso
 // ---------------------------------------------------------------------------
 
-bool D3D12App::CreateRootSignatureAndPso(const std::filesystem::path& shaderDir) {
+bool D3D12App::CreateRootSignatureAndPso() {
     // --- Root signature: one root CBV at VS b0 ---
     D3D12_ROOT_PARAMETER param = {};
     param.ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
@@ -242,33 +305,33 @@ bool D3D12App::CreateRootSignatureAndPso(const std::filesystem::path& shaderDir)
         D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS   |
         D3D12_ROOT_SIGNATURE_FLAG_DENY_PIXEL_SHADER_ROOT_ACCESS;
 
-    Microsoft::WRL::ComPtr<ID3DBlob> sig, err;
-    if (FAILED(D3D12SerializeRootSignature(&rsd, D3D_ROOT_SIGNATURE_VERSION_1,
-            sig.GetAddressOf(), err.GetAddressOf())))
-        return false;
+    if (!mPipelineCache.GetRootSignature(rsd, mRootSignature)) return false;
 
-    if (FAILED(mDevice->CreateRootSignature(
-            0, sig->GetBufferPointer(), sig->GetBufferSize(),
-            IID_PPV_ARGS(mRootSignature.GetAddressOf()))))
-        return false;
+    const std::span<const std::byte> vs = mShaderArchive.Find("vertex12.cso");
+    const std::span<const std::byte> ps = mShaderArchive.Find("pixel12.cso");
+    if (vs.empty() || ps.empty()) return false;
 
-    // --- Load compiled shaders ---
-    Microsoft::WRL::ComPtr<ID3DBlob> vsBytecode, psBytecode;
-    if (!LoadCso(shaderDir / L"vertex12.cso", vsBytecode)) return false;
-    if (!LoadCso(shaderDir / L"pixel12.cso",  psBytecode)) return false;
+    // --- Reflection: PerObject size, input layout from VSInput ---
+    ShaderReflection reflection;
+    if (!reflection.Parse(vs)) return false;
 
-    // --- Input layout: POSITION (float3) + COLOR (float4) ---
-    const D3D12_INPUT_ELEMENT_DESC layout[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,    0,  0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-        { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT,  0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-    };
+    const ShaderConstantBuffer* perObject = reflection.FindConstantBuffer("PerObject");
+    if (!perObject || !MatchesMirror(*perObject, kPerObjectFields, sizeof(PerObjectCB))) return false;
+    mPerObjectCBBytes = perObject->LiveBytes();
+
+    std::vector<PipelineInputElement> elements;
+    if (!reflection.BuildInputLayout(elements) || !MatchesMirror(elements, kVertexFields, sizeof(Vertex)))
+        return false;
+
+    const std::vector<D3D12_INPUT_ELEMENT_DESC> layout = MakeInputElementDescs<D3D12_INPUT_ELEMENT_DESC>(elements);
 
     // --- PSO ---
+
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psd = {};
     psd.pRootSignature        = mRootSignature.Get();
-    psd.VS                    = { vsBytecode->GetBufferPointer(), vsBytecode->GetBufferSize() };
-    psd.PS                    = { psBytecode->GetBufferPointer(),  psBytecode->GetBufferSize()  };
-    psd.InputLayout           = { layout, static_cast<UINT>(std::size(layout)) };
+    psd.VS                    = { vs.data(), vs.size() };
+    psd.PS                    = { ps.data(), ps.size() };
+    psd.InputLayout           = { layout.data(), static_cast<UINT>(layout.size()) };
     psd.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
     psd.NumRenderTargets      = 1;
     psd.RTVFormats[0]         = DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -291,8 +354,11 @@ bool D3D12App::CreateRootSignatureAndPso(const std::filesystem::path& shaderDir)
     psd.SampleMask                      = UINT_MAX;
     psd.SampleDesc.Count                = 1;
 
-    return SUCCEEDED(mDevice->CreateGraphicsPipelineState(
-        &psd, IID_PPV_ARGS(mPso.GetAddressOf())));
+    // Created from the driver blob cached by an earlier launch when possible.
+    if (!mPipelineCache.GetGraphicsPipeline(psd, mPso)) return false;
+
+    mShaderArchive.Close(); // the driver keeps its own copy of the bytecode
+    return true;
 }
 
 // ---------------------------------------------------------------------------
@@ -300,54 +366,50 @@ bool D3D12App::CreateRootSignatureAndPso(const std::filesystem::path& shaderDir)
 // ---------------------------------------------------------------------------
 
 bool D3D12App::CreateGeometryAndConstantBuffer() {
-    // --- Vertex buffer (upload heap — simple, adequate for static geometry) ---
-    const Vertex kTriangle[] = {
-        { { 0.0f,  0.5f, 0.0f}, {1.f, 0.f, 0.f, 1.f} }, // top   — red
-        { { 0.5f, -0.5f, 0.0f}, {0.f, 1.f, 0.f, 1.f} }, // right — green
-        { {-0.5f, -0.5f, 0.0f}, {0.f, 0.f, 1.f, 1.f} }, // left  — blue
-    };
-    const UINT vbSize = sizeof(kTriangle);
+    // The ring and the staging buffer share one upload heap block; static
+    // geometry lives in a default heap block in video memory.
+    if (!mUploadHeap.Init(mDevice.Get(), D3D12_HEAP_TYPE_UPLOAD,
+                          D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, kUploadHeapBytes))
+        return false;
+    if (!mDefaultHeap.Init(mDevice.Get(), D3D12_HEAP_TYPE_DEFAULT,
+                           D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, kDefaultHeapBytes))
+        return false;
 
-    D3D12_HEAP_PROPERTIES hp = {};
-    hp.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-    D3D12_RESOURCE_DESC rd = {};
-    rd.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
-    rd.Width              = vbSize;
-    rd.Height             = 1;
-    rd.DepthOrArraySize   = 1;
-    rd.MipLevels          = 1;
-    rd.Format             = DXGI_FORMAT_UNKNOWN;
-    rd.SampleDesc.Count   = 1;
-    rd.Layout             = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-    if (FAILED(mDevice->CreateCommittedResource(
-            &hp, D3D12_HEAP_FLAG_NONE, &rd,
-            D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
-            IID_PPV_ARGS(mVertexBuffer.GetAddressOf()))))
+    // --- Copy-queue uploads through a persistently mapped staging ring ---
+    if (!mUploadHeap.CreateBuffer(kStagingBytes, D3D12_RESOURCE_STATE_GENERIC_READ,
+                                  mStagingBuffer, mStagingBufferAlloc))
         return false;
 
-    void* vbData = nullptr;
+    void* stagingData = nullptr;
     const D3D12_RANGE readRange = { 0, 0 }; // CPU will not read back
-    if (FAILED(mVertexBuffer->Map(0, &readRange, &vbData))) return false;
-    memcpy(vbData, kTriangle, vbSize);
-    mVertexBuffer->Unmap(0, nullptr);
+    if (FAILED(mStagingBuffer->Map(0, &readRange, &stagingData))) return false;
+    if (!mCopyQueue.Init(mDevice.Get(), mStagingBuffer.Get())) return false;
+    if (!mUploads.Init(&mCopyQueue, stagingData, kStagingBytes, kUploadBudget)) return false;
+
+    // --- Vertex buffer (default heap, COMMON: the copy queue promotes it) ---
+    const UINT vbSize = sizeof(kTriangle);
+    if (!mDefaultHeap.CreateBuffer(vbSize, D3D12_RESOURCE_STATE_COMMON,
+                                   mVertexBuffer, mVertexBufferAlloc))
+        return false;
+
+    mGeometryTicket = mUploads.UploadBuffer(reinterpret_cast<uintptr_t>(mVertexBuffer.Get()), 0,
+                                            std::as_bytes(std::span(kTriangle)));
+    if (mGeometryTicket == 0 || !mUploads.Update()) return false; // submitted now; Render() waits on it
 
     mVBView.BufferLocation = mVertexBuffer->GetGPUVirtualAddress();
     mVBView.StrideInBytes  = sizeof(Vertex);
     mVBView.SizeInBytes    = vbSize;
 
-    // --- Constant buffer (upload heap, 256-byte aligned, persistently mapped) ---
-    rd.Width = sizeof(PerObjectCB); // 256
-
-    if (FAILED(mDevice->CreateCommittedResource(
-            &hp, D3D12_HEAP_FLAG_NONE, &rd,
-            D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
-            IID_PPV_ARGS(mConstantBuffer.GetAddressOf()))))
+    // --- Upload ring (one large buffer; per-draw 256-byte aligned sub-allocations) ---
+    if (!mUploadHeap.CreateBuffer(kUploadRingBytes, D3D12_RESOURCE_STATE_GENERIC_READ,
+                                  mUploadBuffer, mUploadBufferAlloc))
         return false;
 
     // Persistently map; never unmap (valid until the resource is destroyed).
-    return SUCCEEDED(mConstantBuffer->Map(0, &readRange, &mCbMapped));
+    void* ringData = nullptr;
+    if (FAILED(mUploadBuffer->Map(0, &readRange, &ringData))) return false;
+
+    return mUploadRing.Init(ringData, mUploadBuffer->GetGPUVirtualAddress(), kUploadRingBytes);
 }
 
 // ---------------------------------------------------------------------------
@@ -355,28 +417,17 @@ bool D3D12App::CreateGeometryAndConstantBuffer() {
 // ---------------------------------------------------------------------------
 
 bool D3D12App::CreateFence() {
-    mFenceEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
-    if (!mFenceEvent) return false;
-
-    return SUCCEEDED(mDevice->CreateFence(
-        mFenceValue, D3D12_FENCE_FLAG_NONE,
-        IID_PPV_ARGS(mFence.GetAddressOf())));
+    if (!mFenceQueue.Init(mDevice.Get(), mCommandQueue.Get())) return false;
+    return mPacer.Init(&mFenceQueue, kFrameCount);
 }
 
 // ---------------------------------------------------------------------------
-// WaitForGPU — signal the fence then block until the GPU has processed it.
+// WaitForGPU — full drain; only needed for resize and shutdown.
 // ---------------------------------------------------------------------------
 
 void D3D12App::WaitForGPU() {
-    if (!mCommandQueue || !mFence || !mFenceEvent) return;
-
-    ++mFenceValue;
-    if (FAILED(mCommandQueue->Signal(mFence.Get(), mFenceValue))) return;
-    if (mFence->GetCompletedValue() < mFenceValue) {
-        if (FAILED(mFence->SetEventOnCompletion(mFenceValue, mFenceEvent))) return;
-        // Bounded wait: 5 s covers normal vsync stalls; returns on device removal.
-        WaitForSingleObject(mFenceEvent, 5000);
-    }
+    PROFILE_ZONE("WaitForGPU");
+    mPacer.WaitIdle();
 }
 
 // ---------------------------------------------------------------------------
@@ -405,8 +456,10 @@ void D3D12App::OnResize(int width, int height) {
     WaitForGPU();
 
     // Release RTV references held by this class.
-    for (UINT i = 0; i < kFrameCount; ++i)
+    for (UINT i = 0; i < kFrameCount; ++i) {
+        mStateTracker.Unregister(mRenderTargetIds[i]);
         mRenderTargets[i].Reset();
+    }
 
     HRESULT hr = mSwapChain->ResizeBuffers(
         kFrameCount,
@@ -418,17 +471,18 @@ void D3D12App::OnResize(int width, int height) {
     mHeight     = height;
     mFrameIndex = mSwapChain->GetCurrentBackBufferIndex();
 
-    // Recreate RTVs.
-    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle =
-        mRtvHeap->GetCPUDescriptorHandleForHeapStart();
+    // Recreate RTVs in the same descriptor slots.
     for (UINT i = 0; i < kFrameCount; ++i) {
         if (FAILED(mSwapChain->GetBuffer(
                 i, IID_PPV_ARGS(mRenderTargets[i].GetAddressOf())))) {
             mRenderTargets[i].Reset();
             return;
         }
-        mDevice->CreateRenderTargetView(mRenderTargets[i].Get(), nullptr, rtvHandle);
-        rtvHandle.ptr += mRtvDescSize;
+        mDevice->CreateRenderTargetView(mRenderTargets[i].Get(), nullptr,
+                                        mDescriptors.RtvHandle(mRtvIndices[i]));
+
+        mRenderTargetIds[i] = mStateTracker.Register(
+            mRenderTargets[i].Get(), 1, kResourceStatePresent);
     }
 
     UpdateViewportScissor();
@@ -439,11 +493,10 @@ void D3D12App::OnResize(int width, int height) {
 // ---------------------------------------------------------------------------
 
 void D3D12App::Update(float dt) {
+    PROFILE_ZONE("Update");
     mAngle += dt;
     if (mAngle > DirectX::XM_2PI) mAngle -= DirectX::XM_2PI;
 
-    if (!mCbMapped) return;
-
     // Build MVP matrix (same camera/projection as D3D11 version).
     const DirectX::XMMATRIX model = DirectX::XMMatrixRotationY(mAngle);
 
@@ -460,9 +513,125 @@ void D3D12App::Update(float dt) {
     // Transpose: row-major (DirectXMath) -> column-major (HLSL).
     const DirectX::XMMATRIX mvp = DirectX::XMMatrixTranspose(model * view * proj);
 
-    auto* cb = static_cast<PerObjectCB*>(mCbMapped);
-    DirectX::XMStoreFloat4x4(&cb->mvpMatrix, mvp);
-    cb->tintColor = { 1.f, 1.f, 1.f, 1.f }; // no tint
+    // The GPU may still be reading this slot's constant buffer; Render()
+    // uploads the matrix after FramePacer has cleared the slot.
+    DirectX::XMStoreFloat4x4(&mMvp, mvp);
+}
+
+// ---------------------------------------------------------------------------
+// RecordCommands — record draws [firstDraw, lastDraw) into `list`.
+// Command lists share no state, so every list sets up the full pipeline.
+// The frame's first list also records the Scene pass barriers and clears the
+// back buffer; its last list records the Present pass barriers.
+// ---------------------------------------------------------------------------
+
+bool D3D12App::RecordCommands(ID3D12GraphicsCommandList* list,
+                              ID3D12CommandAllocator*    allocator,
+                              size_t firstDraw, size_t lastDraw,
+                              bool openFrame, bool closeFrame) {
+    PROFILE_ZONE("RecordCommands");
+    // --- Reset command allocator and list ---
+    if (FAILED(allocator->Reset())) return false;
+    // The pipeline may still be building in the background (mSceneReady).
+    if (FAILED(list->Reset(allocator, mSceneReady ? mPso.Get() : nullptr))) return false;
+
+    // --- Set global state ---
+    ID3D12DescriptorHeap* heaps[] = { mDescriptors.ShaderVisibleHeap() };
+    list->SetDescriptorHeaps(1, heaps);
+    if (mSceneReady) list->SetGraphicsRootSignature(mRootSignature.Get());
+    list->RSSetViewports(1, &mViewport);
+    list->RSSetScissorRects(1, &mScissor);
+
+    // --- Scene pass barriers (back buffer PRESENT -> RENDER_TARGET) ---
+    if (openFrame && !mSceneBarriers.empty()) {
+        list->ResourceBarrier(static_cast<UINT>(mSceneBarriers.size()), mSceneBarriers.data());
+    }
+
+    // --- Set (and clear) RTV ---
+    const D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = mDescriptors.RtvHandle(mRtvIndices[mFrameIndex]);
+    list->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
+
+    if (openFrame) {
+        constexpr float kClearColor[4] = { 0.392f, 0.584f, 0.929f, 1.0f };
+        list->ClearRenderTargetView(rtvHandle, kClearColor, 0, nullptr);
+    }
+
+    // --- Draw triangles ---
+    if (firstDraw < lastDraw) {
+        list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        list->IASetVertexBuffers(0, 1, &mVBView);
+    }
+    for (size_t i = firstDraw; i < lastDraw; ++i) {
+        list->SetGraphicsRootConstantBufferView(0, mDrawConstants[i]);
+        list->DrawInstanced(3, 1, 0, 0);
+    }
+
+    // --- Present pass barriers (back buffer RENDER_TARGET -> PRESENT) ---
+    if (closeFrame && !mPresentBarriers.empty()) {
+        list->ResourceBarrier(static_cast<UINT>(mPresentBarriers.size()), mPresentBarriers.data());
+    }
+
+    return SUCCEEDED(list->Close());
+}
+
+// ---------------------------------------------------------------------------
+// RecordCommandsParallel — split the frame's draws across kRecordLists lists,
+// each recorded by a job from its own allocator. ExecuteCommandLists runs the
+// lists in array order, so list 0's clear precedes every draw.
+// ---------------------------------------------------------------------------
+
+bool D3D12App::RecordCommandsParallel(FrameResources& frame) {
+    const size_t      drawCount = mDrawConstants.size();
+    std::atomic<bool> ok{ true };
+
+    mJobs.ParallelFor(kRecordLists, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const size_t first = drawCount * i / kRecordLists;
+            const size_t last  = drawCount * (i + 1) / kRecordLists;
+            if (!RecordCommands(mRecordLists[i].Get(), frame.recordAllocators[i].Get(),
+                                first, last, i == 0, i == kRecordLists - 1))
+                ok.store(false, std::memory_order_relaxed);
+        }
+    });
+    return ok.load();
+}
+
+// ---------------------------------------------------------------------------
+// BuildFrameGraph — declare the frame (Scene draws into the back buffer,
+// Present hands it to DXGI), compile it, and turn each pass's resource
+// usages into one barrier batch. Batches are built up front on this thread
+// so parallel recording jobs only copy them into their lists.
+// ---------------------------------------------------------------------------
+
+bool D3D12App::BuildFrameGraph() {
+    mFrameGraph.Reset();
+
+    TextureDesc backBufferDesc;
+    backBufferDesc.width  = static_cast<uint32_t>(mWidth);
+    backBufferDesc.height = static_cast<uint32_t>(mHeight);
+    backBufferDesc.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    const ResourceHandle backBuffer = mFrameGraph.ImportTexture("BackBuffer", backBufferDesc);
+
+    const uint32_t scenePass = mFrameGraph.AddPass("Scene", [&](RenderGraphBuilder& builder) {
+        builder.Write(backBuffer, ResourceUsage::RenderTarget);
+    });
+    const uint32_t presentPass = mFrameGraph.AddPass("Present", [&](RenderGraphBuilder& builder) {
+        builder.Read(backBuffer, ResourceUsage::Present);
+        builder.SetSideEffect();
+    });
+    if (!mFrameGraph.Compile()) return false;
+
+    // Graph resource index -> tracker id; BackBuffer is the only resource.
+    const uint32_t trackerIds[] = { mRenderTargetIds[mFrameIndex] };
+
+    mSceneBarriers.clear();
+    mPresentBarriers.clear();
+    for (uint32_t pass : mFrameGraph.Schedule()) {
+        TransitionPassResources(mStateTracker, mFrameGraph, pass, trackerIds);
+        auto& out = pass == presentPass ? mPresentBarriers : mSceneBarriers;
+        AppendD3D12Barriers(mStateTracker.Flush(), out);
+    }
+    return !mFrameGraph.IsCulled(scenePass);
 }
 
 // ---------------------------------------------------------------------------
@@ -470,54 +639,73 @@ void D3D12App::Update(float dt) {
 // ---------------------------------------------------------------------------
 
 void D3D12App::Render() {
+    PROFILE_ZONE("Render");
     if (!mCommandList || !mRenderTargets[mFrameIndex]) return;
+    PollInit();
 
-    // --- Reset command allocator and list ---
-    if (FAILED(mCommandAllocator->Reset())) return;
-    if (FAILED(mCommandList->Reset(mCommandAllocator.Get(), mPso.Get()))) return;
+    // --- Wait only if this slot's previous frame is still on the GPU ---
+    {
+        PROFILE_ZONE("WaitForFrame");
+        mPacer.BeginFrame(mFrameIndex);
+    }
+    FrameResources& frame = mFrames[mFrameIndex];
 
-    // --- Set global state ---
-    mCommandList->SetGraphicsRootSignature(mRootSignature.Get());
-    mCommandList->RSSetViewports(1, &mViewport);
-    mCommandList->RSSetScissorRects(1, &mScissor);
-
-    // --- Transition back buffer: PRESENT -> RENDER_TARGET ---
-    Transition(mCommandList.Get(),
-               mRenderTargets[mFrameIndex].Get(),
-               D3D12_RESOURCE_STATE_PRESENT,
-               D3D12_RESOURCE_STATE_RENDER_TARGET);
-
-    // --- Set and clear RTV ---
-    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle =
-        mRtvHeap->GetCPUDescriptorHandleForHeapStart();
-    rtvHandle.ptr += static_cast<SIZE_T>(mFrameIndex) * mRtvDescSize;
-
-    constexpr float kClearColor[4] = { 0.392f, 0.584f, 0.929f, 1.0f };
-    mCommandList->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
-    mCommandList->ClearRenderTargetView(rtvHandle, kClearColor, 0, nullptr);
-
-    // --- Draw triangle ---
-    mCommandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    mCommandList->IASetVertexBuffers(0, 1, &mVBView);
-    mCommandList->SetGraphicsRootConstantBufferView(
-        0, mConstantBuffer->GetGPUVirtualAddress());
-    mCommandList->DrawInstanced(3, 1, 0, 0);
-
-    // --- Transition back buffer: RENDER_TARGET -> PRESENT ---
-    Transition(mCommandList.Get(),
-               mRenderTargets[mFrameIndex].Get(),
-               D3D12_RESOURCE_STATE_RENDER_TARGET,
-               D3D12_RESOURCE_STATE_PRESENT);
-
-    // --- Submit ---
-    if (FAILED(mCommandList->Close())) return;
-    ID3D12CommandList* lists[] = { mCommandList.Get() };
-    mCommandQueue->ExecuteCommandLists(1, lists);
+    // --- Reclaim ring space and transient descriptors of retired frames ---
+    if (mSceneReady) mUploadRing.Retire(mPacer.CompletedValue());
+    mDescriptors.Retire(mPacer.CompletedValue());
+
+    // --- Copy queue: retire finished uploads, submit this frame's batch ---
+    if (mSceneReady && !mUploads.Update()) return;
+
+    // --- Draws: none (clear only) until the scene resources are built ---
+    mDrawConstants.clear();
+    if (mSceneReady) {
+        PerObjectCB constants;
+        constants.mvpMatrix = mMvp;
+        constants.tintColor = { 1.f, 1.f, 1.f, 1.f }; // no tint
+
+        // Only the bytes the shader reads (reflected), not sizeof(PerObjectCB).
+        UploadAllocation cbAlloc;
+        if (!mUploadRing.Allocate(mPerObjectCBBytes, cbAlloc)) return;
+        std::memcpy(cbAlloc.cpu, &constants, mPerObjectCBBytes);
+
+        mDrawConstants.push_back(cbAlloc.gpu);
+    }
+
+    if (!BuildFrameGraph()) return;
+
+    // --- Record: one list on this thread, or kRecordLists lists on workers ---
+    ID3D12CommandList* lists[kRecordLists] = {};
+    UINT               listCount           = 0;
+    if (mParallelRecording) {
+        if (!RecordCommandsParallel(frame)) return;
+        for (auto& list : mRecordLists) lists[listCount++] = list.Get();
+    } else {
+        if (!RecordCommands(mCommandList.Get(), frame.commandAllocator.Get(),
+                            0, mDrawConstants.size(), true, true))
+            return;
+        lists[listCount++] = mCommandList.Get();
+    }
+
+    // --- Cross-queue handoff: the first draws wait (on the GPU, not the
+    // CPU) until the copy queue has written the vertex buffer ---
+    if (mSceneReady && !mGeometryWaited) {
+        if (FAILED(mCommandQueue->Wait(mCopyQueue.Fence(), mUploads.FenceValue(mGeometryTicket)))) return;
+        mGeometryWaited = true;
+    }
+
+    // --- Submit, then mark the slot and its ring bytes busy until this fence ---
+    mCommandQueue->ExecuteCommandLists(listCount, lists);
+    if (!mPacer.EndFrame()) return;
+    if (mSceneReady) mUploadRing.EndFrame(mPacer.LastSignaledValue());
+    mDescriptors.EndFrame(mPacer.LastSignaledValue());
 
     // --- Present (vsync) ---
-    if (FAILED(mSwapChain->Present(1, 0))) return;
+    {
+        PROFILE_ZONE("Present");
+        if (FAILED(mSwapChain->Present(1, 0))) return;
+    }
 
-    // --- Advance frame index and wait (simple full-sync pattern) ---
+    // --- Advance to the next back buffer; no CPU/GPU sync here ---
     mFrameIndex = mSwapChain->GetCurrentBackBufferIndex();
-    WaitForGPU();
 }
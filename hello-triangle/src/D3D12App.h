@@ -5,8 +5,25 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <wrl/client.h>
+#include <DirectXMath.h>
 
 #include <filesystem>
+#include <vector>
+
+#include "D3D12CopyQueue.h"
+#include "D3D12DescriptorManager.h"
+#include "D3D12FenceQueue.h"
+#include "D3D12HeapAllocator.h"
+#include "D3D12PipelineCache.h"
+#include "D3D12StateTracker.h"
+#include "FramePacer.h"
+#include "JobSystem.h"
+#include "RenderGraph.h"
+#include "ResourceStateTracker.h"
+#include "ShaderArchive.h"
+#include "TaskGraph.h"
+#include "UploadRing.h"
+#include "UploadScheduler.h"
 
 // ---------------------------------------------------------------------------
 // D3D12App — D3D12 port of Phase 1 hello-triangle (rotating RGB triangle).
@@ -14,12 +31,21 @@
 // Key D3D12 concepts demonstrated:
 //   • ID3D12Device + ID3D12CommandQueue
 //   • IDXGISwapChain3 with double-buffered RTVs
-//   • ID3D12DescriptorHeap (RTV)
+//   • Descriptor heaps: bindless shader-visible CBV/SRV/UAV heap (persistent
+//     free list + per-frame ring) and RTV/DSV staging heaps
 //   • ID3D12RootSignature with a single CBV root descriptor (b0)
-//   • ID3D12PipelineState (PSO)
-//   • Resource barriers: PRESENT <-> RENDER_TARGET
-//   • Constant buffer on upload heap (persistently mapped, 256-byte aligned)
-//   • Fence-based CPU/GPU synchronization
+//   • ID3D12PipelineState (PSO), created through a content-hashed cache
+//     whose driver blobs persist on disk between launches
+//   • Resource barriers: PRESENT <-> RENDER_TARGET, derived from a two-pass
+//     render graph by a resource state tracker
+//   • Buffers placed in TLSF-managed ID3D12Heap blocks (no committed resources)
+//   • Per-draw constants sub-allocated from a persistently mapped upload ring
+//   • Static geometry in a default heap, uploaded on a copy queue and
+//     handed to the direct queue with a cross-queue fence wait
+//   • Fence-based CPU/GPU synchronization with kFrameCount frames in flight
+//   • Optional parallel command-list recording on a work-stealing job system
+//   • Init steps run as a dependency graph on the same job system; frames
+//     are presented (cleared) while the pipeline and geometry finish
 // ---------------------------------------------------------------------------
 class D3D12App {
 public:
@@ -34,20 +60,50 @@ public:
     void Update(float dt);
     void Render();
 
+    // A background init step (shaders, pipeline, geometry) failed after
+    // Init() returned; the app can only clear the screen.
+    [[nodiscard]] bool InitFailed() const { return mInitFailed; }
+
+    // Record each frame into kRecordLists command lists on worker threads
+    // and submit them with a single ExecuteCommandLists call.
+    void SetParallelRecording(bool enabled) { mParallelRecording = enabled; }
+    bool ParallelRecording() const          { return mParallelRecording; }
+
 private:
-    static constexpr UINT kFrameCount = 2; // double-buffered swap chain
+    static constexpr UINT   kFrameCount       = 2;             // swap-chain buffers == frames in flight
+    static constexpr UINT64 kUploadRingBytes  = 1ull << 20;    // per-draw upload data, all frames in flight
+    static constexpr UINT64 kUploadHeapBytes  = 4ull << 20;    // upload heap block: ring + staging
+    static constexpr UINT64 kStagingBytes     = 1ull << 20;    // copy-queue staging ring
+    static constexpr UINT64 kUploadBudget     = 256ull << 10;  // staged bytes per frame
+    static constexpr UINT64 kDefaultHeapBytes = 4ull << 20;    // default heap block: static geometry
+    static constexpr UINT   kRecordLists      = 4;             // command lists per frame in parallel mode
+
+    // Per-slot command memory: an allocator may only be reset once the GPU
+    // has retired every list recorded from it. Per-draw constant data lives
+    // in mUploadRing and is reclaimed by the same fence.
+    struct FrameResources {
+        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> recordAllocators[kRecordLists]; // parallel mode
+    };
 
     // --- Init helpers ---
     [[nodiscard]] bool CreateDeviceAndQueue();
     [[nodiscard]] bool CreateSwapChain(HWND hwnd);
-    [[nodiscard]] bool CreateRtvHeapAndViews();
+    [[nodiscard]] bool CreateDescriptorHeapsAndViews();
     [[nodiscard]] bool CreateCommandInfrastructure();
-    [[nodiscard]] bool CreateRootSignatureAndPso(const std::filesystem::path& shaderDir);
+    [[nodiscard]] bool LoadShaders(const std::filesystem::path& shaderDir);
+    [[nodiscard]] bool CreateRootSignatureAndPso();
     [[nodiscard]] bool CreateGeometryAndConstantBuffer();
     [[nodiscard]] bool CreateFence();
 
     // --- Per-frame helpers ---
-    void RecordCommands();
+    [[nodiscard]] bool RecordCommands(ID3D12GraphicsCommandList* list,
+                                      ID3D12CommandAllocator*    allocator,
+                                      size_t firstDraw, size_t lastDraw,
+                                      bool openFrame, bool closeFrame);
+    [[nodiscard]] bool RecordCommandsParallel(FrameResources& frame);
+    [[nodiscard]] bool BuildFrameGraph();
+    void PollInit();
     void WaitForGPU();
     void UpdateViewportScissor();
 
@@ -60,33 +116,71 @@ private:
     Microsoft::WRL::ComPtr<IDXGISwapChain3>    mSwapChain;
     UINT                                        mFrameIndex = 0;
 
-    // --- RTV descriptor heap ---
-    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mRtvHeap;
-    UINT                                          mRtvDescSize = 0;
+    // --- Descriptor heaps: bindless CBV/SRV/UAV + RTV/DSV staging ---
+    D3D12DescriptorManager mDescriptors;
+    uint32_t               mRtvIndices[kFrameCount] = {}; // one RTV per swap-chain buffer
 
     // --- Render targets (one per swap-chain buffer) ---
     Microsoft::WRL::ComPtr<ID3D12Resource> mRenderTargets[kFrameCount];
+    uint32_t                               mRenderTargetIds[kFrameCount] = {}; // mStateTracker ids
+
+    // --- Frame graph and barriers: rebuilt every frame, capacity reused ---
+    RenderGraph                         mFrameGraph;
+    ResourceStateTracker                mStateTracker;
+    std::vector<D3D12_RESOURCE_BARRIER> mSceneBarriers;   // recorded before the first draw
+    std::vector<D3D12_RESOURCE_BARRIER> mPresentBarriers; // recorded after the last draw
 
-    // --- Command infrastructure (single allocator; full sync each frame) ---
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator>    mCommandAllocator;
+    // --- Command infrastructure (one allocator per frame slot, shared list) ---
+    FrameResources                                    mFrames[kFrameCount];
     Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> mCommandList;
 
-    // --- Pipeline state ---
+    // --- Parallel recording: one list per worker job, submitted in order ---
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> mRecordLists[kRecordLists];
+    JobSystem                                         mJobs;
+    bool                                              mParallelRecording = false;
+
+    // --- Async init: task graph on mJobs; draws start once mSceneTask is done ---
+    TaskGraph mInitTasks;
+    uint32_t  mSceneTask    = TaskGraph::kInvalid;
+    bool      mSceneReady   = false; // geometry + pipeline built, read on this thread only
+    bool      mInitFailed   = false;
+    bool      mInitReported = false;
+
+    // Root CBV address of every draw in the current frame.
+    std::vector<D3D12_GPU_VIRTUAL_ADDRESS> mDrawConstants;
+
+    // --- Pipeline state (deduplicated, driver blobs persisted across launches) ---
+    D3D12PipelineCache                          mPipelineCache;
     Microsoft::WRL::ComPtr<ID3D12RootSignature> mRootSignature;
     Microsoft::WRL::ComPtr<ID3D12PipelineState> mPso;
+    ShaderArchive                               mShaderArchive; // mapped until the PSO exists
+
+    // --- Placed-resource heaps (declared first: outlive the resources in them) ---
+    D3D12HeapAllocator mUploadHeap;
+    D3D12HeapAllocator mDefaultHeap;
 
-    // --- Vertex buffer (upload heap) ---
+    // --- Vertex buffer (default heap, filled by mUploads) ---
     Microsoft::WRL::ComPtr<ID3D12Resource> mVertexBuffer;
+    HeapAllocation                         mVertexBufferAlloc;
     D3D12_VERTEX_BUFFER_VIEW               mVBView = {};
 
-    // --- Constant buffer (upload heap, persistently mapped, 256-byte aligned) ---
-    Microsoft::WRL::ComPtr<ID3D12Resource> mConstantBuffer;
-    void*                                  mCbMapped = nullptr; // persistent map
+    // --- Static uploads: staging ring + copy queue; the direct queue waits
+    // for mGeometryTicket's copy fence before its first draw ---
+    Microsoft::WRL::ComPtr<ID3D12Resource> mStagingBuffer;
+    HeapAllocation                         mStagingBufferAlloc;
+    D3D12CopyQueue                         mCopyQueue;
+    UploadScheduler                        mUploads;
+    uint64_t                               mGeometryTicket = 0;
+    bool                                   mGeometryWaited = false; // direct queue waits on the copy fence once
 
-    // --- CPU/GPU synchronization ---
-    Microsoft::WRL::ComPtr<ID3D12Fence> mFence;
-    UINT64                              mFenceValue = 0;
-    HANDLE                              mFenceEvent = nullptr;
+    // --- Upload ring (one persistently mapped buffer, 256-byte sub-allocations) ---
+    Microsoft::WRL::ComPtr<ID3D12Resource> mUploadBuffer;
+    HeapAllocation                         mUploadBufferAlloc;
+    UploadRing                             mUploadRing;
+
+    // --- CPU/GPU synchronization (fence value per swap-chain slot) ---
+    D3D12FenceQueue mFenceQueue;
+    FramePacer      mPacer;
 
     // --- Render state ---
     D3D12_VIEWPORT mViewport = {};
@@ -94,4 +188,9 @@ private:
     int            mWidth    = 0;
     int            mHeight   = 0;
     float          mAngle    = 0.f;
+
+    // MVP built in Update(); copied into an upload-ring allocation in
+    // Render() once the ring has retired the GPU's finished frames.
+    DirectX::XMFLOAT4X4 mMvp              = {};
+    uint32_t            mPerObjectCBBytes = 0; // live bytes of cbuffer PerObject (reflected)
 };
@@ -0,0 +1,102 @@
+#include "D3D12CopyQueue.h"
+
+D3D12CopyQueue::~D3D12CopyQueue() {
+    if (mEvent) {
+        CloseHandle(mEvent);
+        mEvent = nullptr;
+    }
+}
+
+bool D3D12CopyQueue::Init(ID3D12Device* device, ID3D12Resource* staging) {
+    if (device == nullptr || staging == nullptr) return false;
+    mDevice  = device;
+    mStaging = staging;
+
+    D3D12_COMMAND_QUEUE_DESC qd = {};
+    qd.Type  = D3D12_COMMAND_LIST_TYPE_COPY;
+    qd.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    if (FAILED(device->CreateCommandQueue(&qd, IID_PPV_ARGS(mQueue.GetAddressOf())))) return false;
+
+    for (Allocator& a : mAllocators) {
+        if (FAILED(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY,
+                                                  IID_PPV_ARGS(a.allocator.GetAddressOf()))))
+            return false;
+    }
+    if (FAILED(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, mAllocators[0].allocator.Get(), nullptr,
+                                         IID_PPV_ARGS(mList.GetAddressOf()))))
+        return false;
+    if (FAILED(mList->Close())) return false;
+
+    mEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (!mEvent) return false;
+
+    return SUCCEEDED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(mFence.GetAddressOf())));
+}
+
+bool D3D12CopyQueue::Execute(std::span<const UploadCopy> copies) {
+    if (!mList || copies.empty()) return false;
+
+    Allocator& a = mAllocators[mNextAllocator];
+    WaitForValue(a.fenceValue);
+    if (FAILED(a.allocator->Reset()))                       return false;
+    if (FAILED(mList->Reset(a.allocator.Get(), nullptr)))   return false;
+
+    for (const UploadCopy& c : copies) {
+        auto* dst = reinterpret_cast<ID3D12Resource*>(static_cast<uintptr_t>(c.destination));
+        if (c.subresource == UploadCopy::kBuffer) {
+            mList->CopyBufferRegion(dst, c.dstOffset, mStaging.Get(), c.stagingOffset, c.size);
+            continue;
+        }
+
+        // Width, height and format come from the destination; offset and
+        // pitch from the scheduler's staging layout.
+        const D3D12_RESOURCE_DESC           desc = dst->GetDesc();
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+        mDevice->GetCopyableFootprints(&desc, c.subresource, 1, 0, &footprint, nullptr, nullptr, nullptr);
+        footprint.Offset             = c.stagingOffset;
+        footprint.Footprint.RowPitch = c.rowPitch;
+
+        D3D12_TEXTURE_COPY_LOCATION dstLocation = {};
+        dstLocation.pResource        = dst;
+        dstLocation.Type             = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        dstLocation.SubresourceIndex = c.subresource;
+
+        D3D12_TEXTURE_COPY_LOCATION srcLocation = {};
+        srcLocation.pResource       = mStaging.Get();
+        srcLocation.Type            = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        srcLocation.PlacedFootprint = footprint;
+
+        mList->CopyTextureRegion(&dstLocation, 0, 0, 0, &srcLocation, nullptr);
+    }
+    if (FAILED(mList->Close())) return false;
+
+    ID3D12CommandList* lists[] = { mList.Get() };
+    mQueue->ExecuteCommandLists(1, lists);
+
+    mLastAllocator = mNextAllocator;
+    mNextAllocator = (mNextAllocator + 1) % kAllocatorCount;
+    return true;
+}
+
+bool D3D12CopyQueue::Signal(uint64_t value) {
+    if (!mQueue || !mFence) return false;
+    if (FAILED(mQueue->Signal(mFence.Get(), value))) return false;
+    if (mLastAllocator != ~0u) {
+        mAllocators[mLastAllocator].fenceValue = value;
+        mLastAllocator                         = ~0u;
+    }
+    return true;
+}
+
+uint64_t D3D12CopyQueue::CompletedValue() const {
+    return mFence ? mFence->GetCompletedValue() : 0;
+}
+
+void D3D12CopyQueue::WaitForValue(uint64_t value) {
+    if (!mFence || !mEvent) return;
+    if (mFence->GetCompletedValue() >= value) return;
+
+    if (FAILED(mFence->SetEventOnCompletion(value, mEvent))) return;
+    // Bounded wait, as D3D12FenceQueue: returns on device removal.
+    WaitForSingleObject(mEvent, 5000);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <windows.h>
+
+#include <d3d12.h>
+#include <wrl/client.h>
+
+#include "UploadScheduler.h"
+
+// ---------------------------------------------------------------------------
+// D3D12CopyQueue — ICopyQueue over a D3D12_COMMAND_LIST_TYPE_COPY queue with
+// its own fence, so uploads run on the copy engine beside the direct queue.
+//
+// Copies read from one staging buffer; UploadCopy::destination is an
+// ID3D12Resource*. Buffers are copied with CopyBufferRegion, texture
+// subresources with CopyTextureRegion from a placed footprint at the staged
+// offset and pitch.
+//
+// Destinations are created in COMMON: the copy queue promotes them to
+// COPY_DEST implicitly and they decay back once the list completes. The
+// direct queue Wait()s on Fence() before the first read; buffers then
+// promote to any read state on their own, textures need a transition there.
+// ---------------------------------------------------------------------------
+class D3D12CopyQueue final : public ICopyQueue {
+public:
+    D3D12CopyQueue()                          = default;
+    D3D12CopyQueue(const D3D12CopyQueue&) = delete;
+    D3D12CopyQueue& operator=(const D3D12CopyQueue&) = delete;
+    ~D3D12CopyQueue() override;
+
+    [[nodiscard]] bool Init(ID3D12Device* device, ID3D12Resource* staging);
+
+    [[nodiscard]] bool     Execute(std::span<const UploadCopy> copies) override;
+    [[nodiscard]] bool     Signal(uint64_t value) override;
+    [[nodiscard]] uint64_t CompletedValue() const override;
+    void                   WaitForValue(uint64_t value) override;
+
+    ID3D12CommandQueue* Queue() const { return mQueue.Get(); }
+    ID3D12Fence*        Fence() const { return mFence.Get(); }
+
+private:
+    // A list's allocator is reset only once the signal after it completed.
+    static constexpr uint32_t kAllocatorCount = 3;
+
+    struct Allocator {
+        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
+        uint64_t                                       fenceValue = 0;
+    };
+
+    Microsoft::WRL::ComPtr<ID3D12Device>              mDevice;
+    Microsoft::WRL::ComPtr<ID3D12CommandQueue>        mQueue;
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> mList;
+    Microsoft::WRL::ComPtr<ID3D12Resource>            mStaging;
+    Microsoft::WRL::ComPtr<ID3D12Fence>               mFence;
+    HANDLE                                            mEvent = nullptr;
+    Allocator                                         mAllocators[kAllocatorCount];
+    uint32_t                                          mNextAllocator = 0;
+    uint32_t                                          mLastAllocator = ~0u; // executed, not yet signalled
+};
@@ -0,0 +1,69 @@
+#include "D3D12DescriptorManager.h"
+
+namespace {
+
+[[nodiscard]] bool CreateHeap(ID3D12Device*                                 device,
+                              D3D12_DESCRIPTOR_HEAP_TYPE                    type,
+                              UINT                                          count,
+                              bool                                          shaderVisible,
+                              Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>& out)
+{
+    D3D12_DESCRIPTOR_HEAP_DESC hd = {};
+    hd.NumDescriptors = count;
+    hd.Type           = type;
+    hd.Flags          = shaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE
+                                      : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+    return SUCCEEDED(device->CreateDescriptorHeap(&hd, IID_PPV_ARGS(out.ReleaseAndGetAddressOf())));
+}
+
+} // namespace
+
+bool D3D12DescriptorManager::Init(ID3D12Device* device, const Desc& desc) {
+    if (device == nullptr) return false;
+
+    if (!mShaderVisible.Init(desc.persistentCount, desc.transientCount)) return false;
+    if (!mRtvSlots.Init(0, desc.rtvCount)) return false;
+    if (!mDsvSlots.Init(0, desc.dsvCount)) return false;
+
+    if (!CreateHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+                    mShaderVisible.Capacity(), true, mCbvSrvUavHeap))
+        return false;
+    if (!CreateHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, desc.rtvCount, false, mRtvHeap))
+        return false;
+    if (!CreateHeap(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, desc.dsvCount, false, mDsvHeap))
+        return false;
+
+    mCbvSrvUavSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    mRtvSize       = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+    mDsvSize       = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
+
+    mCbvSrvUavCpuStart = mCbvSrvUavHeap->GetCPUDescriptorHandleForHeapStart();
+    mCbvSrvUavGpuStart = mCbvSrvUavHeap->GetGPUDescriptorHandleForHeapStart();
+    mRtvCpuStart       = mRtvHeap->GetCPUDescriptorHandleForHeapStart();
+    mDsvCpuStart       = mDsvHeap->GetCPUDescriptorHandleForHeapStart();
+    return true;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12DescriptorManager::CpuHandle(uint32_t index) const {
+    D3D12_CPU_DESCRIPTOR_HANDLE handle = mCbvSrvUavCpuStart;
+    handle.ptr += static_cast<SIZE_T>(index) * mCbvSrvUavSize;
+    return handle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE D3D12DescriptorManager::GpuHandle(uint32_t index) const {
+    D3D12_GPU_DESCRIPTOR_HANDLE handle = mCbvSrvUavGpuStart;
+    handle.ptr += static_cast<UINT64>(index) * mCbvSrvUavSize;
+    return handle;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12DescriptorManager::RtvHandle(uint32_t index) const {
+    D3D12_CPU_DESCRIPTOR_HANDLE handle = mRtvCpuStart;
+    handle.ptr += static_cast<SIZE_T>(index) * mRtvSize;
+    return handle;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE D3D12DescriptorManager::DsvHandle(uint32_t index) const {
+    D3D12_CPU_DESCRIPTOR_HANDLE handle = mDsvCpuStart;
+    handle.ptr += static_cast<SIZE_T>(index) * mDsvSize;
+    return handle;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <windows.h>
+
+#include <d3d12.h>
+#include <wrl/client.h>
+
+#include "DescriptorAllocator.h"
+
+// ---------------------------------------------------------------------------
+// D3D12DescriptorManager — owns every descriptor heap of the app.
+//
+//   • One shader-visible CBV/SRV/UAV heap, split by DescriptorAllocator into
+//     a persistent free-list region and a per-frame transient ring. Bound
+//     once per command list; shaders index it directly (bindless).
+//   • CPU-only staging heaps for RTVs and DSVs, each a DescriptorFreeList.
+//
+// Indices are heap slots; the *Handle() helpers turn them into descriptor
+// handles.
+// ---------------------------------------------------------------------------
+class D3D12DescriptorManager {
+public:
+    static constexpr uint32_t kInvalid = DescriptorAllocator::kInvalid;
+
+    struct Desc {
+        uint32_t persistentCount = 16384; // long-lived CBV/SRV/UAVs
+        uint32_t transientCount  = 16384; // per-frame tables, all frames in flight
+        uint32_t rtvCount        = 64;
+        uint32_t dsvCount        = 16;
+    };
+
+    [[nodiscard]] bool Init(ID3D12Device* device, const Desc& desc);
+
+    // --- Shader-visible CBV/SRV/UAV heap ---
+    [[nodiscard]] uint32_t AllocatePersistent()             { return mShaderVisible.AllocatePersistent(); }
+    void                   FreePersistent(uint32_t index)   { mShaderVisible.FreePersistent(index); }
+    [[nodiscard]] bool     AllocateTransient(uint32_t count, uint32_t& first) {
+        return mShaderVisible.AllocateTransient(count, first);
+    }
+
+    [[nodiscard]] D3D12_CPU_DESCRIPTOR_HANDLE CpuHandle(uint32_t index) const;
+    [[nodiscard]] D3D12_GPU_DESCRIPTOR_HANDLE GpuHandle(uint32_t index) const;
+    [[nodiscard]] ID3D12DescriptorHeap*       ShaderVisibleHeap() const { return mCbvSrvUavHeap.Get(); }
+
+    // Transient slots of frames retired by the fence are recycled.
+    void EndFrame(uint64_t fenceValue)         { mShaderVisible.EndFrame(fenceValue); }
+    void Retire(uint64_t completedFenceValue)  { mShaderVisible.Retire(completedFenceValue); }
+
+    // --- CPU-only RTV / DSV staging heaps ---
+    [[nodiscard]] uint32_t AllocateRtv()           { return mRtvSlots.Allocate(); }
+    void                   FreeRtv(uint32_t index) { mRtvSlots.Free(index); }
+    [[nodiscard]] uint32_t AllocateDsv()           { return mDsvSlots.Allocate(); }
+    void                   FreeDsv(uint32_t index) { mDsvSlots.Free(index); }
+
+    [[nodiscard]] D3D12_CPU_DESCRIPTOR_HANDLE RtvHandle(uint32_t index) const;
+    [[nodiscard]] D3D12_CPU_DESCRIPTOR_HANDLE DsvHandle(uint32_t index) const;
+
+    [[nodiscard]] const DescriptorAllocator& ShaderVisibleStats() const { return mShaderVisible; }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mCbvSrvUavHeap;
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mRtvHeap;
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> mDsvHeap;
+
+    UINT mCbvSrvUavSize = 0;
+    UINT mRtvSize       = 0;
+    UINT mDsvSize       = 0;
+
+    // Heap starts, cached: GetCPU/GPUDescriptorHandleForHeapStart are calls
+    // into the runtime.
+    D3D12_CPU_DESCRIPTOR_HANDLE mCbvSrvUavCpuStart = {};
+    D3D12_GPU_DESCRIPTOR_HANDLE mCbvSrvUavGpuStart = {};
+    D3D12_CPU_DESCRIPTOR_HANDLE mRtvCpuStart       = {};
+    D3D12_CPU_DESCRIPTOR_HANDLE mDsvCpuStart       = {};
+
+    DescriptorAllocator mShaderVisible;
+    DescriptorFreeList  mRtvSlots;
+    DescriptorFreeList  mDsvSlots;
+};
@@ -0,0 +1,37 @@
+#include "D3D12FenceQueue.h"
+
+D3D12FenceQueue::~D3D12FenceQueue() {
+    if (mEvent) {
+        CloseHandle(mEvent);
+        mEvent = nullptr;
+    }
+}
+
+bool D3D12FenceQueue::Init(ID3D12Device* device, ID3D12CommandQueue* queue) {
+    if (device == nullptr || queue == nullptr) return false;
+    mQueue = queue;
+
+    mEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (!mEvent) return false;
+
+    return SUCCEEDED(device->CreateFence(
+        0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(mFence.GetAddressOf())));
+}
+
+bool D3D12FenceQueue::Signal(uint64_t value) {
+    if (!mQueue || !mFence) return false;
+    return SUCCEEDED(mQueue->Signal(mFence.Get(), value));
+}
+
+uint64_t D3D12FenceQueue::CompletedValue() const {
+    return mFence ? mFence->GetCompletedValue() : 0;
+}
+
+void D3D12FenceQueue::WaitForValue(uint64_t value) {
+    if (!mFence || !mEvent) return;
+    if (mFence->GetCompletedValue() >= value) return;
+
+    if (FAILED(mFence->SetEventOnCompletion(value, mEvent))) return;
+    // Bounded wait: 5 s covers normal vsync stalls; returns on device removal.
+    WaitForSingleObject(mEvent, 5000);
+}
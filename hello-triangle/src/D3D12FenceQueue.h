@@ -0,0 +1,33 @@
+#pragma once
+
+#include <windows.h>
+
+#include <d3d12.h>
+#include <wrl/client.h>
+
+#include "FramePacer.h"
+
+// ---------------------------------------------------------------------------
+// D3D12FenceQueue — IFenceQueue over an ID3D12CommandQueue, an ID3D12Fence
+// and a Win32 auto-reset event used for blocking waits.
+// ---------------------------------------------------------------------------
+class D3D12FenceQueue final : public IFenceQueue {
+public:
+    D3D12FenceQueue()                         = default;
+    D3D12FenceQueue(const D3D12FenceQueue&) = delete;
+    D3D12FenceQueue& operator=(const D3D12FenceQueue&) = delete;
+    ~D3D12FenceQueue() override;
+
+    [[nodiscard]] bool Init(ID3D12Device* device, ID3D12CommandQueue* queue);
+
+    [[nodiscard]] bool     Signal(uint64_t value) override;
+    [[nodiscard]] uint64_t CompletedValue() const override;
+    void                   WaitForValue(uint64_t value) override;
+
+    ID3D12Fence* Fence() const { return mFence.Get(); }
+
+private:
+    Microsoft::WRL::ComPtr<ID3D12CommandQueue> mQueue;
+    Microsoft::WRL::ComPtr<ID3D12Fence>        mFence;
+    HANDLE                                     mEvent = nullptr;
+};
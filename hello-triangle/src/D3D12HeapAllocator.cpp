@@ -0,0 +1,126 @@
+#include "D3D12HeapAllocator.h"
+
+bool D3D12HeapAllocator::Init(ID3D12Device*    device,
+                              D3D12_HEAP_TYPE  heapType,
+                              D3D12_HEAP_FLAGS heapFlags,
+                              uint64_t         blockBytes) {
+    if (device == nullptr || blockBytes < kDefaultPlacementAlignment) return false;
+
+    mDevice     = device;
+    mHeapType   = heapType;
+    mHeapFlags  = heapFlags;
+    mBlockBytes = blockBytes;
+    mHeaps.clear();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Resource creation
+// ---------------------------------------------------------------------------
+
+bool D3D12HeapAllocator::CreateBuffer(uint64_t                                size,
+                                      D3D12_RESOURCE_STATES                   initialState,
+                                      Microsoft::WRL::ComPtr<ID3D12Resource>& out,
+                                      HeapAllocation&                         allocation) {
+    D3D12_RESOURCE_DESC rd = {};
+    rd.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
+    rd.Width              = size;
+    rd.Height             = 1;
+    rd.DepthOrArraySize   = 1;
+    rd.MipLevels          = 1;
+    rd.Format             = DXGI_FORMAT_UNKNOWN;
+    rd.SampleDesc.Count   = 1;
+    rd.Layout             = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    return CreateResource(rd, initialState, nullptr, out, allocation);
+}
+
+bool D3D12HeapAllocator::CreateResource(const D3D12_RESOURCE_DESC&              desc,
+                                        D3D12_RESOURCE_STATES                   initialState,
+                                        const D3D12_CLEAR_VALUE*                clearValue,
+                                        Microsoft::WRL::ComPtr<ID3D12Resource>& out,
+                                        HeapAllocation&                         allocation) {
+    if (!mDevice) return false;
+
+    // Size and alignment class (4 KB small texture, 64 KB default, 4 MB MSAA)
+    // as the driver reports them for this exact description.
+    const D3D12_RESOURCE_ALLOCATION_INFO info = mDevice->GetResourceAllocationInfo(0, 1, &desc);
+    if (info.SizeInBytes == UINT64_MAX) return false;
+
+    if (!Allocate(info.SizeInBytes, info.Alignment, allocation)) return false;
+
+    if (FAILED(mDevice->CreatePlacedResource(
+            mHeaps[allocation.heapIndex]->heap.Get(), allocation.range.offset,
+            &desc, initialState, clearValue, IID_PPV_ARGS(out.ReleaseAndGetAddressOf())))) {
+        Free(allocation);
+        return false;
+    }
+    return true;
+}
+
+void D3D12HeapAllocator::Free(HeapAllocation& allocation) {
+    if (!allocation.IsValid() || allocation.heapIndex >= mHeaps.size()) return;
+    mHeaps[allocation.heapIndex]->tlsf.Free(allocation.range);
+    allocation = {};
+}
+
+// ---------------------------------------------------------------------------
+// Heap blocks
+// ---------------------------------------------------------------------------
+
+bool D3D12HeapAllocator::Allocate(uint64_t size, uint64_t alignment, HeapAllocation& out) {
+    for (uint32_t i = 0; i < mHeaps.size(); ++i) {
+        if (mHeaps[i]->tlsf.Allocate(size, alignment, out.range)) {
+            out.heapIndex = i;
+            return true;
+        }
+    }
+
+    // No room: a new block, or a dedicated heap for oversized resources.
+    // The heap starts aligned, so the resource fits at offset 0 even when
+    // it fills the heap.
+    const uint64_t bytes = size > mBlockBytes ? size : mBlockBytes;
+    if (!AddHeap(bytes)) return false;
+
+    if (!mHeaps.back()->tlsf.Allocate(size, alignment, out.range)) {
+        mHeaps.pop_back(); // not kept as an empty heap
+        return false;
+    }
+    out.heapIndex = static_cast<uint32_t>(mHeaps.size() - 1);
+    return true;
+}
+
+bool D3D12HeapAllocator::AddHeap(uint64_t bytes) {
+    // Heaps that may hold render targets must be MSAA-aligned in case one
+    // of them is multisampled.
+    const uint64_t heapAlignment = (mHeapFlags & D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES)
+                                 ? kDefaultPlacementAlignment : kMsaaPlacementAlignment;
+
+    D3D12_HEAP_DESC hd = {};
+    hd.SizeInBytes     = (bytes + heapAlignment - 1) & ~(heapAlignment - 1);
+    hd.Properties.Type = mHeapType;
+    hd.Alignment       = heapAlignment;
+    hd.Flags           = mHeapFlags;
+
+    auto block = std::make_unique<HeapBlock>();
+    if (FAILED(mDevice->CreateHeap(&hd, IID_PPV_ARGS(block->heap.GetAddressOf())))) return false;
+    if (!block->tlsf.Init(hd.SizeInBytes, kSmallTexturePlacementAlignment)) return false;
+
+    mHeaps.push_back(std::move(block));
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Statistics
+// ---------------------------------------------------------------------------
+
+uint64_t D3D12HeapAllocator::ReservedBytes() const {
+    uint64_t bytes = 0;
+    for (const auto& block : mHeaps) bytes += block->tlsf.Capacity();
+    return bytes;
+}
+
+uint64_t D3D12HeapAllocator::UsedBytes() const {
+    uint64_t bytes = 0;
+    for (const auto& block : mHeaps) bytes += block->tlsf.UsedBytes();
+    return bytes;
+}
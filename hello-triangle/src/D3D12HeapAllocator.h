@@ -0,0 +1,77 @@
+#pragma once
+
+#include <windows.h>
+
+#include <d3d12.h>
+#include <wrl/client.h>
+
+#include <memory>
+#include <vector>
+
+#include "TlsfAllocator.h"
+
+// Memory backing one placed resource: the heap block it lives in and the
+// TLSF range inside it.
+struct HeapAllocation {
+    uint32_t       heapIndex = ~0u;
+    TlsfAllocation range;
+
+    [[nodiscard]] bool IsValid() const { return heapIndex != ~0u; }
+};
+
+// ---------------------------------------------------------------------------
+// D3D12HeapAllocator — places resources into large ID3D12Heap blocks
+// sub-allocated with TlsfAllocator, instead of one implicit heap per
+// CreateCommittedResource.
+//
+// One allocator serves one heap type and one resource category (heap flags
+// ALLOW_ONLY_BUFFERS / _NON_RT_DS_TEXTURES / _RT_DS_TEXTURES), which keeps
+// it valid on resource heap tier 1. Blocks are added on demand; a resource
+// larger than a block gets a dedicated heap of its own size.
+//
+// Free() returns the range immediately: the caller must release the
+// resource only after the GPU has finished with it.
+// ---------------------------------------------------------------------------
+class D3D12HeapAllocator {
+public:
+    static constexpr uint64_t kDefaultBlockBytes = 64ull << 20;
+
+    [[nodiscard]] bool Init(ID3D12Device*    device,
+                            D3D12_HEAP_TYPE  heapType,
+                            D3D12_HEAP_FLAGS heapFlags,
+                            uint64_t         blockBytes = kDefaultBlockBytes);
+
+    [[nodiscard]] bool CreateBuffer(uint64_t                                size,
+                                    D3D12_RESOURCE_STATES                   initialState,
+                                    Microsoft::WRL::ComPtr<ID3D12Resource>& out,
+                                    HeapAllocation&                         allocation);
+
+    [[nodiscard]] bool CreateResource(const D3D12_RESOURCE_DESC&              desc,
+                                      D3D12_RESOURCE_STATES                   initialState,
+                                      const D3D12_CLEAR_VALUE*                clearValue,
+                                      Microsoft::WRL::ComPtr<ID3D12Resource>& out,
+                                      HeapAllocation&                         allocation);
+
+    void Free(HeapAllocation& allocation);
+
+    // --- Statistics ---
+    [[nodiscard]] size_t   HeapCount()     const { return mHeaps.size(); }
+    [[nodiscard]] uint64_t ReservedBytes() const; // sum of heap sizes
+    [[nodiscard]] uint64_t UsedBytes()     const;
+
+private:
+    struct HeapBlock {
+        Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+        TlsfAllocator                      tlsf;
+    };
+
+    [[nodiscard]] bool Allocate(uint64_t size, uint64_t alignment, HeapAllocation& out);
+    [[nodiscard]] bool AddHeap(uint64_t bytes);
+
+    Microsoft::WRL::ComPtr<ID3D12Device> mDevice;
+    D3D12_HEAP_TYPE                      mHeapType   = D3D12_HEAP_TYPE_DEFAULT;
+    D3D12_HEAP_FLAGS                     mHeapFlags  = D3D12_HEAP_FLAG_NONE;
+    uint64_t                             mBlockBytes = kDefaultBlockBytes;
+
+    std::vector<std::unique_ptr<HeapBlock>> mHeaps;
+};
@@ -0,0 +1,206 @@
+#include "D3D12PipelineCache.h"
+
+namespace {
+
+std::span<const std::byte> Bytes(const void* data, size_t size) {
+    return { static_cast<const std::byte*>(data), size };
+}
+
+std::span<const std::byte> Bytes(const D3D12_SHADER_BYTECODE& bytecode) {
+    return Bytes(bytecode.pShaderBytecode, bytecode.pShaderBytecode ? bytecode.BytecodeLength : 0);
+}
+
+PipelineStencilOp ToStencilOp(const D3D12_DEPTH_STENCILOP_DESC& op) {
+    return { static_cast<uint32_t>(op.StencilFailOp), static_cast<uint32_t>(op.StencilDepthFailOp),
+             static_cast<uint32_t>(op.StencilPassOp), static_cast<uint32_t>(op.StencilFunc) };
+}
+
+// Blobs are only valid for the adapter and user-mode driver that built them.
+uint64_t QueryDeviceId(ID3D12Device* device, IDXGIFactory4* factory) {
+    PipelineHasher h;
+    h.AddString("d3d12-device");
+
+    Microsoft::WRL::ComPtr<IDXGIAdapter1> adapter;
+    DXGI_ADAPTER_DESC1                    ad = {};
+    if (factory &&
+        SUCCEEDED(factory->EnumAdapterByLuid(device->GetAdapterLuid(),
+                                             IID_PPV_ARGS(adapter.GetAddressOf()))) &&
+        SUCCEEDED(adapter->GetDesc1(&ad))) {
+        h.AddU32(ad.VendorId);
+        h.AddU32(ad.DeviceId);
+        h.AddU32(ad.SubSysId);
+        h.AddU32(ad.Revision);
+
+        LARGE_INTEGER umdVersion = {};
+        if (SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion)))
+            h.AddU64(static_cast<uint64_t>(umdVersion.QuadPart));
+    }
+    return h.Value();
+}
+
+} // namespace
+
+bool D3D12PipelineCache::Init(ID3D12Device* device, IDXGIFactory4* factory,
+                              std::filesystem::path cacheFile) {
+    if (device == nullptr) return false;
+
+    mDevice    = device;
+    mDeviceId  = QueryDeviceId(device, factory);
+    mCacheFile = std::move(cacheFile);
+    mRootSignatures.clear();
+    mRootSignatureKeys.clear();
+    mPipelines.clear();
+    mDiskHits   = 0;
+    mDiskMisses = 0;
+
+    (void)mBlobs.Load(mCacheFile, mDeviceId); // empty on any failure
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Root signatures
+// ---------------------------------------------------------------------------
+
+bool D3D12PipelineCache::GetRootSignature(const D3D12_ROOT_SIGNATURE_DESC&             desc,
+                                          Microsoft::WRL::ComPtr<ID3D12RootSignature>& out) {
+    if (!mDevice) return false;
+
+    Microsoft::WRL::ComPtr<ID3DBlob> sig, err;
+    if (FAILED(D3D12SerializeRootSignature(&desc, D3D_ROOT_SIGNATURE_VERSION_1,
+            sig.GetAddressOf(), err.GetAddressOf())))
+        return false;
+
+    const uint64_t key = HashRootSignature(Bytes(sig->GetBufferPointer(), sig->GetBufferSize()));
+    if (const auto it = mRootSignatures.find(key); it != mRootSignatures.end()) {
+        out = it->second;
+        return true;
+    }
+
+    if (FAILED(mDevice->CreateRootSignature(
+            0, sig->GetBufferPointer(), sig->GetBufferSize(),
+            IID_PPV_ARGS(out.ReleaseAndGetAddressOf()))))
+        return false;
+
+    mRootSignatures.emplace(key, out);
+    mRootSignatureKeys.emplace(out.Get(), key);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Graphics pipelines
+// ---------------------------------------------------------------------------
+
+bool D3D12PipelineCache::GetGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC&    desc,
+                                             Microsoft::WRL::ComPtr<ID3D12PipelineState>& out) {
+    if (!mDevice) return false;
+
+    const auto root = mRootSignatureKeys.find(desc.pRootSignature);
+    if (root == mRootSignatureKeys.end()) return false;
+
+    // --- Key ---
+    GraphicsPipelineDesc key;
+    key.rootSignature = root->second;
+    key.vs = Bytes(desc.VS);
+    key.ps = Bytes(desc.PS);
+    key.ds = Bytes(desc.DS);
+    key.hs = Bytes(desc.HS);
+    key.gs = Bytes(desc.GS);
+
+    mLayoutScratch.clear();
+    for (UINT i = 0; i < desc.InputLayout.NumElements; ++i) {
+        const D3D12_INPUT_ELEMENT_DESC& e = desc.InputLayout.pInputElementDescs[i];
+        mLayoutScratch.push_back({ e.SemanticName ? e.SemanticName : "", e.SemanticIndex,
+                                   static_cast<uint32_t>(e.Format), e.InputSlot, e.AlignedByteOffset,
+                                   static_cast<uint32_t>(e.InputSlotClass), e.InstanceDataStepRate });
+    }
+    key.inputLayout           = mLayoutScratch;
+    key.ibStripCutValue       = static_cast<uint32_t>(desc.IBStripCutValue);
+    key.primitiveTopologyType = static_cast<uint32_t>(desc.PrimitiveTopologyType);
+
+    const D3D12_RASTERIZER_DESC& rs = desc.RasterizerState;
+    key.fillMode              = static_cast<uint32_t>(rs.FillMode);
+    key.cullMode              = static_cast<uint32_t>(rs.CullMode);
+    key.frontCounterClockwise = rs.FrontCounterClockwise != FALSE;
+    key.depthBias             = rs.DepthBias;
+    key.depthBiasClamp        = rs.DepthBiasClamp;
+    key.slopeScaledDepthBias  = rs.SlopeScaledDepthBias;
+    key.depthClipEnable       = rs.DepthClipEnable != FALSE;
+    key.multisampleEnable     = rs.MultisampleEnable != FALSE;
+    key.antialiasedLineEnable = rs.AntialiasedLineEnable != FALSE;
+    key.forcedSampleCount     = rs.ForcedSampleCount;
+    key.conservativeRaster    = static_cast<uint32_t>(rs.ConservativeRaster);
+
+    key.alphaToCoverageEnable  = desc.BlendState.AlphaToCoverageEnable != FALSE;
+    key.independentBlendEnable = desc.BlendState.IndependentBlendEnable != FALSE;
+    for (uint32_t i = 0; i < kPipelineMaxRenderTargets; ++i) {
+        const D3D12_RENDER_TARGET_BLEND_DESC& b = desc.BlendState.RenderTarget[i];
+        key.blend[i] = { b.BlendEnable != FALSE, b.LogicOpEnable != FALSE,
+                         static_cast<uint32_t>(b.SrcBlend),      static_cast<uint32_t>(b.DestBlend),
+                         static_cast<uint32_t>(b.BlendOp),       static_cast<uint32_t>(b.SrcBlendAlpha),
+                         static_cast<uint32_t>(b.DestBlendAlpha), static_cast<uint32_t>(b.BlendOpAlpha),
+                         static_cast<uint32_t>(b.LogicOp),       b.RenderTargetWriteMask };
+    }
+
+    const D3D12_DEPTH_STENCIL_DESC& ds = desc.DepthStencilState;
+    key.depthEnable      = ds.DepthEnable != FALSE;
+    key.depthWriteMask   = static_cast<uint32_t>(ds.DepthWriteMask);
+    key.depthFunc        = static_cast<uint32_t>(ds.DepthFunc);
+    key.stencilEnable    = ds.StencilEnable != FALSE;
+    key.stencilReadMask  = ds.StencilReadMask;
+    key.stencilWriteMask = ds.StencilWriteMask;
+    key.frontFace        = ToStencilOp(ds.FrontFace);
+    key.backFace         = ToStencilOp(ds.BackFace);
+
+    key.sampleMask       = desc.SampleMask;
+    key.numRenderTargets = desc.NumRenderTargets;
+    for (uint32_t i = 0; i < kPipelineMaxRenderTargets; ++i)
+        key.rtvFormats[i] = static_cast<uint32_t>(desc.RTVFormats[i]);
+    key.dsvFormat     = static_cast<uint32_t>(desc.DSVFormat);
+    key.sampleCount   = desc.SampleDesc.Count;
+    key.sampleQuality = desc.SampleDesc.Quality;
+    key.nodeMask      = desc.NodeMask;
+    key.flags         = static_cast<uint32_t>(desc.Flags);
+
+    const uint64_t hash = HashGraphicsPipeline(key);
+
+    // --- In-memory dedup ---
+    if (const auto it = mPipelines.find(hash); it != mPipelines.end()) {
+        out = it->second;
+        return true;
+    }
+
+    // --- Disk cache, then full compilation ---
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC psd = desc;
+    psd.CachedPSO = {};
+
+    bool created = false;
+    if (const std::span<const std::byte> blob = mBlobs.Find(hash); !blob.empty()) {
+        psd.CachedPSO = { blob.data(), blob.size() };
+        created = SUCCEEDED(mDevice->CreateGraphicsPipelineState(
+            &psd, IID_PPV_ARGS(out.ReleaseAndGetAddressOf())));
+        if (created) {
+            ++mDiskHits;
+        } else {
+            mBlobs.Erase(hash); // driver or adapter changed: recompile below
+            psd.CachedPSO = {};
+        }
+    }
+    if (!created) {
+        if (FAILED(mDevice->CreateGraphicsPipelineState(
+                &psd, IID_PPV_ARGS(out.ReleaseAndGetAddressOf()))))
+            return false;
+        ++mDiskMisses;
+
+        Microsoft::WRL::ComPtr<ID3DBlob> compiled;
+        if (SUCCEEDED(out->GetCachedBlob(compiled.GetAddressOf())) && compiled->GetBufferSize() > 0)
+            mBlobs.Store(hash, Bytes(compiled->GetBufferPointer(), compiled->GetBufferSize()));
+    }
+
+    mPipelines.emplace(hash, out);
+    return true;
+}
+
+bool D3D12PipelineCache::Save() {
+    if (!mDevice || !mBlobs.Dirty()) return true;
+    return mBlobs.Save(mCacheFile, mDeviceId);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <windows.h>
+
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <wrl/client.h>
+
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+#include "PipelineCache.h"
+
+// ---------------------------------------------------------------------------
+// D3D12PipelineCache — root signatures and graphics PSOs by content key.
+//
+// In memory, identical descriptions share one object: root signatures are
+// keyed by their serialized blob, pipelines by HashGraphicsPipeline() of the
+// normalized desc (shader bytecode included). On disk, the driver-compiled
+// blob of every pipeline (GetCachedBlob) is kept in a PipelineCache image
+// and fed back through CachedPSO on the next launch, which skips the
+// driver's shader compilation. A blob the driver rejects (new driver,
+// other adapter) is dropped and the PSO is compiled from scratch.
+// ---------------------------------------------------------------------------
+class D3D12PipelineCache {
+public:
+    // A missing or stale cache file is not an error; the cache starts empty.
+    [[nodiscard]] bool Init(ID3D12Device* device, IDXGIFactory4* factory,
+                            std::filesystem::path cacheFile);
+
+    [[nodiscard]] bool GetRootSignature(const D3D12_ROOT_SIGNATURE_DESC&             desc,
+                                        Microsoft::WRL::ComPtr<ID3D12RootSignature>& out);
+
+    // desc.pRootSignature must come from GetRootSignature(); desc.CachedPSO
+    // is ignored.
+    [[nodiscard]] bool GetGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC&    desc,
+                                           Microsoft::WRL::ComPtr<ID3D12PipelineState>& out);
+
+    // Writes the cache file if anything changed since it was loaded.
+    [[nodiscard]] bool Save();
+
+    // --- Statistics ---
+    [[nodiscard]] size_t   RootSignatureCount() const { return mRootSignatures.size(); }
+    [[nodiscard]] size_t   PipelineCount()      const { return mPipelines.size(); }
+    [[nodiscard]] uint32_t DiskHits()           const { return mDiskHits; }   // PSOs created from a cached blob
+    [[nodiscard]] uint32_t DiskMisses()         const { return mDiskMisses; } // PSOs compiled from scratch
+
+private:
+    ID3D12Device*         mDevice   = nullptr;
+    uint64_t              mDeviceId = 0; // adapter + driver version
+    std::filesystem::path mCacheFile;
+    PipelineCache         mBlobs;
+
+    std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<ID3D12RootSignature>> mRootSignatures;
+    std::unordered_map<ID3D12RootSignature*, uint64_t>                         mRootSignatureKeys;
+    std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<ID3D12PipelineState>> mPipelines;
+
+    std::vector<PipelineInputElement> mLayoutScratch;
+
+    uint32_t mDiskHits   = 0;
+    uint32_t mDiskMisses = 0;
+};
@@ -0,0 +1,44 @@
+#include "D3D12StateTracker.h"
+
+static_assert(kResourceStateCommon                  == static_cast<uint32_t>(D3D12_RESOURCE_STATE_COMMON));
+static_assert(kResourceStateVertexAndConstantBuffer == static_cast<uint32_t>(D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER));
+static_assert(kResourceStateIndexBuffer             == static_cast<uint32_t>(D3D12_RESOURCE_STATE_INDEX_BUFFER));
+static_assert(kResourceStateRenderTarget            == static_cast<uint32_t>(D3D12_RESOURCE_STATE_RENDER_TARGET));
+static_assert(kResourceStateUnorderedAccess         == static_cast<uint32_t>(D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+static_assert(kResourceStateDepthWrite              == static_cast<uint32_t>(D3D12_RESOURCE_STATE_DEPTH_WRITE));
+static_assert(kResourceStateDepthRead               == static_cast<uint32_t>(D3D12_RESOURCE_STATE_DEPTH_READ));
+static_assert(kResourceStateNonPixelShaderResource  == static_cast<uint32_t>(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
+static_assert(kResourceStatePixelShaderResource     == static_cast<uint32_t>(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+static_assert(kResourceStateIndirectArgument        == static_cast<uint32_t>(D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT));
+static_assert(kResourceStateCopyDest                == static_cast<uint32_t>(D3D12_RESOURCE_STATE_COPY_DEST));
+static_assert(kResourceStateCopySource              == static_cast<uint32_t>(D3D12_RESOURCE_STATE_COPY_SOURCE));
+static_assert(kResourceStateGenericRead             == static_cast<uint32_t>(D3D12_RESOURCE_STATE_GENERIC_READ));
+static_assert(kResourceStatePresent                 == static_cast<uint32_t>(D3D12_RESOURCE_STATE_PRESENT));
+static_assert(ResourceStateTracker::kAllSubresources == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+void AppendD3D12Barriers(std::span<const ResourceBarrierDesc> batch,
+                         std::vector<D3D12_RESOURCE_BARRIER>& out) {
+    for (const ResourceBarrierDesc& desc : batch) {
+        D3D12_RESOURCE_BARRIER barrier = {};
+        auto* resource = static_cast<ID3D12Resource*>(desc.resource);
+
+        if (desc.type == ResourceBarrierDesc::Type::Uav) {
+            barrier.Type          = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+            barrier.UAV.pResource = resource;
+            out.push_back(barrier);
+            continue;
+        }
+
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        switch (desc.split) {
+        case BarrierSplit::None:      barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;       break;
+        case BarrierSplit::BeginOnly: barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY; break;
+        case BarrierSplit::EndOnly:   barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;   break;
+        }
+        barrier.Transition.pResource   = resource;
+        barrier.Transition.Subresource = desc.subresource;
+        barrier.Transition.StateBefore = static_cast<D3D12_RESOURCE_STATES>(desc.before);
+        barrier.Transition.StateAfter  = static_cast<D3D12_RESOURCE_STATES>(desc.after);
+        out.push_back(barrier);
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <windows.h>
+
+#include <d3d12.h>
+
+#include <span>
+#include <vector>
+
+#include "ResourceStateTracker.h"
+
+// ---------------------------------------------------------------------------
+// D3D12 glue for ResourceStateTracker: converts flushed batches into
+// D3D12_RESOURCE_BARRIERs.
+// ---------------------------------------------------------------------------
+
+// Appends one D3D12_RESOURCE_BARRIER per entry of `batch` to `out`; record
+// them with a single ResourceBarrier(out.size(), out.data()) call.
+void AppendD3D12Barriers(std::span<const ResourceBarrierDesc> batch,
+                         std::vector<D3D12_RESOURCE_BARRIER>& out);
@@ -1,36 +1,72 @@
 #include "D3DApp.h"
 
 #include <DirectXMath.h>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
 
+#include "Checkerboard.h"
+#include "MeshOptimizer.h"
+#include "Profiler.h"
+#include "ShaderReflection.h"
+
 namespace {
 
-// Mirrors cbuffer PerObject : register(b0) in vertex.hlsl.
-// Size: 64 + 16 = 80 bytes  (multiple of 16 — D3D11 requirement).
-struct alignas(16) PerObjectCB {
-    DirectX::XMFLOAT4X4 mvpMatrix; // 64 bytes
-    DirectX::XMFLOAT4   tintColor; // 16 bytes
+// Mirrors cbuffer PerView : register(b0) in vertex.hlsl.
+struct PerViewCB {
+    DirectX::XMFLOAT4X4 viewProjMatrix; // 64 bytes
+};
+static_assert(sizeof(PerViewCB) % 16 == 0,
+    "PerViewCB must be a multiple of 16 bytes");
+
+// Mirrors cbuffer PerFrame : register(b1) in pixel.hlsl. Only the live
+// 8 bytes; the buffer itself is rounded up to the 16-byte cbuffer size.
+struct PerFrameCB {
+    float time;      // accumulated time in seconds
+    float deltaTime; // last frame duration in seconds
+};
+constexpr UINT kPerFrameCBBytes = (sizeof(PerFrameCB) + 15) & ~UINT{ 15 };
+
+// Checked against the shaders' reflection data in CreateShaders(), so a
+// change on either side fails init instead of reading garbage.
+constexpr MirrorField kVertexFields[] = {
+    { "POSITION", offsetof(Vertex, pos), sizeof(Vertex::pos) },
+    { "COLOR",    offsetof(Vertex, col), sizeof(Vertex::col) },
+    { "TEXCOORD", offsetof(Vertex, uv),  sizeof(Vertex::uv)  },
+};
+constexpr MirrorField kInstanceFields[] = {
+    { "INSTANCE_WORLD",  offsetof(InstanceData, world[0]), sizeof(InstanceData::world[0]) },
+    { "INSTANCE_WORLD1", offsetof(InstanceData, world[1]), sizeof(InstanceData::world[1]) },
+    { "INSTANCE_WORLD2", offsetof(InstanceData, world[2]), sizeof(InstanceData::world[2]) },
+    { "INSTANCE_TINT",   offsetof(InstanceData, tint),     sizeof(InstanceData::tint) },
+};
+constexpr MirrorField kPerViewFields[] = {
+    { "viewProjMatrix", offsetof(PerViewCB, viewProjMatrix), sizeof(PerViewCB::viewProjMatrix) },
 };
-static_assert(sizeof(PerObjectCB) % 16 == 0,
-    "PerObjectCB must be a multiple of 16 bytes");
-
-// Mirrors cbuffer PerFrame : register(b1) in pixel.hlsl.
-// Size: 4 + 4 + 8 = 16 bytes (multiple of 16).
-struct alignas(16) PerFrameCB {
-    float time;       //  4 bytes — accumulated time in seconds
-    float deltaTime;  //  4 bytes — last frame duration in seconds
-    float padding[2]; //  8 bytes — explicit padding to satisfy 16-byte alignment
+constexpr MirrorField kPerFrameFields[] = {
+    { "time",      offsetof(PerFrameCB, time),      sizeof(PerFrameCB::time) },
+    { "deltaTime", offsetof(PerFrameCB, deltaTime), sizeof(PerFrameCB::deltaTime) },
 };
-static_assert(sizeof(PerFrameCB) == 16,
-    "PerFrameCB must be exactly 16 bytes");
-
-// Pack RGBA into a uint32_t whose byte layout matches DXGI_FORMAT_R8G8B8A8_UNORM.
-// On little-endian systems the bytes land as [R][G][B][A] in memory.
-constexpr uint32_t PackRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 0xFF) {
-    return static_cast<uint32_t>(r)
-         | (static_cast<uint32_t>(g) <<  8)
-         | (static_cast<uint32_t>(b) << 16)
-         | (static_cast<uint32_t>(a) << 24);
+
+// Swaps the float elements of `inputSlot` (reflected from the shader) for
+// the packed ones of `packed`. Every shader input must be in `packed` and
+// vice versa; the formats may differ, the IA converts them to float.
+bool UsePackedVertexStream(std::vector<PipelineInputElement>& layout, const VertexLayout& packed,
+                           uint32_t inputSlot) {
+    size_t matched = 0;
+    for (PipelineInputElement& e : layout) {
+        if (e.inputSlot != inputSlot) continue;
+        const auto it = std::ranges::find_if(packed.Elements(), [&](const PipelineInputElement& p) {
+            return p.semanticName == e.semanticName && p.semanticIndex == e.semanticIndex;
+        });
+        if (it == packed.Elements().end()) return false;
+        e.format            = it->format;
+        e.alignedByteOffset = it->alignedByteOffset;
+        ++matched;
+    }
+    return matched == packed.Elements().size();
 }
 
 } // namespace
@@ -40,6 +76,8 @@ constexpr uint32_t PackRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 0xFF) {
 // ---------------------------------------------------------------------------
 
 D3DApp::~D3DApp() {
+    (void)mInitTasks.WaitAll(); // background init tasks reference members
+
     // Ensure GPU is done before releasing resources.
     // ComPtr members release automatically in reverse declaration order.
     if (mContext) {
@@ -56,11 +94,70 @@ bool D3DApp::Init(HWND hwnd, int width, int height) {
     mWidth  = width;
     mHeight = height;
 
+    // Locate compiled shaders in a "shaders/" subdirectory next to the exe.
+    wchar_t exePath[MAX_PATH] = {};
+    const DWORD pathLen = GetModuleFileNameW(nullptr, exePath, MAX_PATH);
+    if (pathLen == 0 || pathLen == MAX_PATH) return false; // failed or truncated
+    const auto shaderDir = std::filesystem::path(exePath).parent_path() / L"shaders";
+
+    if (!mJobs.Init()) return false;
+
+    // --- Init steps as a dependency graph ---
+    // The shader archive mapping and the checkerboard need no device and start right away;
+    // resource creation runs concurrently on mJobs (ID3D11Device is
+    // free-threaded, only the immediate context is not). Device, swap chain
+    // and back-buffer view are created on this, the window's, thread.
+    // Init() returns once a cleared frame can be presented; Update() and
+    // Render() use the scene resources once mSceneTask is done.
+    TaskGraph& g = mInitTasks;
+    g.Reset();
+
+    const uint32_t device  = g.Add("device + swap chain", [this, hwnd] { return CreateDeviceAndSwapChain(hwnd); },
+                                   {}, TaskAffinity::Main);
+    const uint32_t archive = g.Add("map shaders.shar", [this, shaderDir] {
+        return mShaderArchive.Open(shaderDir / L"shaders.shar");
+    });
+    const uint32_t texels  = g.Add("checkerboard",    [this] { return GenerateTexturePixels(); });
+    const uint32_t target  = g.Add("render target",   [this] { return CreateRenderTarget(); },
+                                   { device }, TaskAffinity::Main);
+    const uint32_t shaders = g.Add("shaders + layout", [this] { return CreateShaders(); }, { device, archive });
+    const uint32_t buffers = g.Add("buffers + mesh",   [this] { return CreateBuffersAndMesh(); }, { device });
+    const uint32_t texture = g.Add("texture",          [this] { return CreateCheckerboardTexture(); }, { device, texels });
+    mSceneTask             = g.Add("scene", {}, { shaders, buffers, texture });
+
+    g.Start(mJobs);
+    return g.Wait(target);
+}
+
+// ---------------------------------------------------------------------------
+// PollInit — called every frame until the init graph has finished: picks up
+// the background scene resources and reports the init timings once.
+// ---------------------------------------------------------------------------
+
+void D3DApp::PollInit() {
+    if (mInitReported) return;
+
+    mInitTasks.Poll();
+    if (!mSceneReady && !mInitFailed && mInitTasks.IsDone(mSceneTask)) {
+        mSceneReady = mInitTasks.Succeeded(mSceneTask);
+        mInitFailed = !mSceneReady;
+    }
+    if (mInitTasks.AllDone()) {
+        OutputDebugStringA(mInitTasks.FormatReport("D3DApp::Init").c_str());
+        mInitReported = true;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// CreateDeviceAndSwapChain
+// ---------------------------------------------------------------------------
+
+bool D3DApp::CreateDeviceAndSwapChain(HWND hwnd) {
     // --- Swap chain description ---
     DXGI_SWAP_CHAIN_DESC scd             = {};
     scd.BufferCount                      = 2;
-    scd.BufferDesc.Width                 = static_cast<UINT>(width);
-    scd.BufferDesc.Height                = static_cast<UINT>(height);
+    scd.BufferDesc.Width                 = static_cast<UINT>(mWidth);
+    scd.BufferDesc.Height                = static_cast<UINT>(mHeight);
     scd.BufferDesc.Format                = DXGI_FORMAT_R8G8B8A8_UNORM;
     scd.BufferDesc.RefreshRate.Numerator = 60;
     scd.BufferDesc.RefreshRate.Denominator = 1;
@@ -121,61 +218,72 @@ bool D3DApp::Init(HWND hwnd, int width, int height) {
         }
     }
 
-    if (FAILED(hr)) {
-        return false;
-    }
-
-    if (!CreateRenderTarget()) {
-        return false;
-    }
-
-    // Locate compiled shaders in a "shaders/" subdirectory next to the exe.
-    wchar_t exePath[MAX_PATH] = {};
-    const DWORD pathLen = GetModuleFileNameW(nullptr, exePath, MAX_PATH);
-    if (pathLen == 0 || pathLen == MAX_PATH) return false; // failed or truncated
-    const auto shaderDir = std::filesystem::path(exePath).parent_path() / L"shaders";
-
-    return InitPipeline(shaderDir);
+    return SUCCEEDED(hr);
 }
 
 // ---------------------------------------------------------------------------
-// InitPipeline
+// CreateShaders — shader objects straight from the bytecode in the mapped
+// shader archive; the input layout comes from the vertex shader's input
+// signature, and every C++ mirror is checked against the reflection data.
 // ---------------------------------------------------------------------------
 
-bool D3DApp::InitPipeline(const std::filesystem::path& shaderDir) {
-    // Load vertex and pixel shaders from pre-compiled .cso files.
-    if (!mVS.Load(mDevice.Get(), shaderDir / L"vertex.cso")) return false;
-    if (!mPS.Load(mDevice.Get(), shaderDir / L"pixel.cso"))  return false;
-
-    // Input layout — must match the Vertex struct and VSInput in vertex.hlsl.
-    // Offsets: pos=0 (12 B), col=12 (16 B), uv=28 (8 B). Stride = 36 B.
-    const D3D11_INPUT_ELEMENT_DESC layoutDesc[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,   0,  0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "COLOR",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, 28, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-    };
+bool D3DApp::CreateShaders() {
+    const std::span<const std::byte> vsBytecode = mShaderArchive.Find("vertex.cso");
+    const std::span<const std::byte> psBytecode = mShaderArchive.Find("pixel.cso");
+    if (!mVS.Load(mDevice.Get(), vsBytecode)) return false;
+    if (!mPS.Load(mDevice.Get(), psBytecode)) return false;
+
+    ShaderReflection vsReflection, psReflection;
+    if (!vsReflection.Parse(vsBytecode) || !psReflection.Parse(psBytecode)) return false;
+
+    const ShaderConstantBuffer* perView  = vsReflection.FindConstantBuffer("PerView");
+    const ShaderConstantBuffer* perFrame = psReflection.FindConstantBuffer("PerFrame");
+    if (!perView  || !MatchesMirror(*perView,  kPerViewFields,  sizeof(PerViewCB)))  return false;
+    if (!perFrame || !MatchesMirror(*perFrame, kPerFrameFields, sizeof(PerFrameCB))) return false;
+
+    // Input layout — derived from VSInput in vertex.hlsl: the INSTANCE_*
+    // inputs form the per-instance stream in slot 1, checked against
+    // InstanceData; the rest is slot 0, checked against Vertex and then
+    // switched to the packed formats of kMeshVertexFormat.
+    std::vector<PipelineInputElement> layout;
+    if (!vsReflection.BuildInputLayout(layout, 0, "INSTANCE_", kInstanceSlot)) return false;
+    if (!MatchesMirror(layout, kVertexFields, sizeof(Vertex)))                                 return false;
+    if (!MatchesMirror(layout, kInstanceFields, sizeof(InstanceData), kInstanceSlot))          return false;
+    if (!UsePackedVertexStream(layout, MakeVertexLayout(kMeshVertexFormat), 0))               return false;
+
+    const std::vector<D3D11_INPUT_ELEMENT_DESC> layoutDesc = MakeInputElementDescs<D3D11_INPUT_ELEMENT_DESC>(layout);
     HRESULT hr = mDevice->CreateInputLayout(
-        layoutDesc,
-        static_cast<UINT>(std::size(layoutDesc)),
+        layoutDesc.data(),
+        static_cast<UINT>(layoutDesc.size()),
         mVS.Bytecode(),
         mVS.BytecodeSize(),
         mInputLayout.GetAddressOf()
     );
-    if (FAILED(hr)) return false;
+    return SUCCEEDED(hr);
+}
+
+// ---------------------------------------------------------------------------
+// CreateBuffersAndMesh — constant buffers, sampler and the quad.
+// ---------------------------------------------------------------------------
 
-    // Dynamic constant buffer for per-object data updated every frame.
+bool D3DApp::CreateBuffersAndMesh() {
+    // Dynamic constant buffer for the view-projection matrix, updated every frame.
     D3D11_BUFFER_DESC cbd = {};
-    cbd.ByteWidth      = sizeof(PerObjectCB);
+    cbd.ByteWidth      = sizeof(PerViewCB);
     cbd.Usage          = D3D11_USAGE_DYNAMIC;
     cbd.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
     cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    if (FAILED(mDevice->CreateBuffer(&cbd, nullptr, mPerObjectCB.GetAddressOf()))) {
+    if (FAILED(mDevice->CreateBuffer(&cbd, nullptr, mPerViewCB.GetAddressOf()))) {
         return false;
     }
 
+    // Per-instance stream, sized for the whole grid; EnsureInstanceCapacity()
+    // grows it if a frame ever needs more.
+    if (!EnsureInstanceCapacity(QuadGrid::kQuadCount)) return false;
+
     // Dynamic constant buffer for per-frame data (time, deltaTime) — PS slot 1.
     D3D11_BUFFER_DESC pfbd = {};
-    pfbd.ByteWidth      = sizeof(PerFrameCB);
+    pfbd.ByteWidth      = kPerFrameCBBytes;
     pfbd.Usage          = D3D11_USAGE_DYNAMIC;
     pfbd.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
     pfbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
@@ -183,9 +291,6 @@ bool D3DApp::InitPipeline(const std::filesystem::path& shaderDir) {
         return false;
     }
 
-    // Procedural 64x64 checkerboard texture (white / cornflower-blue cells).
-    if (!CreateCheckerboardTexture()) return false;
-
     // Linear-wrap sampler.
     D3D11_SAMPLER_DESC sd = {};
     sd.Filter   = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
@@ -206,41 +311,86 @@ bool D3DApp::InitPipeline(const std::filesystem::path& shaderDir) {
         { { 0.5f, -0.5f, 0.f}, {1,1,1,1}, {1.f, 1.f} }, // bottom-right
         { {-0.5f, -0.5f, 0.f}, {1,1,1,1}, {0.f, 1.f} }, // bottom-left
     };
-    return mMesh.Create(mDevice.Get(), kQuad);
+
+    // Indexed and reordered: the shared corners become one vertex each.
+    std::vector<Vertex>   vertices;
+    std::vector<uint32_t> indices;
+    OptimizeMesh(kQuad, vertices, indices);
+
+    // Packed to kMeshVertexFormat; the dequantization rides along in every
+    // instance's world matrix (see QuadGrid::Update()).
+    const PositionDequant  dequant = ComputePositionDequant(vertices, kMeshVertexFormat.position);
+    const uint32_t         stride  = MakeVertexLayout(kMeshVertexFormat).stride;
+    std::vector<std::byte> packed(vertices.size() * stride);
+    if (!EncodeVertices(vertices, kMeshVertexFormat, dequant, packed)) return false;
+    mGrid.Init(DequantMatrix(dequant)); // culling bounds + dequantization
+    return mMesh.Create(mDevice.Get(), packed, stride, indices);
 }
 
 // ---------------------------------------------------------------------------
-// CreateCheckerboardTexture
+// EnsureInstanceCapacity — (re)creates the dynamic per-instance vertex
+// buffer when `instances` do not fit; grows geometrically.
 // ---------------------------------------------------------------------------
 
-bool D3DApp::CreateCheckerboardTexture() {
-    constexpr int kSize     = 64; // texture dimensions (64x64 texels)
-    constexpr int kCellSize =  8; // checkerboard cell size in texels
-
-    uint32_t pixels[kSize * kSize];
-    for (int y = 0; y < kSize; ++y) {
-        for (int x = 0; x < kSize; ++x) {
-            const bool even = ((x / kCellSize) + (y / kCellSize)) % 2 == 0;
-            pixels[y * kSize + x] = even
-                ? PackRGBA(255, 255, 255)   // white
-                : PackRGBA(100, 149, 237);  // cornflower blue
-        }
+bool D3DApp::EnsureInstanceCapacity(size_t instances) {
+    if (instances <= mInstanceCapacity) return true;
+
+    const size_t capacity = std::max(instances, mInstanceCapacity * 2);
+
+    D3D11_BUFFER_DESC bd = {};
+    bd.ByteWidth      = static_cast<UINT>(capacity * sizeof(InstanceData));
+    bd.Usage          = D3D11_USAGE_DYNAMIC;
+    bd.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
+    bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    mInstanceBuffer.Reset();
+    mInstanceCapacity = 0;
+    if (FAILED(mDevice->CreateBuffer(&bd, nullptr, mInstanceBuffer.GetAddressOf()))) return false;
+    mInstanceCapacity = capacity;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Checkerboard texture — procedural 64x64, white / cornflower-blue cells.
+// The texels, their mip chain and its BC1 blocks are all produced on the CPU
+// before the device exists.
+// ---------------------------------------------------------------------------
+
+bool D3DApp::GenerateTexturePixels() {
+    std::vector<uint32_t> pixels(kTextureSize * kTextureSize);
+    if (!GenerateCheckerboard(pixels, kTextureSize, kTextureCellSize)) return false;
+
+    // Full mip chain: the colours are sRGB-encoded, so levels are averaged
+    // in linear light; the quads tile the texture, so the filter wraps.
+    // Then block-compressed to kTextureFormat.
+    const MipOptions options = { MipFilter::Box, MipAddress::Wrap, 0 };
+    MipChain         mips;
+    if (!GenerateMipChain(std::as_bytes(std::span(pixels)), kTextureSize, kTextureSize,
+                          MipFormat::Rgba8UnormSrgb, options, mips, &mJobs)) {
+        return false;
     }
+    return CompressMipChain(mips, kTextureFormat, BcQuality::Quality, mTextureBlocks, &mJobs);
+}
 
+bool D3DApp::CreateCheckerboardTexture() {
     D3D11_TEXTURE2D_DESC td = {};
-    td.Width            = kSize;
-    td.Height           = kSize;
-    td.MipLevels        = 1;
+    td.Width            = kTextureSize;
+    td.Height           = kTextureSize;
+    td.MipLevels        = static_cast<UINT>(mTextureBlocks.levels.size());
     td.ArraySize        = 1;
-    td.Format           = DXGI_FORMAT_R8G8B8A8_UNORM;
+    td.Format           = static_cast<DXGI_FORMAT>(BcDxgiFormat(kTextureFormat));
     td.SampleDesc.Count = 1;
     td.Usage            = D3D11_USAGE_IMMUTABLE;
     td.BindFlags        = D3D11_BIND_SHADER_RESOURCE;
 
-    const D3D11_SUBRESOURCE_DATA initData { pixels, kSize * sizeof(uint32_t), 0 };
+    std::vector<D3D11_SUBRESOURCE_DATA> initData;
+    for (uint32_t i = 0; i < td.MipLevels; ++i) {
+        initData.push_back({ mTextureBlocks.Level(i).data(), mTextureBlocks.levels[i].rowPitch, 0 });
+    }
 
     Microsoft::WRL::ComPtr<ID3D11Texture2D> tex;
-    if (FAILED(mDevice->CreateTexture2D(&td, &initData, tex.GetAddressOf()))) return false;
+    if (FAILED(mDevice->CreateTexture2D(&td, initData.data(), tex.GetAddressOf()))) return false;
+    mTextureBlocks = {}; // copied into the immutable texture
 
     return SUCCEEDED(mDevice->CreateShaderResourceView(
         tex.Get(), nullptr, mTextureSRV.GetAddressOf()));
@@ -305,6 +455,9 @@ void D3DApp::OnResize(int width, int height) {
 // ---------------------------------------------------------------------------
 
 void D3DApp::Update(float dt) {
+    PROFILE_ZONE("Update");
+    PollInit();
+
     // Rotate at 1 radian per second; wrap to avoid float drift over time.
     mAngle += dt;
     if (mAngle > DirectX::XM_2PI) mAngle -= DirectX::XM_2PI;
@@ -312,35 +465,38 @@ void D3DApp::Update(float dt) {
     // Accumulate elapsed time for UV animation.
     mTime += dt;
 
-    // --- Upload per-object CB (MVP + tint) ---
-    if (mPerObjectCB) {
-        const DirectX::XMMATRIX model = DirectX::XMMatrixRotationY(mAngle);
-
-        const DirectX::XMVECTOR eye    = DirectX::XMVectorSet(0.f, 0.f, -2.f, 0.f);
-        const DirectX::XMVECTOR target = DirectX::XMVectorZero();
-        const DirectX::XMVECTOR up     = DirectX::XMVectorSet(0.f, 1.f,  0.f, 0.f);
-        const DirectX::XMMATRIX view   = DirectX::XMMatrixLookAtLH(eye, target, up);
-
+    // --- Upload per-view CB (view-projection) ---
+    if (mSceneReady) {
         const float aspect = (mHeight > 0)
             ? static_cast<float>(mWidth) / static_cast<float>(mHeight)
             : 1.f;
-        const DirectX::XMMATRIX proj = DirectX::XMMatrixPerspectiveFovLH(
-            DirectX::XM_PIDIV4, aspect, 0.1f, 100.f);
-
-        // Transpose: DirectXMath stores row-major; HLSL float4x4 is column-major.
-        const DirectX::XMMATRIX mvp = DirectX::XMMatrixTranspose(model * view * proj);
+        const Float4x4 viewProj = QuadGrid::ViewProjection(aspect);
 
+        // Transpose: CpuMath stores row-major like DirectXMath; HLSL float4x4
+        // is column-major.
         D3D11_MAPPED_SUBRESOURCE mapped = {};
-        if (SUCCEEDED(mContext->Map(mPerObjectCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
-            auto* cb = static_cast<PerObjectCB*>(mapped.pData);
-            DirectX::XMStoreFloat4x4(&cb->mvpMatrix, mvp);
-            cb->tintColor = { 1.f, 1.f, 1.f, 1.f }; // no tint
-            mContext->Unmap(mPerObjectCB.Get(), 0);
+        if (SUCCEEDED(mContext->Map(mPerViewCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+            auto* cb           = static_cast<PerViewCB*>(mapped.pData);
+            cb->viewProjMatrix = std::bit_cast<DirectX::XMFLOAT4X4>(MatrixTranspose(viewProj));
+            mContext->Unmap(mPerViewCB.Get(), 0);
+        }
+
+        // --- Cull the quad grid, batch the visible quads (QuadGrid, shared
+        //     with the benchmarks) and upload the instance stream (one map) ---
+        mGrid.Update(viewProj, mAngle);
+
+        const std::span<const InstanceData> instances = mGrid.Instances();
+        if (EnsureInstanceCapacity(instances.size()) &&
+            SUCCEEDED(mContext->Map(mInstanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+            std::memcpy(mapped.pData, instances.data(), instances.size_bytes());
+            mContext->Unmap(mInstanceBuffer.Get(), 0);
+        } else {
+            mGrid.ClearBatches(); // nothing uploaded: draw nothing this frame
         }
     }
 
     // --- Upload per-frame CB (time / deltaTime) ---
-    if (mPerFrameCB) {
+    if (mSceneReady) {
         D3D11_MAPPED_SUBRESOURCE mapped = {};
         if (SUCCEEDED(mContext->Map(mPerFrameCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
             auto* pf      = static_cast<PerFrameCB*>(mapped.pData);
@@ -352,6 +508,7 @@ void D3DApp::Update(float dt) {
 }
 
 void D3DApp::Render() {
+    PROFILE_ZONE("Render");
     if (!mContext || !mRTV) return; // guard against failed resize
 
     // --- Clear ---
@@ -360,19 +517,33 @@ void D3DApp::Render() {
     mContext->RSSetViewports(1, &mViewport);
     mContext->ClearRenderTargetView(mRTV.Get(), kClearColor);
 
+    // Clear only until the background init has built the scene resources.
+    if (!mSceneReady) {
+        mSwapChain->Present(1, 0);
+        return;
+    }
+
     // --- Bind pipeline state ---
     mContext->VSSetShader(mVS.Get(), nullptr, 0);
     mContext->PSSetShader(mPS.Get(), nullptr, 0);
     mContext->IASetInputLayout(mInputLayout.Get());
-    mContext->VSSetConstantBuffers(0, 1, mPerObjectCB.GetAddressOf());
+    mContext->VSSetConstantBuffers(0, 1, mPerViewCB.GetAddressOf());
     mContext->PSSetConstantBuffers(1, 1, mPerFrameCB.GetAddressOf());
     mContext->PSSetShaderResources(0, 1, mTextureSRV.GetAddressOf());
     mContext->PSSetSamplers(0, 1, mSampler.GetAddressOf());
 
-    // --- Draw quad ---
+    // --- Draw: one instanced draw per (mesh, material) batch ---
+    // The scene has a single mesh and material (QuadGrid::kQuadMesh,
+    // QuadGrid::kCheckerMaterial), so every batch binds the same state.
+    constexpr UINT kInstanceStride = sizeof(InstanceData);
+    constexpr UINT kInstanceOffset = 0;
     mMesh.Bind(mContext.Get());
+    mContext->IASetVertexBuffers(kInstanceSlot, 1, mInstanceBuffer.GetAddressOf(), &kInstanceStride, &kInstanceOffset);
     mContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    mMesh.Draw(mContext.Get());
+    for (const InstanceBatch& batch : mGrid.Batches()) {
+        mMesh.DrawInstanced(mContext.Get(), batch.instanceCount, batch.firstInstance);
+    }
 
+    PROFILE_ZONE("Present");
     mSwapChain->Present(1, 0); // vsync
 }
@@ -6,10 +6,18 @@
 #include <dxgi.h>
 #include <wrl/client.h>
 
+#include <cstdint>
 #include <filesystem>
+#include <vector>
 
+#include "BlockCompressor.h"
+#include "JobSystem.h"
 #include "Mesh.h"
+#include "QuadGrid.h"
 #include "Shader.h"
+#include "ShaderArchive.h"
+#include "TaskGraph.h"
+#include "VertexFormat.h"
 
 class D3DApp {
 public:
@@ -24,11 +32,31 @@ public:
     void Update(float dt);
     void Render();
 
+    // A background init step (shaders, buffers, texture) failed after
+    // Init() returned; the app can only clear the screen.
+    [[nodiscard]] bool InitFailed() const { return mInitFailed; }
+
 private:
+    static constexpr int      kTextureSize     = 64;            // checkerboard dimensions (texels)
+    static constexpr int      kTextureCellSize = 8;             // checkerboard cell size (texels)
+    static constexpr BcFormat kTextureFormat   = BcFormat::Bc1; // opaque: 8 bytes per 4x4 texels
+
+    static constexpr UINT     kInstanceSlot    = 1;             // IA slot of the per-instance stream
+
+    // Vertex stream of mMesh: 16-byte packed vertices, slot 0 of the input
+    // layout generated from it.
+    static constexpr VertexFormat kMeshVertexFormat = kCompactVertexFormat;
+
+    // --- Init steps (tasks of mInitTasks) ---
+    [[nodiscard]] bool CreateDeviceAndSwapChain(HWND hwnd);
     [[nodiscard]] bool CreateRenderTarget();
     void               ReleaseRenderTarget();
-    [[nodiscard]] bool InitPipeline(const std::filesystem::path& shaderDir);
+    [[nodiscard]] bool CreateShaders();
+    [[nodiscard]] bool CreateBuffersAndMesh();
+    [[nodiscard]] bool EnsureInstanceCapacity(size_t instances);
+    [[nodiscard]] bool GenerateTexturePixels();
     [[nodiscard]] bool CreateCheckerboardTexture();
+    void               PollInit();
 
     // --- D3D11 core ---
     Microsoft::WRL::ComPtr<ID3D11Device>           mDevice;
@@ -40,20 +68,35 @@ private:
     int                                            mHeight   = 0;
 
     // --- Phase 1-2/1-3: shaders, input layout, quad mesh ---
+    ShaderArchive                             mShaderArchive; // mapped shaders.shar; mVS points into it
     VertexShader                              mVS;
     PixelShader                               mPS;
     Microsoft::WRL::ComPtr<ID3D11InputLayout> mInputLayout;
-    Mesh                                      mMesh;
+    Mesh                                      mMesh;          // kMeshVertexFormat
 
-    // --- Phase 1-4: constant buffer (MVP matrix + tint color) ---
-    Microsoft::WRL::ComPtr<ID3D11Buffer>      mPerObjectCB;
+    // --- Phase 1-4: per-view constant buffer (view-projection matrix) ---
+    Microsoft::WRL::ComPtr<ID3D11Buffer>      mPerViewCB;
     float                                     mAngle = 0.f; // rotation angle (radians)
 
+    // --- Culling + instancing: visible grid cells, one draw per batch ---
+    QuadGrid                                  mGrid;                 // cull + batch, rebuilt every frame
+    Microsoft::WRL::ComPtr<ID3D11Buffer>      mInstanceBuffer;       // dynamic, IA slot kInstanceSlot
+    size_t                                    mInstanceCapacity = 0; // in instances
+
     // --- Phase 1-5: texture + sampler ---
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> mTextureSRV;
     Microsoft::WRL::ComPtr<ID3D11SamplerState>       mSampler;
+    BcTexture                                        mTextureBlocks; // until the texture exists
 
     // --- Phase 1-6: per-frame constant buffer (time / deltaTime) ---
     Microsoft::WRL::ComPtr<ID3D11Buffer> mPerFrameCB;
     float                                mTime = 0.f; // accumulated time (seconds)
+
+    // --- Async init: task graph on mJobs; scene drawn once mSceneTask is done ---
+    JobSystem mJobs;
+    TaskGraph mInitTasks;
+    uint32_t  mSceneTask    = TaskGraph::kInvalid;
+    bool      mSceneReady   = false; // read on the window thread only
+    bool      mInitFailed   = false;
+    bool      mInitReported = false;
 };
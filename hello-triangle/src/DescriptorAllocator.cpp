@@ -0,0 +1,89 @@
+#include "DescriptorAllocator.h"
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// DescriptorFreeList
+// ---------------------------------------------------------------------------
+
+bool DescriptorFreeList::Init(uint32_t first, uint32_t count) {
+    if (count == 0 || first > kInvalid - count) return false;
+
+    mFirst = first;
+    mLive.assign(count, false);
+
+    // Pushed in reverse so the lowest index is handed out first.
+    mFree.resize(count);
+    for (uint32_t i = 0; i < count; ++i) mFree[i] = first + count - 1 - i;
+    return true;
+}
+
+uint32_t DescriptorFreeList::Allocate() {
+    if (mFree.empty()) return kInvalid;
+
+    const uint32_t index = mFree.back();
+    mFree.pop_back();
+    mLive[index - mFirst] = true;
+    return index;
+}
+
+void DescriptorFreeList::Free(uint32_t index) {
+    if (index < mFirst || index - mFirst >= mLive.size()) return;
+    if (!mLive[index - mFirst]) return;
+
+    mLive[index - mFirst] = false;
+    mFree.push_back(index);
+}
+
+// ---------------------------------------------------------------------------
+// DescriptorAllocator
+// ---------------------------------------------------------------------------
+
+bool DescriptorAllocator::Init(uint32_t persistentCount, uint32_t transientCount) {
+    if (transientCount == 0) return false;
+    if (!mPersistent.Init(0, persistentCount)) return false;
+
+    mTransientFirst = persistentCount;
+    mTransientCount = transientCount;
+    mHead           = 0;
+    mTail           = 0;
+    mFrames.clear();
+
+    mHighWater         = 0;
+    mFailedAllocations = 0;
+    return true;
+}
+
+bool DescriptorAllocator::AllocateTransient(uint32_t count, uint32_t& first) {
+    if (count == 0 || count > mTransientCount) return false;
+
+    const uint64_t physical = mHead % mTransientCount;
+    uint64_t       offset   = physical;
+    uint64_t       consumed = count;
+    if (physical + count > mTransientCount) {
+        // Skip the slots before the end so the run stays contiguous.
+        offset   = 0;
+        consumed = (mTransientCount - physical) + count;
+    }
+
+    if (TransientInFlight() + consumed > mTransientCount) {
+        ++mFailedAllocations; // the GPU is too far behind
+        return false;
+    }
+
+    mHead     += consumed;
+    mHighWater = std::max(mHighWater, TransientInFlight());
+    first      = mTransientFirst + static_cast<uint32_t>(offset);
+    return true;
+}
+
+void DescriptorAllocator::EndFrame(uint64_t fenceValue) {
+    mFrames.push_back({ fenceValue, mHead });
+}
+
+void DescriptorAllocator::Retire(uint64_t completedFenceValue) {
+    while (!mFrames.empty() && mFrames.front().fenceValue <= completedFenceValue) {
+        mTail = mFrames.front().head;
+        mFrames.pop_front();
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// DescriptorFreeList — O(1) allocation of single descriptor slots out of a
+// fixed range, for descriptors that live until explicitly freed (a
+// texture's SRV, a swap-chain buffer's RTV...). LIFO reuse keeps the live
+// slots dense near the start of the range.
+// ---------------------------------------------------------------------------
+class DescriptorFreeList {
+public:
+    static constexpr uint32_t kInvalid = ~0u;
+
+    [[nodiscard]] bool Init(uint32_t first, uint32_t count);
+
+    [[nodiscard]] uint32_t Allocate();      // heap index, or kInvalid when full
+    void                   Free(uint32_t index); // ignores foreign and double frees
+
+    [[nodiscard]] uint32_t First()     const { return mFirst; }
+    [[nodiscard]] uint32_t Capacity()  const { return static_cast<uint32_t>(mLive.size()); }
+    [[nodiscard]] uint32_t LiveCount() const { return Capacity() - static_cast<uint32_t>(mFree.size()); }
+
+private:
+    uint32_t              mFirst = 0;
+    std::vector<uint32_t> mFree; // stack of free indices
+    std::vector<bool>     mLive; // per slot, catches double frees
+};
+
+// ---------------------------------------------------------------------------
+// DescriptorAllocator — index bookkeeping for one large shader-visible
+// CBV/SRV/UAV heap (bindless: shaders index the whole heap).
+//
+//   [0, persistentCount)          persistent region, DescriptorFreeList
+//   [persistentCount, capacity)   transient region, per-frame linear ring
+//
+// Transient descriptors (per-draw tables copied from staging heaps) are
+// bump-allocated as contiguous runs and never freed one by one: EndFrame()
+// tags the frame's runs with its fence value and Retire() recycles every
+// frame whose fence has completed — the UploadRing scheme, in descriptor
+// slots. A run never wraps past the end of the region.
+//
+// No device involved: D3D12DescriptorManager maps indices to handles.
+// ---------------------------------------------------------------------------
+class DescriptorAllocator {
+public:
+    static constexpr uint32_t kInvalid = ~0u;
+
+    [[nodiscard]] bool Init(uint32_t persistentCount, uint32_t transientCount);
+
+    // --- Persistent region ---
+    [[nodiscard]] uint32_t AllocatePersistent() { return mPersistent.Allocate(); }
+    void                   FreePersistent(uint32_t index) { mPersistent.Free(index); }
+
+    // --- Transient region: `count` contiguous slots, first index in `first` ---
+    [[nodiscard]] bool AllocateTransient(uint32_t count, uint32_t& first);
+    void               EndFrame(uint64_t fenceValue);
+    void               Retire(uint64_t completedFenceValue);
+
+    // --- Statistics ---
+    [[nodiscard]] uint32_t Capacity()            const { return mPersistent.Capacity() + mTransientCount; }
+    [[nodiscard]] uint32_t PersistentLiveCount() const { return mPersistent.LiveCount(); }
+    [[nodiscard]] uint64_t TransientInFlight()   const { return mHead - mTail; }
+    [[nodiscard]] uint64_t TransientHighWater()  const { return mHighWater; }
+    [[nodiscard]] uint64_t FailedAllocations()   const { return mFailedAllocations; }
+
+private:
+    struct FrameMarker {
+        uint64_t fenceValue;
+        uint64_t head;
+    };
+
+    DescriptorFreeList mPersistent;
+
+    uint32_t mTransientFirst = 0;
+    uint32_t mTransientCount = 0;
+    uint64_t mHead           = 0; // absolute positions; slot = first + pos % count
+    uint64_t mTail           = 0;
+
+    std::deque<FrameMarker> mFrames;
+
+    uint64_t mHighWater         = 0;
+    uint64_t mFailedAllocations = 0;
+};
@@ -0,0 +1,81 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// FramePacer
+// ---------------------------------------------------------------------------
+
+bool FramePacer::Init(IFenceQueue* queue, uint32_t slotCount) {
+    if (queue == nullptr || slotCount == 0) return false;
+
+    mQueue        = queue;
+    mSlotFence.assign(slotCount, 0);
+    mCurrentSlot  = 0;
+    mLastSignaled = queue->CompletedValue();
+    mFrameCount   = 0;
+    mStallCount   = 0;
+    return true;
+}
+
+void FramePacer::BeginFrame(uint32_t slot) {
+    if (!mQueue || slot >= mSlotFence.size()) return;
+
+    mCurrentSlot = slot;
+    ++mFrameCount;
+
+    // The slot's previous submission must have retired before its allocator
+    // and constant data are reused. Fresh slots (fence 0) never wait.
+    const uint64_t pending = mSlotFence[slot];
+    if (pending != 0 && mQueue->CompletedValue() < pending) {
+        ++mStallCount;
+        mQueue->WaitForValue(pending);
+    }
+}
+
+bool FramePacer::EndFrame() {
+    if (!mQueue) return false;
+
+    const uint64_t value = mLastSignaled + 1;
+    if (!mQueue->Signal(value)) return false;
+
+    mLastSignaled            = value;
+    mSlotFence[mCurrentSlot] = value;
+    return true;
+}
+
+void FramePacer::WaitIdle() {
+    if (!mQueue) return;
+
+    const uint64_t value = mLastSignaled + 1;
+    if (!mQueue->Signal(value)) return;
+    mLastSignaled = value;
+
+    if (mQueue->CompletedValue() < value) {
+        mQueue->WaitForValue(value);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SimulatedFenceQueue
+// ---------------------------------------------------------------------------
+
+bool SimulatedFenceQueue::Signal(uint64_t value) {
+    if (value <= mSignaled) return false; // fence values must increase
+    mSignaled = value;
+
+    if (mRetireLag != ~0ull && value > mRetireLag) {
+        CompleteUpTo(value - mRetireLag);
+    }
+    return true;
+}
+
+void SimulatedFenceQueue::WaitForValue(uint64_t value) {
+    ++mWaitCount;
+    CompleteUpTo(value);
+}
+
+void SimulatedFenceQueue::CompleteUpTo(uint64_t value) {
+    // The GPU cannot finish work that has not been signalled yet.
+    mCompleted = std::max(mCompleted, std::min(value, mSignaled));
+}
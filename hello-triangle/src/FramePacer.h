@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// IFenceQueue — the minimal view of a GPU timeline that frame pacing needs:
+// enqueue a monotonically increasing fence signal, read the last completed
+// value, and block the CPU until a value is reached.
+//
+// D3D12FenceQueue implements it with ID3D12CommandQueue + ID3D12Fence;
+// SimulatedFenceQueue implements it on the CPU so pacing runs headless.
+// ---------------------------------------------------------------------------
+class IFenceQueue {
+public:
+    virtual ~IFenceQueue() = default;
+
+    // Enqueue a signal of `value` behind all previously submitted GPU work.
+    [[nodiscard]] virtual bool Signal(uint64_t value) = 0;
+
+    // Highest fence value the GPU has finished.
+    [[nodiscard]] virtual uint64_t CompletedValue() const = 0;
+
+    // Block the calling thread until CompletedValue() >= value.
+    virtual void WaitForValue(uint64_t value) = 0;
+};
+
+// ---------------------------------------------------------------------------
+// FramePacer — N-frames-in-flight bookkeeping.
+//
+// Each slot (one per swap-chain buffer) remembers the fence value signalled
+// after its last submission. BeginFrame() only waits when that value has not
+// completed yet, i.e. when the CPU is about to overwrite per-frame data the
+// GPU may still be reading. Everything else overlaps freely.
+// ---------------------------------------------------------------------------
+class FramePacer {
+public:
+    [[nodiscard]] bool Init(IFenceQueue* queue, uint32_t slotCount);
+
+    // Start CPU work for `slot`. Blocks only if the slot is still in flight.
+    void BeginFrame(uint32_t slot);
+
+    // Signal the fence after the slot's command lists were submitted.
+    [[nodiscard]] bool EndFrame();
+
+    // Signal a fresh value and wait for it (resize / shutdown).
+    void WaitIdle();
+
+    [[nodiscard]] uint32_t SlotCount()         const { return static_cast<uint32_t>(mSlotFence.size()); }
+    [[nodiscard]] uint32_t CurrentSlot()       const { return mCurrentSlot; }
+    [[nodiscard]] uint64_t SlotFenceValue(uint32_t slot) const { return mSlotFence[slot]; }
+    [[nodiscard]] uint64_t LastSignaledValue() const { return mLastSignaled; }
+    [[nodiscard]] uint64_t CompletedValue()    const { return mQueue ? mQueue->CompletedValue() : 0; }
+
+    // Statistics: frames begun, and how many of them had to block.
+    [[nodiscard]] uint64_t FrameCount() const { return mFrameCount; }
+    [[nodiscard]] uint64_t StallCount() const { return mStallCount; }
+
+private:
+    IFenceQueue*          mQueue        = nullptr;
+    std::vector<uint64_t> mSlotFence;          // fence value per slot (0 = never submitted)
+    uint32_t              mCurrentSlot  = 0;
+    uint64_t              mLastSignaled = 0;
+    uint64_t              mFrameCount   = 0;
+    uint64_t              mStallCount   = 0;
+};
+
+// ---------------------------------------------------------------------------
+// SimulatedFenceQueue — CPU stand-in for a GPU queue.
+//
+// Signals complete either explicitly (CompleteUpTo) or automatically once
+// `retireLag` newer signals have been queued, which models a GPU running
+// that many frames behind the CPU. WaitForValue() completes the requested
+// value immediately and counts the wait, so pacing can be driven and
+// inspected without a device.
+// ---------------------------------------------------------------------------
+class SimulatedFenceQueue final : public IFenceQueue {
+public:
+    explicit SimulatedFenceQueue(uint64_t retireLag = ~0ull) : mRetireLag(retireLag) {}
+
+    [[nodiscard]] bool     Signal(uint64_t value) override;
+    [[nodiscard]] uint64_t CompletedValue() const override { return mCompleted; }
+    void                   WaitForValue(uint64_t value) override;
+
+    // Mark every signal <= value as finished by the "GPU".
+    void CompleteUpTo(uint64_t value);
+
+    [[nodiscard]] uint64_t SignaledValue() const { return mSignaled; }
+    [[nodiscard]] uint64_t WaitCount()     const { return mWaitCount; }
+
+private:
+    uint64_t mRetireLag = ~0ull;
+    uint64_t mSignaled  = 0;
+    uint64_t mCompleted = 0;
+    uint64_t mWaitCount = 0;
+};
@@ -0,0 +1,63 @@
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace {
+
+// Nearest-rank percentile of ascending `sorted` (non-empty).
+double Percentile(const std::vector<double>& sorted, double p) {
+    const auto rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+} // namespace
+
+void FrameStats::BeginFrame() {
+    ++mFrameCount;
+    for (Stage& stage : mStages) stage.ms.push_back(0.0);
+}
+
+void FrameStats::Add(std::string_view stage, double ms) {
+    if (mFrameCount == 0) return;
+
+    auto it = std::find_if(mStages.begin(), mStages.end(),
+                           [&](const Stage& s) { return s.name == stage; });
+    if (it == mStages.end()) {
+        Stage& added = mStages.emplace_back();
+        added.name = std::string(stage);
+        added.ms.assign(mFrameCount, 0.0); // absent from earlier frames
+        it = std::prev(mStages.end());
+    }
+    it->ms.back() += ms;
+}
+
+void FrameStats::AddZones(std::span<const ProfileZone> zones) {
+    for (const ProfileZone& zone : zones) {
+        Add(zone.name ? zone.name : "", static_cast<double>(zone.durationNs) / 1e6);
+    }
+}
+
+std::vector<StageStats> FrameStats::Summarize() const {
+    std::vector<StageStats> out;
+    std::vector<double>     sorted;
+    for (const Stage& stage : mStages) {
+        StageStats& s = out.emplace_back();
+        s.name   = stage.name;
+        s.frames = mFrameCount;
+        if (stage.ms.empty()) continue;
+
+        sorted = stage.ms;
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0.0;
+        for (double ms : sorted) sum += ms;
+        s.mean = sum / static_cast<double>(sorted.size());
+        s.p50  = Percentile(sorted, 50.0);
+        s.p95  = Percentile(sorted, 95.0);
+        s.p99  = Percentile(sorted, 99.0);
+        s.max  = sorted.back();
+    }
+    return out;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Profiler.h"
+
+// Distribution of one stage's per-frame time, in ms. Percentiles are
+// nearest-rank: p99 of 100 frames is the second-slowest.
+struct StageStats {
+    std::string name;
+    uint32_t    frames = 0;
+    double      mean   = 0.0;
+    double      p50    = 0.0;
+    double      p95    = 0.0;
+    double      p99    = 0.0;
+    double      max    = 0.0;
+};
+
+// ---------------------------------------------------------------------------
+// FrameStats — per-frame stage times of a benchmark run.
+//
+// Each frame starts with BeginFrame(); Add() and AddZones() then accumulate
+// into that frame, so a stage entered several times (e.g. one zone per
+// tile) counts its total. A stage that does not occur in a frame counts 0
+// there, so every stage has one sample per frame.
+// ---------------------------------------------------------------------------
+class FrameStats {
+public:
+    void BeginFrame();
+
+    void Add(std::string_view stage, double ms);
+
+    // Adds every zone as a stage of its name. Zones of different threads are
+    // summed, i.e. a stage run by parallel jobs reports CPU time, not wall
+    // time.
+    void AddZones(std::span<const ProfileZone> zones);
+
+    [[nodiscard]] uint32_t FrameCount() const { return mFrameCount; }
+
+    // One entry per stage, in order of first appearance.
+    [[nodiscard]] std::vector<StageStats> Summarize() const;
+
+private:
+    struct Stage {
+        std::string         name;
+        std::vector<double> ms; // per frame
+    };
+
+    std::vector<Stage> mStages;
+    uint32_t           mFrameCount = 0;
+};
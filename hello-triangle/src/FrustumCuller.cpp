@@ -0,0 +1,308 @@
+#include "FrustumCuller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "Simd.h"
+
+namespace {
+
+// Padding slots: a NaN centre fails every comparison, so they are never
+// visible even when a block is tested past the last object.
+const float kPadding = std::nanf("");
+
+// Whole blocks plus one spare: a leaf range may start at any slot, and its
+// last block still loads eight in-bounds slots.
+uint32_t PaddedSize(uint32_t count) {
+    return (count + kSimdWidth - 1) / kSimdWidth * kSimdWidth + kSimdWidth;
+}
+
+// -1: outside the plane; 1: fully inside; 0: straddles.
+int ClassifyBox(const float (&plane)[4], const Float3& center, const Float3& extent) {
+    const float dist = plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3];
+    const float r    = std::fabs(plane[0]) * extent.x + std::fabs(plane[1]) * extent.y
+                     + std::fabs(plane[2]) * extent.z;
+    if (dist + r < 0.f)  return -1;
+    if (dist - r >= 0.f) return 1;
+    return 0;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Frustum
+// ---------------------------------------------------------------------------
+
+Frustum Frustum::FromViewProjection(const Float4x4& viewProj) {
+    // Row vectors: clip = v * M, so clip.x is v dotted with column 0, etc.
+    // Each plane is a sum/difference of clip-space columns (Gribb/Hartmann).
+    const auto column = [&viewProj](int c, float (&out)[4]) {
+        for (int r = 0; r < 4; ++r) out[r] = viewProj.m[r][c];
+    };
+    float c0[4], c1[4], c2[4], c3[4];
+    column(0, c0);
+    column(1, c1);
+    column(2, c2);
+    column(3, c3);
+
+    Frustum f;
+    for (int i = 0; i < 4; ++i) {
+        f.planes[0][i] = c3[i] + c0[i]; // left:   -w <= x
+        f.planes[1][i] = c3[i] - c0[i]; // right:   x <= w
+        f.planes[2][i] = c3[i] + c1[i]; // bottom: -w <= y
+        f.planes[3][i] = c3[i] - c1[i]; // top:     y <= w
+        f.planes[4][i] = c2[i];         // near:    0 <= z
+        f.planes[5][i] = c3[i] - c2[i]; // far:     z <= w
+    }
+    for (auto& p : f.planes) {
+        const float len = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (len > 0.f) {
+            for (float& x : p) x /= len;
+        }
+    }
+    return f;
+}
+
+// ---------------------------------------------------------------------------
+// Storage
+// ---------------------------------------------------------------------------
+
+void FrustumCuller::Clear() {
+    mCount = 0;
+    for (auto* v : { &mCenterX, &mCenterY, &mCenterZ, &mExtentX, &mExtentY, &mExtentZ, &mRadius }) v->clear();
+    mIds.clear();
+    mSlotOf.clear();
+    mNodes.clear();
+}
+
+uint32_t FrustumCuller::Add(const Aabb& bounds) {
+    const uint32_t id = mCount++;
+    const uint32_t padded = PaddedSize(mCount);
+    if (padded > mCenterX.size()) {
+        for (auto* v : { &mCenterX, &mCenterY, &mCenterZ }) v->resize(padded, kPadding);
+        for (auto* v : { &mExtentX, &mExtentY, &mExtentZ, &mRadius }) v->resize(padded, 0.f);
+        mIds.resize(padded, 0);
+    }
+    mIds[id] = id;
+    mSlotOf.push_back(id);
+    mNodes.clear();
+    StoreSlot(id, bounds);
+    return id;
+}
+
+void FrustumCuller::SetBounds(uint32_t id, const Aabb& bounds) {
+    StoreSlot(mSlotOf[id], bounds);
+}
+
+void FrustumCuller::StoreSlot(uint32_t slot, const Aabb& b) {
+    const Float3 e = { 0.5f * (b.max.x - b.min.x), 0.5f * (b.max.y - b.min.y), 0.5f * (b.max.z - b.min.z) };
+    mCenterX[slot] = 0.5f * (b.min.x + b.max.x);
+    mCenterY[slot] = 0.5f * (b.min.y + b.max.y);
+    mCenterZ[slot] = 0.5f * (b.min.z + b.max.z);
+    mExtentX[slot] = e.x;
+    mExtentY[slot] = e.y;
+    mExtentZ[slot] = e.z;
+    mRadius[slot]  = std::sqrt(Dot(e, e));
+}
+
+// ---------------------------------------------------------------------------
+// SIMD test — eight slots per iteration, all six planes
+// ---------------------------------------------------------------------------
+
+uint32_t* FrustumCuller::TestSlots(const Frustum& frustum, CullShape shape, uint32_t first, uint32_t count,
+                                   uint32_t* out) const {
+    Float8 nx[6], ny[6], nz[6], d[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < 6; ++p) {
+        nx[p] = frustum.planes[p][0];
+        ny[p] = frustum.planes[p][1];
+        nz[p] = frustum.planes[p][2];
+        d[p]  = frustum.planes[p][3];
+        ax[p] = std::fabs(frustum.planes[p][0]);
+        ay[p] = std::fabs(frustum.planes[p][1]);
+        az[p] = std::fabs(frustum.planes[p][2]);
+    }
+
+    const uint32_t end = first + count;
+    for (uint32_t base = first; base < end; base += kSimdWidth) {
+        const Float8 cx = Float8::Load(&mCenterX[base]);
+        const Float8 cy = Float8::Load(&mCenterY[base]);
+        const Float8 cz = Float8::Load(&mCenterZ[base]);
+
+        // Projected "radius" per plane: the sphere radius, or the box's
+        // extent along the plane normal.
+        Float8 inside;
+        if (shape == CullShape::Sphere) {
+            const Float8 negR = Float8(0.f) - Float8::Load(&mRadius[base]);
+            inside = CmpGe(nx[0] * cx + ny[0] * cy + nz[0] * cz + d[0], negR);
+            for (int p = 1; p < 6; ++p) inside = And(inside, CmpGe(nx[p] * cx + ny[p] * cy + nz[p] * cz + d[p], negR));
+        } else {
+            const Float8 ex = Float8::Load(&mExtentX[base]);
+            const Float8 ey = Float8::Load(&mExtentY[base]);
+            const Float8 ez = Float8::Load(&mExtentZ[base]);
+            const auto planeTest = [&](int p) {
+                const Float8 dist = nx[p] * cx + ny[p] * cy + nz[p] * cz + d[p];
+                return CmpGe(dist + ax[p] * ex + ay[p] * ey + az[p] * ez, Float8(0.f));
+            };
+            inside = planeTest(0);
+            for (int p = 1; p < 6; ++p) inside = And(inside, planeTest(p));
+        }
+
+        // Lanes past `end` belong to the next range (or are padding).
+        uint32_t mask = MoveMask(inside);
+        if (end - base < kSimdWidth) mask &= (1u << (end - base)) - 1;
+
+        const uint32_t* ids = &mIds[base];
+        for (int lane = 0; lane < kSimdWidth; ++lane) {
+            *out = ids[lane];
+            out += (mask >> lane) & 1;
+        }
+    }
+    return out;
+}
+
+void FrustumCuller::CullLinear(const Frustum& frustum, CullShape shape, std::vector<uint32_t>& visible) const {
+    visible.resize(size_t{ mCount } + kSimdWidth); // room for the last block's unconditional stores
+    const uint32_t* end = TestSlots(frustum, shape, 0, mCount, visible.data());
+    visible.resize(static_cast<size_t>(end - visible.data()));
+}
+
+// ---------------------------------------------------------------------------
+// BVH
+// ---------------------------------------------------------------------------
+
+void FrustumCuller::BoundsOfSlots(uint32_t first, uint32_t count, Float3& center, Float3& extent) const {
+    Float3 lo = { INFINITY, INFINITY, INFINITY };
+    Float3 hi = { -INFINITY, -INFINITY, -INFINITY };
+    for (uint32_t s = first; s < first + count; ++s) {
+        lo = { std::min(lo.x, mCenterX[s] - mExtentX[s]), std::min(lo.y, mCenterY[s] - mExtentY[s]),
+               std::min(lo.z, mCenterZ[s] - mExtentZ[s]) };
+        hi = { std::max(hi.x, mCenterX[s] + mExtentX[s]), std::max(hi.y, mCenterY[s] + mExtentY[s]),
+               std::max(hi.z, mCenterZ[s] + mExtentZ[s]) };
+    }
+    center = { 0.5f * (lo.x + hi.x), 0.5f * (lo.y + hi.y), 0.5f * (lo.z + hi.z) };
+    extent = { 0.5f * (hi.x - lo.x), 0.5f * (hi.y - lo.y), 0.5f * (hi.z - lo.z) };
+}
+
+void FrustumCuller::Permute(const std::vector<uint32_t>& order) {
+    std::vector<float> scratch(mCenterX.size(), kPadding);
+    for (auto* v : { &mCenterX, &mCenterY, &mCenterZ, &mExtentX, &mExtentY, &mExtentZ, &mRadius }) {
+        for (uint32_t s = 0; s < mCount; ++s) scratch[s] = (*v)[order[s]];
+        std::copy(scratch.begin(), scratch.begin() + mCount, v->begin());
+    }
+    std::vector<uint32_t> ids(mIds.size(), 0);
+    for (uint32_t s = 0; s < mCount; ++s) ids[s] = mIds[order[s]];
+    mIds.swap(ids);
+    for (uint32_t s = 0; s < mCount; ++s) mSlotOf[mIds[s]] = s;
+}
+
+void FrustumCuller::BuildBvh(uint32_t leafSize) {
+    mNodes.clear();
+    if (mCount == 0) return;
+    leafSize = std::max<uint32_t>(leafSize, 1);
+
+    // Median split on the longest axis of the centroids; `order` holds the
+    // slots in their final positions once every range has been split.
+    std::vector<uint32_t> order(mCount);
+    std::iota(order.begin(), order.end(), 0u);
+
+    const float* centers[3] = { mCenterX.data(), mCenterY.data(), mCenterZ.data() };
+
+    mNodes.push_back({ {}, {}, 0, mCount, kNoChild });
+    for (size_t n = 0; n < mNodes.size(); ++n) { // breadth first: children follow parents
+        const uint32_t first = mNodes[n].first;
+        const uint32_t count = mNodes[n].count;
+        if (count <= leafSize) continue;
+
+        float lo[3] = { INFINITY, INFINITY, INFINITY };
+        float hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+        for (uint32_t i = first; i < first + count; ++i) {
+            for (int a = 0; a < 3; ++a) {
+                lo[a] = std::min(lo[a], centers[a][order[i]]);
+                hi[a] = std::max(hi[a], centers[a][order[i]]);
+            }
+        }
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (hi[a] - lo[a] > hi[axis] - lo[axis]) axis = a;
+        }
+
+        // Round the split to whole SIMD blocks so leaves start aligned.
+        uint32_t half = count / 2;
+        if (half >= kSimdWidth) half -= half % kSimdWidth;
+
+        const float* key = centers[axis];
+        std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                         [key](uint32_t a, uint32_t b) { return key[a] < key[b]; });
+
+        mNodes[n].left = static_cast<uint32_t>(mNodes.size());
+        mNodes.push_back({ {}, {}, first, half, kNoChild });
+        mNodes.push_back({ {}, {}, first + half, count - half, kNoChild });
+    }
+
+    Permute(order);
+    RefitBvh();
+}
+
+void FrustumCuller::RefitBvh() {
+    for (size_t n = mNodes.size(); n-- > 0;) {
+        BvhNode& node = mNodes[n];
+        if (node.left == kNoChild) {
+            BoundsOfSlots(node.first, node.count, node.center, node.extent);
+            continue;
+        }
+        const BvhNode& a = mNodes[node.left];
+        const BvhNode& b = mNodes[node.left + 1];
+        const Float3 lo = { std::min(a.center.x - a.extent.x, b.center.x - b.extent.x),
+                            std::min(a.center.y - a.extent.y, b.center.y - b.extent.y),
+                            std::min(a.center.z - a.extent.z, b.center.z - b.extent.z) };
+        const Float3 hi = { std::max(a.center.x + a.extent.x, b.center.x + b.extent.x),
+                            std::max(a.center.y + a.extent.y, b.center.y + b.extent.y),
+                            std::max(a.center.z + a.extent.z, b.center.z + b.extent.z) };
+        node.center = { 0.5f * (lo.x + hi.x), 0.5f * (lo.y + hi.y), 0.5f * (lo.z + hi.z) };
+        node.extent = { 0.5f * (hi.x - lo.x), 0.5f * (hi.y - lo.y), 0.5f * (hi.z - lo.z) };
+    }
+}
+
+void FrustumCuller::CullHierarchical(const Frustum& frustum, std::vector<uint32_t>& visible) const {
+    if (mNodes.empty()) {
+        CullLinear(frustum, CullShape::Box, visible);
+        return;
+    }
+
+    visible.resize(size_t{ mCount } + kSimdWidth);
+    uint32_t* out = visible.data();
+
+    struct Entry {
+        uint32_t node;
+        uint32_t planeMask; // planes the node is not yet known to be inside of
+    };
+    Entry stack[64];
+    int   top = 0;
+    stack[top++] = { 0, 0x3F };
+
+    while (top > 0) {
+        const Entry    e    = stack[--top];
+        const BvhNode& node = mNodes[e.node];
+
+        uint32_t mask     = e.planeMask;
+        bool     rejected = false;
+        for (int p = 0; p < 6 && !rejected; ++p) {
+            if (!(mask & (1u << p))) continue;
+            const int c = ClassifyBox(frustum.planes[p], node.center, node.extent);
+            if (c < 0)  rejected = true;
+            if (c > 0)  mask &= ~(1u << p);
+        }
+        if (rejected) continue;
+
+        if (mask == 0) { // inside every plane: no per-object tests
+            out = std::copy_n(mIds.begin() + node.first, node.count, out);
+        } else if (node.left == kNoChild) {
+            out = TestSlots(frustum, CullShape::Box, node.first, node.count, out);
+        } else {
+            stack[top++] = { node.left + 1, mask };
+            stack[top++] = { node.left, mask };
+        }
+    }
+    visible.resize(static_cast<size_t>(out - visible.data()));
+}
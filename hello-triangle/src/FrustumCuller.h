@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "CpuMath.h"
+
+// Axis-aligned bounding box in world space.
+struct Aabb {
+    Float3 min;
+    Float3 max;
+};
+
+// ---------------------------------------------------------------------------
+// Frustum — six world-space planes (left, right, bottom, top, near, far),
+// normalized, normals pointing inwards: a point p is inside when
+// dot(n, p) + d >= 0 for every plane.
+// ---------------------------------------------------------------------------
+struct Frustum {
+    float planes[6][4]; // nx, ny, nz, d
+
+    // From a CpuMath/DirectXMath view-projection matrix (row vectors, D3D
+    // clip depth in [0, w]).
+    static Frustum FromViewProjection(const Float4x4& viewProj);
+};
+
+enum class CullShape : uint8_t {
+    Sphere, // bounding sphere of each box: 4 multiply-adds per plane, looser
+    Box,    // the box itself (centre / extents form): exact against each plane
+};
+
+// ---------------------------------------------------------------------------
+// FrustumCuller — visibility of many boxes against one frustum.
+//
+// Bounds are stored as structure-of-arrays (centre x/y/z, extent x/y/z,
+// sphere radius), padded to whole blocks of kSimdWidth, so each test
+// iteration loads eight objects per component into one Float8 and checks
+// all six planes with no shuffles. The backend follows Simd.h (AVX with
+// HELLO_TRIANGLE_AVX2, otherwise SSE2).
+//
+// The output is a compact list of object ids (the index Add() returned),
+// written branch-free: every lane stores its id and the write cursor
+// advances by the lane's mask bit.
+//
+// BuildBvh() adds a binary BVH over the boxes for hierarchical rejection.
+// It reorders the storage so every node covers a contiguous slot range;
+// CullHierarchical() then drops whole subtrees that are outside one plane,
+// emits subtrees that are inside all planes without per-object tests, and
+// runs the SIMD box test only on the leaves that straddle the frustum.
+// Planes a node is already fully inside of are skipped for its children.
+// ---------------------------------------------------------------------------
+class FrustumCuller {
+public:
+    static constexpr uint32_t kDefaultLeafSize = 64;
+
+    // Removes every object and the BVH.
+    void Clear();
+
+    // Returns the object's id: 0, 1, 2... in Add() order. Invalidates the BVH.
+    uint32_t Add(const Aabb& bounds);
+
+    // Moves an object. A built BVH stays usable but loose until RefitBvh().
+    void SetBounds(uint32_t id, const Aabb& bounds);
+
+    [[nodiscard]] uint32_t Count() const { return mCount; }
+
+    // --- Culling: `visible` is overwritten with the ids that intersect the
+    //     frustum, in storage order (Add() order until BuildBvh()) ---
+    void CullLinear(const Frustum& frustum, CullShape shape, std::vector<uint32_t>& visible) const;
+
+    // Falls back to CullLinear(..., CullShape::Box) without a BVH.
+    void CullHierarchical(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+    // --- BVH ---
+    void BuildBvh(uint32_t leafSize = kDefaultLeafSize);
+    void RefitBvh(); // recompute node bounds after SetBounds()
+
+    [[nodiscard]] bool     HasBvh()        const { return !mNodes.empty(); }
+    [[nodiscard]] uint32_t BvhNodeCount()  const { return static_cast<uint32_t>(mNodes.size()); }
+
+private:
+    static constexpr uint32_t kNoChild = ~0u;
+
+    // Children of an inner node are `left` and `left + 1`; always stored
+    // after their parent.
+    struct BvhNode {
+        Float3   center;
+        Float3   extent;
+        uint32_t first = 0; // slot range
+        uint32_t count = 0;
+        uint32_t left  = kNoChild;
+    };
+
+    void StoreSlot(uint32_t slot, const Aabb& bounds);
+
+    // SIMD test of slots [first, first + count); appends ids at `out`,
+    // returns the new end.
+    uint32_t* TestSlots(const Frustum& frustum, CullShape shape, uint32_t first, uint32_t count,
+                        uint32_t* out) const;
+
+    void BoundsOfSlots(uint32_t first, uint32_t count, Float3& center, Float3& extent) const;
+    void Permute(const std::vector<uint32_t>& order);
+
+    uint32_t mCount = 0;
+
+    // SoA, slot order, padded to whole blocks plus one spare block.
+    std::vector<float>    mCenterX, mCenterY, mCenterZ;
+    std::vector<float>    mExtentX, mExtentY, mExtentZ;
+    std::vector<float>    mRadius;
+    std::vector<uint32_t> mIds;    // slot -> id
+    std::vector<uint32_t> mSlotOf; // id -> slot
+
+    std::vector<BvhNode> mNodes; // root first; empty = no BVH
+};
@@ -0,0 +1,119 @@
+#include "InstanceBatcher.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+constexpr uint32_t kInitialSlotBits = 8;
+
+} // namespace
+
+void InstanceBatcher::Reset() {
+    std::fill(mSlotKeys.begin(), mSlotKeys.end(), kEmptySlot);
+    mBatches.clear();
+    mObjectBatch.clear();
+    mStaged.clear();
+    mInstances.clear();
+    mLastKey   = kEmptySlot;
+    mLastBatch = 0;
+    mInOrder   = true;
+}
+
+// ---------------------------------------------------------------------------
+// Batch lookup
+// ---------------------------------------------------------------------------
+
+uint32_t InstanceBatcher::FindOrAddBatch(uint64_t key) {
+    if ((mBatches.size() + 1) * 2 > mSlotKeys.size()) GrowSlots();
+
+    const size_t mask = mSlotKeys.size() - 1;
+    size_t       slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> mSlotShift);
+    while (mSlotKeys[slot] != key) {
+        if (mSlotKeys[slot] == kEmptySlot) {
+            mSlotKeys[slot]    = key;
+            mSlotBatches[slot] = static_cast<uint32_t>(mBatches.size());
+            mBatches.push_back({ static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), 0, 0 });
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return mSlotBatches[slot];
+}
+
+void InstanceBatcher::GrowSlots() {
+    const uint32_t bits = mSlotKeys.empty() ? kInitialSlotBits : 64 - mSlotShift + 1;
+    mSlotShift = 64 - bits;
+    mSlotKeys.assign(size_t{ 1 } << bits, kEmptySlot);
+    mSlotBatches.assign(size_t{ 1 } << bits, 0);
+
+    // Reinsert; the batches keep their indices.
+    const size_t mask = mSlotKeys.size() - 1;
+    for (uint32_t b = 0; b < mBatches.size(); ++b) {
+        const uint64_t key  = Key(mBatches[b].mesh, mBatches[b].material);
+        size_t         slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> mSlotShift);
+        while (mSlotKeys[slot] != kEmptySlot) slot = (slot + 1) & mask;
+        mSlotKeys[slot]    = key;
+        mSlotBatches[slot] = b;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Add / Build
+// ---------------------------------------------------------------------------
+
+void InstanceBatcher::Add(uint32_t mesh, uint32_t material, const InstanceData& instance) {
+    const uint64_t key = Key(mesh, material);
+    if (key != mLastKey) {
+        // kEmptySlot is the "nothing added yet" sentinel, never a smaller key.
+        if (mLastKey != kEmptySlot && key < mLastKey) mInOrder = false;
+        mLastKey   = key;
+        mLastBatch = FindOrAddBatch(key);
+    }
+
+    ++mBatches[mLastBatch].instanceCount;
+    mObjectBatch.push_back(mLastBatch);
+    mStaged.push_back(instance);
+}
+
+void InstanceBatcher::Build() {
+    // In-order submission: a key never comes back after a larger one, so
+    // the batches are already contiguous and sorted.
+    const bool contiguous = mInOrder;
+
+    // --- Batch order and instance ranges ---
+    std::vector<uint32_t> order(mBatches.size());
+    std::iota(order.begin(), order.end(), 0u);
+    if (!contiguous) {
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            return Key(mBatches[a].mesh, mBatches[a].material) < Key(mBatches[b].mesh, mBatches[b].material);
+        });
+    }
+
+    uint32_t first = 0;
+    for (uint32_t b : order) {
+        mBatches[b].firstInstance = first;
+        first += mBatches[b].instanceCount;
+    }
+
+    // --- Instances: reuse the staged array, or group (stable counting sort) ---
+    if (contiguous) {
+        mInstances.swap(mStaged);
+    } else {
+        // Sort the 4-byte object indices, then gather the 64-byte records
+        // in output order: scattering the records themselves would write to
+        // one stream per batch at a time, which is about twice as slow.
+        std::vector<uint32_t> cursor(mBatches.size());
+        for (size_t b = 0; b < mBatches.size(); ++b) cursor[b] = mBatches[b].firstInstance;
+
+        mSource.resize(mObjectBatch.size());
+        for (uint32_t i = 0; i < mObjectBatch.size(); ++i) mSource[cursor[mObjectBatch[i]]++] = i;
+
+        mInstances.resize(mStaged.size());
+        for (size_t i = 0; i < mSource.size(); ++i) mInstances[i] = mStaged[mSource[i]];
+    }
+
+    std::sort(mBatches.begin(), mBatches.end(), [](const InstanceBatch& a, const InstanceBatch& b) {
+        return a.firstInstance < b.firstInstance;
+    });
+}
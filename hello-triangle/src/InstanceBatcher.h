@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CpuMath.h"
+
+// ---------------------------------------------------------------------------
+// Per-instance vertex data (input slot 1); mirrors the INSTANCE_* inputs of
+// vertex.hlsl. The world matrix is stored as its first three columns, so the
+// shader computes each world coordinate with one dot product against
+// float4(position, 1). That works for any affine transform.
+// ---------------------------------------------------------------------------
+struct InstanceData {
+    float world[3][4]; // INSTANCE_WORLD0..2: columns 0-2 of the row-major world matrix
+    float tint[4];     // INSTANCE_TINT: rgba multiplier
+};
+static_assert(sizeof(InstanceData) == 64, "InstanceData must stay tightly packed (stride 64)");
+
+inline InstanceData MakeInstanceData(const Float4x4& world, const float (&tint)[4]) {
+    InstanceData d;
+    for (int c = 0; c < 3; ++c) {
+        for (int r = 0; r < 4; ++r) d.world[c][r] = world.m[r][c];
+    }
+    for (int i = 0; i < 4; ++i) d.tint[i] = tint[i];
+    return d;
+}
+
+// One instanced draw: every object of one (mesh, material) pair.
+struct InstanceBatch {
+    uint32_t mesh          = 0;
+    uint32_t material      = 0;
+    uint32_t firstInstance = 0; // StartInstanceLocation into Instances()
+    uint32_t instanceCount = 0;
+};
+
+// ---------------------------------------------------------------------------
+// InstanceBatcher — merges a frame's objects into one draw per (mesh,
+// material).
+//
+// Add() records an object; Build() groups the instance data into one
+// contiguous range per batch, ready to be copied into an instance buffer
+// with a single map. The batches come out sorted by (mesh, material), which
+// minimizes state changes between draws. Within a batch the objects keep
+// their submission order.
+//
+// Work is O(objects). Add() finds the batch with a probe of a flat
+// open-addressing table, skipped when the key repeats. Build() is a counting
+// sort of object indices followed by one gather of the instance data (the
+// output is written sequentially), and it is skipped entirely when the
+// objects arrived already sorted: the staged data is then used as is.
+// ---------------------------------------------------------------------------
+class InstanceBatcher {
+public:
+    // Starts a new frame; keeps the capacity of the previous ones.
+    void Reset();
+
+    // (mesh, material) = (~0u, ~0u) is reserved.
+    void Add(uint32_t mesh, uint32_t material, const InstanceData& instance);
+
+    void Build();
+
+    // Valid after Build() until the next Reset(), which must come before
+    // the next Add().
+    [[nodiscard]] std::span<const InstanceBatch> Batches()   const { return mBatches; }
+    [[nodiscard]] std::span<const InstanceData>  Instances() const { return mInstances; }
+
+    [[nodiscard]] size_t ObjectCount() const { return mObjectBatch.size(); }
+
+private:
+    static constexpr uint64_t kEmptySlot = ~0ull; // Key(~0u, ~0u), reserved
+
+    static uint64_t Key(uint32_t mesh, uint32_t material) {
+        return (uint64_t{ mesh } << 32) | material;
+    }
+
+    uint32_t FindOrAddBatch(uint64_t key);
+    void     GrowSlots();
+
+    // Key -> batch index, linear probing; at most half full.
+    std::vector<uint64_t> mSlotKeys;
+    std::vector<uint32_t> mSlotBatches;
+    uint32_t              mSlotShift = 64; // hash >> mSlotShift = slot; 64 - log2(slot count)
+
+    std::vector<InstanceBatch> mBatches; // first-seen order until Build()
+
+    std::vector<uint32_t>     mObjectBatch; // per object, submission order
+    std::vector<uint32_t>     mSource;      // grouped position -> object index
+    std::vector<InstanceData> mStaged;      // per object, submission order
+    std::vector<InstanceData> mInstances;   // grouped by batch
+
+    uint64_t mLastKey   = kEmptySlot;
+    uint32_t mLastBatch = 0;
+    bool     mInOrder   = true; // every Add() so far had a key >= the previous one
+};
@@ -0,0 +1,166 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <string>
+
+#include "Profiler.h"
+
+namespace {
+
+// Worker identity of the current thread. tOwner guards against a worker of
+// one JobSystem being mistaken for a worker of another.
+thread_local const JobSystem* tOwner = nullptr;
+thread_local uint32_t         tIndex = 0;
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Lifetime
+// ---------------------------------------------------------------------------
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+uint32_t JobSystem::DefaultWorkerCount() {
+    const uint32_t hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+}
+
+bool JobSystem::Init(uint32_t workerCount) {
+    if (!mQueues.empty()) return false; // already running
+
+    mStopping.store(false);
+    mQueues.clear();
+    for (uint32_t i = 0; i <= workerCount; ++i) {
+        mQueues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    mWorkers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; ++i) {
+        mWorkers.emplace_back([this, i] { WorkerMain(i); });
+    }
+    return true;
+}
+
+void JobSystem::Shutdown() {
+    if (mQueues.empty()) return;
+
+    mStopping.store(true, std::memory_order_release);
+    mWakeEpoch.fetch_add(1, std::memory_order_release);
+    mWakeEpoch.notify_all();
+
+    for (std::thread& t : mWorkers) t.join();
+    mWorkers.clear();
+
+    // Drain whatever was still queued so no counter is left dangling.
+    Task task;
+    while (PopOwn(0, task)) Execute(task);
+    mQueues.clear();
+}
+
+uint32_t JobSystem::ThreadIndex() const {
+    return tOwner == this ? tIndex : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Submission
+// ---------------------------------------------------------------------------
+
+void JobSystem::Run(Job job, JobCounter* counter) {
+    if (counter) counter->mPending.fetch_add(1, std::memory_order_relaxed);
+
+    if (mQueues.empty()) {
+        // Not initialised: run inline so callers still make progress.
+        Task task{ std::move(job), counter };
+        Execute(task);
+        return;
+    }
+
+    WorkQueue& queue = *mQueues[ThreadIndex()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back({ std::move(job), counter });
+    }
+
+    // Bumping the epoch makes a concurrent wait() return immediately, so a
+    // worker that just found every deque empty cannot miss this job.
+    mWakeEpoch.fetch_add(1, std::memory_order_release);
+    mWakeEpoch.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    const uint32_t self = ThreadIndex();
+    while (!counter.IsDone()) {
+        if (!TryRunOne(self)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t grain,
+                            const std::function<void(uint32_t, uint32_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max(grain, 1u);
+
+    JobCounter counter;
+    for (uint32_t begin = 0; begin < count; begin += grain) {
+        const uint32_t end = std::min(count, begin + grain);
+        Run([&fn, begin, end] { fn(begin, end); }, &counter);
+    }
+    Wait(counter);
+}
+
+// ---------------------------------------------------------------------------
+// Scheduling
+// ---------------------------------------------------------------------------
+
+void JobSystem::WorkerMain(uint32_t index) {
+    tOwner = this;
+    tIndex = index;
+    Profiler::SetThreadName("worker " + std::to_string(index));
+
+    while (true) {
+        const uint32_t epoch = mWakeEpoch.load(std::memory_order_acquire);
+        if (TryRunOne(index)) continue;
+        if (mStopping.load(std::memory_order_acquire)) break;
+        mWakeEpoch.wait(epoch, std::memory_order_acquire);
+    }
+}
+
+bool JobSystem::TryRunOne(uint32_t selfIndex) {
+    Task task;
+    if (!PopOwn(selfIndex, task) && !Steal(selfIndex, task)) return false;
+    Execute(task);
+    return true;
+}
+
+bool JobSystem::PopOwn(uint32_t index, Task& out) {
+    if (index >= mQueues.size()) return false;
+    WorkQueue& queue = *mQueues[index];
+
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    out = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool JobSystem::Steal(uint32_t thiefIndex, Task& out) {
+    const auto n = static_cast<uint32_t>(mQueues.size());
+    for (uint32_t i = 1; i < n; ++i) {
+        // Start with the neighbour so thieves spread over different victims.
+        WorkQueue& victim = *mQueues[(thiefIndex + i) % n];
+
+        std::lock_guard lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        out = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        mSteals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Task& task) {
+    task.job();
+    if (task.counter) task.counter->mPending.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counts outstanding jobs. Pass one to JobSystem::Run() and wait on it with
+// JobSystem::Wait(); a counter can track any number of jobs and be reused
+// once it reaches zero.
+class JobCounter {
+public:
+    [[nodiscard]] bool     IsDone()  const { return mPending.load(std::memory_order_acquire) == 0; }
+    [[nodiscard]] uint32_t Pending() const { return mPending.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> mPending{ 0 };
+};
+
+// ---------------------------------------------------------------------------
+// JobSystem — fixed pool of worker threads with per-thread work-stealing
+// deques.
+//
+// A thread pushes and pops jobs at the back of its own deque (LIFO, cache
+// warm); idle workers steal from the front of other deques (FIFO, oldest and
+// usually largest work first). Threads that are not workers share deque 0.
+// Wait() never blocks idly: the waiting thread executes queued jobs until
+// its counter drains, so nested Run()/Wait() from inside jobs is safe.
+// Idle workers sleep on an atomic wake epoch rather than spinning.
+// ---------------------------------------------------------------------------
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    JobSystem()                 = default;
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    ~JobSystem();
+
+    // hardware_concurrency() - 1: the caller is the extra thread, it runs
+    // jobs inside Wait().
+    [[nodiscard]] static uint32_t DefaultWorkerCount();
+
+    // workerCount may be 0; every job then runs on the thread that waits.
+    [[nodiscard]] bool Init(uint32_t workerCount = DefaultWorkerCount());
+    void               Shutdown();
+
+    void Run(Job job, JobCounter* counter = nullptr);
+    void Wait(JobCounter& counter);
+
+    // Runs at most one queued job on the calling thread; false when there
+    // was none. Lets a frame loop make progress without blocking when there
+    // are no workers.
+    [[nodiscard]] bool RunPendingJob() { return TryRunOne(ThreadIndex()); }
+
+    // Calls fn(begin, end) over [0, count) in chunks of at most `grain`
+    // items and returns once every chunk has finished.
+    void ParallelFor(uint32_t count, uint32_t grain,
+                     const std::function<void(uint32_t begin, uint32_t end)>& fn);
+
+    // Worker threads plus the calling thread.
+    [[nodiscard]] uint32_t ThreadCount() const { return static_cast<uint32_t>(mWorkers.size()) + 1; }
+
+    // 1..N on this system's workers, 0 on any other thread. Stable for the
+    // lifetime of the thread, so it can index per-thread scratch data.
+    [[nodiscard]] uint32_t ThreadIndex() const;
+
+    // Statistics: jobs taken from another thread's deque.
+    [[nodiscard]] uint64_t StealCount() const { return mSteals.load(std::memory_order_relaxed); }
+
+private:
+    struct Task {
+        Job         job;
+        JobCounter* counter = nullptr;
+    };
+
+    // Mutex-guarded deque; contention is limited to steals, which are rare
+    // compared to the owner's pushes and pops.
+    struct WorkQueue {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerMain(uint32_t index);
+    [[nodiscard]] bool TryRunOne(uint32_t selfIndex);
+    [[nodiscard]] bool PopOwn(uint32_t index, Task& out);
+    [[nodiscard]] bool Steal(uint32_t thiefIndex, Task& out);
+    static void        Execute(Task& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;  // [0] shared, [1..N] per worker
+    std::vector<std::thread>                mWorkers;
+    std::atomic<uint32_t>                   mWakeEpoch{ 0 };
+    std::atomic<bool>                       mStopping{ false };
+    std::atomic<uint64_t>                   mSteals{ 0 };
+};
@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mOpen = std::exchange(other.mOpen, false);
+#if defined(_WIN32)
+        mMapping = std::exchange(other.mMapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(file, &size) || static_cast<uint64_t>(size.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart == 0) { // CreateFileMapping rejects empty files
+        CloseHandle(file);
+        mOpen = true;
+        return true;
+    }
+
+    // The mapping keeps the file open; the handle itself is not needed.
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return false;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    mMapping = mapping;
+    mData    = static_cast<const std::byte*>(view);
+    mSize    = static_cast<std::size_t>(size.QuadPart);
+    mOpen    = true;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (mData) UnmapViewOfFile(mData);
+    if (mMapping) CloseHandle(mMapping);
+    mMapping = nullptr;
+    mData    = nullptr;
+    mSize    = 0;
+    mOpen    = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) { // mmap rejects a zero length
+        ::close(fd);
+        mOpen = true;
+        return true;
+    }
+
+    // The mapping holds its own reference to the file.
+    void* view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    mData = static_cast<const std::byte*>(view);
+    mSize = static_cast<std::size_t>(st.st_size);
+    mOpen = true;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (mData) ::munmap(const_cast<std::byte*>(mData), mSize);
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
+
+#endif
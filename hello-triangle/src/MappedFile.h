@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+// ---------------------------------------------------------------------------
+// MappedFile — read-only memory mapping of a whole file (mmap on POSIX,
+// CreateFileMapping on Windows).
+//
+// Bytes() is valid until Close() or destruction; pages are faulted in on
+// first touch, so opening a large file costs the same as opening a small
+// one. An empty file opens successfully with an empty span.
+// ---------------------------------------------------------------------------
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile() { Close(); }
+
+    [[nodiscard]] bool Open(const std::filesystem::path& path);
+    void               Close();
+
+    [[nodiscard]] bool                       IsOpen() const { return mOpen; }
+    [[nodiscard]] std::span<const std::byte> Bytes()  const { return { mData, mSize }; }
+
+private:
+    const std::byte* mData = nullptr;
+    std::size_t      mSize = 0;
+    bool             mOpen = false;
+#if defined(_WIN32)
+    void* mMapping = nullptr; // HANDLE; the file handle is closed once mapped
+#endif
+};
@@ -1,25 +1,55 @@
 #include "Mesh.h"
 
-bool Mesh::Create(ID3D11Device* device, std::span<const Vertex> vertices) {
-    mStride      = sizeof(Vertex);
+bool Mesh::Create(ID3D11Device* device, std::span<const Vertex> vertices,
+                  std::span<const uint32_t> indices) {
+    return Create(device, std::as_bytes(vertices), sizeof(Vertex), indices);
+}
+
+bool Mesh::Create(ID3D11Device* device, std::span<const std::byte> vertexData, UINT stride,
+                  std::span<const uint32_t> indices) {
+    if (stride == 0 || vertexData.size() % stride != 0) return false;
+
+    mStride      = stride;
     mOffset      = 0;
-    mVertexCount = static_cast<UINT>(vertices.size());
+    mVertexCount = static_cast<UINT>(vertexData.size() / stride);
+    mIndexCount  = static_cast<UINT>(indices.size());
+    mIndexBuffer.Reset();
 
     D3D11_BUFFER_DESC bd = {};
-    bd.ByteWidth         = static_cast<UINT>(vertices.size_bytes());
+    bd.ByteWidth         = static_cast<UINT>(vertexData.size());
     bd.Usage             = D3D11_USAGE_IMMUTABLE;
     bd.BindFlags         = D3D11_BIND_VERTEX_BUFFER;
 
     D3D11_SUBRESOURCE_DATA sd = {};
-    sd.pSysMem                = vertices.data();
+    sd.pSysMem                = vertexData.data();
+
+    if (FAILED(device->CreateBuffer(&bd, &sd, mVertexBuffer.GetAddressOf()))) return false;
+    if (indices.empty()) return true;
 
-    return SUCCEEDED(device->CreateBuffer(&bd, &sd, mVertexBuffer.GetAddressOf()));
+    bd.ByteWidth  = static_cast<UINT>(indices.size_bytes());
+    bd.BindFlags  = D3D11_BIND_INDEX_BUFFER;
+    sd.pSysMem    = indices.data();
+
+    return SUCCEEDED(device->CreateBuffer(&bd, &sd, mIndexBuffer.GetAddressOf()));
 }
 
 void Mesh::Bind(ID3D11DeviceContext* context) const {
     context->IASetVertexBuffers(0, 1, mVertexBuffer.GetAddressOf(), &mStride, &mOffset);
+    if (mIndexBuffer) context->IASetIndexBuffer(mIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
 }
 
 void Mesh::Draw(ID3D11DeviceContext* context) const {
-    context->Draw(mVertexCount, 0);
+    if (mIndexBuffer) {
+        context->DrawIndexed(mIndexCount, 0, 0);
+    } else {
+        context->Draw(mVertexCount, 0);
+    }
+}
+
+void Mesh::DrawInstanced(ID3D11DeviceContext* context, UINT instanceCount, UINT startInstance) const {
+    if (mIndexBuffer) {
+        context->DrawIndexedInstanced(mIndexCount, instanceCount, 0, 0, startInstance);
+    } else {
+        context->DrawInstanced(mVertexCount, instanceCount, 0, startInstance);
+    }
 }
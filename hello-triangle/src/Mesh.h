@@ -3,29 +3,40 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <span>
 
-// Per-vertex data layout (must match D3D11_INPUT_ELEMENT_DESC in D3DApp).
-struct Vertex {
-    float pos[3]; // xyz  (NDC in Phase 1; world-space from Phase 1-4+)
-    float col[4]; // rgba
-    float uv[2];  // texture coordinates (u=left→right, v=top→bottom in D3D)
-};
+#include "Vertex.h"
 
-// Holds an immutable vertex buffer and issues draw calls.
+// Holds an immutable vertex buffer, an optional 32-bit index buffer, and
+// issues draw calls.
 class Mesh {
 public:
-    [[nodiscard]] bool Create(ID3D11Device* device, std::span<const Vertex> vertices);
+    // With no indices the mesh is drawn non-indexed.
+    [[nodiscard]] bool Create(ID3D11Device* device, std::span<const Vertex> vertices,
+                              std::span<const uint32_t> indices = {});
+
+    // Pre-encoded vertices (e.g. EncodeVertices() output, or a MeshPackMesh's
+    // vertexData straight from the mapping) of `stride` bytes each.
+    [[nodiscard]] bool Create(ID3D11Device* device, std::span<const std::byte> vertexData, UINT stride,
+                              std::span<const uint32_t> indices = {});
 
-    // Bind vertex buffer to IA stage (slot 0).
+    // Bind vertex buffer to IA stage (slot 0) and the index buffer, if any.
     void Bind(ID3D11DeviceContext* context) const;
 
-    // Draw all vertices as a non-indexed draw call.
+    // Draw the whole mesh once.
     void Draw(ID3D11DeviceContext* context) const;
 
+    // Draw the whole mesh `instanceCount` times; per-instance streams are
+    // read from `startInstance` on (SV_InstanceID still starts at 0).
+    void DrawInstanced(ID3D11DeviceContext* context, UINT instanceCount, UINT startInstance) const;
+
 private:
     Microsoft::WRL::ComPtr<ID3D11Buffer> mVertexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> mIndexBuffer;
     UINT                                 mStride      = 0;
     UINT                                 mOffset      = 0;
     UINT                                 mVertexCount = 0;
+    UINT                                 mIndexCount  = 0;
 };
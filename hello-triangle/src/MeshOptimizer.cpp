@@ -0,0 +1,396 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "CpuMath.h"
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Vertex hashing (stage 1)
+// ---------------------------------------------------------------------------
+
+uint64_t HashVertex(const Vertex& v) {
+    // Word-wise multiply-xorshift over the bytes: vertices are equal only
+    // when bit-identical.
+    static_assert(sizeof(Vertex) % sizeof(uint32_t) == 0);
+    uint32_t words[sizeof(Vertex) / sizeof(uint32_t)];
+    std::memcpy(words, &v, sizeof(Vertex));
+    uint64_t h = 0;
+    for (uint32_t w : words) {
+        h = (h ^ w) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+// ---------------------------------------------------------------------------
+// Forsyth vertex scores (stage 2)
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t kForsythCacheSize = 32;
+constexpr uint32_t kMaxValenceTable  = 32;
+constexpr float    kCacheDecayPower  = 1.5f;
+constexpr float    kLastTriScore     = 0.75f;
+constexpr float    kValenceScale     = 2.f;
+constexpr float    kValencePower     = 0.5f;
+
+struct ScoreTables {
+    float cache[kForsythCacheSize];
+    float valence[kMaxValenceTable];
+
+    ScoreTables() {
+        for (uint32_t i = 0; i < kForsythCacheSize; ++i) {
+            // The last triangle's three vertices score the same whatever
+            // their order; older entries decay towards the cache's end.
+            cache[i] = i < 3 ? kLastTriScore
+                             : std::pow(1.f - float(i - 3) / float(kForsythCacheSize - 3), kCacheDecayPower);
+        }
+        valence[0] = 0.f;
+        for (uint32_t i = 1; i < kMaxValenceTable; ++i) {
+            valence[i] = kValenceScale * std::pow(float(i), -kValencePower);
+        }
+    }
+};
+
+const ScoreTables& Scores() {
+    static const ScoreTables tables;
+    return tables;
+}
+
+// `cachePosition` < 0: not in the cache. A vertex with no triangles left
+// scores 0, so finished vertices never attract the search.
+float VertexScore(int cachePosition, uint32_t liveTriangles) {
+    if (liveTriangles == 0) return 0.f;
+    const ScoreTables& t = Scores();
+    const float cache   = cachePosition >= 0 ? t.cache[cachePosition] : 0.f;
+    const float valence = liveTriangles < kMaxValenceTable
+                        ? t.valence[liveTriangles]
+                        : kValenceScale * std::pow(float(liveTriangles), -kValencePower);
+    return cache + valence;
+}
+
+// ---------------------------------------------------------------------------
+// Geometry helpers (stage 3)
+// ---------------------------------------------------------------------------
+
+Float3 Position(const Vertex& v) { return { v.pos[0], v.pos[1], v.pos[2] }; }
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Stage 1 — GenerateIndexBuffer
+// ---------------------------------------------------------------------------
+
+void GenerateIndexBuffer(std::span<const Vertex> vertices,
+                         std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices) {
+    outVertices.clear();
+    outIndices.resize(vertices.size());
+
+    // Open addressing, at most half full: slot -> index into outVertices.
+    size_t tableSize = 16;
+    while (tableSize < vertices.size() * 2) tableSize *= 2;
+    std::vector<uint32_t> table(tableSize, ~0u);
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& v    = vertices[i];
+        size_t        slot = static_cast<size_t>(HashVertex(v)) & (tableSize - 1);
+        while (table[slot] != ~0u && std::memcmp(&outVertices[table[slot]], &v, sizeof(Vertex)) != 0) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] == ~0u) {
+            table[slot] = static_cast<uint32_t>(outVertices.size());
+            outVertices.push_back(v);
+        }
+        outIndices[i] = table[slot];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Stage 2 — OptimizeVertexCache (Forsyth)
+//
+// Greedy: emit the highest-scoring triangle among those touching the
+// simulated LRU cache, then rescore only the cached vertices and their
+// triangles. A vertex scores high when it is recently used and has few
+// triangles left (so finishing it frees a cache entry).
+// ---------------------------------------------------------------------------
+
+void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount) {
+    const uint32_t triCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triCount == 0) return;
+
+    // --- Vertex -> triangle adjacency (CSR); live triangles first ---
+    std::vector<uint32_t> liveTris(vertexCount, 0);
+    for (uint32_t i = 0; i < triCount * 3; ++i) ++liveTris[indices[i]];
+
+    std::vector<uint32_t> adjOffset(vertexCount + 1, 0);
+    for (uint32_t v = 0; v < vertexCount; ++v) adjOffset[v + 1] = adjOffset[v] + liveTris[v];
+
+    std::vector<uint32_t> adjacency(triCount * 3);
+    {
+        std::vector<uint32_t> fill(adjOffset.begin(), adjOffset.end() - 1);
+        for (uint32_t i = 0; i < triCount * 3; ++i) adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    // --- Scores ---
+    std::vector<int>   cachePos(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v) vertexScore[v] = VertexScore(-1, liveTris[v]);
+
+    std::vector<float> triScore(triCount);
+    std::vector<bool>  emitted(triCount, false);
+    uint32_t           bestTri   = 0;
+    for (uint32_t t = 0; t < triCount; ++t) {
+        triScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        if (triScore[t] > triScore[bestTri]) bestTri = t;
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triCount * 3);
+
+    uint32_t cache[kForsythCacheSize + 3];
+    uint32_t cacheCount = 0;
+    uint32_t scanCursor = 0; // every triangle before it has been emitted
+
+    for (uint32_t emittedCount = 0; emittedCount < triCount; ++emittedCount) {
+        if (bestTri == ~0u) {
+            // Nothing in the cache has triangles left: restart at the next
+            // unemitted triangle in input order.
+            while (emitted[scanCursor]) ++scanCursor;
+            bestTri = scanCursor;
+        }
+
+        const uint32_t tri[3] = { indices[bestTri * 3], indices[bestTri * 3 + 1], indices[bestTri * 3 + 2] };
+        output.insert(output.end(), tri, tri + 3);
+        emitted[bestTri] = true;
+
+        // Drop the triangle from its vertices' live lists (swap-remove).
+        for (const uint32_t v : tri) {
+            uint32_t* first = &adjacency[adjOffset[v]];
+            uint32_t* last  = first + liveTris[v] - 1;
+            for (uint32_t* it = first; it <= last; ++it) {
+                if (*it == bestTri) {
+                    std::swap(*it, *last);
+                    --liveTris[v];
+                    break;
+                }
+            }
+        }
+
+        // New LRU order: the triangle's vertices, then the old entries.
+        uint32_t newCache[kForsythCacheSize + 3];
+        uint32_t newCount = 0;
+        for (const uint32_t v : tri) {
+            if (std::find(newCache, newCache + newCount, v) == newCache + newCount) newCache[newCount++] = v;
+        }
+        for (uint32_t i = 0; i < cacheCount; ++i) {
+            const uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) newCache[newCount++] = v;
+        }
+
+        // Rescore: entries past kForsythCacheSize fall out of the cache.
+        for (uint32_t i = 0; i < newCount; ++i) {
+            const uint32_t v = newCache[i];
+            cachePos[v]      = i < kForsythCacheSize ? static_cast<int>(i) : -1;
+            vertexScore[v]   = VertexScore(cachePos[v], liveTris[v]);
+        }
+
+        bestTri        = ~0u;
+        float bestScore = -1.f;
+        for (uint32_t i = 0; i < newCount; ++i) {
+            const uint32_t v = newCache[i];
+            for (uint32_t a = adjOffset[v]; a < adjOffset[v] + liveTris[v]; ++a) {
+                const uint32_t t = adjacency[a];
+                triScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]]
+                            + vertexScore[indices[t * 3 + 2]];
+                if (triScore[t] > bestScore) {
+                    bestScore = triScore[t];
+                    bestTri   = t;
+                }
+            }
+        }
+
+        cacheCount = std::min(newCount, kForsythCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+// ---------------------------------------------------------------------------
+// Stage 3 — OptimizeOverdraw
+//
+// Splits the cache-ordered list into clusters, then sorts the clusters so
+// those facing away from the mesh centre (the outer, likely occluding
+// surfaces) draw first. Hard boundaries are where the cache simulation
+// misses all three vertices: the cache is cold there anyway, so moving the
+// cluster costs nothing. Soft boundaries split a hard cluster once its
+// running ACMR is within `threshold` of the whole mesh's.
+//
+// Face normals assume D3D's default front faces: clockwise in a
+// left-handed space, for which cross(b - a, c - a) points outwards.
+// ---------------------------------------------------------------------------
+
+void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const Vertex> vertices, float threshold) {
+    const uint32_t triCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triCount < 2) return;
+
+    constexpr uint32_t kCacheSize = 16;
+    const float        meshAcmr   = AnalyzeVertexCache(indices, static_cast<uint32_t>(vertices.size()),
+                                                       kCacheSize).acmr;
+
+    // --- Clusters: [start of cluster c, start of c + 1) in triangles ---
+    // Two FIFO simulations: one over the whole list finds the hard
+    // boundaries; one restarted cold at every cluster start measures what a
+    // cluster costs wherever the sort puts it.
+    std::vector<uint32_t> clusterStart;
+    {
+        std::vector<uint32_t> meshStamp(vertices.size(), 0), clusterStamp(vertices.size(), 0);
+        uint32_t meshTime      = kCacheSize + 1;
+        uint32_t clusterTime   = kCacheSize + 1;
+        uint32_t clusterMisses = 0;
+        uint32_t clusterBegin  = 0;
+        for (uint32_t t = 0; t < triCount; ++t) {
+            uint32_t meshMisses = 0;
+            for (uint32_t k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                if (meshTime - meshStamp[v] > kCacheSize) {
+                    meshStamp[v] = meshTime++;
+                    ++meshMisses;
+                }
+            }
+
+            const bool hard = meshMisses == 3;
+            const bool soft = t > clusterBegin
+                           && float(clusterMisses) / float(t - clusterBegin) <= meshAcmr * threshold;
+            if (t == 0 || hard || soft) {
+                clusterStart.push_back(t);
+                clusterBegin  = t;
+                clusterMisses = 0;
+                clusterTime  += kCacheSize + 1; // cold cache
+            }
+            for (uint32_t k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                if (clusterTime - clusterStamp[v] > kCacheSize) {
+                    clusterStamp[v] = clusterTime++;
+                    ++clusterMisses;
+                }
+            }
+        }
+    }
+    const uint32_t clusterCount = static_cast<uint32_t>(clusterStart.size());
+    clusterStart.push_back(triCount);
+
+    // --- Per-cluster area-weighted centroid and normal ---
+    struct Cluster {
+        Float3 centroid = { 0.f, 0.f, 0.f }; // sum of area * triangle centroid
+        Float3 normal   = { 0.f, 0.f, 0.f }; // sum of 2 * area * unit normal
+        float  area     = 0.f;
+    };
+    std::vector<Cluster> clusters(clusterCount);
+    Float3 meshCentroid = { 0.f, 0.f, 0.f };
+    float  meshArea     = 0.f;
+
+    for (uint32_t c = 0; c < clusterCount; ++c) {
+        Cluster& cl = clusters[c];
+        for (uint32_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t) {
+            const Float3 a = Position(vertices[indices[t * 3]]);
+            const Float3 b = Position(vertices[indices[t * 3 + 1]]);
+            const Float3 d = Position(vertices[indices[t * 3 + 2]]);
+            const Float3 n = Cross(Sub(b, a), Sub(d, a));
+            const float  area = 0.5f * std::sqrt(Dot(n, n));
+
+            cl.normal    = { cl.normal.x + n.x, cl.normal.y + n.y, cl.normal.z + n.z };
+            cl.centroid  = { cl.centroid.x + area * (a.x + b.x + d.x) / 3.f,
+                             cl.centroid.y + area * (a.y + b.y + d.y) / 3.f,
+                             cl.centroid.z + area * (a.z + b.z + d.z) / 3.f };
+            cl.area     += area;
+        }
+        meshCentroid = { meshCentroid.x + cl.centroid.x, meshCentroid.y + cl.centroid.y,
+                         meshCentroid.z + cl.centroid.z };
+        meshArea    += cl.area;
+    }
+    if (meshArea <= 0.f) return; // all degenerate: nothing to order by
+    meshCentroid = { meshCentroid.x / meshArea, meshCentroid.y / meshArea, meshCentroid.z / meshArea };
+
+    // --- Sort: most outward-facing first (stable, so ties keep cache order) ---
+    std::vector<float> key(clusterCount, 0.f);
+    for (uint32_t c = 0; c < clusterCount; ++c) {
+        const Cluster& cl = clusters[c];
+        if (cl.area <= 0.f) continue;
+        const Float3 centroid = { cl.centroid.x / cl.area, cl.centroid.y / cl.area, cl.centroid.z / cl.area };
+        key[c] = Dot(Sub(centroid, meshCentroid), Normalize(cl.normal));
+    }
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&key](uint32_t a, uint32_t b) { return key[a] > key[b]; });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (const uint32_t c : order) {
+        output.insert(output.end(), indices.begin() + clusterStart[c] * 3, indices.begin() + clusterStart[c + 1] * 3);
+    }
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+// ---------------------------------------------------------------------------
+// Stage 4 — OptimizeVertexFetch
+// ---------------------------------------------------------------------------
+
+uint32_t OptimizeVertexFetch(std::span<Vertex> vertices, std::span<uint32_t> indices) {
+    std::vector<uint32_t> remap(vertices.size(), ~0u);
+    uint32_t next = 0;
+    for (uint32_t& index : indices) {
+        if (remap[index] == ~0u) remap[index] = next++;
+        index = remap[index];
+    }
+
+    std::vector<Vertex> reordered(next);
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        if (remap[v] != ~0u) reordered[remap[v]] = vertices[v];
+    }
+    std::copy(reordered.begin(), reordered.end(), vertices.begin());
+    return next;
+}
+
+void OptimizeMesh(std::span<const Vertex> triangleList,
+                  std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices) {
+    GenerateIndexBuffer(triangleList, outVertices, outIndices);
+    OptimizeVertexCache(outIndices, static_cast<uint32_t>(outVertices.size()));
+    OptimizeOverdraw(outIndices, outVertices);
+    outVertices.resize(OptimizeVertexFetch(outVertices, outIndices));
+}
+
+// ---------------------------------------------------------------------------
+// Statistics
+// ---------------------------------------------------------------------------
+
+VertexCacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize) {
+    VertexCacheStats stats;
+    const uint32_t triCount = static_cast<uint32_t>(indices.size() / 3);
+    if (triCount == 0) return stats;
+
+    // FIFO: a vertex hits while fewer than `cacheSize` misses happened since
+    // it was inserted.
+    std::vector<uint32_t> timestamp(vertexCount, 0);
+    std::vector<bool>     referenced(vertexCount, false);
+    uint32_t time   = cacheSize + 1;
+    uint32_t unique = 0;
+    for (uint32_t i = 0; i < triCount * 3; ++i) {
+        const uint32_t v = indices[i];
+        if (!referenced[v]) {
+            referenced[v] = true;
+            ++unique;
+        }
+        if (time - timestamp[v] > cacheSize) {
+            timestamp[v] = time++;
+            ++stats.transformed;
+        }
+    }
+    stats.acmr = float(stats.transformed) / float(triCount);
+    stats.atvr = float(stats.transformed) / float(unique);
+    return stats;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Vertex.h"
+
+// ---------------------------------------------------------------------------
+// Mesh optimization — turns a triangle list into an indexed mesh ordered for
+// the GPU's front end. Run the stages in this order; each later stage keeps
+// the gains of the earlier ones:
+//
+//   1. GenerateIndexBuffer   merge bit-identical vertices
+//   2. OptimizeVertexCache   triangle order for post-transform cache hits
+//                            (Forsyth's linear-speed algorithm, 32-entry LRU)
+//   3. OptimizeOverdraw      cluster order, front-to-back from outside in
+//                            (Sander et al., "Fast triangle reordering ...")
+//   4. OptimizeVertexFetch   vertex order = first use, for fetch locality
+//
+// OptimizeMesh() runs all four. Indices are 32-bit triangle lists; every
+// function works in place on the index array and is O(n) apart from the
+// cluster sort of stage 3. No D3D dependency, so it runs in tools too.
+// ---------------------------------------------------------------------------
+
+// Stage 1. `outVertices` gets the unique vertices in first-seen order and
+// `outIndices` one index per input vertex.
+void GenerateIndexBuffer(std::span<const Vertex> vertices,
+                         std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices);
+
+// Stage 2. Every index must be < vertexCount.
+void OptimizeVertexCache(std::span<uint32_t> indices, uint32_t vertexCount);
+
+// Stage 3. Reorders clusters of the cache-optimized list; `threshold` caps
+// the ACMR it may give up (1.05 = at most 5% more cache misses).
+void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const Vertex> vertices, float threshold = 1.05f);
+
+// Stage 4. Returns the new vertex count; vertices no triangle references
+// are dropped from the end of `vertices`.
+uint32_t OptimizeVertexFetch(std::span<Vertex> vertices, std::span<uint32_t> indices);
+
+// All four stages on a triangle list.
+void OptimizeMesh(std::span<const Vertex> triangleList,
+                  std::vector<Vertex>& outVertices, std::vector<uint32_t>& outIndices);
+
+// ---------------------------------------------------------------------------
+// Statistics, simulated on a FIFO post-transform cache like the fixed-size
+// caches of most GPUs.
+//   ACMR: transformed vertices per triangle (0.5 is ideal for a large grid,
+//         3 is a cache that never hits)
+//   ATVR: transformed vertices per unique vertex (1 is ideal)
+// ---------------------------------------------------------------------------
+struct VertexCacheStats {
+    uint32_t transformed = 0; // cache misses
+    float    acmr        = 0.f;
+    float    atvr        = 0.f;
+};
+
+[[nodiscard]] VertexCacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount,
+                                                  uint32_t cacheSize = 16);
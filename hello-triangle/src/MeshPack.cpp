@@ -0,0 +1,323 @@
+#include "MeshPack.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <type_traits>
+
+// Sections are used in place, so the records must be plain data laid out the
+// same on every target.
+static_assert(std::endian::native == std::endian::little, "MeshPack sections are little-endian");
+static_assert(std::is_trivially_copyable_v<Meshlet> && sizeof(Meshlet) == 16);
+static_assert(std::is_trivially_copyable_v<MeshletBounds> && sizeof(MeshletBounds) == 44);
+static_assert(std::is_trivially_copyable_v<Vertex>);
+
+namespace {
+
+constexpr char   kMagic[4]   = { 'M', 'P', 'A', 'K' };
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kMeshEntry  = 128;
+constexpr size_t kSections   = 6; // vertices, indices, meshlets, bounds, meshlet vertices, triangles
+
+void PutU32(std::vector<std::byte>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+void PutU64(std::vector<std::byte>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+void PutF32(std::vector<std::byte>& out, float value) { PutU32(out, std::bit_cast<uint32_t>(value)); }
+
+uint32_t GetU32(const std::byte* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return value;
+}
+
+uint64_t GetU64(const std::byte* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return value;
+}
+
+float GetF32(const std::byte* p) { return std::bit_cast<float>(GetU32(p)); }
+
+bool IsPowerOfTwo(uint32_t value) { return value != 0 && (value & (value - 1)) == 0; }
+
+// `count` records of T at `offset`, or false when the range leaves the
+// image or the address is misaligned for T.
+template <class T>
+bool Section(std::span<const std::byte> image, uint64_t offset, uint64_t count, std::span<const T>& out) {
+    const uint64_t size = image.size();
+    if (count > size / sizeof(T)) return false;
+    const uint64_t bytes = count * sizeof(T);
+    if (offset > size || bytes > size - offset) return false;
+    const std::byte* p = image.data() + offset;
+    if (reinterpret_cast<uintptr_t>(p) % alignof(T) != 0) return false;
+    out = { reinterpret_cast<const T*>(p), size_t(count) };
+    return true;
+}
+
+bool ValidEncoding(uint8_t position, uint8_t color, uint8_t texCoord) {
+    return position <= uint8_t(PositionEncoding::Unorm16x4) && color <= uint8_t(ColorEncoding::Unorm8x4) &&
+           texCoord <= uint8_t(TexCoordEncoding::Unorm16x2);
+}
+
+} // namespace
+
+std::span<const Vertex> MeshPackMesh::Vertices() const {
+    if (format.position != PositionEncoding::Float3 || format.color != ColorEncoding::Float4 ||
+        format.texCoord != TexCoordEncoding::Float2)
+        return {};
+    return { reinterpret_cast<const Vertex*>(vertexData.data()), vertexCount };
+}
+
+// ---------------------------------------------------------------------------
+// MeshPack
+// ---------------------------------------------------------------------------
+
+bool MeshPack::Open(const std::filesystem::path& path) {
+    Close();
+    if (!mFile.Open(path)) return false;
+    if (OpenMemory(mFile.Bytes())) return true;
+    mFile.Close();
+    return false;
+}
+
+bool MeshPack::OpenMemory(std::span<const std::byte> image) {
+    mMeshes.clear();
+
+    if (image.size() < kHeaderSize) return false;
+    const std::byte* p = image.data();
+    if (std::memcmp(p, kMagic, sizeof(kMagic)) != 0) return false;
+    if (GetU32(p + 4) != kFormatVersion)             return false;
+
+    const uint32_t count       = GetU32(p + 8);
+    const uint32_t alignment   = GetU32(p + 12);
+    const uint64_t namesOffset = GetU64(p + 16);
+    const uint64_t namesSize   = GetU64(p + 24);
+    // Sections are read in place as u32 / f32 records: only alignments
+    // Build() writes (at least 4), in an image that starts 4-byte aligned.
+    if (!IsPowerOfTwo(alignment) || alignment < 4) return false;
+    if (reinterpret_cast<uintptr_t>(p) % 4 != 0)   return false;
+
+    // Ranges are checked as "offset <= size && length <= size - offset" so
+    // nothing can overflow; Section() does the same for the data.
+    const uint64_t size = image.size();
+    if (uint64_t{ count } > (size - kHeaderSize) / kMeshEntry) return false;
+    if (namesOffset > size || namesSize > size - namesOffset)  return false;
+
+    std::vector<MeshPackMesh> meshes(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const std::byte* e          = p + kHeaderSize + size_t{ i } * kMeshEntry;
+        const uint32_t   nameOffset = GetU32(e);
+        const uint32_t   nameLength = GetU32(e + 4);
+        if (nameLength == 0 || nameOffset > namesSize || nameLength > namesSize - nameOffset) return false;
+
+        MeshPackMesh& m = meshes[i];
+        m.name = { reinterpret_cast<const char*>(p + namesOffset + nameOffset), nameLength };
+        // Strictly ascending: sorted for the binary search, and no duplicates.
+        if (i > 0 && !(meshes[i - 1].name < m.name)) return false;
+
+        m.vertexCount                 = GetU32(e + 8);
+        const uint32_t indexCount     = GetU32(e + 12);
+        const uint32_t meshletCount   = GetU32(e + 16);
+        const uint32_t meshletVerts   = GetU32(e + 20);
+        const uint32_t triangleBytes  = GetU32(e + 24);
+        const auto     encoding       = [e](int k) { return static_cast<uint8_t>(e[28 + k]); };
+        if (!ValidEncoding(encoding(0), encoding(1), encoding(2))) return false;
+        m.format = { PositionEncoding(encoding(0)), ColorEncoding(encoding(1)), TexCoordEncoding(encoding(2)) };
+        m.stride = MakeVertexLayout(m.format).stride;
+
+        for (int c = 0; c < 3; ++c) {
+            m.dequant.scale[c]  = GetF32(e + 32 + 4 * c);
+            m.dequant.offset[c] = GetF32(e + 44 + 4 * c);
+        }
+        m.boundsMin = { GetF32(e + 56), GetF32(e + 60), GetF32(e + 64) };
+        m.boundsMax = { GetF32(e + 68), GetF32(e + 72), GetF32(e + 76) };
+
+        uint64_t offsets[kSections];
+        for (size_t s = 0; s < kSections; ++s) {
+            offsets[s] = GetU64(e + 80 + 8 * s);
+            if (offsets[s] % alignment != 0) return false;
+        }
+        if (!Section(image, offsets[0], uint64_t{ m.vertexCount } * m.stride, m.vertexData)) return false;
+        if (!Section(image, offsets[1], indexCount, m.indices))                               return false;
+        if (!Section(image, offsets[2], meshletCount, m.meshlets))                            return false;
+        if (!Section(image, offsets[3], meshletCount, m.meshletBounds))                       return false;
+        if (!Section(image, offsets[4], meshletVerts, m.meshletVertices))                     return false;
+        if (!Section(image, offsets[5], triangleBytes, m.meshletTriangles))                   return false;
+        if (indexCount % 3 != 0) return false;
+    }
+
+    // Index contents are not checked: that would read every page of the
+    // file. The builder only writes in-range indices.
+    mMeshes = std::move(meshes);
+    return true;
+}
+
+void MeshPack::Close() {
+    mMeshes.clear();
+    mFile.Close();
+}
+
+const MeshPackMesh* MeshPack::Find(std::string_view name) const {
+    const auto it = std::lower_bound(mMeshes.begin(), mMeshes.end(), name,
+                                     [](const MeshPackMesh& m, std::string_view n) { return m.name < n; });
+    if (it != mMeshes.end() && it->name == name) return &*it;
+    return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// MeshPackBuilder
+// ---------------------------------------------------------------------------
+
+bool MeshPackBuilder::Add(std::string_view name, std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+                          const VertexFormat& format, const MeshletMesh* meshlets) {
+    if (name.empty() || name.size() > UINT32_MAX)           return false;
+    if (vertices.size() > UINT32_MAX || indices.size() > UINT32_MAX || indices.size() % 3 != 0) return false;
+    for (uint32_t index : indices)
+        if (index >= vertices.size()) return false;
+    if (mNames.contains(std::string(name))) return false;
+
+    Entry e;
+    e.name        = name;
+    e.format      = format;
+    e.dequant     = ComputePositionDequant(vertices, format.position);
+    e.vertexCount = static_cast<uint32_t>(vertices.size());
+    e.vertexData.resize(vertices.size() * MakeVertexLayout(format).stride);
+    if (!EncodeVertices(vertices, format, e.dequant, e.vertexData)) return false;
+    e.indices.assign(indices.begin(), indices.end());
+    if (meshlets) e.meshlets = *meshlets;
+
+    if (!vertices.empty()) {
+        e.boundsMin = e.boundsMax = { vertices[0].pos[0], vertices[0].pos[1], vertices[0].pos[2] };
+        for (const Vertex& v : vertices) {
+            e.boundsMin = { std::min(e.boundsMin.x, v.pos[0]), std::min(e.boundsMin.y, v.pos[1]),
+                            std::min(e.boundsMin.z, v.pos[2]) };
+            e.boundsMax = { std::max(e.boundsMax.x, v.pos[0]), std::max(e.boundsMax.y, v.pos[1]),
+                            std::max(e.boundsMax.z, v.pos[2]) };
+        }
+    }
+
+    mNames.emplace(name);
+    mMeshes.push_back(std::move(e));
+    return true;
+}
+
+std::vector<std::byte> MeshPackBuilder::Build(uint32_t alignment) const {
+    if (!IsPowerOfTwo(alignment) || alignment < 4) return {};
+
+    std::vector<const Entry*> sorted;
+    sorted.reserve(mMeshes.size());
+    for (const Entry& e : mMeshes) sorted.push_back(&e);
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+    const auto align = [alignment](uint64_t offset) {
+        return (offset + alignment - 1) & ~uint64_t{ alignment - 1 };
+    };
+
+    // --- Layout: per mesh, its sections as (bytes, source) ---
+    uint64_t namesSize = 0;
+    for (const Entry* e : sorted) namesSize += e->name.size();
+    if (namesSize > UINT32_MAX) return {}; // name offsets are 32-bit
+    const uint64_t namesOffset = kHeaderSize + sorted.size() * kMeshEntry;
+
+    struct Chunk {
+        const void* data;
+        uint64_t    bytes;
+    };
+    std::vector<Chunk>    chunks;
+    std::vector<uint64_t> offsets;
+    chunks.reserve(sorted.size() * kSections);
+    offsets.reserve(sorted.size() * kSections);
+    uint64_t end = namesOffset + namesSize;
+    for (const Entry* e : sorted) {
+        const MeshletMesh& m = e->meshlets;
+        const Chunk        sections[kSections] = {
+            { e->vertexData.data(), e->vertexData.size() },
+            { e->indices.data(), e->indices.size() * sizeof(uint32_t) },
+            { m.meshlets.data(), m.meshlets.size() * sizeof(Meshlet) },
+            { m.bounds.data(), m.bounds.size() * sizeof(MeshletBounds) },
+            { m.vertices.data(), m.vertices.size() * sizeof(uint32_t) },
+            { m.triangles.data(), m.triangles.size() },
+        };
+        for (const Chunk& c : sections) {
+            offsets.push_back(align(end));
+            chunks.push_back(c);
+            end = offsets.back() + c.bytes;
+        }
+    }
+
+    // --- Header, mesh table, names ---
+    std::vector<std::byte> out;
+    out.reserve(end);
+    for (char c : kMagic) out.push_back(static_cast<std::byte>(c));
+    PutU32(out, MeshPack::kFormatVersion);
+    PutU32(out, static_cast<uint32_t>(sorted.size()));
+    PutU32(out, alignment);
+    PutU64(out, namesOffset);
+    PutU64(out, namesSize);
+
+    uint32_t nameOffset = 0;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const Entry&       e = *sorted[i];
+        const MeshletMesh& m = e.meshlets;
+        PutU32(out, nameOffset);
+        PutU32(out, static_cast<uint32_t>(e.name.size()));
+        PutU32(out, e.vertexCount);
+        PutU32(out, static_cast<uint32_t>(e.indices.size()));
+        PutU32(out, static_cast<uint32_t>(m.meshlets.size()));
+        PutU32(out, static_cast<uint32_t>(m.vertices.size()));
+        PutU32(out, static_cast<uint32_t>(m.triangles.size()));
+        out.push_back(static_cast<std::byte>(e.format.position));
+        out.push_back(static_cast<std::byte>(e.format.color));
+        out.push_back(static_cast<std::byte>(e.format.texCoord));
+        out.push_back(std::byte{ 0 });
+        for (float f : e.dequant.scale) PutF32(out, f);
+        for (float f : e.dequant.offset) PutF32(out, f);
+        for (float f : { e.boundsMin.x, e.boundsMin.y, e.boundsMin.z, e.boundsMax.x, e.boundsMax.y, e.boundsMax.z })
+            PutF32(out, f);
+        for (size_t s = 0; s < kSections; ++s) PutU64(out, offsets[i * kSections + s]);
+        nameOffset += static_cast<uint32_t>(e.name.size());
+    }
+    for (const Entry* e : sorted) {
+        for (char c : e->name) out.push_back(static_cast<std::byte>(c));
+    }
+
+    // --- Sections, zero padded ---
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        out.resize(offsets[i], std::byte{ 0 });
+        const std::byte* data = static_cast<const std::byte*>(chunks[i].data);
+        if (chunks[i].bytes > 0) out.insert(out.end(), data, data + chunks[i].bytes);
+    }
+    return out;
+}
+
+bool MeshPackBuilder::Write(const std::filesystem::path& path, uint32_t alignment) const {
+    const std::vector<std::byte> image = Build(alignment);
+    if (image.empty()) return false;
+
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    // close() flushes: a failure there (e.g. a full disk) must not replace `path`.
+    file.close();
+
+    std::error_code ec;
+    if (!file) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
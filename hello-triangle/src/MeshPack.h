@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "CpuMath.h"
+#include "MappedFile.h"
+#include "MeshletBuilder.h"
+#include "VertexFormat.h"
+
+// ---------------------------------------------------------------------------
+// MeshPack — meshes in one memory-mapped file, stored exactly as the GPU and
+// the culling code consume them, so loading is a header check plus pointers
+// into the mapping. Vertex data goes straight to Mesh::Create() or a memcpy
+// into upload memory; nothing is parsed, converted or copied on the way.
+// Layout (little-endian, the host order of every target):
+//
+//   char[4] magic "MPAK"            u32 kFormatVersion
+//   u32     mesh count              u32 section alignment (power of two, >= 4)
+//   u64     names offset            u64 names size
+//   mesh table, sorted by name (byte-wise), 128 bytes per mesh:
+//     u32 name offset, u32 name length
+//     u32 vertex count, u32 index count
+//     u32 meshlet count, u32 meshlet vertex count, u32 meshlet triangle bytes
+//     u8  position / colour / texcoord encoding, u8 zero
+//     f32 dequant scale[3], offset[3]
+//     f32 bounds min[3], max[3]
+//     u64 offsets of the vertex, index, meshlet, meshlet bounds,
+//         meshlet vertex and meshlet triangle sections
+//   names, concatenated
+//   sections, each at a multiple of the section alignment
+//
+// The meshlet sections hold Meshlet / MeshletBounds records as laid out in
+// MeshletBuilder.h; a change there needs a kFormatVersion bump.
+// ---------------------------------------------------------------------------
+
+// One mesh; every span points into the pack.
+struct MeshPackMesh {
+    std::string_view               name;
+    VertexFormat                   format;
+    PositionDequant                dequant;
+    Float3                         boundsMin = {}; // decoded positions
+    Float3                         boundsMax = {};
+    uint32_t                       vertexCount = 0;
+    uint32_t                       stride      = 0; // MakeVertexLayout(format).stride
+    std::span<const std::byte>     vertexData;      // vertexCount * stride
+    std::span<const uint32_t>      indices;
+    std::span<const Meshlet>       meshlets;        // all empty when built without meshlets
+    std::span<const MeshletBounds> meshletBounds;
+    std::span<const uint32_t>      meshletVertices;
+    std::span<const uint8_t>       meshletTriangles;
+
+    // The vertices as Vertex, for kFullVertexFormat meshes; empty otherwise.
+    [[nodiscard]] std::span<const Vertex> Vertices() const;
+};
+
+class MeshPack {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    MeshPack() = default;
+    MeshPack(const MeshPack&) = delete;
+    MeshPack& operator=(const MeshPack&) = delete;
+
+    // Maps `path`; any previous pack is closed first. Spans handed out
+    // earlier become invalid.
+    [[nodiscard]] bool Open(const std::filesystem::path& path);
+
+    // Uses an image already in memory (e.g. from MeshPackBuilder); `image`
+    // must outlive the pack. Sections are used in place, so the image must
+    // start at least 4-byte aligned, as mappings and heap blocks do; false
+    // otherwise.
+    [[nodiscard]] bool OpenMemory(std::span<const std::byte> image);
+
+    void Close();
+
+    // Null when absent.
+    [[nodiscard]] const MeshPackMesh* Find(std::string_view name) const;
+
+    [[nodiscard]] uint32_t            MeshCount()      const { return static_cast<uint32_t>(mMeshes.size()); }
+    [[nodiscard]] const MeshPackMesh& Mesh(uint32_t i) const { return mMeshes[i]; } // ascending names
+
+private:
+    MappedFile                mFile;
+    std::vector<MeshPackMesh> mMeshes;
+};
+
+// ---------------------------------------------------------------------------
+// MeshPackBuilder — encodes meshes and writes a MeshPack image. Names are
+// unique; the output depends only on the set of meshes, not the order they
+// were added in.
+// ---------------------------------------------------------------------------
+class MeshPackBuilder {
+public:
+    // 16: enough for every record type, and the D3D12 upload placement
+    // alignment of buffer data.
+    static constexpr uint32_t kDefaultAlignment = 16;
+
+    // Encodes `vertices` to `format` (see EncodeVertices()) and copies
+    // `indices` and `meshlets`, which must have been built for them. False
+    // for an empty or duplicate name, an index out of range or a failed
+    // encode.
+    [[nodiscard]] bool Add(std::string_view name, std::span<const Vertex> vertices, std::span<const uint32_t> indices,
+                           const VertexFormat& format = kFullVertexFormat, const MeshletMesh* meshlets = nullptr);
+
+    // Empty when `alignment` is not a power of two of at least 4.
+    [[nodiscard]] std::vector<std::byte> Build(uint32_t alignment = kDefaultAlignment) const;
+
+    // Writes a temporary file and renames it over `path`.
+    [[nodiscard]] bool Write(const std::filesystem::path& path, uint32_t alignment = kDefaultAlignment) const;
+
+    [[nodiscard]] size_t MeshCount() const { return mMeshes.size(); }
+
+private:
+    struct Entry {
+        std::string            name;
+        VertexFormat           format;
+        PositionDequant        dequant;
+        Float3                 boundsMin = {};
+        Float3                 boundsMax = {};
+        uint32_t               vertexCount = 0;
+        std::vector<std::byte> vertexData;
+        std::vector<uint32_t>  indices;
+        MeshletMesh            meshlets;
+    };
+    std::vector<Entry>              mMeshes;
+    std::unordered_set<std::string> mNames;
+};
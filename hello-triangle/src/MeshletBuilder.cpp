@@ -0,0 +1,187 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "JobSystem.h"
+
+namespace {
+
+constexpr uint8_t kNotInMeshlet = 0xFF;
+
+// Normals spreading wider than this (dot with the axis below it, ~84 deg)
+// give a cone that never culls anything.
+constexpr float kMinConeDot = 0.1f;
+
+Float3 Position(const Vertex& v) { return { v.pos[0], v.pos[1], v.pos[2] }; }
+
+Float3 Add(const Float3& a, const Float3& b)  { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+Float3 Scale(const Float3& a, float s)        { return { a.x * s, a.y * s, a.z * s }; }
+
+// ---------------------------------------------------------------------------
+// Bounds
+// ---------------------------------------------------------------------------
+
+MeshletBounds ComputeBounds(const MeshletMesh& mesh, const Meshlet& m, std::span<const Vertex> vertices) {
+    MeshletBounds b;
+
+    // Sphere around the box of the meshlet's vertices.
+    const uint32_t* local = mesh.vertices.data() + m.vertexOffset;
+    Float3          lo = Position(vertices[local[0]]), hi = lo;
+    for (uint32_t i = 1; i < m.vertexCount; ++i) {
+        const Float3 p = Position(vertices[local[i]]);
+        lo = { std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z) };
+        hi = { std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z) };
+    }
+    b.center = Scale(Add(lo, hi), 0.5f);
+    float radiusSq = 0.f;
+    for (uint32_t i = 0; i < m.vertexCount; ++i) {
+        const Float3 d = Sub(Position(vertices[local[i]]), b.center);
+        radiusSq = std::max(radiusSq, Dot(d, d));
+    }
+    b.radius = std::sqrt(radiusSq);
+
+    // Normal cone. Outward normals follow the CW front faces of the
+    // left-handed convention (same as OptimizeOverdraw()).
+    const uint8_t* tris = mesh.triangles.data() + m.triangleOffset;
+    Float3         normals[kMaxMeshletTriangles];
+    Float3         corners[kMaxMeshletTriangles];
+    uint32_t       normalCount = 0;
+    Float3         sum         = { 0.f, 0.f, 0.f };
+    for (uint32_t t = 0; t < m.triangleCount; ++t) {
+        const Float3 p0 = Position(vertices[local[tris[3 * t + 0]]]);
+        const Float3 p1 = Position(vertices[local[tris[3 * t + 1]]]);
+        const Float3 p2 = Position(vertices[local[tris[3 * t + 2]]]);
+        const Float3 n  = Cross(Sub(p1, p0), Sub(p2, p0));
+        if (Dot(n, n) == 0.f) continue; // degenerate: no facing
+        normals[normalCount] = Normalize(n);
+        corners[normalCount] = p0;
+        sum = Add(sum, normals[normalCount]);
+        ++normalCount;
+    }
+
+    b.coneApex = b.center;
+    b.coneAxis = { 0.f, 0.f, 0.f };
+    if (normalCount == 0 || Dot(sum, sum) == 0.f) return b;
+
+    const Float3 axis   = Normalize(sum);
+    float        minDot = 1.f;
+    for (uint32_t i = 0; i < normalCount; ++i) minDot = std::min(minDot, Dot(axis, normals[i]));
+    b.coneAxis = axis;
+    if (minDot <= kMinConeDot) return b;
+
+    // Apex: the point on the axis behind every triangle's plane, so the
+    // cone test is conservative for the whole cluster.
+    float maxT = 0.f;
+    for (uint32_t i = 0; i < normalCount; ++i) {
+        const float t = Dot(Sub(b.center, corners[i]), normals[i]) / Dot(axis, normals[i]);
+        maxT = std::max(maxT, t);
+    }
+    b.coneApex   = Sub(b.center, Scale(axis, maxT));
+    b.coneCutoff = std::sqrt(1.f - minDot * minDot);
+    return b;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Build
+// ---------------------------------------------------------------------------
+
+void BuildMeshlets(std::span<const Vertex> vertices, std::span<const uint32_t> indices, MeshletMesh& out) {
+    out.meshlets.clear();
+    out.bounds.clear();
+    out.vertices.clear();
+    out.triangles.clear();
+
+    const size_t triangleCount = indices.size() / 3;
+    // Lower bounds; a cache-ordered mesh needs about one vertex per triangle.
+    out.meshlets.reserve(triangleCount / kMaxMeshletTriangles + 1);
+    out.vertices.reserve(triangleCount);
+    out.triangles.reserve(triangleCount * 3);
+
+    std::vector<uint8_t> localIndex(vertices.size(), kNotInMeshlet); // mesh vertex -> meshlet-local
+    Meshlet              current;
+
+    const auto flush = [&] {
+        if (current.triangleCount == 0) return;
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            localIndex[out.vertices[current.vertexOffset + i]] = kNotInMeshlet;
+        }
+        out.meshlets.push_back(current);
+        current = { static_cast<uint32_t>(out.vertices.size()), static_cast<uint32_t>(out.triangles.size()), 0, 0 };
+    };
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* tri = indices.data() + 3 * t;
+
+        const uint32_t newVertices = (localIndex[tri[0]] == kNotInMeshlet)
+                                   + (localIndex[tri[1]] == kNotInMeshlet && tri[1] != tri[0])
+                                   + (localIndex[tri[2]] == kNotInMeshlet && tri[2] != tri[0] && tri[2] != tri[1]);
+        if (current.vertexCount + newVertices > kMaxMeshletVertices ||
+            current.triangleCount == kMaxMeshletTriangles) {
+            flush();
+        }
+
+        for (int c = 0; c < 3; ++c) {
+            uint8_t& local = localIndex[tri[c]];
+            if (local == kNotInMeshlet) {
+                local = static_cast<uint8_t>(current.vertexCount++);
+                out.vertices.push_back(tri[c]);
+            }
+            out.triangles.push_back(local);
+        }
+        ++current.triangleCount;
+    }
+    flush();
+
+    out.bounds.reserve(out.meshlets.size());
+    for (const Meshlet& m : out.meshlets) out.bounds.push_back(ComputeBounds(out, m, vertices));
+}
+
+void BuildMeshlets(JobSystem& jobs, std::span<const MeshletSource> meshes, std::span<MeshletMesh> out) {
+    const uint32_t count = static_cast<uint32_t>(std::min(meshes.size(), out.size()));
+    jobs.ParallelFor(count, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) BuildMeshlets(meshes[i].vertices, meshes[i].indices, out[i]);
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Culling
+// ---------------------------------------------------------------------------
+
+void CullMeshlets(const MeshletMesh& mesh, const Frustum& frustum, const Float3& cameraPosition,
+                  std::vector<uint32_t>& visible) {
+    visible.clear();
+    for (uint32_t i = 0; i < mesh.bounds.size(); ++i) {
+        const MeshletBounds& b = mesh.bounds[i];
+
+        bool inside = true;
+        for (const float* p : frustum.planes) {
+            inside &= p[0] * b.center.x + p[1] * b.center.y + p[2] * b.center.z + p[3] >= -b.radius;
+        }
+        if (!inside) continue;
+
+        if (b.coneCutoff < 1.f) {
+            const Float3 view = Normalize(Sub(b.coneApex, cameraPosition));
+            if (Dot(view, b.coneAxis) >= b.coneCutoff) continue; // back-facing cluster
+        }
+        visible.push_back(i);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Statistics
+// ---------------------------------------------------------------------------
+
+MeshletStats AnalyzeMeshlets(const MeshletMesh& mesh) {
+    MeshletStats s;
+    s.meshletCount = static_cast<uint32_t>(mesh.meshlets.size());
+    if (s.meshletCount == 0) return s;
+
+    const double triangles = double(mesh.triangles.size()) / 3.0;
+    s.vertexFill     = static_cast<float>(double(mesh.vertices.size()) / (double(s.meshletCount) * kMaxMeshletVertices));
+    s.triangleFill   = static_cast<float>(triangles / (double(s.meshletCount) * kMaxMeshletTriangles));
+    s.verticesPerTri = static_cast<float>(double(mesh.vertices.size()) / triangles);
+    return s;
+}
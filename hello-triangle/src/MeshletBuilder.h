@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CpuMath.h"
+#include "FrustumCuller.h" // Frustum
+#include "Vertex.h"
+
+class JobSystem;
+
+// ---------------------------------------------------------------------------
+// Meshlets — a mesh split into small clusters for mesh-shader / GPU-driven
+// rendering. Each meshlet references at most kMaxMeshletVertices vertices of
+// the mesh and at most kMaxMeshletTriangles triangles, stored as 8-bit
+// indices into its own vertex list (the layout mesh shaders consume).
+//
+// The builder scans the triangles in index order and starts a new meshlet
+// when the next triangle would overflow either limit. Run it on the output
+// of OptimizeMesh(): the vertex-cache order keeps neighbouring triangles
+// together, which is what fills the clusters.
+//
+// Every meshlet gets culling data: a bounding sphere and a normal cone
+// (apex, axis, cutoff). CullMeshlets() is the CPU reference of the test a
+// task / amplification shader would run.
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t kMaxMeshletVertices  = 64;
+constexpr uint32_t kMaxMeshletTriangles = 124;
+
+struct Meshlet {
+    uint32_t vertexOffset   = 0; // first entry in MeshletMesh::vertices
+    uint32_t triangleOffset = 0; // first byte in MeshletMesh::triangles
+    uint32_t vertexCount    = 0;
+    uint32_t triangleCount  = 0;
+};
+
+// The meshlet is back-facing from every point p with
+//   dot(normalize(coneApex - p), coneAxis) >= coneCutoff.
+// coneCutoff = 1 when the normals spread too far for the cone to cull.
+struct MeshletBounds {
+    Float3 center;
+    float  radius = 0.f;
+    Float3 coneApex;
+    Float3 coneAxis;
+    float  coneCutoff = 1.f;
+};
+
+struct MeshletMesh {
+    std::vector<Meshlet>       meshlets;
+    std::vector<MeshletBounds> bounds;    // one per meshlet
+    std::vector<uint32_t>      vertices;  // meshlet-local vertex -> mesh vertex index
+    std::vector<uint8_t>       triangles; // three meshlet-local indices per triangle
+};
+
+// An indexed triangle list; the spans must outlive the build.
+struct MeshletSource {
+    std::span<const Vertex>   vertices;
+    std::span<const uint32_t> indices;
+};
+
+// Replaces the contents of `out`. Every index must be < vertices.size().
+void BuildMeshlets(std::span<const Vertex> vertices, std::span<const uint32_t> indices, MeshletMesh& out);
+
+// One job per mesh on `jobs`; returns once all of `out` (same size as
+// `meshes`) is built.
+void BuildMeshlets(JobSystem& jobs, std::span<const MeshletSource> meshes, std::span<MeshletMesh> out);
+
+// ---------------------------------------------------------------------------
+// Cluster culling, CPU reference. `frustum` and `cameraPosition` are in the
+// mesh's space (Frustum::FromViewProjection(world * viewProj) gives the
+// object-space planes). `visible` is overwritten with the indices of the
+// meshlets whose sphere intersects the frustum and whose cone does not
+// face away from the camera.
+// ---------------------------------------------------------------------------
+void CullMeshlets(const MeshletMesh& mesh, const Frustum& frustum, const Float3& cameraPosition,
+                  std::vector<uint32_t>& visible);
+
+// Cluster fill: how close the meshlets come to the limits (1 = every
+// meshlet full).
+struct MeshletStats {
+    uint32_t meshletCount   = 0;
+    float    vertexFill     = 0.f; // mean vertexCount / kMaxMeshletVertices
+    float    triangleFill   = 0.f; // mean triangleCount / kMaxMeshletTriangles
+    float    verticesPerTri = 0.f; // meshlet vertices per triangle (duplication at borders)
+};
+
+[[nodiscard]] MeshletStats AnalyzeMeshlets(const MeshletMesh& mesh);
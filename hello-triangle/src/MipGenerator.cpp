@@ -0,0 +1,332 @@
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#include "CpuMath.h"
+#include "JobSystem.h"
+#include "Simd.h"
+
+namespace {
+
+// Pixels per row-range job.
+constexpr uint32_t kPixelsPerJob = 1u << 16;
+
+// ---------------------------------------------------------------------------
+// sRGB transfer
+// ---------------------------------------------------------------------------
+
+float SrgbToLinear(float s) {
+    return s <= 0.04045f ? s / 12.92f : std::pow((s + 0.055f) / 1.055f, 2.4f);
+}
+
+// Exact decode per 8-bit code.
+const std::array<float, 256>& SrgbDecodeTable() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> t;
+        for (int i = 0; i < 256; ++i) t[i] = SrgbToLinear(i / 255.f);
+        return t;
+    }();
+    return table;
+}
+
+// Linear -> sRGB for x in [0, 1]. x^(1/2.4) as a fit over three nested
+// square roots: within 0.25 of an 8-bit code of the exact curve.
+Float8 LinearToSrgb(Float8 x) {
+    const Float8 s1 = Sqrt(x), s2 = Sqrt(s1), s3 = Sqrt(s2);
+    const Float8 curve = Float8(0.662002687f) * s1 + Float8(0.684122060f) * s2
+                       - Float8(0.323583601f) * s3 - Float8(0.0225411470f) * x;
+    return Select(CmpLe(x, Float8(0.0031308f)), x * Float8(12.92f), curve);
+}
+
+// ---------------------------------------------------------------------------
+// Filter tables: for each output texel along one axis, source indices and
+// normalized weights.
+// ---------------------------------------------------------------------------
+
+struct FilterBank {
+    std::vector<uint32_t> first; // per output: first tap, size dst + 1
+    std::vector<uint32_t> index;
+    std::vector<float>    weight;
+};
+
+float Lanczos2(float x) {
+    x = std::fabs(x);
+    if (x < 1e-6f) return 1.f;
+    if (x >= 2.f) return 0.f;
+    const float px = kPi * x;
+    return 2.f * std::sin(px) * std::sin(px * 0.5f) / (px * px);
+}
+
+uint32_t Address(int64_t i, uint32_t size, MipAddress address) {
+    const int64_t n = size;
+    if (address == MipAddress::Wrap) return static_cast<uint32_t>(((i % n) + n) % n);
+    return static_cast<uint32_t>(std::clamp<int64_t>(i, 0, n - 1));
+}
+
+FilterBank MakeFilterBank(uint32_t src, uint32_t dst, MipFilter filter, MipAddress address) {
+    FilterBank bank;
+    bank.first.reserve(dst + 1);
+    const double scale = double(src) / double(dst); // >= 1
+
+    for (uint32_t x = 0; x < dst; ++x) {
+        bank.first.push_back(static_cast<uint32_t>(bank.index.size()));
+        const size_t begin = bank.index.size();
+
+        if (filter == MipFilter::Box) {
+            // Coverage of [x, x + 1) * scale by each source texel.
+            const double lo = x * scale, hi = (x + 1) * scale;
+            for (int64_t s = static_cast<int64_t>(std::floor(lo)); s < hi; ++s) {
+                const double w = std::min<double>(hi, s + 1) - std::max<double>(lo, s);
+                if (w <= 1e-9) continue;
+                bank.index.push_back(Address(s, src, address));
+                bank.weight.push_back(static_cast<float>(w));
+            }
+        } else {
+            // Kernel stretched by `scale` around the output texel's centre.
+            const double center = (x + 0.5) * scale - 0.5, radius = 2.0 * scale;
+            for (int64_t s = static_cast<int64_t>(std::ceil(center - radius)); s <= center + radius; ++s) {
+                const float w = Lanczos2(static_cast<float>((s - center) / scale));
+                if (w == 0.f) continue;
+                bank.index.push_back(Address(s, src, address));
+                bank.weight.push_back(w);
+            }
+        }
+
+        float sum = 0.f;
+        for (size_t i = begin; i < bank.weight.size(); ++i) sum += bank.weight[i];
+        for (size_t i = begin; i < bank.weight.size(); ++i) bank.weight[i] /= sum;
+    }
+    bank.first.push_back(static_cast<uint32_t>(bank.index.size()));
+    return bank;
+}
+
+// ---------------------------------------------------------------------------
+// Linear float working images: RGBA per texel, rows padded to whole Float8s.
+// ---------------------------------------------------------------------------
+
+struct LinearImage {
+    uint32_t           width  = 0;
+    uint32_t           height = 0;
+    size_t             stride = 0; // floats per row
+    std::vector<float> texels;
+
+    static size_t Stride(uint32_t w) { return (size_t(w) * 4 + kSimdWidth - 1) / kSimdWidth * kSimdWidth; }
+
+    // Keeps old contents: only the first width * 4 floats of a row are
+    // ever read back, the padding just has to be finite.
+    void Resize(uint32_t w, uint32_t h) {
+        width  = w;
+        height = h;
+        stride = Stride(w);
+        texels.resize(stride * h);
+    }
+    float*       Row(uint32_t y)       { return texels.data() + y * stride; }
+    const float* Row(uint32_t y) const { return texels.data() + y * stride; }
+};
+
+// Runs fn(begin, end) over row ranges, on `jobs` when there is one.
+template <class Fn>
+void ForRows(JobSystem* jobs, uint32_t rows, uint32_t width, const Fn& fn) {
+    if (!jobs) {
+        fn(0u, rows);
+        return;
+    }
+    const uint32_t grain = std::max(1u, kPixelsPerJob / std::max(1u, width));
+    jobs->ParallelFor(rows, grain, fn);
+}
+
+void DecodeRow(const std::byte* src, uint32_t width, MipFormat format, float* dst) {
+    const size_t n = size_t(width) * 4;
+    switch (format) {
+    case MipFormat::Rgba32Float:
+        std::memcpy(dst, src, n * sizeof(float));
+        break;
+    case MipFormat::Rgba8Unorm:
+        for (size_t i = 0; i < n; ++i) dst[i] = std::to_integer<uint8_t>(src[i]) * (1.f / 255.f);
+        break;
+    case MipFormat::Rgba8UnormSrgb: {
+        const std::array<float, 256>& table = SrgbDecodeTable();
+        for (size_t i = 0; i < n; i += 4) {
+            dst[i + 0] = table[std::to_integer<uint8_t>(src[i + 0])];
+            dst[i + 1] = table[std::to_integer<uint8_t>(src[i + 1])];
+            dst[i + 2] = table[std::to_integer<uint8_t>(src[i + 2])];
+            dst[i + 3] = std::to_integer<uint8_t>(src[i + 3]) * (1.f / 255.f);
+        }
+        break;
+    }
+    }
+}
+
+// `src` holds whole Float8s (the padded row); writes width * 4 components.
+void EncodeRow(const float* src, uint32_t width, MipFormat format, std::byte* dst) {
+    const size_t n = size_t(width) * 4;
+    if (format == MipFormat::Rgba32Float) {
+        std::memcpy(dst, src, n * sizeof(float));
+        return;
+    }
+
+    // Lanes 3 and 7 are alpha: two RGBA texels per Float8.
+    alignas(32) static constexpr float kAlphaLanes[kSimdWidth] = { 0, 0, 0, 1, 0, 0, 0, 1 };
+    const Float8 alpha = CmpGt(Float8::Load(kAlphaLanes), Float8(0.5f));
+    const bool   srgb  = format == MipFormat::Rgba8UnormSrgb;
+
+    int32_t q[kSimdWidth];
+    for (size_t i = 0; i < n; i += kSimdWidth) {
+        Float8 v = Clamp(Float8::Load(src + i), Float8(0.f), Float8(1.f));
+        if (srgb) v = Select(alpha, v, LinearToSrgb(v));
+        StoreInt(v * Float8(255.f), q);
+        const size_t count = std::min<size_t>(kSimdWidth, n - i);
+        for (size_t k = 0; k < count; ++k) dst[i + k] = static_cast<std::byte>(q[k]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Level 1 reads the input directly: its rows are decoded on demand into a
+// small per-job cache instead of converting the whole (largest) level to
+// float first. A source row feeds at most a handful of consecutive output
+// rows, so each is decoded about once.
+// ---------------------------------------------------------------------------
+
+class DecodedRows {
+public:
+    static constexpr uint32_t kSlots = 16; // > the most taps any filter uses (13)
+
+    DecodedRows(const std::byte* image, uint32_t width, MipFormat format, size_t stride)
+        : mImage(image), mWidth(width), mFormat(format), mStride(stride), mRows(kSlots * stride, 0.f) {
+        mRowOf.fill(kNone);
+        mLastUse.fill(0);
+    }
+
+    // Valid until a call with a later `use`; calls with the same `use` never
+    // evict each other's rows.
+    const float* Row(uint32_t y, uint32_t use) {
+        uint32_t victim = 0;
+        for (uint32_t s = 0; s < kSlots; ++s) {
+            if (mRowOf[s] == y) {
+                mLastUse[s] = use;
+                return mRows.data() + s * mStride;
+            }
+            if (mLastUse[s] < mLastUse[victim]) victim = s;
+        }
+        mRowOf[victim]   = y;
+        mLastUse[victim] = use;
+        float* row       = mRows.data() + victim * mStride;
+        DecodeRow(mImage + size_t(y) * mWidth * MipBytesPerPixel(mFormat), mWidth, mFormat, row);
+        return row;
+    }
+
+private:
+    static constexpr uint32_t kNone = ~0u;
+
+    const std::byte*               mImage;
+    uint32_t                       mWidth;
+    MipFormat                      mFormat;
+    size_t                         mStride;
+    std::vector<float>             mRows;
+    std::array<uint32_t, kSlots>   mRowOf;
+    std::array<uint32_t, kSlots>   mLastUse;
+};
+
+// ---------------------------------------------------------------------------
+// One level: rows [rowBegin, rowEnd) of `dst`. rowOf(y, use) returns source
+// row y as linear floats, `stride` floats long.
+// ---------------------------------------------------------------------------
+
+template <class RowOf>
+void FilterRows(const RowOf& rowOf, size_t stride, const FilterBank& rows, const FilterBank& cols,
+                uint32_t rowBegin, uint32_t rowEnd, LinearImage& dst) {
+    constexpr uint32_t kMaxTaps = 32;
+    std::vector<float> column(stride); // vertical pass result, one source-width row
+    const float*       tapRows[kMaxTaps];
+
+    for (uint32_t y = rowBegin; y < rowEnd; ++y) {
+        // --- Vertical: weighted sum of whole source rows, eight floats at a time ---
+        const uint32_t tapBegin = rows.first[y];
+        const uint32_t taps     = std::min(rows.first[y + 1] - tapBegin, kMaxTaps);
+        for (uint32_t t = 0; t < taps; ++t) tapRows[t] = rowOf(rows.index[tapBegin + t], y + 1);
+
+        const float* weights = rows.weight.data() + tapBegin;
+        for (size_t i = 0; i < stride; i += kSimdWidth) {
+            Float8 acc(0.f);
+            for (uint32_t t = 0; t < taps; ++t) acc = acc + Float8(weights[t]) * Float8::Load(tapRows[t] + i);
+            acc.Store(column.data() + i);
+        }
+
+        // --- Horizontal: per output texel, RGBA together ---
+        float* out = dst.Row(y);
+        for (uint32_t x = 0; x < dst.width; ++x) {
+            float acc[4] = {};
+            for (uint32_t t = cols.first[x]; t < cols.first[x + 1]; ++t) {
+                const float* texel = column.data() + size_t(cols.index[t]) * 4;
+                const float  w     = cols.weight[t];
+                for (int c = 0; c < 4; ++c) acc[c] += w * texel[c];
+            }
+            std::memcpy(out + size_t(x) * 4, acc, sizeof(acc));
+        }
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+uint32_t MipLevelCount(uint32_t width, uint32_t height) {
+    return static_cast<uint32_t>(std::bit_width(std::max(width, height)));
+}
+
+bool GenerateMipChain(std::span<const std::byte> level0, uint32_t width, uint32_t height,
+                      MipFormat format, const MipOptions& options, MipChain& out, JobSystem* jobs) {
+    const uint32_t bpp = MipBytesPerPixel(format);
+    if (width == 0 || height == 0 || level0.size() < size_t(width) * height * bpp) return false;
+
+    // --- Layout ---
+    uint32_t levelCount = MipLevelCount(width, height);
+    if (options.maxLevels != 0) levelCount = std::min(levelCount, options.maxLevels);
+
+    out.format = format;
+    out.levels.clear();
+    size_t bytes = 0;
+    for (uint32_t i = 0, w = width, h = height; i < levelCount; ++i) {
+        out.levels.push_back({ w, h, bytes, w * bpp });
+        bytes += size_t(w) * h * bpp;
+        w = std::max(1u, w / 2);
+        h = std::max(1u, h / 2);
+    }
+    out.data.resize(bytes);
+    std::memcpy(out.data.data(), level0.data(), size_t(width) * height * bpp);
+    if (levelCount == 1) return true;
+
+    // --- Each level from the previous one; level 1 straight from the input ---
+    LinearImage prev, next;
+    for (uint32_t i = 1; i < levelCount; ++i) {
+        const MipLevel&  src   = out.levels[i - 1];
+        const MipLevel&  level = out.levels[i];
+        const FilterBank rows  = MakeFilterBank(src.height, level.height, options.filter, options.address);
+        const FilterBank cols  = MakeFilterBank(src.width, level.width, options.filter, options.address);
+        next.Resize(level.width, level.height);
+
+        std::byte* dst = out.data.data() + level.offset;
+        ForRows(jobs, level.height, level.width, [&](uint32_t begin, uint32_t end) {
+            if (i == 1) {
+                const size_t stride = LinearImage::Stride(width);
+                DecodedRows  decoded(level0.data(), width, format, stride);
+                FilterRows([&](uint32_t y, uint32_t use) { return decoded.Row(y, use); }, stride, rows, cols,
+                           begin, end, next);
+            } else {
+                FilterRows([&](uint32_t y, uint32_t) { return prev.Row(y); }, prev.stride, rows, cols,
+                           begin, end, next);
+            }
+            for (uint32_t y = begin; y < end; ++y) {
+                EncodeRow(next.Row(y), level.width, format, dst + size_t(y) * level.rowPitch);
+            }
+        });
+        std::swap(prev, next);
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class JobSystem;
+
+// ---------------------------------------------------------------------------
+// MipGenerator — full mip chains on the CPU, for textures created with their
+// data (IMMUTABLE resources cannot run GenerateMips()).
+//
+// Every level is filtered from the previous one in linear float RGBA, so
+// rounding does not accumulate down the chain; sRGB data is decoded to
+// linear light first and re-encoded after filtering (alpha stays linear).
+// The filters are separable: a vertical pass over whole rows with Float8,
+// then a horizontal pass through a per-column tap table. The tables cover
+// any size, so odd dimensions get the exact box footprint (three taps)
+// instead of dropping a texel.
+//
+// With a JobSystem the rows of each level are split across its threads.
+// ---------------------------------------------------------------------------
+
+enum class MipFormat : uint8_t {
+    Rgba8Unorm,     // R8G8B8A8_UNORM, filtered as stored
+    Rgba8UnormSrgb, // R8G8B8A8 holding sRGB-encoded colour, filtered in linear light
+    Rgba32Float,    // R32G32B32A32_FLOAT
+};
+
+enum class MipFilter : uint8_t {
+    Box,     // average of the source footprint (2x2 for even sizes)
+    Lanczos, // Lanczos-2 windowed sinc, 8 taps per axis; sharper, clamped to [0, 1] for UNORM
+};
+
+enum class MipAddress : uint8_t {
+    Clamp, // taps past the edge repeat the edge texel
+    Wrap,  // tiling textures: taps wrap to the opposite edge
+};
+
+struct MipOptions {
+    MipFilter  filter    = MipFilter::Box;
+    MipAddress address   = MipAddress::Clamp;
+    uint32_t   maxLevels = 0; // 0 = down to 1x1
+};
+
+struct MipLevel {
+    uint32_t width    = 0;
+    uint32_t height   = 0;
+    size_t   offset   = 0; // bytes into MipChain::data
+    uint32_t rowPitch = 0; // bytes, tightly packed
+};
+
+// Levels stored back to back, level 0 first.
+struct MipChain {
+    MipFormat             format = MipFormat::Rgba8Unorm;
+    std::vector<MipLevel> levels;
+    std::vector<std::byte> data;
+
+    [[nodiscard]] std::span<const std::byte> Level(uint32_t i) const {
+        return { data.data() + levels[i].offset, size_t(levels[i].rowPitch) * levels[i].height };
+    }
+};
+
+[[nodiscard]] constexpr uint32_t MipBytesPerPixel(MipFormat f) { return f == MipFormat::Rgba32Float ? 16 : 4; }
+
+// floor(log2(max(width, height))) + 1; 0 for an empty image.
+[[nodiscard]] uint32_t MipLevelCount(uint32_t width, uint32_t height);
+
+// `level0` is width x height pixels of `format`, tightly packed; it is
+// copied as level 0 of `out`. False on an empty image or a short span.
+[[nodiscard]] bool GenerateMipChain(std::span<const std::byte> level0, uint32_t width, uint32_t height,
+                                    MipFormat format, const MipOptions& options, MipChain& out,
+                                    JobSystem* jobs = nullptr);
@@ -0,0 +1,137 @@
+#include "ObjFile.h"
+
+#include <charconv>
+#include <cstdio>
+
+namespace {
+
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+std::string_view SkipSpace(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size() && IsSpace(s[i])) ++i;
+    return s.substr(i);
+}
+
+// Next whitespace-separated token of `line`, consumed.
+std::string_view NextToken(std::string_view& line) {
+    line = SkipSpace(line);
+    size_t i = 0;
+    while (i < line.size() && !IsSpace(line[i])) ++i;
+    const std::string_view token = line.substr(0, i);
+    line                         = line.substr(i);
+    return token;
+}
+
+bool ParseFloat(std::string_view token, float& out) {
+    const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), out);
+    return ec == std::errc{} && end == token.data() + token.size();
+}
+
+// A 1-based or negative reference into a list of `count` entries.
+bool ParseIndex(std::string_view token, size_t count, uint32_t& out) {
+    long long  value = 0;
+    const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec != std::errc{} || end != token.data() + token.size()) return false;
+    if (value < 0) value += static_cast<long long>(count) + 1;
+    if (value < 1 || static_cast<unsigned long long>(value) > count) return false;
+    out = static_cast<uint32_t>(value - 1);
+    return true;
+}
+
+struct Position {
+    float pos[3];
+    float col[3];
+};
+
+struct TexCoord {
+    float uv[2];
+};
+
+} // namespace
+
+bool ParseObj(std::string_view text, std::vector<Vertex>& out) {
+    std::vector<Position> positions;
+    std::vector<TexCoord> texCoords;
+    std::vector<Vertex>   polygon;
+
+    while (!text.empty()) {
+        const size_t     eol  = text.find('\n');
+        std::string_view line = text.substr(0, eol);
+        text                  = eol == std::string_view::npos ? std::string_view{} : text.substr(eol + 1);
+
+        const std::string_view keyword = NextToken(line);
+        if (keyword == "v") {
+            Position p = { { 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f } };
+            for (float& f : p.pos)
+                if (!ParseFloat(NextToken(line), f)) return false;
+            // Optional colour: all three components or none.
+            const std::string_view r = NextToken(line);
+            if (!r.empty()) {
+                if (!ParseFloat(r, p.col[0]) || !ParseFloat(NextToken(line), p.col[1]) ||
+                    !ParseFloat(NextToken(line), p.col[2]))
+                    return false;
+            }
+            positions.push_back(p);
+        } else if (keyword == "vt") {
+            TexCoord t = {};
+            if (!ParseFloat(NextToken(line), t.uv[0]) || !ParseFloat(NextToken(line), t.uv[1])) return false;
+            t.uv[1] = 1.f - t.uv[1];
+            texCoords.push_back(t);
+        } else if (keyword == "f") {
+            polygon.clear();
+            for (std::string_view ref = NextToken(line); !ref.empty(); ref = NextToken(line)) {
+                const size_t     slash = ref.find('/');
+                uint32_t         p     = 0;
+                if (!ParseIndex(ref.substr(0, slash), positions.size(), p)) return false;
+
+                Vertex v = {};
+                for (int c = 0; c < 3; ++c) v.pos[c] = positions[p].pos[c];
+                for (int c = 0; c < 3; ++c) v.col[c] = positions[p].col[c];
+                v.col[3] = 1.f;
+                if (slash != std::string_view::npos) {
+                    std::string_view rest = ref.substr(slash + 1);
+                    rest                  = rest.substr(0, rest.find('/'));
+                    if (!rest.empty()) {
+                        uint32_t t = 0;
+                        if (!ParseIndex(rest, texCoords.size(), t)) return false;
+                        v.uv[0] = texCoords[t].uv[0];
+                        v.uv[1] = texCoords[t].uv[1];
+                    }
+                }
+                polygon.push_back(v);
+            }
+            if (polygon.size() < 3) return false;
+            // Fan, with the winding reversed: OBJ's counter-clockwise front
+            // faces become Vertex's clockwise ones.
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                out.push_back(polygon[0]);
+                out.push_back(polygon[i]);
+                out.push_back(polygon[i - 1]);
+            }
+        }
+    }
+    return true;
+}
+
+std::string FormatObj(std::span<const Vertex> vertices, std::span<const uint32_t> indices) {
+    std::string out;
+    out.reserve(vertices.size() * 96 + indices.size() * 8);
+
+    char line[160];
+    for (const Vertex& v : vertices) {
+        const int n = std::snprintf(line, sizeof(line), "v %.9g %.9g %.9g %.9g %.9g %.9g\n", v.pos[0], v.pos[1],
+                                    v.pos[2], v.col[0], v.col[1], v.col[2]);
+        out.append(line, static_cast<size_t>(n));
+    }
+    for (const Vertex& v : vertices) {
+        const int n = std::snprintf(line, sizeof(line), "vt %.9g %.9g\n", v.uv[0], 1.f - v.uv[1]);
+        out.append(line, static_cast<size_t>(n));
+    }
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const unsigned a = indices[i] + 1, b = indices[i + 1] + 1, c = indices[i + 2] + 1;
+        const int n = std::snprintf(line, sizeof(line), "f %u/%u %u/%u %u/%u\n", a, a, c, c, b, b);
+        out.append(line, static_cast<size_t>(n));
+    }
+    return out;
+}
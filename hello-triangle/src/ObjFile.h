@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Vertex.h"
+
+// ---------------------------------------------------------------------------
+// Wavefront OBJ — the text interchange format the mesh pack converter
+// (hello-triangle-meshpack) reads.
+//
+// Understood: "v x y z [r g b]" (the common vertex-colour extension; white
+// otherwise), "vt u v", and "f" with v, v/vt, v//vn or v/vt/vn references,
+// negative (relative) indices included; polygons are fan-triangulated.
+// Normals, groups, materials and everything else are skipped.
+//
+// OBJ follows OpenGL conventions, so the parser converts to those of Vertex:
+// v = 1 - v, and triangles are wound clockwise. FormatObj() converts back.
+// ---------------------------------------------------------------------------
+
+// Appends a triangle list (three vertices per triangle) to `out`. False on
+// a malformed number or an out-of-range reference; `out` then holds the
+// triangles before the offending line.
+[[nodiscard]] bool ParseObj(std::string_view text, std::vector<Vertex>& out);
+
+// Writes an indexed mesh (one v and one vt per vertex).
+[[nodiscard]] std::string FormatObj(std::span<const Vertex> vertices, std::span<const uint32_t> indices);
@@ -0,0 +1,410 @@
+#include "PipelineCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Input layout normalization
+// ---------------------------------------------------------------------------
+
+struct NormalizedElement {
+    std::string semanticName; // upper case
+    uint32_t    semanticIndex;
+    uint32_t    format;
+    uint32_t    inputSlot;
+    uint32_t    offset;
+    uint32_t    inputSlotClass;
+    uint32_t    instanceDataStepRate;
+};
+
+void NormalizeInputLayout(std::span<const PipelineInputElement> layout,
+                          std::vector<NormalizedElement>&       out)
+{
+    // D3D12 has 32 input slots; an append-aligned element follows the end
+    // of the previous element in the same slot. After a format of unknown
+    // size it stays unresolved, which is still deterministic.
+    uint32_t slotEnd[32] = {};
+
+    out.clear();
+    out.reserve(layout.size());
+    for (const PipelineInputElement& e : layout) {
+        NormalizedElement n;
+        n.semanticName.resize(e.semanticName.size());
+        std::transform(e.semanticName.begin(), e.semanticName.end(), n.semanticName.begin(),
+                       [](char c) { return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c; });
+        n.semanticIndex        = e.semanticIndex;
+        n.format               = e.format;
+        n.inputSlot            = e.inputSlot;
+        n.offset               = e.alignedByteOffset;
+        n.inputSlotClass       = e.inputSlotClass;
+        n.instanceDataStepRate = e.instanceDataStepRate;
+
+        uint32_t* end = e.inputSlot < 32 ? &slotEnd[e.inputSlot] : nullptr;
+        if (n.offset == kAppendAlignedElement && end && *end != kAppendAlignedElement)
+            n.offset = *end;
+        if (end) {
+            const uint32_t bytes = VertexFormatBytes(n.format);
+            *end = (n.offset == kAppendAlignedElement || bytes == 0) ? kAppendAlignedElement
+                                                                     : n.offset + bytes;
+        }
+        out.push_back(std::move(n));
+    }
+
+    std::sort(out.begin(), out.end(), [](const NormalizedElement& a, const NormalizedElement& b) {
+        if (a.inputSlot != b.inputSlot) return a.inputSlot < b.inputSlot;
+        if (a.offset != b.offset)       return a.offset < b.offset;
+        if (a.semanticName != b.semanticName) return a.semanticName < b.semanticName;
+        return a.semanticIndex < b.semanticIndex;
+    });
+}
+
+void AddStencilOp(PipelineHasher& h, const PipelineStencilOp& op) {
+    h.AddU32(op.failOp);
+    h.AddU32(op.depthFailOp);
+    h.AddU32(op.passOp);
+    h.AddU32(op.func);
+}
+
+// ---------------------------------------------------------------------------
+// Cache image encoding
+// ---------------------------------------------------------------------------
+
+constexpr char   kMagic[4]   = { 'P', 'S', 'O', 'C' };
+constexpr size_t kHeaderSize = 24;
+constexpr size_t kEntryHead  = 16; // key + size
+constexpr size_t kTrailer    = 8;  // checksum
+
+void PutU32(std::vector<std::byte>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+void PutU64(std::vector<std::byte>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+uint32_t GetU32(const std::byte* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return value;
+}
+
+uint64_t GetU64(const std::byte* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return value;
+}
+
+uint64_t Checksum(std::span<const std::byte> bytes) {
+    PipelineHasher h;
+    h.AddBytes(bytes.data(), bytes.size());
+    return h.Value();
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Input layouts
+// ---------------------------------------------------------------------------
+
+uint32_t VertexFormatBytes(uint32_t dxgiFormat) {
+    if (dxgiFormat >= 1  && dxgiFormat <= 4)  return 16; // R32G32B32A32_*
+    if (dxgiFormat >= 5  && dxgiFormat <= 8)  return 12; // R32G32B32_*
+    if (dxgiFormat >= 9  && dxgiFormat <= 22) return 8;  // R16G16B16A16_*, R32G32_*, R32G8X24_*
+    if (dxgiFormat >= 23 && dxgiFormat <= 47) return 4;  // R10G10B10A2_* .. X24_TYPELESS_G8_UINT
+    if (dxgiFormat >= 48 && dxgiFormat <= 59) return 2;  // R8G8_*, R16_*
+    if (dxgiFormat >= 60 && dxgiFormat <= 65) return 1;  // R8_*, A8_UNORM
+    if (dxgiFormat == 67)                     return 4;  // R9G9B9E5_SHAREDEXP
+    if (dxgiFormat == 85 || dxgiFormat == 86) return 2;  // B5G6R5, B5G5R5A1
+    if (dxgiFormat >= 87 && dxgiFormat <= 93) return 4;  // B8G8R8A8_*, B8G8R8X8_*
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// PipelineHasher
+// ---------------------------------------------------------------------------
+
+void PipelineHasher::AddBytes(const void* data, size_t size) {
+    const auto* p    = static_cast<const unsigned char*>(data);
+    uint64_t    hash = mHash;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= kPrime;
+    }
+    mHash = hash;
+}
+
+void PipelineHasher::AddU32(uint32_t value) {
+    const unsigned char bytes[4] = {
+        static_cast<unsigned char>(value),       static_cast<unsigned char>(value >> 8),
+        static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24),
+    };
+    AddBytes(bytes, sizeof(bytes));
+}
+
+void PipelineHasher::AddU64(uint64_t value) {
+    AddU32(static_cast<uint32_t>(value));
+    AddU32(static_cast<uint32_t>(value >> 32));
+}
+
+void PipelineHasher::AddFloat(float value) {
+    if (value != value) {
+        AddU32(0x7fc00000u); // canonical quiet NaN
+        return;
+    }
+    if (value == 0.f) value = 0.f; // folds -0 into +0
+    AddU32(std::bit_cast<uint32_t>(value));
+}
+
+void PipelineHasher::AddString(std::string_view text) {
+    AddU64(text.size());
+    AddBytes(text.data(), text.size());
+}
+
+void PipelineHasher::AddBlob(std::span<const std::byte> blob) {
+    AddU64(blob.size());
+    AddBytes(blob.data(), blob.size());
+}
+
+// ---------------------------------------------------------------------------
+// Keys
+// ---------------------------------------------------------------------------
+
+uint64_t HashRootSignature(std::span<const std::byte> serializedBlob) {
+    PipelineHasher h;
+    h.AddString("root-signature");
+    h.AddU32(kPipelineKeyVersion);
+    h.AddBlob(serializedBlob);
+    return h.Value();
+}
+
+uint64_t HashGraphicsPipeline(const GraphicsPipelineDesc& desc) {
+    PipelineHasher h;
+    h.AddString("graphics-pipeline");
+    h.AddU32(kPipelineKeyVersion);
+    h.AddU64(desc.rootSignature);
+
+    h.AddBlob(desc.vs);
+    h.AddBlob(desc.ps);
+    h.AddBlob(desc.ds);
+    h.AddBlob(desc.hs);
+    h.AddBlob(desc.gs);
+
+    // --- Input assembler ---
+    thread_local std::vector<NormalizedElement> layout;
+    NormalizeInputLayout(desc.inputLayout, layout);
+    h.AddU32(static_cast<uint32_t>(layout.size()));
+    for (const NormalizedElement& e : layout) {
+        h.AddString(e.semanticName);
+        h.AddU32(e.semanticIndex);
+        h.AddU32(e.format);
+        h.AddU32(e.inputSlot);
+        h.AddU32(e.offset);
+        h.AddU32(e.inputSlotClass);
+        h.AddU32(e.inputSlotClass != 0 ? e.instanceDataStepRate : 0); // ignored per vertex
+    }
+    h.AddU32(desc.ibStripCutValue);
+    h.AddU32(desc.primitiveTopologyType);
+
+    // --- Rasterizer ---
+    h.AddU32(desc.fillMode);
+    h.AddU32(desc.cullMode);
+    h.AddBool(desc.frontCounterClockwise);
+    h.AddU32(static_cast<uint32_t>(desc.depthBias));
+    h.AddFloat(desc.depthBiasClamp);
+    h.AddFloat(desc.slopeScaledDepthBias);
+    h.AddBool(desc.depthClipEnable);
+    h.AddBool(desc.multisampleEnable);
+    h.AddBool(desc.antialiasedLineEnable);
+    h.AddU32(desc.forcedSampleCount);
+    h.AddU32(desc.conservativeRaster);
+
+    // --- Blend ---
+    const uint32_t renderTargets = std::min(desc.numRenderTargets, kPipelineMaxRenderTargets);
+    const uint32_t blendTargets  = desc.independentBlendEnable ? std::max(renderTargets, 1u) : 1u;
+    h.AddBool(desc.alphaToCoverageEnable);
+    h.AddBool(desc.independentBlendEnable);
+    for (uint32_t i = 0; i < blendTargets; ++i) {
+        const PipelineBlendTarget& t = desc.blend[i];
+        h.AddBool(t.blendEnable);
+        if (t.blendEnable) {
+            h.AddU32(t.srcBlend);
+            h.AddU32(t.destBlend);
+            h.AddU32(t.blendOp);
+            h.AddU32(t.srcBlendAlpha);
+            h.AddU32(t.destBlendAlpha);
+            h.AddU32(t.blendOpAlpha);
+        }
+        h.AddBool(t.logicOpEnable);
+        if (t.logicOpEnable) h.AddU32(t.logicOp);
+        h.AddU8(t.renderTargetWriteMask);
+    }
+
+    // --- Depth / stencil ---
+    h.AddBool(desc.depthEnable);
+    if (desc.depthEnable) {
+        h.AddU32(desc.depthWriteMask);
+        h.AddU32(desc.depthFunc);
+    }
+    h.AddBool(desc.stencilEnable);
+    if (desc.stencilEnable) {
+        h.AddU8(desc.stencilReadMask);
+        h.AddU8(desc.stencilWriteMask);
+        AddStencilOp(h, desc.frontFace);
+        AddStencilOp(h, desc.backFace);
+    }
+
+    // --- Output ---
+    h.AddU32(desc.sampleMask);
+    h.AddU32(renderTargets);
+    for (uint32_t i = 0; i < renderTargets; ++i) h.AddU32(desc.rtvFormats[i]);
+    h.AddU32(desc.dsvFormat);
+    h.AddU32(desc.sampleCount);
+    h.AddU32(desc.sampleQuality);
+    h.AddU32(desc.nodeMask);
+    h.AddU32(desc.flags);
+    return h.Value();
+}
+
+// ---------------------------------------------------------------------------
+// PipelineCache — entries
+// ---------------------------------------------------------------------------
+
+std::span<const std::byte> PipelineCache::Find(uint64_t key) const {
+    const auto it = mEntries.find(key);
+    if (it == mEntries.end()) return {};
+    return it->second;
+}
+
+void PipelineCache::Store(uint64_t key, std::span<const std::byte> blob) {
+    mEntries[key].assign(blob.begin(), blob.end());
+    mDirty = true;
+}
+
+void PipelineCache::Erase(uint64_t key) {
+    if (mEntries.erase(key) > 0) mDirty = true;
+}
+
+void PipelineCache::Clear() {
+    mDirty = mDirty || !mEntries.empty();
+    mEntries.clear();
+}
+
+// ---------------------------------------------------------------------------
+// PipelineCache — image
+// ---------------------------------------------------------------------------
+
+std::vector<std::byte> PipelineCache::Serialize(uint64_t deviceId) const {
+    // Sorted keys: the same contents always produce the same image.
+    std::vector<uint64_t> keys;
+    keys.reserve(mEntries.size());
+    size_t bytes = kHeaderSize + kTrailer;
+    for (const auto& [key, blob] : mEntries) {
+        keys.push_back(key);
+        bytes += kEntryHead + ((blob.size() + 7) & ~size_t{ 7 });
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::byte> out;
+    out.reserve(bytes);
+    for (char c : kMagic) out.push_back(static_cast<std::byte>(c));
+    PutU32(out, kFormatVersion);
+    PutU64(out, deviceId);
+    PutU32(out, static_cast<uint32_t>(keys.size()));
+    PutU32(out, 0);
+
+    for (uint64_t key : keys) {
+        const std::vector<std::byte>& blob = mEntries.at(key);
+        PutU64(out, key);
+        PutU64(out, blob.size());
+        out.insert(out.end(), blob.begin(), blob.end());
+        out.resize((out.size() + 7) & ~size_t{ 7 }, std::byte{ 0 });
+    }
+
+    PutU64(out, Checksum(out));
+    return out;
+}
+
+bool PipelineCache::Deserialize(std::span<const std::byte> image, uint64_t deviceId) {
+    mEntries.clear();
+    mDirty = true; // whatever was on disk no longer matches memory
+
+    if (image.size() < kHeaderSize + kTrailer || image.size() % 8 != 0) return false;
+
+    const size_t bodySize = image.size() - kTrailer;
+    if (GetU64(image.data() + bodySize) != Checksum(image.first(bodySize))) return false;
+
+    const std::byte* p = image.data();
+    if (std::memcmp(p, kMagic, sizeof(kMagic)) != 0) return false;
+    if (GetU32(p + 4) != kFormatVersion)             return false;
+    if (GetU64(p + 8) != deviceId)                   return false;
+
+    const uint32_t count  = GetU32(p + 16);
+    size_t         offset = kHeaderSize;
+
+    std::unordered_map<uint64_t, std::vector<std::byte>> entries;
+    entries.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (bodySize - offset < kEntryHead) return false;
+        const uint64_t key  = GetU64(p + offset);
+        const uint64_t size = GetU64(p + offset + 8);
+        offset += kEntryHead;
+
+        if (size > bodySize - offset) return false;
+        const std::byte* blob = p + offset;
+        if (!entries.try_emplace(key, blob, blob + size).second) return false; // duplicate key
+        offset += (size + 7) & ~uint64_t{ 7 };
+        if (offset > bodySize) return false;
+    }
+    if (offset != bodySize) return false;
+
+    mEntries = std::move(entries);
+    mDirty   = false;
+    return true;
+}
+
+bool PipelineCache::Load(const std::filesystem::path& path, uint64_t deviceId) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        Clear();
+        return false;
+    }
+
+    const std::streamoff size = file.tellg();
+    std::vector<std::byte> image(size > 0 ? static_cast<size_t>(size) : 0);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(image.data()), static_cast<std::streamsize>(image.size()))) {
+        Clear();
+        return false;
+    }
+    return Deserialize(image, deviceId);
+}
+
+bool PipelineCache::Save(const std::filesystem::path& path, uint64_t deviceId) {
+    const std::vector<std::byte> image = Serialize(deviceId);
+
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    // close() flushes: a failure there (e.g. a full disk) must not replace `path`.
+    file.close();
+
+    std::error_code ec;
+    if (!file) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    mDirty = false;
+    return true;
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// PipelineHasher — 64-bit FNV-1a over an explicit little-endian stream.
+//
+// Every value is fed field by field with a fixed width, never as a raw
+// struct, so padding, host endianness and compiler layout cannot leak into
+// the result: the same description hashes to the same key on every
+// platform and every build.
+// ---------------------------------------------------------------------------
+class PipelineHasher {
+public:
+    static constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+    static constexpr uint64_t kPrime       = 0x100000001b3ull;
+
+    void AddBytes(const void* data, size_t size);
+    void AddU8(uint8_t value)   { AddBytes(&value, 1); }
+    void AddU32(uint32_t value);
+    void AddU64(uint64_t value);
+    void AddBool(bool value)    { AddU8(value ? 1 : 0); }
+    void AddFloat(float value); // -0 folds into +0, every NaN into one NaN
+
+    // Length-prefixed, so ("ab", "c") and ("a", "bc") differ.
+    void AddString(std::string_view text);
+    void AddBlob(std::span<const std::byte> blob);
+
+    [[nodiscard]] uint64_t Value() const { return mHash; }
+
+private:
+    uint64_t mHash = kOffsetBasis;
+};
+
+// ---------------------------------------------------------------------------
+// GraphicsPipelineDesc — API-neutral mirror of
+// D3D12_GRAPHICS_PIPELINE_STATE_DESC. Enum fields carry the D3D12 / DXGI
+// values unchanged (the ResourceState convention); D3D12PipelineCache fills
+// it from the real desc. Spans point into caller memory.
+// ---------------------------------------------------------------------------
+constexpr uint32_t kPipelineMaxRenderTargets = 8;
+constexpr uint32_t kAppendAlignedElement     = ~0u; // D3D12_APPEND_ALIGNED_ELEMENT
+
+struct PipelineInputElement {
+    std::string_view semanticName;
+    uint32_t         semanticIndex        = 0;
+    uint32_t         format               = 0; // DXGI_FORMAT
+    uint32_t         inputSlot            = 0;
+    uint32_t         alignedByteOffset    = 0; // or kAppendAlignedElement
+    uint32_t         inputSlotClass       = 0; // 0 = per vertex, 1 = per instance
+    uint32_t         instanceDataStepRate = 0;
+};
+
+// Bytes per element of the DXGI formats usable in an input layout; 0 for
+// anything else.
+[[nodiscard]] uint32_t VertexFormatBytes(uint32_t dxgiFormat);
+
+// `elements` as D3D11_INPUT_ELEMENT_DESCs or D3D12_INPUT_ELEMENT_DESCs (the
+// two have the same members), so both backends convert a layout the same
+// way. Semantic names are the views' data(), which must be NUL-terminated;
+// reflection and MakeVertexLayout() names are.
+template <class Desc>
+[[nodiscard]] std::vector<Desc> MakeInputElementDescs(std::span<const PipelineInputElement> elements) {
+    std::vector<Desc> descs(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        const PipelineInputElement& e = elements[i];
+        Desc&                       d = descs[i];
+        d.SemanticName         = e.semanticName.data();
+        d.SemanticIndex        = e.semanticIndex;
+        d.Format               = static_cast<decltype(d.Format)>(e.format);
+        d.InputSlot            = e.inputSlot;
+        d.AlignedByteOffset    = e.alignedByteOffset;
+        d.InputSlotClass       = static_cast<decltype(d.InputSlotClass)>(e.inputSlotClass);
+        d.InstanceDataStepRate = e.instanceDataStepRate;
+    }
+    return descs;
+}
+
+struct PipelineBlendTarget {
+    bool     blendEnable           = false;
+    bool     logicOpEnable         = false;
+    uint32_t srcBlend              = 2; // D3D12_BLEND_ONE
+    uint32_t destBlend             = 1; // D3D12_BLEND_ZERO
+    uint32_t blendOp               = 1; // D3D12_BLEND_OP_ADD
+    uint32_t srcBlendAlpha         = 2;
+    uint32_t destBlendAlpha        = 1;
+    uint32_t blendOpAlpha          = 1;
+    uint32_t logicOp               = 4; // D3D12_LOGIC_OP_NOOP
+    uint8_t  renderTargetWriteMask = 0xF;
+};
+
+struct PipelineStencilOp {
+    uint32_t failOp      = 1; // D3D12_STENCIL_OP_KEEP
+    uint32_t depthFailOp = 1;
+    uint32_t passOp      = 1;
+    uint32_t func        = 8; // D3D12_COMPARISON_FUNC_ALWAYS
+};
+
+struct GraphicsPipelineDesc {
+    uint64_t rootSignature = 0; // HashRootSignature() of the serialized blob
+
+    std::span<const std::byte> vs, ps, ds, hs, gs;
+
+    std::span<const PipelineInputElement> inputLayout;
+    uint32_t ibStripCutValue       = 0;
+    uint32_t primitiveTopologyType = 3; // D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE
+
+    // --- Rasterizer ---
+    uint32_t fillMode              = 3; // D3D12_FILL_MODE_SOLID
+    uint32_t cullMode              = 3; // D3D12_CULL_MODE_BACK
+    bool     frontCounterClockwise = false;
+    int32_t  depthBias             = 0;
+    float    depthBiasClamp        = 0.f;
+    float    slopeScaledDepthBias  = 0.f;
+    bool     depthClipEnable       = true;
+    bool     multisampleEnable     = false;
+    bool     antialiasedLineEnable = false;
+    uint32_t forcedSampleCount     = 0;
+    uint32_t conservativeRaster    = 0;
+
+    // --- Blend ---
+    bool                alphaToCoverageEnable = false;
+    bool                independentBlendEnable = false;
+    PipelineBlendTarget blend[kPipelineMaxRenderTargets];
+
+    // --- Depth / stencil ---
+    bool              depthEnable      = true;
+    uint32_t          depthWriteMask   = 1; // D3D12_DEPTH_WRITE_MASK_ALL
+    uint32_t          depthFunc        = 2; // D3D12_COMPARISON_FUNC_LESS
+    bool              stencilEnable    = false;
+    uint8_t           stencilReadMask  = 0xFF;
+    uint8_t           stencilWriteMask = 0xFF;
+    PipelineStencilOp frontFace;
+    PipelineStencilOp backFace;
+
+    // --- Output ---
+    uint32_t sampleMask       = ~0u;
+    uint32_t numRenderTargets = 0;
+    uint32_t rtvFormats[kPipelineMaxRenderTargets] = {};
+    uint32_t dsvFormat        = 0;
+    uint32_t sampleCount      = 1;
+    uint32_t sampleQuality    = 0;
+    uint32_t nodeMask         = 0;
+    uint32_t flags            = 0;
+};
+
+// Bumped whenever the normalization rules below change, which invalidates
+// every key derived with the old rules.
+constexpr uint32_t kPipelineKeyVersion = 1;
+
+[[nodiscard]] uint64_t HashRootSignature(std::span<const std::byte> serializedBlob);
+
+// Key of a pipeline: every field that can change the compiled result,
+// including all shader bytecode, after normalization —
+//   • semantic names compared case-insensitively (as HLSL does);
+//   • append-aligned offsets resolved, then elements sorted by
+//     (slot, offset, semantic), so declaration order does not matter;
+//   • factors and ops of disabled blending / logic ops / stencil and the
+//     depth func and write mask of a disabled depth test are ignored;
+//   • blend targets beyond the used ones (only target 0 without
+//     independent blend) and RTV formats past numRenderTargets are ignored;
+//   • -0.0 and +0.0 depth bias values hash the same.
+[[nodiscard]] uint64_t HashGraphicsPipeline(const GraphicsPipelineDesc& desc);
+
+// ---------------------------------------------------------------------------
+// PipelineCache — key -> blob store with a versioned on-disk image.
+//
+// Holds driver-compiled pipeline blobs (ID3D12PipelineState::GetCachedBlob)
+// between launches. Blobs are only valid for the adapter and driver that
+// produced them, so the image records a device id and Load() discards it
+// when the id differs. Layout (little-endian):
+//
+//   char[4]  magic "PSOC"           u32 kFormatVersion
+//   u64      device id              u32 entry count, u32 reserved (0)
+//   entries, sorted by key:         u64 key, u64 size, bytes, pad to 8
+//   u64      FNV-1a of every preceding byte
+//
+// A truncated, corrupt, stale or foreign image is rejected as a whole and
+// leaves the cache empty: the caller just compiles from scratch.
+// ---------------------------------------------------------------------------
+class PipelineCache {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    // Empty span when absent. Valid until the entry is replaced or erased.
+    [[nodiscard]] std::span<const std::byte> Find(uint64_t key) const;
+    void Store(uint64_t key, std::span<const std::byte> blob);
+    void Erase(uint64_t key);
+    void Clear();
+
+    [[nodiscard]] std::vector<std::byte> Serialize(uint64_t deviceId) const;
+    [[nodiscard]] bool                   Deserialize(std::span<const std::byte> image, uint64_t deviceId);
+
+    // Save() writes a temporary file and renames it over `path`, so a crash
+    // mid-write never leaves a torn image behind.
+    [[nodiscard]] bool Load(const std::filesystem::path& path, uint64_t deviceId);
+    [[nodiscard]] bool Save(const std::filesystem::path& path, uint64_t deviceId);
+
+    [[nodiscard]] size_t EntryCount() const { return mEntries.size(); }
+    [[nodiscard]] bool   Dirty()      const { return mDirty; } // changed since Load/Save
+
+private:
+    std::unordered_map<uint64_t, std::vector<std::byte>> mEntries;
+    bool                                                 mDirty = false;
+};
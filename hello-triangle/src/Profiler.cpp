@@ -0,0 +1,308 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+std::atomic<bool> Profiler::sEnabled{ false };
+
+namespace {
+
+struct ProfileEvent {
+    const char* name  = nullptr;
+    uint64_t    start = 0;
+    uint64_t    end   = 0;
+};
+
+// One thread's zones. head is written only by the owning thread, tail only
+// by Collect() (under the registry lock), each on its own cache line; the
+// producer re-reads tail only when its cached copy says the ring is full.
+struct ProfileRing {
+    alignas(64) std::atomic<uint64_t> head{ 0 };
+    uint64_t              cachedTail = 0; // producer's last view of tail
+    std::atomic<uint64_t> dropped{ 0 };   // written by the producer only
+
+    alignas(64) std::atomic<uint64_t> tail{ 0 };
+    std::atomic<bool> exited{ false };
+    uint32_t          thread = 0;
+
+    ProfileEvent events[Profiler::kRingCapacity];
+};
+
+int64_t SteadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Registry {
+    std::mutex                                mutex;
+    std::vector<std::unique_ptr<ProfileRing>> rings;
+    std::vector<std::string>                  threadNames; // [thread - 1]
+    std::unordered_set<std::string>           interned;    // node-based: c_str() stays put
+    uint64_t                                  exitedDropped = 0;
+
+    // Tick -> ns conversion, refined at every Collect().
+    const uint64_t epochTicks = Profiler::Ticks();
+    const int64_t  epochNs    = SteadyNs();
+    double         nsPerTick  = 1.0;
+};
+
+// Never destroyed: threads may exit (and release their ring) after static
+// destructors have run.
+Registry& GetRegistry() {
+    static Registry& registry = *new Registry;
+    return registry;
+}
+
+thread_local ProfileRing* tRing = nullptr; // trivial, so the hot path needs no init guard
+
+// Releases the thread's ring when the thread exits: freed right away if
+// already drained, otherwise by the Collect() that drains it.
+struct RingOwner {
+    ProfileRing* ring = nullptr;
+
+    ~RingOwner() {
+        if (!ring) return;
+        tRing = nullptr;
+        Registry&        reg = GetRegistry();
+        std::scoped_lock lock(reg.mutex);
+        if (ring->head.load(std::memory_order_relaxed) == ring->tail.load(std::memory_order_relaxed)) {
+            reg.exitedDropped += ring->dropped.load(std::memory_order_relaxed);
+            std::erase_if(reg.rings, [&](const auto& r) { return r.get() == ring; });
+        } else {
+            ring->exited.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local RingOwner   tRingOwner;
+thread_local std::string tThreadName; // set before the thread's first zone
+
+ProfileRing* RegisterThread() {
+    auto      ring = std::make_unique<ProfileRing>();
+    Registry& reg  = GetRegistry();
+    {
+        std::scoped_lock lock(reg.mutex);
+        reg.threadNames.push_back(tThreadName);
+        ring->thread = static_cast<uint32_t>(reg.threadNames.size());
+        reg.rings.push_back(std::move(ring));
+        tRing = reg.rings.back().get();
+    }
+    tRingOwner.ring = tRing;
+    return tRing;
+}
+
+void AppendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void AppendUInt(std::string& out, uint64_t value) {
+    char       digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    out.append(digits, end);
+}
+
+// Trace timestamps are µs; ns precision as three decimals.
+void AppendMicroseconds(std::string& out, uint64_t ns) {
+    AppendUInt(out, ns / 1000);
+    const auto frac = static_cast<uint32_t>(ns % 1000);
+    out += '.';
+    out += static_cast<char>('0' + frac / 100);
+    out += static_cast<char>('0' + frac / 10 % 10);
+    out += static_cast<char>('0' + frac % 10);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+void Profiler::SetEnabled(bool enabled) {
+    (void)GetRegistry(); // epoch before the first zone's start
+    sEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(std::string_view name) {
+    tThreadName.assign(name);
+    if (!tRing) return;
+
+    Registry&        reg = GetRegistry();
+    std::scoped_lock lock(reg.mutex);
+    reg.threadNames[tRing->thread - 1] = tThreadName;
+}
+
+const char* Profiler::Intern(std::string_view name) {
+    Registry&        reg = GetRegistry();
+    std::scoped_lock lock(reg.mutex);
+    return reg.interned.emplace(name).first->c_str();
+}
+
+// ---------------------------------------------------------------------------
+// Recording (hot path)
+// ---------------------------------------------------------------------------
+
+void Profiler::Record(const char* name, uint64_t startTicks, uint64_t endTicks) {
+    ProfileRing* ring = tRing;
+    if (!ring) ring = RegisterThread();
+
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->cachedTail >= kRingCapacity) {
+        ring->cachedTail = ring->tail.load(std::memory_order_acquire);
+        if (head - ring->cachedTail >= kRingCapacity) {
+            ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    ring->events[head & (kRingCapacity - 1)] = { name, startTicks, endTicks };
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// Aggregation
+// ---------------------------------------------------------------------------
+
+void Profiler::Collect(std::vector<ProfileZone>& out) {
+    Registry&        reg = GetRegistry();
+    std::scoped_lock lock(reg.mutex);
+
+#ifdef HELLO_TRIANGLE_PROFILER_TSC
+    // Calibrate over everything since the epoch; the first millisecond is
+    // too short to measure the TSC rate precisely.
+    while (SteadyNs() - reg.epochNs < 1'000'000) std::this_thread::yield();
+    const uint64_t ticks = Ticks() - reg.epochTicks;
+    const int64_t  ns    = SteadyNs() - reg.epochNs;
+    if (ticks > 0) reg.nsPerTick = static_cast<double>(ns) / static_cast<double>(ticks);
+#endif
+
+    const auto toNs = [&](uint64_t t) {
+        return static_cast<uint64_t>(static_cast<double>(t) * reg.nsPerTick);
+    };
+
+    for (size_t i = 0; i < reg.rings.size();) {
+        ProfileRing& ring = *reg.rings[i];
+
+        // Exited first: once set, head is final.
+        const bool     exited = ring.exited.load(std::memory_order_acquire);
+        const uint64_t head   = ring.head.load(std::memory_order_acquire);
+        for (uint64_t t = ring.tail.load(std::memory_order_relaxed); t < head; ++t) {
+            const ProfileEvent& e     = ring.events[t & (kRingCapacity - 1)];
+            const uint64_t      start    = e.start > reg.epochTicks ? e.start - reg.epochTicks : 0;
+            const uint64_t      duration = std::max(e.end, e.start) - e.start;
+            out.push_back({ e.name, ring.thread, toNs(start), toNs(duration) });
+        }
+        ring.tail.store(head, std::memory_order_release);
+
+        if (exited) {
+            reg.exitedDropped += ring.dropped.load(std::memory_order_relaxed);
+            reg.rings.erase(reg.rings.begin() + static_cast<ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+}
+
+uint64_t Profiler::DroppedCount() {
+    Registry&        reg = GetRegistry();
+    std::scoped_lock lock(reg.mutex);
+
+    uint64_t dropped = reg.exitedDropped;
+    for (const auto& ring : reg.rings) dropped += ring->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+std::vector<ProfileStat> Profiler::Summarize(std::span<const ProfileZone> zones) {
+    std::vector<ProfileStat>                     stats;
+    std::unordered_map<std::string_view, size_t> index; // by text: equal literals may not share storage
+
+    for (const ProfileZone& zone : zones) {
+        const auto [it, inserted] = index.try_emplace(zone.name, stats.size());
+        if (inserted) stats.push_back({ zone.name });
+
+        ProfileStat& stat = stats[it->second];
+        ++stat.count;
+        stat.totalNs += zone.durationNs;
+        stat.maxNs    = std::max(stat.maxNs, zone.durationNs);
+    }
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Chrome trace export
+// ---------------------------------------------------------------------------
+
+std::string Profiler::FormatChromeTrace(std::span<const ProfileZone> zones) {
+    std::vector<std::string> names;
+    {
+        Registry&        reg = GetRegistry();
+        std::scoped_lock lock(reg.mutex);
+        names = reg.threadNames;
+    }
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool        first = true;
+    const auto  separate = [&] {
+        if (!first) out += ",\n";
+        first = false;
+    };
+
+    // Thread labels, for the threads that appear.
+    std::vector<bool> seen(names.size() + 1, false);
+    for (const ProfileZone& zone : zones) {
+        if (zone.thread == 0 || zone.thread > names.size() || seen[zone.thread]) continue;
+        seen[zone.thread] = true;
+        if (names[zone.thread - 1].empty()) continue;
+
+        separate();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        AppendUInt(out, zone.thread);
+        out += ",\"args\":{\"name\":";
+        AppendJsonString(out, names[zone.thread - 1]);
+        out += "}}";
+    }
+
+    // Complete events.
+    for (const ProfileZone& zone : zones) {
+        separate();
+        out += "{\"name\":";
+        AppendJsonString(out, zone.name ? zone.name : "");
+        out += ",\"ph\":\"X\",\"pid\":1,\"tid\":";
+        AppendUInt(out, zone.thread);
+        out += ",\"ts\":";
+        AppendMicroseconds(out, zone.startNs);
+        out += ",\"dur\":";
+        AppendMicroseconds(out, zone.durationNs);
+        out += '}';
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+bool Profiler::WriteChromeTrace(const std::filesystem::path& path, std::span<const ProfileZone> zones) {
+    const std::string text = FormatChromeTrace(zones);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define HELLO_TRIANGLE_PROFILER_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HELLO_TRIANGLE_PROFILER_TSC 1
+#endif
+
+// One finished zone, as returned by Profiler::Collect(); times in ns since
+// the profiler's epoch (first use in the process).
+struct ProfileZone {
+    const char* name       = nullptr;
+    uint32_t    thread     = 0; // 1-based, in order of each thread's first zone
+    uint64_t    startNs    = 0;
+    uint64_t    durationNs = 0;
+};
+
+// Per-name totals over a set of zones (Profiler::Summarize()).
+struct ProfileStat {
+    const char* name    = nullptr;
+    uint64_t    count   = 0;
+    uint64_t    totalNs = 0;
+    uint64_t    maxNs   = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Profiler — scoped CPU zones with a few ns of overhead each.
+//
+// PROFILE_ZONE("Render") times the rest of the enclosing scope. On the hot
+// path a zone reads the timestamp counter twice and appends {name, start,
+// end} to its thread's ring: a single-producer / single-consumer buffer
+// owned by that thread, so recording takes no lock and touches no shared
+// cache line. When a ring is full the zone is dropped and counted, never
+// blocked on.
+//
+// Everything else happens off the hot path, on whichever thread calls
+// Collect(), typically once per frame: it drains every ring, converts
+// ticks to ns and hands back the zones, which Summarize() aggregates and
+// FormatChromeTrace() turns into a trace for chrome://tracing or Perfetto.
+//
+// Zone names are not copied: they must outlive the profiler, i.e. be string
+// literals or come from Intern(). Recording is off until SetEnabled(true);
+// a disabled zone costs one relaxed load. Building with
+// HELLO_TRIANGLE_PROFILER=0 compiles every PROFILE_ZONE out.
+// ---------------------------------------------------------------------------
+class Profiler {
+public:
+    // Zones a thread can record between two Collect() calls.
+    static constexpr uint32_t kRingCapacity = 1u << 14;
+
+    // Enabling also fixes the epoch, if no zone has done so yet.
+    static void SetEnabled(bool enabled);
+    [[nodiscard]] static bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    // Label for the calling thread in traces ("main", "worker 2"...).
+    static void SetThreadName(std::string_view name);
+
+    // A stable copy of `name`, for zone names built at run time. Takes a
+    // lock; call it once per name, not per zone.
+    [[nodiscard]] static const char* Intern(std::string_view name);
+
+    // Raw timestamp: the CPU's invariant TSC on x86, steady_clock ns
+    // elsewhere. Collect() converts.
+    [[nodiscard]] static uint64_t Ticks() {
+#ifdef HELLO_TRIANGLE_PROFILER_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Appends a zone to the calling thread's ring (registering the ring on
+    // the thread's first zone). Ignores IsEnabled(); ProfileScope checks it.
+    static void Record(const char* name, uint64_t startTicks, uint64_t endTicks);
+
+    // Drains every thread's ring into `out` (appended, per thread in time
+    // order). Rings of exited threads are freed once drained.
+    static void Collect(std::vector<ProfileZone>& out);
+
+    // Zones lost to full rings since startup.
+    [[nodiscard]] static uint64_t DroppedCount();
+
+    // One entry per distinct name, in order of first appearance.
+    [[nodiscard]] static std::vector<ProfileStat> Summarize(std::span<const ProfileZone> zones);
+
+    // Chrome trace event format: complete ("X") events plus thread names.
+    [[nodiscard]] static std::string FormatChromeTrace(std::span<const ProfileZone> zones);
+    [[nodiscard]] static bool        WriteChromeTrace(const std::filesystem::path& path,
+                                                      std::span<const ProfileZone> zones);
+
+private:
+    static std::atomic<bool> sEnabled;
+};
+
+// Records the enclosing scope as one zone; see PROFILE_ZONE.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : mName(Profiler::IsEnabled() ? name : nullptr), mStart(mName ? Profiler::Ticks() : 0) {}
+    ~ProfileScope() {
+        if (mName) Profiler::Record(mName, mStart, Profiler::Ticks());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* mName;
+    uint64_t    mStart;
+};
+
+#ifndef HELLO_TRIANGLE_PROFILER
+#define HELLO_TRIANGLE_PROFILER 1
+#endif
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b)       PROFILE_CONCAT_INNER(a, b)
+
+#if HELLO_TRIANGLE_PROFILER
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
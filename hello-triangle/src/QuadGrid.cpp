@@ -0,0 +1,47 @@
+#include "QuadGrid.h"
+
+#include "Profiler.h"
+
+Float4x4 QuadGrid::ViewProjection(float aspect) {
+    const Float4x4 view = MatrixLookAtLH({ 0.f, 0.f, -kSize * 1.75f }, { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f });
+    const Float4x4 proj = MatrixPerspectiveFovLH(kPi / 4.f, aspect, 0.1f, 100.f);
+    return MatrixMultiply(view, proj);
+}
+
+void QuadGrid::Init(const Float4x4& meshDequant) {
+    mMeshDequant = meshDequant;
+
+    // One id per cell in row order. A quad spinning about Y stays inside a
+    // box of half-size 0.5.
+    mCuller.Clear();
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            const Float3 c = { CellCenter(x), CellCenter(y), 0.f };
+            mCuller.Add({ { c.x - 0.5f, c.y - 0.5f, c.z - 0.5f }, { c.x + 0.5f, c.y + 0.5f, c.z + 0.5f } });
+        }
+    }
+    mCuller.BuildBvh();
+    mVisible.clear();
+    mBatcher.Reset();
+}
+
+void QuadGrid::Update(const Float4x4& viewProj, float angle) {
+    PROFILE_ZONE("QuadGrid");
+    mCuller.CullHierarchical(Frustum::FromViewProjection(viewProj), mVisible);
+
+    mBatcher.Reset();
+    for (const uint32_t id : mVisible) {
+        const int x = static_cast<int>(id) % kSize; // ids follow the Add() order of Init()
+        const int y = static_cast<int>(id) / kSize;
+
+        Float4x4 world = MatrixRotationY(angle + 0.2f * static_cast<float>(x + y));
+        world.m[3][0]  = CellCenter(x);
+        world.m[3][1]  = CellCenter(y);
+        world          = MatrixMultiply(mMeshDequant, world);
+
+        const float tint[4] = { 0.5f + 0.5f * x / (kSize - 1),
+                                0.5f + 0.5f * y / (kSize - 1), 1.f, 1.f };
+        mBatcher.Add(kQuadMesh, kCheckerMaterial, MakeInstanceData(world, tint));
+    }
+    mBatcher.Build();
+}
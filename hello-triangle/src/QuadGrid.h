@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CpuMath.h"
+#include "FrustumCuller.h"
+#include "InstanceBatcher.h"
+
+// ---------------------------------------------------------------------------
+// QuadGrid — the CPU side of D3DApp's scene: a kSize x kSize grid of
+// spinning quads, culled against the camera frustum and merged into
+// instanced draws.
+//
+// Init() adds one box per cell to a FrustumCuller and builds its BVH.
+// Update() culls hierarchically, then records each visible quad's world
+// matrix (with the mesh dequantization folded in front) and tint into an
+// InstanceBatcher. No graphics API: D3DApp uploads Instances() and draws
+// Batches(); the benchmarks time the same calls.
+// ---------------------------------------------------------------------------
+class QuadGrid {
+public:
+    static constexpr int      kSize            = 16;    // quads per row / column
+    static constexpr float    kSpacing         = 1.25f; // quad centre distance (world units)
+    static constexpr uint32_t kQuadCount       = kSize * kSize;
+    static constexpr uint32_t kQuadMesh        = 0;     // batch keys of the scene's only
+    static constexpr uint32_t kCheckerMaterial = 0;     // mesh and material
+
+    // World-space x (or y) of a cell's centre; the grid is centred on 0.
+    static constexpr float CellCenter(int cell) {
+        return (static_cast<float>(cell) - 0.5f * (kSize - 1)) * kSpacing;
+    }
+
+    // The camera that frames the whole grid (row vectors, D3D clip depth).
+    [[nodiscard]] static Float4x4 ViewProjection(float aspect);
+
+    // `meshDequant` goes in front of every world matrix (see DequantMatrix()).
+    void Init(const Float4x4& meshDequant = MatrixIdentity());
+
+    // Culls against `viewProj` and rebuilds the batches; quads spin about Y
+    // by `angle` (radians), phase-shifted along the diagonal.
+    void Update(const Float4x4& viewProj, float angle);
+
+    // Drops this frame's batches, e.g. when the instances were not uploaded.
+    void ClearBatches() { mBatcher.Reset(); }
+
+    // Valid after Update() until the next Update() or ClearBatches().
+    [[nodiscard]] std::span<const InstanceBatch> Batches()   const { return mBatcher.Batches(); }
+    [[nodiscard]] std::span<const InstanceData>  Instances() const { return mBatcher.Instances(); }
+    [[nodiscard]] size_t                         VisibleCount() const { return mVisible.size(); }
+
+private:
+    Float4x4              mMeshDequant = MatrixIdentity();
+    FrustumCuller         mCuller;  // cell bounds (static)
+    std::vector<uint32_t> mVisible; // cell ids, rebuilt every Update()
+    InstanceBatcher       mBatcher;
+};
@@ -0,0 +1,301 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// RenderGraphBuilder
+// ---------------------------------------------------------------------------
+
+ResourceHandle RenderGraphBuilder::CreateTexture(std::string_view name, const TextureDesc& desc) {
+    return mGraph.AddResource(name, &desc, nullptr, false);
+}
+
+ResourceHandle RenderGraphBuilder::CreateBuffer(std::string_view name, const BufferDesc& desc) {
+    return mGraph.AddResource(name, nullptr, &desc, false);
+}
+
+ResourceHandle RenderGraphBuilder::Read(ResourceHandle resource, ResourceUsage usage) {
+    return mGraph.AddAccess(mPass, resource, usage, false);
+}
+
+ResourceHandle RenderGraphBuilder::Write(ResourceHandle resource, ResourceUsage usage) {
+    return mGraph.AddAccess(mPass, resource, usage, true);
+}
+
+void RenderGraphBuilder::SetSideEffect() {
+    mGraph.mPasses[mPass].sideEffect = true;
+}
+
+// ---------------------------------------------------------------------------
+// Declaration
+// ---------------------------------------------------------------------------
+
+void RenderGraph::Reset() {
+    mResources.clear();
+    mPasses.clear();
+    mAccesses.clear();
+    mValid = true;
+
+    mProducers.clear();
+    mEdges.clear();
+    mSchedule.clear();
+    mLevelCount = 0;
+    mLifetimes.clear();
+    mFirstUseBegin.clear();
+    mLastUseBegin.clear();
+    mFirstUses.clear();
+    mLastUses.clear();
+}
+
+ResourceHandle RenderGraph::ImportTexture(std::string_view name, const TextureDesc& desc) {
+    return AddResource(name, &desc, nullptr, true);
+}
+
+ResourceHandle RenderGraph::ImportBuffer(std::string_view name, const BufferDesc& desc) {
+    return AddResource(name, nullptr, &desc, true);
+}
+
+ResourceHandle RenderGraph::AddResource(std::string_view   name,
+                                        const TextureDesc* texture,
+                                        const BufferDesc*  buffer,
+                                        bool               imported) {
+    Resource& r = mResources.emplace_back();
+    r.name     = name;
+    r.texture  = texture != nullptr;
+    r.imported = imported;
+    if (texture) r.textureDesc = *texture;
+    if (buffer)  r.bufferDesc  = *buffer;
+    return { static_cast<uint32_t>(mResources.size() - 1) };
+}
+
+uint32_t RenderGraph::BeginPass(std::string_view name, ExecuteFn execute) {
+    Pass& pass = mPasses.emplace_back();
+    pass.name        = name;
+    pass.execute     = std::move(execute);
+    pass.accessBegin = static_cast<uint32_t>(mAccesses.size());
+    pass.accessEnd   = pass.accessBegin;
+    return static_cast<uint32_t>(mPasses.size() - 1);
+}
+
+ResourceHandle RenderGraph::AddAccess(uint32_t pass, ResourceHandle resource,
+                                      ResourceUsage usage, bool write) {
+    // Accesses of one pass are contiguous because setup runs inside AddPass().
+    if (!resource.IsValid() || resource.index >= mResources.size()) {
+        mValid = false;
+        return {};
+    }
+
+    mAccesses.push_back({ resource, usage, write });
+    mPasses[pass].accessEnd = static_cast<uint32_t>(mAccesses.size());
+    if (write && mResources[resource.index].imported) mPasses[pass].sideEffect = true;
+    return resource;
+}
+
+std::span<const PassAccess> RenderGraph::Accesses(uint32_t pass) const {
+    const Pass& p = mPasses[pass];
+    return std::span<const PassAccess>(mAccesses).subspan(p.accessBegin, p.accessEnd - p.accessBegin);
+}
+
+std::span<const uint32_t> RenderGraph::Dependencies(uint32_t pass) const {
+    const Pass& p = mPasses[pass];
+    return std::span<const uint32_t>(mEdges).subspan(p.edgeBegin, p.edgeEnd - p.edgeBegin);
+}
+
+std::span<const ResourceHandle> RenderGraph::FirstUses(uint32_t position) const {
+    const uint32_t begin = mFirstUseBegin[position];
+    return std::span<const ResourceHandle>(mFirstUses).subspan(begin, mFirstUseBegin[position + 1] - begin);
+}
+
+std::span<const ResourceHandle> RenderGraph::LastUses(uint32_t position) const {
+    const uint32_t begin = mLastUseBegin[position];
+    return std::span<const ResourceHandle>(mLastUses).subspan(begin, mLastUseBegin[position + 1] - begin);
+}
+
+// ---------------------------------------------------------------------------
+// Compile
+// ---------------------------------------------------------------------------
+
+bool RenderGraph::Compile() {
+    mProducers.clear();
+    mEdges.clear();
+    mSchedule.clear();
+    mLevelCount = 0;
+    mLifetimes.assign(mResources.size(), {});
+
+    if (!mValid || !LinkProducers()) return false;
+
+    CullPasses();
+    BuildEdges();
+    SchedulePasses();
+    ComputeLifetimes();
+    return true;
+}
+
+// Step 1: for every read, the pass that wrote the version being read.
+bool RenderGraph::LinkProducers() {
+    mLastWriter.assign(mResources.size(), kNone);
+    mEdgeStamp.assign(mPasses.size(), kNone);
+
+    for (uint32_t p = 0; p < mPasses.size(); ++p) {
+        Pass& pass = mPasses[p];
+        pass.producerBegin = static_cast<uint32_t>(mProducers.size());
+
+        // Reads first: a pass that reads and writes a resource reads the
+        // previous version, not its own output.
+        for (uint32_t a = pass.accessBegin; a < pass.accessEnd; ++a) {
+            const PassAccess& access = mAccesses[a];
+            if (access.write) continue;
+
+            const uint32_t r      = access.resource.index;
+            const uint32_t writer = mLastWriter[r];
+            if (writer == kNone) {
+                if (!mResources[r].imported) return false; // undefined contents
+                continue;
+            }
+            if (mEdgeStamp[writer] == p) continue;
+            mEdgeStamp[writer] = p;
+            mProducers.push_back(writer);
+        }
+        for (uint32_t a = pass.accessBegin; a < pass.accessEnd; ++a) {
+            if (mAccesses[a].write) mLastWriter[mAccesses[a].resource.index] = p;
+        }
+
+        pass.producerEnd = static_cast<uint32_t>(mProducers.size());
+    }
+    return true;
+}
+
+// Step 2: walk backwards from the side effects. Producers always precede
+// their consumers, so one reverse sweep sees every consumer of a pass
+// before the pass itself.
+void RenderGraph::CullPasses() {
+    for (Pass& pass : mPasses) pass.live = false;
+
+    for (uint32_t p = static_cast<uint32_t>(mPasses.size()); p-- > 0;) {
+        Pass& pass = mPasses[p];
+        pass.live  = pass.live || pass.sideEffect;
+        if (!pass.live) continue;
+
+        for (uint32_t i = pass.producerBegin; i < pass.producerEnd; ++i)
+            mPasses[mProducers[i]].live = true;
+    }
+}
+
+// Step 3: hazards between surviving passes. Culled passes are skipped
+// entirely so that, e.g., two surviving writers of a resource are linked
+// directly rather than through a culled writer between them.
+void RenderGraph::BuildEdges() {
+    mLastWriter.assign(mResources.size(), kNone);
+    mReaderHead.assign(mResources.size(), kNone);
+    mReaderNodes.clear();
+    mEdgeStamp.assign(mPasses.size(), kNone);
+
+    for (uint32_t p = 0; p < mPasses.size(); ++p) {
+        Pass& pass = mPasses[p];
+        pass.edgeBegin = static_cast<uint32_t>(mEdges.size());
+        pass.level     = 0;
+
+        if (pass.live) {
+            const auto addEdge = [&](uint32_t from) {
+                if (from == kNone || from == p || mEdgeStamp[from] == p) return;
+                mEdgeStamp[from] = p;
+                mEdges.push_back(from);
+                pass.level = std::max(pass.level, mPasses[from].level + 1);
+            };
+
+            // Read after write
+            for (uint32_t a = pass.accessBegin; a < pass.accessEnd; ++a) {
+                if (!mAccesses[a].write) addEdge(mLastWriter[mAccesses[a].resource.index]);
+            }
+
+            // Write after write / write after read
+            for (uint32_t a = pass.accessBegin; a < pass.accessEnd; ++a) {
+                if (!mAccesses[a].write) continue;
+                const uint32_t r = mAccesses[a].resource.index;
+                addEdge(mLastWriter[r]);
+                for (uint32_t n = mReaderHead[r]; n != kNone; n = mReaderNodes[n].next)
+                    addEdge(mReaderNodes[n].pass);
+                mLastWriter[r] = p;
+                mReaderHead[r] = kNone;
+            }
+
+            for (uint32_t a = pass.accessBegin; a < pass.accessEnd; ++a) {
+                if (mAccesses[a].write) continue;
+                const uint32_t r = mAccesses[a].resource.index;
+                mReaderNodes.push_back({ p, mReaderHead[r] });
+                mReaderHead[r] = static_cast<uint32_t>(mReaderNodes.size() - 1);
+            }
+        }
+
+        pass.edgeEnd = static_cast<uint32_t>(mEdges.size());
+    }
+}
+
+// Step 4: counting sort of the surviving passes by dependency level. Every
+// edge goes from a lower to a higher level, so the result is a topological
+// order; within a level the passes are independent.
+void RenderGraph::SchedulePasses() {
+    uint32_t liveCount = 0;
+    for (const Pass& pass : mPasses) {
+        if (!pass.live) continue;
+        ++liveCount;
+        mLevelCount = std::max(mLevelCount, pass.level + 1);
+    }
+
+    mLevelStart.assign(mLevelCount + 1, 0);
+    for (const Pass& pass : mPasses) {
+        if (pass.live) ++mLevelStart[pass.level + 1];
+    }
+    for (uint32_t l = 0; l < mLevelCount; ++l) mLevelStart[l + 1] += mLevelStart[l];
+
+    mSchedule.resize(liveCount);
+    for (uint32_t p = 0; p < mPasses.size(); ++p) {
+        if (mPasses[p].live) mSchedule[mLevelStart[mPasses[p].level]++] = p;
+    }
+}
+
+// Step 5: first/last schedule position per resource, then the transients
+// bucketed by the position where they begin and end.
+void RenderGraph::ComputeLifetimes() {
+    mLifetimes.assign(mResources.size(), {});
+
+    const uint32_t positions = static_cast<uint32_t>(mSchedule.size());
+    for (uint32_t pos = 0; pos < positions; ++pos) {
+        for (const PassAccess& access : Accesses(mSchedule[pos])) {
+            ResourceLifetime& life = mLifetimes[access.resource.index];
+            if (!life.IsUsed()) life.first = pos;
+            life.last = pos;
+        }
+    }
+
+    // Two-pass bucket fill: counts land at [pos + 2]; after the prefix sum
+    // [pos + 1] is the insert cursor of pos and ends up as its end offset.
+    const auto bucket = [&](std::vector<uint32_t>& begin, std::vector<ResourceHandle>& out,
+                            uint32_t ResourceLifetime::*end) {
+        begin.assign(positions + 2, 0);
+        out.clear();
+        for (uint32_t r = 0; r < mResources.size(); ++r) {
+            if (mResources[r].imported || !mLifetimes[r].IsUsed()) continue;
+            ++begin[mLifetimes[r].*end + 2];
+        }
+        for (uint32_t i = 2; i < begin.size(); ++i) begin[i] += begin[i - 1];
+
+        out.resize(begin.back());
+        for (uint32_t r = 0; r < mResources.size(); ++r) {
+            if (mResources[r].imported || !mLifetimes[r].IsUsed()) continue;
+            out[begin[mLifetimes[r].*end + 1]++] = { r };
+        }
+    };
+    bucket(mFirstUseBegin, mFirstUses, &ResourceLifetime::first);
+    bucket(mLastUseBegin,  mLastUses,  &ResourceLifetime::last);
+}
+
+// ---------------------------------------------------------------------------
+// Execute
+// ---------------------------------------------------------------------------
+
+void RenderGraph::Execute() const {
+    for (uint32_t p : mSchedule) {
+        if (mPasses[p].execute) mPasses[p].execute();
+    }
+}
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// How a pass uses a resource. The backend maps each usage to an API state
+// (e.g. RenderTarget -> D3D12_RESOURCE_STATE_RENDER_TARGET).
+enum class ResourceUsage : uint8_t {
+    ShaderResource,
+    RenderTarget,
+    DepthWrite,
+    DepthRead,
+    UnorderedAccess,
+    CopySource,
+    CopyDest,
+    Present,
+};
+
+// Index of a resource inside one RenderGraph.
+struct ResourceHandle {
+    static constexpr uint32_t kInvalid = ~0u;
+
+    uint32_t index = kInvalid;
+
+    [[nodiscard]] bool IsValid() const { return index != kInvalid; }
+};
+
+struct TextureDesc {
+    uint32_t width     = 0;
+    uint32_t height    = 0;
+    uint16_t mipLevels = 1;
+    uint16_t arraySize = 1;
+    uint32_t format    = 0; // DXGI_FORMAT value
+};
+
+struct BufferDesc {
+    uint64_t size = 0;
+};
+
+// One Read()/Write() declaration of a pass.
+struct PassAccess {
+    ResourceHandle resource;
+    ResourceUsage  usage;
+    bool           write;
+};
+
+// Range of schedule positions (indices into RenderGraph::Schedule()) during
+// which a resource must exist. Both ends are inclusive.
+struct ResourceLifetime {
+    static constexpr uint32_t kUnused = ~0u;
+
+    uint32_t first = kUnused;
+    uint32_t last  = kUnused;
+
+    [[nodiscard]] bool IsUsed() const { return first != kUnused; }
+};
+
+class RenderGraph;
+
+// ---------------------------------------------------------------------------
+// RenderGraphBuilder — handed to a pass's setup callback to declare what the
+// pass reads, writes and creates. Only valid during that callback.
+// ---------------------------------------------------------------------------
+class RenderGraphBuilder {
+public:
+    // Transient resources: owned by the graph, alive from first to last use.
+    ResourceHandle CreateTexture(std::string_view name, const TextureDesc& desc);
+    ResourceHandle CreateBuffer(std::string_view name, const BufferDesc& desc);
+
+    ResourceHandle Read(ResourceHandle resource, ResourceUsage usage = ResourceUsage::ShaderResource);
+    ResourceHandle Write(ResourceHandle resource, ResourceUsage usage = ResourceUsage::RenderTarget);
+
+    // Never cull this pass, even if nothing reads its outputs (readback,
+    // queries, debug output...).
+    void SetSideEffect();
+
+private:
+    friend class RenderGraph;
+    RenderGraphBuilder(RenderGraph& graph, uint32_t pass) : mGraph(graph), mPass(pass) {}
+
+    RenderGraph& mGraph;
+    uint32_t     mPass;
+};
+
+// ---------------------------------------------------------------------------
+// RenderGraph — API-agnostic frame graph (Phase 11-1).
+//
+// Passes are declared in submission order; each declares the resources it
+// reads and writes. Declaration order defines the meaning of the frame: a
+// read sees the most recent earlier write. Compile() then
+//   1. links every read to the pass that produced the data,
+//   2. culls passes whose outputs are never consumed — a pass survives if it
+//      has a side effect, writes an imported resource, or feeds a survivor,
+//   3. builds the DAG over the surviving passes (read-after-write,
+//      write-after-read and write-after-write edges),
+//   4. schedules it topologically by dependency level: a pass runs one level
+//      after its deepest predecessor, so each level is a set of mutually
+//      independent passes (ties keep declaration order),
+//   5. computes each transient resource's first/last use in the schedule.
+//
+// Every edge points from an earlier to a later declaration, so the graph is
+// acyclic by construction. Resource and pass names are not copied and must
+// outlive the graph (string literals in practice). Reset() keeps capacity so
+// a graph rebuilt every frame stops allocating after warm-up.
+// ---------------------------------------------------------------------------
+class RenderGraph {
+public:
+    using ExecuteFn = std::function<void()>;
+
+    void Reset();
+
+    // External resources (swap-chain back buffer, persistent history
+    // buffers...). Writing one makes the pass a side effect.
+    ResourceHandle ImportTexture(std::string_view name, const TextureDesc& desc);
+    ResourceHandle ImportBuffer(std::string_view name, const BufferDesc& desc);
+
+    // Calls setup(RenderGraphBuilder&) immediately; `execute` runs from
+    // Execute() if the pass survives culling. Returns the pass index.
+    template <class Setup>
+    uint32_t AddPass(std::string_view name, Setup&& setup, ExecuteFn execute = {}) {
+        const uint32_t pass = BeginPass(name, std::move(execute));
+        RenderGraphBuilder builder(*this, pass);
+        setup(builder);
+        return pass;
+    }
+
+    // False if a pass used an invalid handle or read a transient resource
+    // that no earlier pass wrote.
+    [[nodiscard]] bool Compile();
+
+    // Runs the execute callbacks of the scheduled passes in order.
+    void Execute() const;
+
+    // --- Declarations ---
+    [[nodiscard]] uint32_t                    PassCount()     const { return static_cast<uint32_t>(mPasses.size()); }
+    [[nodiscard]] uint32_t                    ResourceCount() const { return static_cast<uint32_t>(mResources.size()); }
+    [[nodiscard]] std::string_view            PassName(uint32_t pass) const { return mPasses[pass].name; }
+    [[nodiscard]] std::string_view            ResourceName(ResourceHandle r) const { return mResources[r.index].name; }
+    [[nodiscard]] bool                        IsImported(ResourceHandle r) const { return mResources[r.index].imported; }
+    [[nodiscard]] bool                        IsTexture(ResourceHandle r) const { return mResources[r.index].texture; }
+    [[nodiscard]] const TextureDesc&          GetTextureDesc(ResourceHandle r) const { return mResources[r.index].textureDesc; }
+    [[nodiscard]] const BufferDesc&           GetBufferDesc(ResourceHandle r) const { return mResources[r.index].bufferDesc; }
+    [[nodiscard]] std::span<const PassAccess> Accesses(uint32_t pass) const;
+
+    // --- Compile() results ---
+    [[nodiscard]] std::span<const uint32_t> Schedule() const { return mSchedule; } // pass indices
+    [[nodiscard]] bool     IsCulled(uint32_t pass)   const { return !mPasses[pass].live; }
+    [[nodiscard]] uint32_t PassLevel(uint32_t pass)  const { return mPasses[pass].level; }
+    [[nodiscard]] uint32_t LevelCount()              const { return mLevelCount; }
+    [[nodiscard]] uint32_t CulledPassCount()         const { return PassCount() - static_cast<uint32_t>(mSchedule.size()); }
+    [[nodiscard]] uint32_t EdgeCount()               const { return static_cast<uint32_t>(mEdges.size()); }
+
+    // Predecessors of a surviving pass in the DAG.
+    [[nodiscard]] std::span<const uint32_t> Dependencies(uint32_t pass) const;
+
+    [[nodiscard]] ResourceLifetime Lifetime(ResourceHandle r) const { return mLifetimes[r.index]; }
+
+    // Transient resources whose lifetime starts / ends at a schedule position.
+    [[nodiscard]] std::span<const ResourceHandle> FirstUses(uint32_t position) const;
+    [[nodiscard]] std::span<const ResourceHandle> LastUses(uint32_t position) const;
+
+private:
+    friend class RenderGraphBuilder;
+
+    static constexpr uint32_t kNone = ~0u;
+
+    struct Resource {
+        std::string_view name;
+        TextureDesc      textureDesc;
+        BufferDesc       bufferDesc;
+        bool             texture  = false;
+        bool             imported = false;
+    };
+
+    struct Pass {
+        std::string_view name;
+        ExecuteFn        execute;
+        uint32_t         accessBegin   = 0; // into mAccesses
+        uint32_t         accessEnd     = 0;
+        uint32_t         producerBegin = 0; // into mProducers
+        uint32_t         producerEnd   = 0;
+        uint32_t         edgeBegin     = 0; // into mEdges
+        uint32_t         edgeEnd       = 0;
+        uint32_t         level         = 0;
+        bool             sideEffect    = false;
+        bool             live          = false;
+    };
+
+    uint32_t       BeginPass(std::string_view name, ExecuteFn execute);
+    ResourceHandle AddResource(std::string_view name, const TextureDesc* texture,
+                               const BufferDesc* buffer, bool imported);
+    ResourceHandle AddAccess(uint32_t pass, ResourceHandle resource, ResourceUsage usage, bool write);
+
+    [[nodiscard]] bool LinkProducers();
+    void               CullPasses();
+    void               BuildEdges();
+    void               SchedulePasses();
+    void               ComputeLifetimes();
+
+    // --- Declarations ---
+    std::vector<Resource>   mResources;
+    std::vector<Pass>       mPasses;
+    std::vector<PassAccess> mAccesses;
+    bool                    mValid = true;
+
+    // --- Compile() output ---
+    std::vector<uint32_t>         mProducers;  // per pass: passes whose data it reads
+    std::vector<uint32_t>         mEdges;      // per pass: DAG predecessors
+    std::vector<uint32_t>         mSchedule;
+    uint32_t                      mLevelCount = 0;
+    std::vector<ResourceLifetime> mLifetimes;
+    std::vector<uint32_t>         mFirstUseBegin; // per schedule position + 1, into mFirstUses
+    std::vector<uint32_t>         mLastUseBegin;
+    std::vector<ResourceHandle>   mFirstUses;
+    std::vector<ResourceHandle>   mLastUses;
+
+    // --- Compile() scratch, kept for its capacity ---
+    struct ReaderNode {
+        uint32_t pass;
+        uint32_t next;
+    };
+    std::vector<uint32_t>   mLastWriter;  // per resource
+    std::vector<uint32_t>   mReaderHead;  // per resource: readers since the last write
+    std::vector<ReaderNode> mReaderNodes;
+    std::vector<uint32_t>   mEdgeStamp;   // per pass: last pass that linked to it
+    std::vector<uint32_t>   mLevelStart;
+};
@@ -0,0 +1,247 @@
+#include "ResourceStateTracker.h"
+
+#include "RenderGraph.h"
+
+namespace {
+
+// States that only read; any combination of them is a valid state, and a
+// resource in such a combination needs no barrier to be read in one of them.
+constexpr uint32_t kReadOnlyStates = kResourceStateGenericRead | kResourceStateDepthRead;
+
+bool Satisfies(uint32_t current, uint32_t target) {
+    if (current == target) return true;
+    return target != kResourceStateCommon
+        && (current & ~kReadOnlyStates) == 0
+        && (current & target) == target;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Registration
+// ---------------------------------------------------------------------------
+
+uint32_t ResourceStateTracker::Register(void* resource, uint32_t subresourceCount, uint32_t initialState) {
+    uint32_t id;
+    if (!mFreeIds.empty()) {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    } else {
+        id = static_cast<uint32_t>(mResources.size());
+        mResources.emplace_back();
+    }
+
+    TrackedResource& res = mResources[id];
+    res.resource = resource;
+    res.live     = true;
+    res.subresources.assign(subresourceCount ? subresourceCount : 1, SubresourceState{ initialState });
+    return id;
+}
+
+// Barriers already queued for the resource are still returned by Flush().
+void ResourceStateTracker::Unregister(uint32_t id) {
+    if (id >= mResources.size() || !mResources[id].live) return;
+
+    TrackedResource& res = mResources[id];
+    res.resource = nullptr;
+    res.live     = false;
+    res.subresources.clear();
+    mFreeIds.push_back(id);
+}
+
+// ---------------------------------------------------------------------------
+// Requests
+// ---------------------------------------------------------------------------
+
+void ResourceStateTracker::Transition(uint32_t id, uint32_t state, uint32_t subresource) {
+    Request(id, state, subresource, Kind::Full);
+}
+
+void ResourceStateTracker::BeginTransition(uint32_t id, uint32_t state, uint32_t subresource) {
+    Request(id, state, subresource, Kind::Begin);
+}
+
+void ResourceStateTracker::UavBarrier(uint32_t id) {
+    ++mRequests;
+    if (id >= mResources.size() || !mResources[id].live) return;
+
+    TrackedResource& res = mResources[id];
+    ResourceBarrierDesc barrier;
+    barrier.type     = ResourceBarrierDesc::Type::Uav;
+    barrier.resource = res.resource;
+    Queue(barrier);
+
+    // A transition queued before the UAV barrier must not absorb later requests.
+    for (SubresourceState& sub : res.subresources) sub.pendingIndex = kNone;
+}
+
+void ResourceStateTracker::Request(uint32_t id, uint32_t state, uint32_t subresource, Kind kind) {
+    ++mRequests;
+    if (id >= mResources.size() || !mResources[id].live) return;
+
+    TrackedResource& res   = mResources[id];
+    const uint32_t   count = static_cast<uint32_t>(res.subresources.size());
+
+    if (subresource != kAllSubresources) {
+        if (subresource < count) Apply(res, subresource, subresource + 1, subresource, state, kind);
+        return;
+    }
+
+    // Whole resource: one ALL_SUBRESOURCES barrier while the subresources
+    // agree, otherwise one barrier per subresource that needs it.
+    if (Uniform(res)) {
+        Apply(res, 0, count, kAllSubresources, state, kind);
+        return;
+    }
+    for (uint32_t s = 0; s < count; ++s) Apply(res, s, s + 1, s, state, kind);
+}
+
+// Applies a request to subresources [first, last), which are in identical
+// tracking state; subresource `first` stands for all of them.
+void ResourceStateTracker::Apply(TrackedResource& res, uint32_t first, uint32_t last,
+                                 uint32_t barrierSubresource, uint32_t state, Kind kind) {
+    const std::span<SubresourceState> subs(res.subresources.data() + first, last - first);
+    const SubresourceState&           rep = subs.front();
+
+    ResourceBarrierDesc barrier;
+    barrier.resource    = res.resource;
+    barrier.subresource = barrierSubresource;
+
+    // --- Finish an in-flight split barrier first ---
+    if (rep.splitTarget != kNone) {
+        if (kind == Kind::Begin && state == rep.splitTarget) {
+            ++mElided;
+            return;
+        }
+
+        barrier.split  = BarrierSplit::EndOnly;
+        barrier.before = rep.state;
+        barrier.after  = rep.splitTarget;
+        Queue(barrier);
+
+        const uint32_t reached = rep.splitTarget;
+        for (SubresourceState& sub : subs) {
+            sub.state        = reached;
+            sub.splitTarget  = kNone;
+            sub.pendingIndex = kNone;
+        }
+        if (kind == Kind::Full && state == reached) return;
+    }
+
+    if (Satisfies(rep.state, state)) {
+        ++mElided;
+        return;
+    }
+
+    // --- Fold into a full barrier queued earlier in this batch ---
+    if (kind == Kind::Full && rep.pendingBatch == mBatch && rep.pendingIndex != kNone
+        && mQueued[rep.pendingIndex].subresource == barrierSubresource) {
+        ++mMerged;
+        const uint32_t       index  = rep.pendingIndex;
+        ResourceBarrierDesc& queued = mQueued[index];
+        queued.after = state;
+
+        const bool roundTrip = queued.before == state;
+        if (roundTrip) mDropped[index] = true;
+        for (SubresourceState& sub : subs) {
+            sub.state        = state;
+            sub.pendingIndex = roundTrip ? kNone : index;
+        }
+        return;
+    }
+
+    barrier.split  = kind == Kind::Begin ? BarrierSplit::BeginOnly : BarrierSplit::None;
+    barrier.before = rep.state;
+    barrier.after  = state;
+    const uint32_t index = Queue(barrier);
+
+    for (SubresourceState& sub : subs) {
+        if (kind == Kind::Begin) {
+            sub.splitTarget  = state;
+            sub.pendingIndex = kNone;
+        } else {
+            sub.state        = state;
+            sub.pendingBatch = mBatch;
+            sub.pendingIndex = index;
+        }
+    }
+}
+
+bool ResourceStateTracker::Uniform(const TrackedResource& res) const {
+    const SubresourceState& first = res.subresources.front();
+    for (const SubresourceState& sub : res.subresources) {
+        const bool firstPending = first.pendingBatch == mBatch && first.pendingIndex != kNone;
+        const bool subPending   = sub.pendingBatch == mBatch && sub.pendingIndex != kNone;
+        if (sub.state != first.state || sub.splitTarget != first.splitTarget
+            || subPending != firstPending || (subPending && sub.pendingIndex != first.pendingIndex))
+            return false;
+    }
+    return true;
+}
+
+uint32_t ResourceStateTracker::Queue(const ResourceBarrierDesc& barrier) {
+    mQueued.push_back(barrier);
+    mDropped.push_back(false);
+    return static_cast<uint32_t>(mQueued.size() - 1);
+}
+
+// ---------------------------------------------------------------------------
+// Flush / queries
+// ---------------------------------------------------------------------------
+
+std::span<const ResourceBarrierDesc> ResourceStateTracker::Flush() {
+    mFlushed.clear();
+    for (size_t i = 0; i < mQueued.size(); ++i) {
+        if (!mDropped[i]) mFlushed.push_back(mQueued[i]);
+    }
+    mQueued.clear();
+    mDropped.clear();
+    ++mBatch;
+
+    mBarriers += mFlushed.size();
+    if (!mFlushed.empty()) ++mFlushes;
+    return mFlushed;
+}
+
+uint32_t ResourceStateTracker::State(uint32_t id, uint32_t subresource) const {
+    if (id >= mResources.size() || !mResources[id].live) return kResourceStateCommon;
+    const auto& subs = mResources[id].subresources;
+    return subresource < subs.size() ? subs[subresource].state : kResourceStateCommon;
+}
+
+bool ResourceStateTracker::HasPendingSplit(uint32_t id) const {
+    if (id >= mResources.size() || !mResources[id].live) return false;
+    for (const SubresourceState& sub : mResources[id].subresources) {
+        if (sub.splitTarget != kNone) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Render graph glue
+// ---------------------------------------------------------------------------
+
+uint32_t ResourceStateForUsage(ResourceUsage usage) {
+    switch (usage) {
+    case ResourceUsage::ShaderResource:  return kResourceStateNonPixelShaderResource | kResourceStatePixelShaderResource;
+    case ResourceUsage::RenderTarget:    return kResourceStateRenderTarget;
+    case ResourceUsage::DepthWrite:      return kResourceStateDepthWrite;
+    case ResourceUsage::DepthRead:       return kResourceStateDepthRead;
+    case ResourceUsage::UnorderedAccess: return kResourceStateUnorderedAccess;
+    case ResourceUsage::CopySource:      return kResourceStateCopySource;
+    case ResourceUsage::CopyDest:        return kResourceStateCopyDest;
+    case ResourceUsage::Present:         return kResourceStatePresent;
+    }
+    return kResourceStateCommon;
+}
+
+void TransitionPassResources(ResourceStateTracker&     tracker,
+                             const RenderGraph&        graph,
+                             uint32_t                  pass,
+                             std::span<const uint32_t> trackerIds) {
+    for (const PassAccess& access : graph.Accesses(pass)) {
+        const uint32_t r = access.resource.index;
+        if (r >= trackerIds.size() || trackerIds[r] == ResourceStateTracker::kInvalidId) continue;
+        tracker.Transition(trackerIds[r], ResourceStateForUsage(access.usage));
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class RenderGraph;
+enum class ResourceUsage : uint8_t;
+
+// Resource state bits, numerically identical to D3D12_RESOURCE_STATES so the
+// tracker needs no Windows headers (D3D12StateTracker.cpp static_asserts it).
+enum ResourceState : uint32_t {
+    kResourceStateCommon                  = 0,
+    kResourceStateVertexAndConstantBuffer = 0x1,
+    kResourceStateIndexBuffer             = 0x2,
+    kResourceStateRenderTarget            = 0x4,
+    kResourceStateUnorderedAccess         = 0x8,
+    kResourceStateDepthWrite              = 0x10,
+    kResourceStateDepthRead               = 0x20,
+    kResourceStateNonPixelShaderResource  = 0x40,
+    kResourceStatePixelShaderResource     = 0x80,
+    kResourceStateIndirectArgument        = 0x200,
+    kResourceStateCopyDest                = 0x400,
+    kResourceStateCopySource              = 0x800,
+    kResourceStateGenericRead             = 0x1 | 0x2 | 0x40 | 0x80 | 0x200 | 0x800,
+    kResourceStatePresent                 = 0,
+};
+
+// D3D12_RESOURCE_BARRIER_FLAGS
+enum class BarrierSplit : uint8_t {
+    None,
+    BeginOnly,
+    EndOnly,
+};
+
+// One barrier of a flushed batch, in API-neutral form.
+struct ResourceBarrierDesc {
+    enum class Type : uint8_t { Transition, Uav };
+
+    Type         type        = Type::Transition;
+    BarrierSplit split       = BarrierSplit::None;
+    void*        resource    = nullptr; // ID3D12Resource*
+    uint32_t     subresource = 0;       // or ResourceStateTracker::kAllSubresources
+    uint32_t     before      = kResourceStateCommon;
+    uint32_t     after       = kResourceStateCommon;
+};
+
+// ---------------------------------------------------------------------------
+// ResourceStateTracker — knows the current state of every registered
+// resource (per subresource when they diverge) and turns "make this
+// resource X" requests into barrier batches.
+//
+// Requests are queued until Flush(), which returns the batch for a single
+// ResourceBarrier call. Within a batch, a second request for the same
+// subresource folds into the queued barrier (A->B then B->C becomes A->C,
+// A->B then B->A vanishes), so callers can request states freely.
+// Requests already satisfied are dropped: same state, or a read-only
+// target contained in the current combined read state.
+//
+// Split barriers: BeginTransition() queues a BEGIN_ONLY half; the matching
+// END_ONLY half is emitted by the next Transition() of that subresource, so
+// the GPU may overlap the transition with the work recorded in between.
+//
+// Pure bookkeeping: no device, no command list. D3D12StateTracker.h turns
+// a flushed batch into D3D12_RESOURCE_BARRIERs.
+// ---------------------------------------------------------------------------
+class ResourceStateTracker {
+public:
+    // D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+    static constexpr uint32_t kAllSubresources = 0xFFFFFFFFu;
+    static constexpr uint32_t kInvalidId       = ~0u;
+
+    // `resource` is opaque to the tracker and copied into each barrier.
+    [[nodiscard]] uint32_t Register(void* resource, uint32_t subresourceCount, uint32_t initialState);
+    void                   Unregister(uint32_t id);
+
+    void Transition(uint32_t id, uint32_t state, uint32_t subresource = kAllSubresources);
+    void BeginTransition(uint32_t id, uint32_t state, uint32_t subresource = kAllSubresources);
+    void UavBarrier(uint32_t id);
+
+    // Returns the queued batch (empty if nothing is pending) and starts a
+    // new one. The span stays valid until the next Flush().
+    [[nodiscard]] std::span<const ResourceBarrierDesc> Flush();
+
+    // Current state of one subresource as recorded so far; while a split
+    // barrier is in flight this is still the "before" state.
+    [[nodiscard]] uint32_t State(uint32_t id, uint32_t subresource = 0) const;
+    [[nodiscard]] bool     HasPendingSplit(uint32_t id) const;
+
+    // --- Statistics (since construction) ---
+    [[nodiscard]] uint64_t RequestCount()  const { return mRequests; }
+    [[nodiscard]] uint64_t ElidedCount()   const { return mElided; }   // already in the requested state
+    [[nodiscard]] uint64_t MergedCount()   const { return mMerged; }   // folded into a queued barrier
+    [[nodiscard]] uint64_t BarrierCount()  const { return mBarriers; } // emitted by Flush()
+    [[nodiscard]] uint64_t FlushCount()    const { return mFlushes; }  // non-empty batches
+
+private:
+    static constexpr uint32_t kNone = ~0u;
+
+    struct SubresourceState {
+        uint32_t state        = kResourceStateCommon;
+        uint32_t splitTarget  = kNone; // BEGIN_ONLY queued, END_ONLY not yet
+        uint32_t pendingBatch = kNone; // batch and index of the last queued
+        uint32_t pendingIndex = kNone; //   full barrier touching this subresource
+    };
+
+    struct TrackedResource {
+        void*                         resource = nullptr;
+        std::vector<SubresourceState> subresources;
+        bool                          live     = false;
+    };
+
+    enum class Kind : uint8_t { Full, Begin };
+
+    void Request(uint32_t id, uint32_t state, uint32_t subresource, Kind kind);
+    void Apply(TrackedResource& res, uint32_t first, uint32_t last, uint32_t barrierSubresource,
+               uint32_t state, Kind kind);
+    [[nodiscard]] bool Uniform(const TrackedResource& res) const;
+    uint32_t           Queue(const ResourceBarrierDesc& barrier);
+
+    std::vector<TrackedResource> mResources;
+    std::vector<uint32_t>        mFreeIds;
+
+    std::vector<ResourceBarrierDesc> mQueued;  // may contain folded-away entries
+    std::vector<bool>                mDropped; // parallel to mQueued
+    std::vector<ResourceBarrierDesc> mFlushed;
+    uint32_t                         mBatch = 0;
+
+    uint64_t mRequests = 0;
+    uint64_t mElided   = 0;
+    uint64_t mMerged   = 0;
+    uint64_t mBarriers = 0;
+    uint64_t mFlushes  = 0;
+};
+
+// State a render-graph access needs (ResourceUsage -> ResourceState).
+[[nodiscard]] uint32_t ResourceStateForUsage(ResourceUsage usage);
+
+// Requests the states every access of `pass` needs. `trackerIds` maps graph
+// resource indices to tracker ids (kInvalidId: not tracked).
+void TransitionPassResources(ResourceStateTracker&     tracker,
+                             const RenderGraph&        graph,
+                             uint32_t                  pass,
+                             std::span<const uint32_t> trackerIds);
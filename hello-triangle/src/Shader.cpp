@@ -1,50 +1,23 @@
 #include "Shader.h"
 
-#include <fstream>
-
-namespace {
-
-std::vector<std::byte> ReadBinaryFile(const std::filesystem::path& path) {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
-    if (!file) return {};
-
-    const std::streampos end = file.tellg();
-    if (end <= 0) return {}; // tellg() failure returns streampos(-1)
-    const auto size = static_cast<std::size_t>(end);
-
-    file.seekg(0, std::ios::beg);
-    if (!file) return {};
-
-    std::vector<std::byte> buf(size);
-    if (!file.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(size))) {
-        return {};
-    }
-    return buf;
-}
-
-} // namespace
-
-bool VertexShader::Load(ID3D11Device* device, const std::filesystem::path& csoPath) {
-    if (device == nullptr) return false;
-    mBytecode = ReadBinaryFile(csoPath);
-    if (mBytecode.empty()) return false;
+bool VertexShader::Load(ID3D11Device* device, std::span<const std::byte> bytecode) {
+    if (device == nullptr || bytecode.empty()) return false;
 
+    mBytecode = bytecode;
     return SUCCEEDED(device->CreateVertexShader(
-        mBytecode.data(),
-        mBytecode.size(),
+        bytecode.data(),
+        bytecode.size(),
         nullptr,
         mShader.GetAddressOf()
     ));
 }
 
-bool PixelShader::Load(ID3D11Device* device, const std::filesystem::path& csoPath) {
-    if (device == nullptr) return false;
-    mBytecode = ReadBinaryFile(csoPath);
-    if (mBytecode.empty()) return false;
+bool PixelShader::Load(ID3D11Device* device, std::span<const std::byte> bytecode) {
+    if (device == nullptr || bytecode.empty()) return false;
 
     return SUCCEEDED(device->CreatePixelShader(
-        mBytecode.data(),
-        mBytecode.size(),
+        bytecode.data(),
+        bytecode.size(),
         nullptr,
         mShader.GetAddressOf()
     ));
@@ -4,14 +4,14 @@
 #include <wrl/client.h>
 
 #include <cstddef>
-#include <filesystem>
-#include <vector>
+#include <span>
 
-// Loads a compiled shader object (.cso) and creates a vertex shader.
-// Retains the bytecode so D3DApp can use it for CreateInputLayout.
+// Creates a vertex shader from compiled bytecode (.cso contents), normally
+// a view into a mapped ShaderArchive. The bytecode is referenced, not
+// copied: it must stay alive while D3DApp uses it for CreateInputLayout.
 class VertexShader {
 public:
-    [[nodiscard]] bool  Load(ID3D11Device* device, const std::filesystem::path& csoPath);
+    [[nodiscard]] bool  Load(ID3D11Device* device, std::span<const std::byte> bytecode);
 
     ID3D11VertexShader* Get()          const { return mShader.Get(); }
     const void*         Bytecode()     const { return mBytecode.data(); }
@@ -19,17 +19,16 @@ public:
 
 private:
     Microsoft::WRL::ComPtr<ID3D11VertexShader> mShader;
-    std::vector<std::byte>                     mBytecode;
+    std::span<const std::byte>                 mBytecode;
 };
 
-// Loads a compiled shader object (.cso) and creates a pixel shader.
+// Creates a pixel shader from compiled bytecode (.cso contents).
 class PixelShader {
 public:
-    [[nodiscard]] bool Load(ID3D11Device* device, const std::filesystem::path& csoPath);
+    [[nodiscard]] bool Load(ID3D11Device* device, std::span<const std::byte> bytecode);
 
     ID3D11PixelShader* Get() const { return mShader.Get(); }
 
 private:
     Microsoft::WRL::ComPtr<ID3D11PixelShader> mShader;
-    std::vector<std::byte>                    mBytecode;
 };
@@ -0,0 +1,225 @@
+#include "ShaderArchive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace {
+
+constexpr char   kMagic[4]   = { 'S', 'H', 'A', 'R' };
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kIndexEntry = 24; // name offset, name length, data offset, data size
+
+void PutU32(std::vector<std::byte>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+void PutU64(std::vector<std::byte>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+uint32_t GetU32(const std::byte* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return value;
+}
+
+uint64_t GetU64(const std::byte* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return value;
+}
+
+bool IsPowerOfTwo(uint32_t value) { return value != 0 && (value & (value - 1)) == 0; }
+
+std::string_view AsText(const std::byte* p, size_t size) {
+    return { reinterpret_cast<const char*>(p), size };
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ShaderArchive
+// ---------------------------------------------------------------------------
+
+bool ShaderArchive::Open(const std::filesystem::path& path) {
+    Close();
+    if (!mFile.Open(path)) return false;
+    if (OpenMemory(mFile.Bytes())) return true;
+    mFile.Close();
+    return false;
+}
+
+bool ShaderArchive::OpenMemory(std::span<const std::byte> image) {
+    mImage = {};
+    mCount = 0;
+
+    if (image.size() < kHeaderSize) return false;
+    const std::byte* p = image.data();
+    if (std::memcmp(p, kMagic, sizeof(kMagic)) != 0) return false;
+    if (GetU32(p + 4) != kFormatVersion)             return false;
+
+    const uint32_t count       = GetU32(p + 8);
+    const uint32_t alignment   = GetU32(p + 12);
+    const uint64_t namesOffset = GetU64(p + 16);
+    const uint64_t namesSize   = GetU64(p + 24);
+    if (!IsPowerOfTwo(alignment)) return false;
+
+    // Every range is checked as "offset <= size && length <= size - offset"
+    // so nothing can overflow.
+    const uint64_t size = image.size();
+    if (uint64_t{ count } > (size - kHeaderSize) / kIndexEntry)  return false;
+    if (namesOffset > size || namesSize > size - namesOffset)    return false;
+
+    std::string_view previous;
+    for (uint32_t i = 0; i < count; ++i) {
+        const std::byte* e          = p + kHeaderSize + size_t{ i } * kIndexEntry;
+        const uint32_t   nameOffset = GetU32(e);
+        const uint32_t   nameLength = GetU32(e + 4);
+        const uint64_t   dataOffset = GetU64(e + 8);
+        const uint64_t   dataSize   = GetU64(e + 16);
+
+        if (nameLength == 0 || nameOffset > namesSize || nameLength > namesSize - nameOffset)
+            return false;
+        if (dataOffset > size || dataSize > size - dataOffset) return false;
+        if (dataOffset % alignment != 0)                       return false;
+
+        // Strictly ascending: sorted for the binary search, and no duplicates.
+        const std::string_view name = AsText(p + namesOffset + nameOffset, nameLength);
+        if (i > 0 && !(previous < name)) return false;
+        previous = name;
+    }
+
+    mImage = image;
+    mCount = count;
+    return true;
+}
+
+void ShaderArchive::Close() {
+    mImage = {};
+    mCount = 0;
+    mFile.Close();
+}
+
+std::string_view ShaderArchive::Name(uint32_t i) const {
+    if (i >= mCount) return {};
+    const std::byte* p = mImage.data();
+    const std::byte* e = p + kHeaderSize + size_t{ i } * kIndexEntry;
+    return AsText(p + GetU64(p + 16) + GetU32(e), GetU32(e + 4));
+}
+
+std::span<const std::byte> ShaderArchive::Data(uint32_t i) const {
+    if (i >= mCount) return {};
+    const std::byte* e = mImage.data() + kHeaderSize + size_t{ i } * kIndexEntry;
+    return mImage.subspan(GetU64(e + 8), GetU64(e + 16));
+}
+
+std::span<const std::byte> ShaderArchive::Find(std::string_view name) const {
+    // Lower bound over the index; names compare byte-wise like the builder's sort.
+    uint32_t first = 0;
+    uint32_t count = mCount;
+    while (count > 0) {
+        const uint32_t half = count / 2;
+        if (Name(first + half) < name) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    if (first < mCount && Name(first) == name) return Data(first);
+    return {};
+}
+
+// ---------------------------------------------------------------------------
+// ShaderArchiveBuilder
+// ---------------------------------------------------------------------------
+
+bool ShaderArchiveBuilder::Add(std::string_view name, std::span<const std::byte> data) {
+    if (name.empty() || name.size() > UINT32_MAX) return false;
+    if (!mNames.emplace(name).second) return false;
+    mEntries.push_back({ std::string(name), { data.begin(), data.end() } });
+    return true;
+}
+
+std::vector<std::byte> ShaderArchiveBuilder::Build(uint32_t alignment) const {
+    if (!IsPowerOfTwo(alignment)) return {};
+
+    std::vector<const Entry*> sorted;
+    sorted.reserve(mEntries.size());
+    for (const Entry& e : mEntries) sorted.push_back(&e);
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+    const auto align = [alignment](uint64_t offset) {
+        return (offset + alignment - 1) & ~uint64_t{ alignment - 1 };
+    };
+
+    // --- Layout ---
+    uint64_t namesSize = 0;
+    for (const Entry* e : sorted) namesSize += e->name.size();
+    if (namesSize > UINT32_MAX) return {}; // name offsets are 32-bit
+    const uint64_t namesOffset = kHeaderSize + sorted.size() * kIndexEntry;
+
+    std::vector<uint64_t> dataOffsets;
+    dataOffsets.reserve(sorted.size());
+    uint64_t end = namesOffset + namesSize;
+    for (const Entry* e : sorted) {
+        dataOffsets.push_back(align(end));
+        end = dataOffsets.back() + e->data.size();
+    }
+
+    // --- Header, index, names ---
+    std::vector<std::byte> out;
+    out.reserve(end);
+    for (char c : kMagic) out.push_back(static_cast<std::byte>(c));
+    PutU32(out, ShaderArchive::kFormatVersion);
+    PutU32(out, static_cast<uint32_t>(sorted.size()));
+    PutU32(out, alignment);
+    PutU64(out, namesOffset);
+    PutU64(out, namesSize);
+
+    uint32_t nameOffset = 0;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        PutU32(out, nameOffset);
+        PutU32(out, static_cast<uint32_t>(sorted[i]->name.size()));
+        PutU64(out, dataOffsets[i]);
+        PutU64(out, sorted[i]->data.size());
+        nameOffset += static_cast<uint32_t>(sorted[i]->name.size());
+    }
+    for (const Entry* e : sorted) {
+        for (char c : e->name) out.push_back(static_cast<std::byte>(c));
+    }
+
+    // --- Blobs, zero padded ---
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        out.resize(dataOffsets[i], std::byte{ 0 });
+        out.insert(out.end(), sorted[i]->data.begin(), sorted[i]->data.end());
+    }
+    return out;
+}
+
+bool ShaderArchiveBuilder::Write(const std::filesystem::path& path, uint32_t alignment) const {
+    const std::vector<std::byte> image = Build(alignment);
+    if (image.empty()) return false;
+
+    std::filesystem::path temp = path;
+    temp += ".tmp";
+    std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    // close() flushes: a failure there (e.g. a full disk) must not replace `path`.
+    file.close();
+
+    std::error_code ec;
+    if (!file) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "MappedFile.h"
+
+// ---------------------------------------------------------------------------
+// ShaderArchive — many compiled shaders (.cso) in one memory-mapped file.
+//
+// Loading a shader is a binary search over a sorted index plus a pointer
+// into the mapping: no per-shader open/seek/read and no copy. Layout
+// (little-endian):
+//
+//   char[4] magic "SHAR"            u32 kFormatVersion
+//   u32     entry count             u32 blob alignment (power of two)
+//   u64     names offset            u64 names size
+//   index, sorted by name (byte-wise): u32 name offset, u32 name length,
+//                                      u64 data offset, u64 data size
+//   names, concatenated
+//   blobs, each at a multiple of the blob alignment from the file start
+//
+// Open() checks the structure (every range inside the file, names strictly
+// ascending) but, unlike PipelineCache, keeps no checksum: hashing the whole
+// file would touch every page the mapping is meant to leave cold.
+// ---------------------------------------------------------------------------
+class ShaderArchive {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    ShaderArchive() = default;
+    ShaderArchive(const ShaderArchive&) = delete;
+    ShaderArchive& operator=(const ShaderArchive&) = delete;
+
+    // Maps `path`; any previous archive is closed first. Spans handed out
+    // earlier become invalid.
+    [[nodiscard]] bool Open(const std::filesystem::path& path);
+
+    // Uses an image already in memory (e.g. from ShaderArchiveBuilder);
+    // `image` must outlive the archive.
+    [[nodiscard]] bool OpenMemory(std::span<const std::byte> image);
+
+    void Close();
+
+    // Empty span when absent. Valid until Close() / Open().
+    [[nodiscard]] std::span<const std::byte> Find(std::string_view name) const;
+
+    [[nodiscard]] uint32_t                   EntryCount()     const { return mCount; }
+    [[nodiscard]] std::string_view           Name(uint32_t i) const; // ascending
+    [[nodiscard]] std::span<const std::byte> Data(uint32_t i) const;
+
+private:
+    MappedFile                 mFile;
+    std::span<const std::byte> mImage;
+    uint32_t                   mCount = 0;
+};
+
+// ---------------------------------------------------------------------------
+// ShaderArchiveBuilder — collects named blobs and writes a ShaderArchive
+// image. Names are unique; the output depends only on the set of entries,
+// not the order they were added in.
+// ---------------------------------------------------------------------------
+class ShaderArchiveBuilder {
+public:
+    // 64: every blob starts on its own cache line, more than the 4 bytes a
+    // DXBC container needs.
+    static constexpr uint32_t kDefaultAlignment = 64;
+
+    // Copies `data`. False for an empty or duplicate name.
+    [[nodiscard]] bool Add(std::string_view name, std::span<const std::byte> data);
+
+    // Empty when `alignment` is not a power of two.
+    [[nodiscard]] std::vector<std::byte> Build(uint32_t alignment = kDefaultAlignment) const;
+
+    // Writes a temporary file and renames it over `path`.
+    [[nodiscard]] bool Write(const std::filesystem::path& path,
+                             uint32_t alignment = kDefaultAlignment) const;
+
+    [[nodiscard]] size_t EntryCount() const { return mEntries.size(); }
+
+private:
+    struct Entry {
+        std::string            name;
+        std::vector<std::byte> data;
+    };
+    std::vector<Entry>              mEntries;
+    std::unordered_set<std::string> mNames;
+};
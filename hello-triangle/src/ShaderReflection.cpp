@@ -0,0 +1,332 @@
+#include "ShaderReflection.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Container access. All multi-byte values are little-endian; every read is
+// bounds-checked against the chunk it belongs to.
+// ---------------------------------------------------------------------------
+
+constexpr size_t kContainerHeader = 32; // "DXBC", digest[16], version, size, chunk count
+
+uint32_t GetU32(const std::byte* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return value;
+}
+
+bool HasFourCC(const std::byte* p, const char (&fourcc)[5]) {
+    return std::memcmp(p, fourcc, 4) == 0;
+}
+
+// One chunk's payload. Offsets inside chunks are relative to the payload.
+struct Chunk {
+    std::span<const std::byte> data;
+
+    [[nodiscard]] bool Has(uint64_t offset, uint64_t size) const {
+        return offset <= data.size() && size <= data.size() - offset;
+    }
+    [[nodiscard]] bool Read(uint64_t offset, uint32_t& out) const {
+        if (!Has(offset, 4)) return false;
+        out = GetU32(data.data() + offset);
+        return true;
+    }
+    // NUL-terminated string at `offset`; the view excludes the terminator.
+    [[nodiscard]] bool ReadString(uint32_t offset, std::string_view& out) const {
+        if (offset >= data.size()) return false;
+        const auto* begin = reinterpret_cast<const char*>(data.data() + offset);
+        const auto* end   = static_cast<const char*>(std::memchr(begin, 0, data.size() - offset));
+        if (end == nullptr) return false;
+        out = { begin, static_cast<size_t>(end - begin) };
+        return true;
+    }
+};
+
+// --- Signatures ---
+
+enum class SignatureLayout { kBasic, kStream, kFull }; // ISGN / OSG5 / ISG1
+
+bool ParseSignature(const Chunk& chunk, SignatureLayout layout, std::vector<SignatureElement>& out) {
+    uint32_t count = 0, first = 0;
+    if (!chunk.Read(0, count) || !chunk.Read(4, first)) return false;
+
+    const uint32_t stride = layout == SignatureLayout::kBasic ? 24 : layout == SignatureLayout::kStream ? 28 : 32;
+    if (!chunk.Has(first, uint64_t{ count } * stride)) return false;
+
+    out.clear();
+    out.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t         at = first + uint64_t{ i } * stride;
+        SignatureElement e;
+        if (layout != SignatureLayout::kBasic) {
+            e.stream = GetU32(chunk.data.data() + at);
+            at += 4;
+        }
+        const std::byte* p = chunk.data.data() + at;
+        if (!chunk.ReadString(GetU32(p), e.semanticName)) return false;
+        e.semanticIndex = GetU32(p + 4);
+        e.systemValue   = GetU32(p + 8);
+        const uint32_t componentType = GetU32(p + 12);
+        e.componentType = componentType <= 3 ? static_cast<SignatureComponent>(componentType)
+                                             : SignatureComponent::Unknown;
+        e.reg           = GetU32(p + 16);
+        e.mask          = static_cast<uint8_t>(p[20]);
+        e.readWriteMask = static_cast<uint8_t>(p[21]);
+        if (layout == SignatureLayout::kFull) e.minPrecision = GetU32(p + 24);
+        out.push_back(e);
+    }
+    return true;
+}
+
+// --- Resource definitions ---
+
+constexpr uint32_t kSitConstantBuffer = 0; // D3D_SIT_CBUFFER
+constexpr uint32_t kSvfUsed           = 2; // D3D_SVF_USED
+
+bool ParseResourceDefinitions(const Chunk& chunk,
+                              std::vector<ShaderConstantBuffer>&  constantBuffers,
+                              std::vector<ShaderResourceBinding>& resources) {
+    uint32_t cbCount = 0, cbOffset = 0, bindCount = 0, bindOffset = 0, version = 0;
+    if (!chunk.Read(0, cbCount) || !chunk.Read(4, cbOffset) ||
+        !chunk.Read(8, bindCount) || !chunk.Read(12, bindOffset) || !chunk.Read(16, version))
+        return false;
+
+    // Shader model 5 added texture / sampler ranges to variables (RD11) and
+    // 5.1 register spaces to bindings.
+    const uint32_t minor       = version & 0xFF;
+    const uint32_t major       = (version >> 8) & 0xFF;
+    const uint32_t varStride   = major >= 5 ? 40 : 24;
+    const uint32_t bindStride  = (major > 5 || (major == 5 && minor >= 1)) ? 40 : 32;
+    constexpr uint32_t kCbStride = 24;
+
+    // --- Bindings ---
+    if (!chunk.Has(bindOffset, uint64_t{ bindCount } * bindStride)) return false;
+    resources.clear();
+    resources.reserve(bindCount);
+    for (uint32_t i = 0; i < bindCount; ++i) {
+        const std::byte*      p = chunk.data.data() + bindOffset + uint64_t{ i } * bindStride;
+        ShaderResourceBinding r;
+        if (!chunk.ReadString(GetU32(p), r.name)) return false;
+        r.type      = GetU32(p + 4);
+        r.bindPoint = GetU32(p + 20);
+        r.bindCount = GetU32(p + 24);
+        if (bindStride == 40) r.space = GetU32(p + 32);
+        resources.push_back(r);
+    }
+
+    // --- Constant buffers and their variables ---
+    if (!chunk.Has(cbOffset, uint64_t{ cbCount } * kCbStride)) return false;
+    constantBuffers.clear();
+    constantBuffers.resize(cbCount);
+    for (uint32_t i = 0; i < cbCount; ++i) {
+        const std::byte*      p  = chunk.data.data() + cbOffset + uint64_t{ i } * kCbStride;
+        ShaderConstantBuffer& cb = constantBuffers[i];
+        if (!chunk.ReadString(GetU32(p), cb.name)) return false;
+        const uint32_t varCount  = GetU32(p + 4);
+        const uint32_t varOffset = GetU32(p + 8);
+        cb.size                  = GetU32(p + 12);
+
+        if (!chunk.Has(varOffset, uint64_t{ varCount } * varStride)) return false;
+        cb.variables.reserve(varCount);
+        for (uint32_t v = 0; v < varCount; ++v) {
+            const std::byte* q = chunk.data.data() + varOffset + uint64_t{ v } * varStride;
+            ShaderVariable   var;
+            if (!chunk.ReadString(GetU32(q), var.name)) return false;
+            var.offset = GetU32(q + 4);
+            var.size   = GetU32(q + 8);
+            var.used   = (GetU32(q + 12) & kSvfUsed) != 0;
+            if (var.offset > cb.size || var.size > cb.size - var.offset) return false;
+            cb.variables.push_back(var);
+        }
+
+        for (const ShaderResourceBinding& r : resources) {
+            if (r.type == kSitConstantBuffer && r.name == cb.name) cb.bindPoint = r.bindPoint;
+        }
+    }
+    return true;
+}
+
+// --- Input layouts ---
+
+constexpr uint32_t kNameVertexId   = 6; // D3D_NAME_VERTEX_ID
+constexpr uint32_t kNameInstanceId = 8; // D3D_NAME_INSTANCE_ID
+
+// DXGI_FORMAT for 1-4 32-bit components.
+uint32_t VertexFormat(SignatureComponent type, uint32_t components) {
+    static constexpr uint32_t kFloat[4] = { 41, 16, 6, 2 }; // R32_FLOAT .. R32G32B32A32_FLOAT
+    static constexpr uint32_t kUint[4]  = { 42, 17, 7, 3 }; // R32_UINT ..
+    static constexpr uint32_t kSint[4]  = { 43, 18, 8, 4 }; // R32_SINT ..
+    if (components < 1 || components > 4) return 0;
+    switch (type) {
+        case SignatureComponent::Float32: return kFloat[components - 1];
+        case SignatureComponent::UInt32:  return kUint[components - 1];
+        case SignatureComponent::SInt32:  return kSint[components - 1];
+        default:                          return 0;
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ShaderConstantBuffer
+// ---------------------------------------------------------------------------
+
+uint32_t ShaderConstantBuffer::LiveBytes() const {
+    uint32_t end = 0;
+    for (const ShaderVariable& v : variables) {
+        if (v.used) end = std::max(end, v.offset + v.size);
+    }
+    return end;
+}
+
+const ShaderVariable* ShaderConstantBuffer::FindVariable(std::string_view variable) const {
+    for (const ShaderVariable& v : variables) {
+        if (v.name == variable) return &v;
+    }
+    return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// ShaderReflection
+// ---------------------------------------------------------------------------
+
+bool ShaderReflection::Parse(std::span<const std::byte> container) {
+    *this = {};
+
+    if (container.size() < kContainerHeader || !HasFourCC(container.data(), "DXBC")) return false;
+    const std::byte* base       = container.data();
+    const uint32_t   totalSize  = GetU32(base + 24);
+    const uint32_t   chunkCount = GetU32(base + 28);
+    if (totalSize < kContainerHeader || totalSize > container.size()) return false;
+    container = container.first(totalSize);
+    if (chunkCount > (totalSize - kContainerHeader) / 4) return false;
+
+    bool haveInputs = false, haveOutputs = false;
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        // A bad chunk header rejects the container even after earlier
+        // chunks were read: clear them too.
+        const uint32_t offset = GetU32(base + kContainerHeader + size_t{ i } * 4);
+        if (offset > totalSize || totalSize - offset < 8 || GetU32(base + offset + 4) > totalSize - offset - 8) {
+            *this = {};
+            return false;
+        }
+        const uint32_t size = GetU32(base + offset + 4);
+
+        const std::byte* fourcc = base + offset;
+        const Chunk      chunk{ container.subspan(offset + 8, size) };
+
+        bool ok = true;
+        if (HasFourCC(fourcc, "ISGN") || HasFourCC(fourcc, "ISG1")) {
+            ok = !haveInputs && ParseSignature(chunk, HasFourCC(fourcc, "ISG1") ? SignatureLayout::kFull
+                                                                                 : SignatureLayout::kBasic, mInputs);
+            haveInputs = true;
+        } else if (HasFourCC(fourcc, "OSGN") || HasFourCC(fourcc, "OSG5") || HasFourCC(fourcc, "OSG1")) {
+            const SignatureLayout layout = HasFourCC(fourcc, "OSGN") ? SignatureLayout::kBasic
+                                         : HasFourCC(fourcc, "OSG5") ? SignatureLayout::kStream
+                                                                     : SignatureLayout::kFull;
+            ok = !haveOutputs && ParseSignature(chunk, layout, mOutputs);
+            haveOutputs = true;
+        } else if (HasFourCC(fourcc, "RDEF")) {
+            ok = ParseResourceDefinitions(chunk, mConstantBuffers, mResources);
+        } else if (HasFourCC(fourcc, "SHDR") || HasFourCC(fourcc, "SHEX")) {
+            uint32_t token = 0;
+            ok = chunk.Read(0, token);
+            const uint32_t type = token >> 16;
+            mStage = type <= static_cast<uint32_t>(ShaderStage::Compute) ? static_cast<ShaderStage>(type)
+                                                                         : ShaderStage::Unknown;
+            mMajor = (token >> 4) & 0xF;
+            mMinor = token & 0xF;
+        }
+        if (!ok) {
+            *this = {};
+            return false;
+        }
+    }
+    return true;
+}
+
+const ShaderConstantBuffer* ShaderReflection::FindConstantBuffer(std::string_view name) const {
+    for (const ShaderConstantBuffer& cb : mConstantBuffers) {
+        if (cb.name == name) return &cb;
+    }
+    return nullptr;
+}
+
+bool ShaderReflection::BuildInputLayout(std::vector<PipelineInputElement>& out, uint32_t vertexSlot,
+                                        std::string_view instancePrefix, uint32_t instanceSlot) const {
+    out.clear();
+
+    std::vector<const SignatureElement*> elements;
+    for (const SignatureElement& e : mInputs) {
+        if (e.systemValue != kNameVertexId && e.systemValue != kNameInstanceId) elements.push_back(&e);
+    }
+    std::stable_sort(elements.begin(), elements.end(),
+                     [](const SignatureElement* a, const SignatureElement* b) { return a->reg < b->reg; });
+
+    uint32_t vertexOffset = 0, instanceOffset = 0;
+    for (const SignatureElement* e : elements) {
+        // Components in use: up to the highest mask bit (a float3 is .xyz).
+        uint32_t components = 0;
+        for (uint32_t c = 0; c < 4; ++c) {
+            if (e->mask & (1u << c)) components = c + 1;
+        }
+        const uint32_t format = VertexFormat(e->componentType, components);
+        if (format == 0) {
+            out.clear();
+            return false;
+        }
+
+        const bool perInstance = !instancePrefix.empty() && e->semanticName.starts_with(instancePrefix);
+        uint32_t&  offset      = perInstance ? instanceOffset : vertexOffset;
+
+        PipelineInputElement element;
+        element.semanticName         = e->semanticName;
+        element.semanticIndex        = e->semanticIndex;
+        element.format               = format;
+        element.inputSlot            = perInstance ? instanceSlot : vertexSlot;
+        element.alignedByteOffset    = offset;
+        element.inputSlotClass       = perInstance ? 1 : 0;
+        element.instanceDataStepRate = perInstance ? 1 : 0;
+        out.push_back(element);
+        offset += VertexFormatBytes(format);
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Mirror validation
+// ---------------------------------------------------------------------------
+
+bool MatchesMirror(const ShaderConstantBuffer& cb, std::span<const MirrorField> fields, size_t structSize) {
+    if (fields.size() != cb.variables.size() || structSize > cb.size) return false;
+    for (const MirrorField& f : fields) {
+        const ShaderVariable* v = cb.FindVariable(f.name);
+        if (v == nullptr || v->offset != f.offset || v->size != f.size) return false;
+        if (structSize < size_t{ v->offset } + v->size) return false;
+    }
+    return true;
+}
+
+bool MatchesMirror(std::span<const PipelineInputElement> layout,
+                   std::span<const MirrorField> fields, size_t stride, uint32_t inputSlot) {
+    size_t elements = 0;
+    for (const PipelineInputElement& e : layout) {
+        if (e.inputSlot != inputSlot) continue;
+        ++elements;
+
+        std::string name(e.semanticName);
+        if (e.semanticIndex != 0) name += std::to_string(e.semanticIndex);
+
+        const auto field = std::find_if(fields.begin(), fields.end(),
+                                        [&](const MirrorField& f) { return f.name == name; });
+        const uint32_t bytes = VertexFormatBytes(e.format);
+        if (field == fields.end() || bytes == 0 || field->size != bytes) return false;
+        if (e.alignedByteOffset != field->offset)                       return false;
+        if (stride < size_t{ field->offset } + field->size)             return false;
+    }
+    return elements == fields.size();
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "PipelineCache.h" // PipelineInputElement
+
+// ---------------------------------------------------------------------------
+// Reflection data read from a DXBC container (fxc output, .cso). Enum fields
+// carry the D3D values unchanged, like GraphicsPipelineDesc. Every name is a
+// view into the container and is NUL-terminated there, so .data() can be
+// handed to D3D as a C string; the container must outlive the reflection.
+// ---------------------------------------------------------------------------
+
+// D3D_REGISTER_COMPONENT_TYPE
+enum class SignatureComponent : uint8_t {
+    Unknown = 0,
+    UInt32  = 1,
+    SInt32  = 2,
+    Float32 = 3,
+};
+
+// One element of an input or output signature (ISGN / OSGN and variants).
+struct SignatureElement {
+    std::string_view   semanticName;
+    uint32_t           semanticIndex = 0;
+    uint32_t           systemValue   = 0; // D3D_NAME; 0 = none
+    SignatureComponent componentType = SignatureComponent::Unknown;
+    uint32_t           reg           = 0;
+    uint8_t            mask          = 0; // components present (xyzw = bits 0-3)
+    uint8_t            readWriteMask = 0; // inputs: read by the shader; outputs: never written
+    uint32_t           stream        = 0; // geometry shader output stream
+    uint32_t           minPrecision  = 0; // D3D_MIN_PRECISION
+};
+
+struct ShaderVariable {
+    std::string_view name;
+    uint32_t         offset = 0; // bytes from the start of the cbuffer
+    uint32_t         size   = 0;
+    bool             used   = false; // referenced by the shader code (D3D_SVF_USED)
+};
+
+struct ShaderConstantBuffer {
+    std::string_view            name;
+    uint32_t                    size      = 0;   // declared, a multiple of 16
+    uint32_t                    bindPoint = ~0u; // b#; ~0u when not bound
+    std::vector<ShaderVariable> variables;
+
+    // Bytes up to the end of the last variable the shader reads; what an
+    // upload has to write. 0 when nothing is used.
+    [[nodiscard]] uint32_t LiveBytes() const;
+    [[nodiscard]] const ShaderVariable* FindVariable(std::string_view name) const;
+};
+
+struct ShaderResourceBinding {
+    std::string_view name;
+    uint32_t         type      = 0; // D3D_SHADER_INPUT_TYPE
+    uint32_t         bindPoint = 0;
+    uint32_t         bindCount = 0;
+    uint32_t         space     = 0; // SM 5.1+
+};
+
+// D3D10_SB_TOKENIZED_PROGRAM_TYPE
+enum class ShaderStage : uint8_t {
+    Pixel    = 0,
+    Vertex   = 1,
+    Geometry = 2,
+    Hull     = 3,
+    Domain   = 4,
+    Compute  = 5,
+    Unknown  = 0xFF,
+};
+
+// ---------------------------------------------------------------------------
+// ShaderReflection — reads the chunks of a DXBC container in place:
+// ISGN/ISG1 (inputs), OSGN/OSG1/OSG5 (outputs), RDEF (cbuffers and resource
+// bindings) and the version token of SHDR/SHEX. No D3D headers and no
+// D3DReflect, so it runs on any host, e.g. in build tools.
+//
+// Parse() bounds-checks every offset and rejects a malformed container as a
+// whole. The container checksum is not verified (D3D does that when the
+// shader is created).
+// ---------------------------------------------------------------------------
+class ShaderReflection {
+public:
+    [[nodiscard]] bool Parse(std::span<const std::byte> container);
+
+    [[nodiscard]] ShaderStage Stage()             const { return mStage; }
+    [[nodiscard]] uint32_t    ShaderModelMajor()  const { return mMajor; }
+    [[nodiscard]] uint32_t    ShaderModelMinor()  const { return mMinor; }
+
+    [[nodiscard]] std::span<const SignatureElement>      Inputs()          const { return mInputs; }
+    [[nodiscard]] std::span<const SignatureElement>      Outputs()         const { return mOutputs; }
+    [[nodiscard]] std::span<const ShaderConstantBuffer>  ConstantBuffers() const { return mConstantBuffers; }
+    [[nodiscard]] std::span<const ShaderResourceBinding> Resources()       const { return mResources; }
+
+    [[nodiscard]] const ShaderConstantBuffer* FindConstantBuffer(std::string_view name) const;
+
+    // Vertex input layout for the input signature, elements in register
+    // order. Semantics starting with `instancePrefix` (if not empty) form a
+    // per-instance stream in `instanceSlot`, the rest a per-vertex stream in
+    // `vertexSlot`; each stream is tightly packed. System values generated
+    // by the input assembler (SV_VertexID, SV_InstanceID) are left out.
+    // False for an element of unknown component type.
+    [[nodiscard]] bool BuildInputLayout(std::vector<PipelineInputElement>& out,
+                                        uint32_t         vertexSlot     = 0,
+                                        std::string_view instancePrefix = {},
+                                        uint32_t         instanceSlot   = 1) const;
+
+private:
+    ShaderStage                        mStage = ShaderStage::Unknown;
+    uint32_t                           mMajor = 0;
+    uint32_t                           mMinor = 0;
+    std::vector<SignatureElement>      mInputs;
+    std::vector<SignatureElement>      mOutputs;
+    std::vector<ShaderConstantBuffer>  mConstantBuffers;
+    std::vector<ShaderResourceBinding> mResources;
+};
+
+// ---------------------------------------------------------------------------
+// C++ mirror validation. A MirrorField describes one member of a struct
+// that mirrors shader data, e.g.
+//   { "tintColor", offsetof(PerObjectCB, tintColor), sizeof(PerObjectCB::tintColor) }
+// ---------------------------------------------------------------------------
+struct MirrorField {
+    std::string_view name;
+    uint32_t         offset = 0;
+    uint32_t         size   = 0;
+};
+
+// Each cbuffer variable has a field of the same name, offset and size and
+// vice versa; `structSize` covers every variable and fits in cb.size.
+[[nodiscard]] bool MatchesMirror(const ShaderConstantBuffer& cb,
+                                 std::span<const MirrorField> fields, size_t structSize);
+
+// Each element of `inputSlot` has a field named after its semantic (plus
+// the index when it is not 0, e.g. "TEXCOORD1") at the element's offset and
+// with the format's size, and vice versa; the elements fit in `stride`.
+[[nodiscard]] bool MatchesMirror(std::span<const PipelineInputElement> layout,
+                                 std::span<const MirrorField> fields, size_t stride,
+                                 uint32_t inputSlot = 0);
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+// Float8 — eight float lanes with one code path for every CPU-side SIMD
+// kernel (rasterizer, culling, texture and vertex processing).
+//
+//   AVX  (__AVX__, e.g. -mavx2 / /arch:AVX2)  one __m256
+//   SSE2 (any x86-64)                         two __m128
+//   otherwise                                 plain float[8]
+//
+// Comparisons return lane masks (all bits set / clear) that feed Select(),
+// And()/Or() and MoveMask(). The backend is fixed at compile time; configure
+// with -DHELLO_TRIANGLE_AVX2=ON to get the single-register path.
+// ---------------------------------------------------------------------------
+
+#if defined(__AVX__)
+    #define HT_SIMD_AVX 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define HT_SIMD_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define HT_SIMD_SCALAR 1
+#endif
+
+constexpr int kSimdWidth = 8;
+
+#if HT_SIMD_AVX
+
+struct Float8 {
+    __m256 v;
+
+    Float8() = default;
+    Float8(__m256 x) : v(x) {}
+    Float8(float s) : v(_mm256_set1_ps(s)) {}
+
+    static Float8 Load(const float* p)  { return _mm256_loadu_ps(p); }
+    void          Store(float* p) const { _mm256_storeu_ps(p, v); }
+
+    // { base, base + 1, ..., base + 7 }
+    static Float8 Ramp(float base) {
+        return _mm256_add_ps(_mm256_set1_ps(base), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+};
+
+inline Float8 operator+(Float8 a, Float8 b) { return _mm256_add_ps(a.v, b.v); }
+inline Float8 operator-(Float8 a, Float8 b) { return _mm256_sub_ps(a.v, b.v); }
+inline Float8 operator*(Float8 a, Float8 b) { return _mm256_mul_ps(a.v, b.v); }
+inline Float8 operator/(Float8 a, Float8 b) { return _mm256_div_ps(a.v, b.v); }
+
+inline Float8 Min(Float8 a, Float8 b)   { return _mm256_min_ps(a.v, b.v); }
+inline Float8 Max(Float8 a, Float8 b)   { return _mm256_max_ps(a.v, b.v); }
+inline Float8 Sqrt(Float8 a)            { return _mm256_sqrt_ps(a.v); }
+inline Float8 Floor(Float8 a)           { return _mm256_floor_ps(a.v); }
+inline Float8 Abs(Float8 a)             { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a.v); }
+
+inline Float8 CmpLt(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+inline Float8 CmpLe(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+inline Float8 CmpGt(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+inline Float8 CmpGe(Float8 a, Float8 b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+
+inline Float8 And(Float8 a, Float8 b)    { return _mm256_and_ps(a.v, b.v); }
+inline Float8 Or(Float8 a, Float8 b)     { return _mm256_or_ps(a.v, b.v); }
+inline Float8 AndNot(Float8 a, Float8 b) { return _mm256_andnot_ps(a.v, b.v); } // ~a & b
+
+// mask ? a : b
+inline Float8 Select(Float8 mask, Float8 a, Float8 b) { return _mm256_blendv_ps(b.v, a.v, mask.v); }
+
+// One bit per lane, lane 0 in bit 0.
+inline uint32_t MoveMask(Float8 mask) { return static_cast<uint32_t>(_mm256_movemask_ps(mask.v)); }
+
+// Round to nearest, then store as int32.
+inline void StoreInt(Float8 a, int32_t* out) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtps_epi32(a.v));
+}
+
+#elif HT_SIMD_SSE2
+
+struct Float8 {
+    __m128 lo, hi;
+
+    Float8() = default;
+    Float8(__m128 l, __m128 h) : lo(l), hi(h) {}
+    Float8(float s) : lo(_mm_set1_ps(s)), hi(_mm_set1_ps(s)) {}
+
+    static Float8 Load(const float* p)  { return { _mm_loadu_ps(p), _mm_loadu_ps(p + 4) }; }
+    void          Store(float* p) const { _mm_storeu_ps(p, lo); _mm_storeu_ps(p + 4, hi); }
+
+    static Float8 Ramp(float base) {
+        const __m128 b = _mm_set1_ps(base);
+        return { _mm_add_ps(b, _mm_setr_ps(0, 1, 2, 3)), _mm_add_ps(b, _mm_setr_ps(4, 5, 6, 7)) };
+    }
+};
+
+#define HT_SIMD_BINARY(name, op)                                             \
+    inline Float8 name(Float8 a, Float8 b) { return { op(a.lo, b.lo), op(a.hi, b.hi) }; }
+
+HT_SIMD_BINARY(operator+, _mm_add_ps)
+HT_SIMD_BINARY(operator-, _mm_sub_ps)
+HT_SIMD_BINARY(operator*, _mm_mul_ps)
+HT_SIMD_BINARY(operator/, _mm_div_ps)
+HT_SIMD_BINARY(Min,       _mm_min_ps)
+HT_SIMD_BINARY(Max,       _mm_max_ps)
+HT_SIMD_BINARY(CmpLt,     _mm_cmplt_ps)
+HT_SIMD_BINARY(CmpLe,     _mm_cmple_ps)
+HT_SIMD_BINARY(CmpGt,     _mm_cmpgt_ps)
+HT_SIMD_BINARY(CmpGe,     _mm_cmpge_ps)
+HT_SIMD_BINARY(And,       _mm_and_ps)
+HT_SIMD_BINARY(Or,        _mm_or_ps)
+HT_SIMD_BINARY(AndNot,    _mm_andnot_ps) // ~a & b
+
+#undef HT_SIMD_BINARY
+
+inline Float8 Sqrt(Float8 a) { return { _mm_sqrt_ps(a.lo), _mm_sqrt_ps(a.hi) }; }
+
+inline Float8 Abs(Float8 a) {
+    const __m128 sign = _mm_set1_ps(-0.f);
+    return { _mm_andnot_ps(sign, a.lo), _mm_andnot_ps(sign, a.hi) };
+}
+
+inline Float8 Select(Float8 mask, Float8 a, Float8 b) {
+    return { _mm_or_ps(_mm_and_ps(mask.lo, a.lo), _mm_andnot_ps(mask.lo, b.lo)),
+             _mm_or_ps(_mm_and_ps(mask.hi, a.hi), _mm_andnot_ps(mask.hi, b.hi)) };
+}
+
+// SSE2 has no floor: truncate, then step down where truncation rounded up.
+// Valid for |a| < 2^31, which covers texel coordinates and pixel positions.
+inline Float8 Floor(Float8 a) {
+    auto floor4 = [](__m128 x) {
+        const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), _mm_set1_ps(1.f)));
+    };
+    return { floor4(a.lo), floor4(a.hi) };
+}
+
+inline uint32_t MoveMask(Float8 mask) {
+    return static_cast<uint32_t>(_mm_movemask_ps(mask.lo))
+         | (static_cast<uint32_t>(_mm_movemask_ps(mask.hi)) << 4);
+}
+
+inline void StoreInt(Float8 a, int32_t* out) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),     _mm_cvtps_epi32(a.lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_cvtps_epi32(a.hi));
+}
+
+#else // HT_SIMD_SCALAR
+
+struct Float8 {
+    float v[8];
+
+    Float8() = default;
+    Float8(float s) { for (float& x : v) x = s; }
+
+    static Float8 Load(const float* p)  { Float8 r; for (int i = 0; i < 8; ++i) r.v[i] = p[i]; return r; }
+    void          Store(float* p) const { for (int i = 0; i < 8; ++i) p[i] = v[i]; }
+
+    static Float8 Ramp(float base) { Float8 r; for (int i = 0; i < 8; ++i) r.v[i] = base + i; return r; }
+};
+
+namespace simd_detail {
+
+inline float MaskBits(bool b) {
+    const uint32_t bits = b ? 0xFFFFFFFFu : 0u;
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline uint32_t Bits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+inline float FromBits(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+template <class Op>
+inline Float8 Map(Float8 a, Float8 b, Op op) {
+    Float8 r;
+    for (int i = 0; i < 8; ++i) r.v[i] = op(a.v[i], b.v[i]);
+    return r;
+}
+
+} // namespace simd_detail
+
+inline Float8 operator+(Float8 a, Float8 b) { return simd_detail::Map(a, b, [](float x, float y) { return x + y; }); }
+inline Float8 operator-(Float8 a, Float8 b) { return simd_detail::Map(a, b, [](float x, float y) { return x - y; }); }
+inline Float8 operator*(Float8 a, Float8 b) { return simd_detail::Map(a, b, [](float x, float y) { return x * y; }); }
+inline Float8 operator/(Float8 a, Float8 b) { return simd_detail::Map(a, b, [](float x, float y) { return x / y; }); }
+inline Float8 Min(Float8 a, Float8 b)       { return simd_detail::Map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+inline Float8 Max(Float8 a, Float8 b)       { return simd_detail::Map(a, b, [](float x, float y) { return y > x ? y : x; }); }
+inline Float8 CmpLt(Float8 a, Float8 b)     { return simd_detail::Map(a, b, [](float x, float y) { return simd_detail::MaskBits(x <  y); }); }
+inline Float8 CmpLe(Float8 a, Float8 b)     { return simd_detail::Map(a, b, [](float x, float y) { return simd_detail::MaskBits(x <= y); }); }
+inline Float8 CmpGt(Float8 a, Float8 b)     { return simd_detail::Map(a, b, [](float x, float y) { return simd_detail::MaskBits(x >  y); }); }
+inline Float8 CmpGe(Float8 a, Float8 b)     { return simd_detail::Map(a, b, [](float x, float y) { return simd_detail::MaskBits(x >= y); }); }
+
+inline Float8 And(Float8 a, Float8 b) {
+    return simd_detail::Map(a, b, [](float x, float y) {
+        return simd_detail::FromBits(simd_detail::Bits(x) & simd_detail::Bits(y)); });
+}
+inline Float8 Or(Float8 a, Float8 b) {
+    return simd_detail::Map(a, b, [](float x, float y) {
+        return simd_detail::FromBits(simd_detail::Bits(x) | simd_detail::Bits(y)); });
+}
+inline Float8 AndNot(Float8 a, Float8 b) {
+    return simd_detail::Map(a, b, [](float x, float y) {
+        return simd_detail::FromBits(~simd_detail::Bits(x) & simd_detail::Bits(y)); });
+}
+
+inline Float8 Select(Float8 mask, Float8 a, Float8 b) { return Or(And(mask, a), AndNot(mask, b)); }
+
+inline Float8 Sqrt(Float8 a)  { Float8 r; for (int i = 0; i < 8; ++i) r.v[i] = std::sqrt(a.v[i]);  return r; }
+inline Float8 Floor(Float8 a) { Float8 r; for (int i = 0; i < 8; ++i) r.v[i] = std::floor(a.v[i]); return r; }
+inline Float8 Abs(Float8 a)   { Float8 r; for (int i = 0; i < 8; ++i) r.v[i] = std::fabs(a.v[i]);  return r; }
+
+inline uint32_t MoveMask(Float8 mask) {
+    uint32_t bits = 0;
+    for (int i = 0; i < 8; ++i) bits |= (simd_detail::Bits(mask.v[i]) >> 31) << i;
+    return bits;
+}
+
+inline void StoreInt(Float8 a, int32_t* out) {
+    for (int i = 0; i < 8; ++i) out[i] = static_cast<int32_t>(std::nearbyint(a.v[i]));
+}
+
+#endif
+
+// --- Backend-independent helpers ---
+
+inline Float8 Clamp(Float8 a, Float8 lo, Float8 hi) { return Min(Max(a, lo), hi); }
+inline Float8 Lerp(Float8 a, Float8 b, Float8 t)    { return a + (b - a) * t; }
@@ -0,0 +1,444 @@
+#include "SoftwareRenderer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+#include "Checkerboard.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "Simd.h"
+
+namespace {
+
+// Same clear color as D3DApp::Render, converted to UNORM8 (round to nearest).
+constexpr uint32_t kClearColor = PackRGBA(100, 149, 237, 255);
+
+constexpr int kTextureSize = 64; // CreateCheckerboardTexture: 64x64 texels
+constexpr int kCellSize    =  8; // 8-texel cells
+
+// Quad vertices — identical to kQuad in D3DApp::CreateBuffersAndMesh.
+constexpr Vertex kQuad[] = {
+    //  pos                    col           uv
+    { {-0.5f,  0.5f, 0.f}, {1,1,1,1}, {0.f, 0.f} }, // top-left
+    { { 0.5f,  0.5f, 0.f}, {1,1,1,1}, {1.f, 0.f} }, // top-right
+    { {-0.5f, -0.5f, 0.f}, {1,1,1,1}, {0.f, 1.f} }, // bottom-left
+    { { 0.5f,  0.5f, 0.f}, {1,1,1,1}, {1.f, 0.f} }, // top-right    (tri 2)
+    { { 0.5f, -0.5f, 0.f}, {1,1,1,1}, {1.f, 1.f} }, // bottom-right
+    { {-0.5f, -0.5f, 0.f}, {1,1,1,1}, {0.f, 1.f} }, // bottom-left
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Init / resize
+// ---------------------------------------------------------------------------
+
+bool SoftwareRenderer::Init(int width, int height, JobSystem* jobs) {
+    if (width <= 0 || height <= 0) return false;
+    mJobs = jobs;
+
+    mVertices.assign(std::begin(kQuad), std::end(kQuad));
+
+    // Wrap addressing below masks texel coordinates, so the size must be a power of two.
+    static_assert(std::has_single_bit(static_cast<unsigned>(kTextureSize)));
+    mTexSize = kTextureSize;
+    mTexture.resize(static_cast<size_t>(kTextureSize) * kTextureSize);
+    if (!GenerateCheckerboard(mTexture, kTextureSize, kCellSize)) return false;
+
+    mWidth  = 0;
+    mHeight = 0;
+    OnResize(width, height);
+    return true;
+}
+
+void SoftwareRenderer::OnResize(int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    if (width == mWidth && height == mHeight) return;
+
+    mWidth  = width;
+    mHeight = height;
+    mTilesX = (width  + kTileSize - 1) / kTileSize;
+    mTilesY = (height + kTileSize - 1) / kTileSize;
+
+    mColor.assign(static_cast<size_t>(width) * height, kClearColor);
+    mBins.assign(static_cast<size_t>(mTilesX) * mTilesY, {});
+}
+
+// ---------------------------------------------------------------------------
+// Update — the single-quad MVP of D3D12App::Update (CpuMath mirrors
+// DirectXMath), not D3DApp's grid
+// ---------------------------------------------------------------------------
+
+void SoftwareRenderer::Update(float dt) {
+    PROFILE_ZONE("Update");
+    mAngle += dt;
+    if (mAngle > kTwoPi) mAngle -= kTwoPi;
+    mTime += dt;
+
+    const Float4x4 model = MatrixRotationY(mAngle);
+    const Float4x4 view  = MatrixLookAtLH({ 0.f, 0.f, -2.f }, { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f });
+
+    const float aspect = (mHeight > 0)
+        ? static_cast<float>(mWidth) / static_cast<float>(mHeight)
+        : 1.f;
+    const Float4x4 proj = MatrixPerspectiveFovLH(kPi / 4.f, aspect, 0.1f, 100.f);
+
+    // Transposed like the GPU upload, so RunVertexStage reads it as HLSL does.
+    mPerObject.mvpMatrix = MatrixTranspose(MatrixMultiply(MatrixMultiply(model, view), proj));
+    mPerObject.tintColor[0] = mPerObject.tintColor[1] = 1.f; // no tint
+    mPerObject.tintColor[2] = mPerObject.tintColor[3] = 1.f;
+
+    mPerFrame.time      = mTime;
+    mPerFrame.deltaTime = dt;
+}
+
+// ---------------------------------------------------------------------------
+// Render
+// ---------------------------------------------------------------------------
+
+void SoftwareRenderer::Render() {
+    PROFILE_ZONE("Render");
+    if (mColor.empty()) return;
+
+    RunVertexStage();
+    BinTriangles();
+
+    PROFILE_ZONE("Raster");
+    const auto tileCount = static_cast<uint32_t>(mBins.size());
+    if (mJobs) {
+        mJobs->ParallelFor(tileCount, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t t = begin; t < end; ++t) RasterTile(static_cast<int>(t));
+        });
+    } else {
+        for (uint32_t t = 0; t < tileCount; ++t) RasterTile(static_cast<int>(t));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Vertex stage (vertex.hlsl) + primitive assembly
+// ---------------------------------------------------------------------------
+
+void SoftwareRenderer::RunVertexStage() {
+    PROFILE_ZONE("VertexStage");
+    const Float4x4& m = mPerObject.mvpMatrix;
+
+    mClipVertices.resize(mVertices.size());
+    for (size_t i = 0; i < mVertices.size(); ++i) {
+        const Vertex& in  = mVertices[i];
+        ClipVertex&   out = mClipVertices[i];
+
+        // mul(mvpMatrix, float4(position, 1))
+        for (int r = 0; r < 4; ++r) {
+            out.pos[r] = m.m[r][0] * in.pos[0] + m.m[r][1] * in.pos[1]
+                       + m.m[r][2] * in.pos[2] + m.m[r][3];
+        }
+        for (int c = 0; c < 4; ++c) out.col[c] = in.col[c] * mPerObject.tintColor[c];
+        out.uv[0] = in.uv[0];
+        out.uv[1] = in.uv[1];
+    }
+
+    // Triangle list, non-indexed (Mesh::Draw).
+    mTriangles.clear();
+    for (size_t i = 0; i + 2 < mClipVertices.size(); i += 3) {
+        ClipAndSetup(mClipVertices[i], mClipVertices[i + 1], mClipVertices[i + 2]);
+    }
+}
+
+// Clip against the near (z >= 0) and far (z <= w) planes, then fan-triangulate.
+// x/y need no clipping: the bounding box is clamped to the viewport.
+void SoftwareRenderer::ClipAndSetup(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2) {
+    auto nearDist = [](const ClipVertex& v) { return v.pos[2]; };
+    auto farDist  = [](const ClipVertex& v) { return v.pos[3] - v.pos[2]; };
+
+    const bool inside =
+        nearDist(v0) >= 0.f && nearDist(v1) >= 0.f && nearDist(v2) >= 0.f &&
+        farDist(v0)  >= 0.f && farDist(v1)  >= 0.f && farDist(v2)  >= 0.f;
+    if (inside) {
+        SetupTriangleScreen(v0, v1, v2);
+        return;
+    }
+
+    // Sutherland–Hodgman; a triangle clipped by two planes has at most 5 vertices.
+    ClipVertex bufA[8] = { v0, v1, v2 };
+    ClipVertex bufB[8];
+    ClipVertex* in  = bufA;
+    ClipVertex* out = bufB;
+    int count = 3;
+
+    auto lerp = [](const ClipVertex& a, const ClipVertex& b, float t) {
+        ClipVertex r;
+        for (int i = 0; i < 4; ++i) r.pos[i] = a.pos[i] + (b.pos[i] - a.pos[i]) * t;
+        for (int i = 0; i < 4; ++i) r.col[i] = a.col[i] + (b.col[i] - a.col[i]) * t;
+        for (int i = 0; i < 2; ++i) r.uv[i]  = a.uv[i]  + (b.uv[i]  - a.uv[i])  * t;
+        return r;
+    };
+
+    for (int plane = 0; plane < 2 && count >= 3; ++plane) {
+        int outCount = 0;
+        for (int i = 0; i < count; ++i) {
+            const ClipVertex& a  = in[i];
+            const ClipVertex& b  = in[(i + 1) % count];
+            const float       da = plane == 0 ? nearDist(a) : farDist(a);
+            const float       db = plane == 0 ? nearDist(b) : farDist(b);
+
+            if (da >= 0.f) out[outCount++] = a;
+            if ((da >= 0.f) != (db >= 0.f)) out[outCount++] = lerp(a, b, da / (da - db));
+        }
+        std::swap(in, out);
+        count = outCount;
+    }
+
+    for (int i = 1; i + 1 < count; ++i) {
+        SetupTriangleScreen(in[0], in[i], in[i + 1]);
+    }
+}
+
+void SoftwareRenderer::SetupTriangleScreen(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2) {
+    const ClipVertex* v[3] = { &v0, &v1, &v2 };
+
+    // Perspective divide + viewport transform (TopLeft = 0, y down).
+    float sx[3], sy[3], invW[3];
+    for (int i = 0; i < 3; ++i) {
+        invW[i] = 1.f / v[i]->pos[3];
+        sx[i]   = (v[i]->pos[0] * invW[i] * 0.5f + 0.5f) * static_cast<float>(mWidth);
+        sy[i]   = (0.5f - v[i]->pos[1] * invW[i] * 0.5f) * static_cast<float>(mHeight);
+    }
+
+    // Signed area in y-down pixel space: > 0 means clockwise = front face.
+    const float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+    if (!(area > 0.f)) return; // back face (CullMode BACK) or degenerate
+
+    SetupTriangle tri;
+
+    // Edge k is opposite vertex k: (v1,v2), (v2,v0), (v0,v1).
+    // E(p) = (xj - xi) * (py - yi) - (yj - yi) * (px - xi); E_k / area = barycentric k.
+    for (int k = 0; k < 3; ++k) {
+        const int   i  = (k + 1) % 3;
+        const int   j  = (k + 2) % 3;
+        const float dx = sx[j] - sx[i];
+        const float dy = sy[j] - sy[i];
+
+        tri.edge[k]    = { -dy, dx, dy * sx[i] - dx * sy[i] };
+        tri.topLeft[k] = dy < 0.f || (dy == 0.f && dx > 0.f); // left edge, or flat top edge
+    }
+
+    // Attribute planes: sum_k (attr_k / w_k) * E_k / area.
+    float values[kAttributeCount][3];
+    for (int k = 0; k < 3; ++k) {
+        values[kOneOverW][k] = invW[k];
+        values[kR][k]        = v[k]->col[0] * invW[k];
+        values[kG][k]        = v[k]->col[1] * invW[k];
+        values[kB][k]        = v[k]->col[2] * invW[k];
+        values[kA][k]        = v[k]->col[3] * invW[k];
+        values[kU][k]        = v[k]->uv[0]  * invW[k];
+        values[kV][k]        = v[k]->uv[1]  * invW[k];
+    }
+    const float invArea = 1.f / area;
+    for (int a = 0; a < kAttributeCount; ++a) {
+        Plane& p = tri.attr[a];
+        p = { 0.f, 0.f, 0.f };
+        for (int k = 0; k < 3; ++k) {
+            const float s = values[a][k] * invArea;
+            p.a += tri.edge[k].a * s;
+            p.b += tri.edge[k].b * s;
+            p.c += tri.edge[k].c * s;
+        }
+    }
+
+    const float minX = std::min({ sx[0], sx[1], sx[2] });
+    const float maxX = std::max({ sx[0], sx[1], sx[2] });
+    const float minY = std::min({ sy[0], sy[1], sy[2] });
+    const float maxY = std::max({ sy[0], sy[1], sy[2] });
+
+    tri.minX = std::max(0,           static_cast<int>(std::floor(minX)));
+    tri.minY = std::max(0,           static_cast<int>(std::floor(minY)));
+    tri.maxX = std::min(mWidth  - 1, static_cast<int>(std::floor(maxX)));
+    tri.maxY = std::min(mHeight - 1, static_cast<int>(std::floor(maxY)));
+    if (tri.minX > tri.maxX || tri.minY > tri.maxY) return; // off screen
+
+    mTriangles.push_back(tri);
+}
+
+// ---------------------------------------------------------------------------
+// Binning
+// ---------------------------------------------------------------------------
+
+void SoftwareRenderer::BinTriangles() {
+    PROFILE_ZONE("BinTriangles");
+    for (auto& bin : mBins) bin.clear(); // keeps capacity across frames
+
+    for (uint32_t i = 0; i < mTriangles.size(); ++i) {
+        const SetupTriangle& tri = mTriangles[i];
+        for (int ty = tri.minY / kTileSize; ty <= tri.maxY / kTileSize; ++ty) {
+            for (int tx = tri.minX / kTileSize; tx <= tri.maxX / kTileSize; ++tx) {
+                mBins[static_cast<size_t>(ty) * mTilesX + tx].push_back(i);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Tile rasterization — one job per tile; tiles never share pixels.
+// ---------------------------------------------------------------------------
+
+void SoftwareRenderer::RasterTile(int tileIndex) {
+    PROFILE_ZONE("RasterTile");
+    const int tileX0 = (tileIndex % mTilesX) * kTileSize;
+    const int tileY0 = (tileIndex / mTilesX) * kTileSize;
+    const int tileX1 = std::min(tileX0 + kTileSize, mWidth);  // exclusive
+    const int tileY1 = std::min(tileY0 + kTileSize, mHeight);
+
+    // --- Clear ---
+    for (int y = tileY0; y < tileY1; ++y) {
+        uint32_t* row = &mColor[static_cast<size_t>(y) * mWidth];
+        std::fill(row + tileX0, row + tileX1, kClearColor);
+    }
+
+    // --- Triangles in submission order (no depth buffer: later wins) ---
+    for (const uint32_t triIndex : mBins[tileIndex]) {
+        const SetupTriangle& tri = mTriangles[triIndex];
+
+        const int x0 = std::max(tri.minX, tileX0);
+        const int x1 = std::min(tri.maxX, tileX1 - 1);
+        const int y0 = std::max(tri.minY, tileY0);
+        const int y1 = std::min(tri.maxY, tileY1 - 1);
+        if (x0 > x1 || y0 > y1) continue;
+
+        // Spans start on a multiple of 8 (tile origins are multiples of 64);
+        // lanes outside [x0, x1] are masked off.
+        const int    xStart = x0 & ~(kSimdWidth - 1);
+        const Float8 xMin(static_cast<float>(x0));
+        const Float8 xMax(static_cast<float>(x1));
+
+        for (int y = y0; y <= y1; ++y) {
+            const Float8 py(static_cast<float>(y) + 0.5f);
+
+            for (int x = xStart; x <= x1; x += kSimdWidth) {
+                const Float8 lane = Float8::Ramp(static_cast<float>(x));
+                const Float8 px   = lane + Float8(0.5f);
+
+                Float8 mask = And(CmpGe(lane, xMin), CmpLe(lane, xMax));
+                for (int k = 0; k < 3; ++k) {
+                    const Float8 e = Float8(tri.edge[k].a) * px
+                                   + Float8(tri.edge[k].b) * py
+                                   + Float8(tri.edge[k].c);
+                    mask = And(mask, tri.topLeft[k] ? CmpGe(e, Float8(0.f)) : CmpGt(e, Float8(0.f)));
+                }
+
+                const uint32_t bits = MoveMask(mask);
+                if (bits != 0) ShadeSpan(tri, x, y, bits);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Pixel stage (pixel.hlsl) for 8 horizontally adjacent pixels
+// ---------------------------------------------------------------------------
+
+void SoftwareRenderer::ShadeSpan(const SetupTriangle& tri, int x, int y, uint32_t laneMask) {
+    const Float8 px = Float8::Ramp(static_cast<float>(x)) + Float8(0.5f);
+    const Float8 py(static_cast<float>(y) + 0.5f);
+
+    auto eval = [&](const Plane& p) {
+        return Float8(p.a) * px + Float8(p.b) * py + Float8(p.c);
+    };
+
+    // --- Perspective-correct interpolation ---
+    const Float8 w = Float8(1.f) / eval(tri.attr[kOneOverW]);
+    const Float8 r = eval(tri.attr[kR]) * w;
+    const Float8 g = eval(tri.attr[kG]) * w;
+    const Float8 b = eval(tri.attr[kB]) * w;
+    const Float8 a = eval(tri.attr[kA]) * w;
+    const Float8 u = eval(tri.attr[kU]) * w + Float8(mPerFrame.time * 0.1f); // UV scroll
+    const Float8 v = eval(tri.attr[kV]) * w;
+
+    // --- Bilinear, wrap addressing (D3D11_FILTER_MIN_MAG_MIP_LINEAR, 1 mip) ---
+    const float  size = static_cast<float>(mTexSize);
+    const Float8 tx   = u * Float8(size) - Float8(0.5f);
+    const Float8 ty   = v * Float8(size) - Float8(0.5f);
+    const Float8 fx   = Floor(tx);
+    const Float8 fy   = Floor(ty);
+    const Float8 wx   = tx - fx;
+    const Float8 wy   = ty - fy;
+
+    alignas(32) int32_t ix[kSimdWidth];
+    alignas(32) int32_t iy[kSimdWidth];
+    StoreInt(fx, ix);
+    StoreInt(fy, iy);
+
+    // Gather the 2x2 footprint per lane; channels land in SoA order.
+    alignas(32) float tap[4][4][kSimdWidth]; // [tap][channel][lane]
+    const int wrap = mTexSize - 1;
+    for (int l = 0; l < kSimdWidth; ++l) {
+        const int x0i = ix[l] & wrap;
+        const int y0i = iy[l] & wrap;
+        const int x1i = (x0i + 1) & wrap;
+        const int y1i = (y0i + 1) & wrap;
+        const uint32_t texels[4] = {
+            mTexture[y0i * mTexSize + x0i], mTexture[y0i * mTexSize + x1i],
+            mTexture[y1i * mTexSize + x0i], mTexture[y1i * mTexSize + x1i],
+        };
+        for (int t = 0; t < 4; ++t) {
+            for (int c = 0; c < 4; ++c) {
+                tap[t][c][l] = static_cast<float>((texels[t] >> (8 * c)) & 0xFF);
+            }
+        }
+    }
+
+    Float8 color[4];
+    const Float8 vertexColor[4] = { r, g, b, a };
+    for (int c = 0; c < 4; ++c) {
+        const Float8 top    = Lerp(Float8::Load(tap[0][c]), Float8::Load(tap[1][c]), wx);
+        const Float8 bottom = Lerp(Float8::Load(tap[2][c]), Float8::Load(tap[3][c]), wx);
+        const Float8 texel  = Lerp(top, bottom, wy) * Float8(1.f / 255.f);
+        // gAlbedo.Sample(...) * input.color, then UNORM8 conversion.
+        color[c] = Clamp(texel * vertexColor[c], Float8(0.f), Float8(1.f)) * Float8(255.f);
+    }
+
+    alignas(32) int32_t rgba[4][kSimdWidth];
+    for (int c = 0; c < 4; ++c) StoreInt(color[c], rgba[c]);
+
+    uint32_t* dst = &mColor[static_cast<size_t>(y) * mWidth + x];
+    for (uint32_t bits = laneMask; bits != 0; bits &= bits - 1) {
+        const int l = std::countr_zero(bits);
+        dst[l] = PackRGBA(static_cast<uint8_t>(rgba[0][l]), static_cast<uint8_t>(rgba[1][l]),
+                          static_cast<uint8_t>(rgba[2][l]), static_cast<uint8_t>(rgba[3][l]));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Output
+// ---------------------------------------------------------------------------
+
+uint64_t SoftwareRenderer::Checksum() const {
+    uint64_t hash = 0xcbf29ce484222325ull; // FNV-1a offset basis
+    for (const uint32_t px : mColor) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (px >> (8 * i)) & 0xFF;
+            hash *= 0x100000001b3ull;      // FNV-1a prime
+        }
+    }
+    return hash;
+}
+
+bool SoftwareRenderer::WritePpm(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    file << "P6\n" << mWidth << ' ' << mHeight << "\n255\n";
+    std::vector<char> row(static_cast<size_t>(mWidth) * 3);
+    for (int y = 0; y < mHeight; ++y) {
+        for (int x = 0; x < mWidth; ++x) {
+            const uint32_t px = mColor[static_cast<size_t>(y) * mWidth + x];
+            row[x * 3 + 0] = static_cast<char>(px & 0xFF);
+            row[x * 3 + 1] = static_cast<char>((px >> 8) & 0xFF);
+            row[x * 3 + 2] = static_cast<char>((px >> 16) & 0xFF);
+        }
+        file.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "CpuMath.h"
+#include "Vertex.h"
+
+class JobSystem;
+
+// ---------------------------------------------------------------------------
+// SoftwareRenderer — CPU backend for the Phase 1-6 scene (textured quad with
+// scrolling UVs), rendering into an RGBA8 memory framebuffer.
+//
+// The scene is one quad spinning in front of a camera at z = -2 (D3D12App's
+// transform), not D3DApp's culled, instanced grid; QuadGrid is the CPU side
+// of that. The stages follow the HLSL and D3D11 state:
+//   • vertex        MVP transform, color * tint (PerObject of vertex12.hlsl),
+//                   pass-through UV
+//   • rasterizer    D3D11 defaults: back-face cull (CW front), near/far clip,
+//                   top-left fill rule, pixel-center sampling
+//   • pixel.hlsl    linear-wrap sample of the 64x64 checkerboard at
+//                   uv + (time * 0.1, 0), multiplied by the vertex color
+//
+// Triangles are binned into kTileSize tiles; tiles are rasterized in
+// parallel on a JobSystem (or serially when none is given). Inside a tile,
+// edge functions and attribute planes are evaluated 8 pixels at a time.
+// ---------------------------------------------------------------------------
+class SoftwareRenderer {
+public:
+    static constexpr int kTileSize = 64;
+
+    SoftwareRenderer()                        = default;
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    [[nodiscard]] bool Init(int width, int height, JobSystem* jobs = nullptr);
+    void               OnResize(int width, int height);
+
+    void Update(float dt);
+    void Render();
+
+    // --- Framebuffer (row-major, DXGI_FORMAT_R8G8B8A8_UNORM byte order) ---
+    [[nodiscard]] std::span<const uint32_t> Pixels() const { return mColor; }
+    [[nodiscard]] int                       Width()  const { return mWidth; }
+    [[nodiscard]] int                       Height() const { return mHeight; }
+
+    // 64-bit FNV-1a of the framebuffer, for image regression checks.
+    [[nodiscard]] uint64_t Checksum() const;
+    [[nodiscard]] bool     WritePpm(const std::filesystem::path& path) const;
+
+    // --- Statistics of the last Render() ---
+    [[nodiscard]] uint32_t TrianglesRasterized() const { return static_cast<uint32_t>(mTriangles.size()); }
+
+private:
+    // Mirrors cbuffer PerObject : register(b0) in vertex.hlsl (mvp pre-transposed).
+    struct PerObjectCB {
+        Float4x4 mvpMatrix;
+        float    tintColor[4];
+    };
+
+    // Mirrors cbuffer PerFrame : register(b1) in pixel.hlsl.
+    struct PerFrameCB {
+        float time;
+        float deltaTime;
+        float padding[2];
+    };
+
+    // VSOutput: SV_Position (clip space), COLOR, TEXCOORD.
+    struct ClipVertex {
+        float pos[4];
+        float col[4];
+        float uv[2];
+    };
+
+    // Attributes interpolated per pixel; each is stored divided by w so the
+    // screen-space plane is linear (perspective-correct after * w).
+    enum Attribute { kOneOverW, kR, kG, kB, kA, kU, kV, kAttributeCount };
+
+    // Plane a*x + b*y + c in pixel coordinates.
+    struct Plane {
+        float a, b, c;
+    };
+
+    struct SetupTriangle {
+        Plane edge[3];     // inside when >= 0 (top-left edges) or > 0 (others)
+        bool  topLeft[3];
+        Plane attr[kAttributeCount];
+        int   minX, minY, maxX, maxY; // inclusive pixel bounds, clamped to the viewport
+    };
+
+    void RunVertexStage();
+    void ClipAndSetup(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+    void SetupTriangleScreen(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+    void BinTriangles();
+    void RasterTile(int tileIndex);
+    void ShadeSpan(const SetupTriangle& tri, int x, int y, uint32_t laneMask);
+
+    JobSystem* mJobs   = nullptr;
+    int        mWidth  = 0;
+    int        mHeight = 0;
+    int        mTilesX = 0;
+    int        mTilesY = 0;
+
+    // --- Scene (D3DApp's quad and checkerboard, the texture left uncompressed) ---
+    std::vector<Vertex>   mVertices;
+    std::vector<uint32_t> mTexture;
+    int                   mTexSize = 0;
+
+    PerObjectCB mPerObject = {};
+    PerFrameCB  mPerFrame  = {};
+    float       mAngle     = 0.f;
+    float       mTime      = 0.f;
+
+    // --- Per-frame pipeline state ---
+    std::vector<ClipVertex>            mClipVertices;
+    std::vector<SetupTriangle>         mTriangles;
+    std::vector<std::vector<uint32_t>> mBins; // triangle indices per tile, in submission order
+    std::vector<uint32_t>              mColor;
+};
@@ -0,0 +1,231 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "Profiler.h"
+
+// ---------------------------------------------------------------------------
+// Building
+// ---------------------------------------------------------------------------
+
+void TaskGraph::Reset() {
+    (void)WaitAll();
+    mTasks.clear();
+    mMainReady.clear();
+    mJobs    = nullptr;
+    mStartNs = 0;
+}
+
+uint32_t TaskGraph::Add(std::string name, TaskFn fn,
+                        std::initializer_list<uint32_t> dependencies,
+                        TaskAffinity affinity) {
+    const auto index = static_cast<uint32_t>(mTasks.size());
+    if (mJobs) return kInvalid;
+    for (uint32_t dep : dependencies) {
+        if (dep >= index) return kInvalid;
+    }
+
+    Task& task = mTasks.emplace_back();
+    task.name     = std::move(name);
+    task.zoneName = Profiler::Intern(task.name);
+    task.fn       = std::move(fn);
+    task.affinity = affinity;
+    task.dependencies.assign(dependencies.begin(), dependencies.end());
+
+    // Duplicates would be counted twice in `remaining`.
+    std::sort(task.dependencies.begin(), task.dependencies.end());
+    task.dependencies.erase(std::unique(task.dependencies.begin(), task.dependencies.end()),
+                            task.dependencies.end());
+    task.remaining.store(static_cast<uint32_t>(task.dependencies.size()), std::memory_order_relaxed);
+    for (uint32_t dep : task.dependencies) mTasks[dep].successors.push_back(index);
+    return index;
+}
+
+// ---------------------------------------------------------------------------
+// Running
+// ---------------------------------------------------------------------------
+
+int64_t TaskGraph::Now() const {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+void TaskGraph::Start(JobSystem& jobs) {
+    if (mJobs) return;
+    mJobs    = &jobs;
+    mStartNs = Now();
+
+    // Collect roots first: a root may finish (and launch successors) while
+    // this loop is still running.
+    std::vector<uint32_t> roots;
+    for (uint32_t i = 0; i < TaskCount(); ++i) {
+        if (mTasks[i].dependencies.empty()) roots.push_back(i);
+    }
+    for (uint32_t root : roots) Launch(root);
+}
+
+void TaskGraph::Launch(uint32_t index) {
+    Task& task = mTasks[index];
+    if (task.affinity == TaskAffinity::Main) {
+        std::lock_guard lock(mMainMutex);
+        mMainReady.push_back(index);
+        return;
+    }
+    mJobs->Run([this, index] { Execute(index); }, &task.counter);
+}
+
+void TaskGraph::Execute(uint32_t index) {
+    Task& task = mTasks[index];
+
+    bool ok = true;
+    for (uint32_t dep : task.dependencies) {
+        ok = ok && mTasks[dep].state.load(std::memory_order_acquire) == kSucceeded;
+    }
+
+    task.startNs = Now() - mStartNs;
+    {
+        ProfileScope zone(task.zoneName);
+        if (ok && task.fn) ok = task.fn(); // skipped when a dependency failed
+    }
+    task.endNs = Now() - mStartNs;
+    task.fn    = {};                    // drop captures early
+    task.state.store(ok ? kSucceeded : kFailed, std::memory_order_release);
+
+    for (uint32_t successor : task.successors) {
+        if (mTasks[successor].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Launch(successor);
+    }
+    task.settled.store(true, std::memory_order_release);
+}
+
+bool TaskGraph::Wait(uint32_t index) {
+    if (!mJobs || index >= TaskCount()) return false;
+
+    Task& task = mTasks[index];
+    if (!task.settled.load(std::memory_order_acquire)) {
+        // Once every dependency has settled, this task has been launched.
+        for (uint32_t dep : task.dependencies) (void)Wait(dep);
+
+        // Only this thread runs Main tasks; a stale queue entry is skipped
+        // by Poll().
+        if (task.affinity == TaskAffinity::Main &&
+            task.state.load(std::memory_order_acquire) == kPending)
+            Execute(index);
+    }
+    // Also for settled jobs: the counter is released after Execute()
+    // returns, and the task must not be destroyed before that.
+    if (task.affinity == TaskAffinity::Any) mJobs->Wait(task.counter);
+    return task.state.load(std::memory_order_acquire) == kSucceeded;
+}
+
+bool TaskGraph::WaitAll() {
+    bool ok = true;
+    for (uint32_t i = 0; i < TaskCount(); ++i) ok = Wait(i) && ok;
+    return ok;
+}
+
+void TaskGraph::Poll() {
+    if (!mJobs) return;
+
+    std::vector<uint32_t> ready;
+    {
+        std::lock_guard lock(mMainMutex);
+        ready.swap(mMainReady);
+    }
+    for (uint32_t index : ready) {
+        if (mTasks[index].state.load(std::memory_order_acquire) == kPending) Execute(index);
+    }
+
+    if (mJobs->ThreadCount() == 1) (void)mJobs->RunPendingJob();
+}
+
+bool TaskGraph::IsDone(uint32_t index) const {
+    return index < TaskCount() && mTasks[index].settled.load(std::memory_order_acquire);
+}
+
+bool TaskGraph::Succeeded(uint32_t index) const {
+    return IsDone(index) && mTasks[index].state.load(std::memory_order_acquire) == kSucceeded;
+}
+
+bool TaskGraph::AllDone() const {
+    for (uint32_t i = 0; i < TaskCount(); ++i) {
+        if (!IsDone(i)) return false;
+    }
+    return mJobs != nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Critical path
+// ---------------------------------------------------------------------------
+
+std::vector<TaskTiming> TaskGraph::Timings() const {
+    std::vector<TaskTiming> timings;
+    (void)Analyze(timings);
+    return timings;
+}
+
+double TaskGraph::Analyze(std::vector<TaskTiming>& timings) const {
+    timings.clear();
+    if (!AllDone()) return 0.0;
+
+    const uint32_t      n = TaskCount();
+    std::vector<double> duration(n), earliestFinish(n), latestFinish(n);
+
+    // Tasks are in topological order (dependencies always come first):
+    // forward pass for the earliest finish, backward pass for the latest
+    // finish that keeps the total unchanged.
+    double length = 0.0;
+    for (uint32_t i = 0; i < n; ++i) {
+        duration[i] = static_cast<double>(mTasks[i].endNs - mTasks[i].startNs) * 1e-6;
+        double ready = 0.0;
+        for (uint32_t dep : mTasks[i].dependencies) ready = std::max(ready, earliestFinish[dep]);
+        earliestFinish[i] = ready + duration[i];
+        length            = std::max(length, earliestFinish[i]);
+    }
+    for (uint32_t i = n; i-- > 0;) {
+        double finish = length;
+        for (uint32_t s : mTasks[i].successors) finish = std::min(finish, latestFinish[s] - duration[s]);
+        latestFinish[i] = finish;
+    }
+
+    constexpr double kEpsilonMs = 1e-3; // timer noise
+    timings.resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        TaskTiming& t = timings[i];
+        t.name      = mTasks[i].name;
+        t.start     = static_cast<double>(mTasks[i].startNs) * 1e-6;
+        t.end       = static_cast<double>(mTasks[i].endNs) * 1e-6;
+        t.slack     = std::max(0.0, latestFinish[i] - earliestFinish[i]);
+        t.critical  = t.slack < kEpsilonMs;
+        t.succeeded = mTasks[i].state.load(std::memory_order_acquire) == kSucceeded;
+    }
+    return length;
+}
+
+std::string TaskGraph::FormatReport(std::string_view title) const {
+    std::vector<TaskTiming> timings;
+    const double            critical = Analyze(timings);
+    if (timings.empty()) return {};
+
+    double wall = 0.0;
+    for (const TaskTiming& t : timings) wall = std::max(wall, t.end);
+
+    char        line[160];
+    std::string report;
+    std::snprintf(line, sizeof(line), "%.*s: %u tasks, %.2f ms wall, %.2f ms critical path\n",
+                  static_cast<int>(title.size()), title.data(), TaskCount(), wall, critical);
+    report += line;
+    std::snprintf(line, sizeof(line), "    %-24s %9s %9s %9s %9s\n",
+                  "task", "start", "end", "ms", "slack");
+    report += line;
+    for (const TaskTiming& t : timings) {
+        std::snprintf(line, sizeof(line), "  %c %-24.*s %9.2f %9.2f %9.2f %9.2f%s\n",
+                      t.critical ? '*' : ' ', static_cast<int>(t.name.size()), t.name.data(),
+                      t.start, t.end, t.end - t.start, t.slack, t.succeeded ? "" : "  FAILED");
+        report += line;
+    }
+    return report;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "JobSystem.h"
+
+// Where a task may run. Main tasks (window and swap-chain work) run only on
+// the thread that calls TaskGraph::Wait() / Poll().
+enum class TaskAffinity : uint8_t {
+    Any,
+    Main,
+};
+
+// Per-task result of a finished graph; times in ms since Start().
+struct TaskTiming {
+    std::string_view name;
+    double           start     = 0.0;
+    double           end       = 0.0;
+    double           slack     = 0.0; // how far it could slip without lengthening the critical path
+    bool             critical  = false;
+    bool             succeeded = false;
+};
+
+// ---------------------------------------------------------------------------
+// TaskGraph — one-shot DAG of named tasks on a JobSystem, for startup work.
+//
+// Add() declares a task and the tasks it depends on; dependencies must
+// already exist, so the graph is acyclic by construction. Start() launches
+// every root, and each task is launched by whichever thread finishes its
+// last dependency. A task returns false to fail; everything downstream of
+// it is skipped and fails as well.
+//
+// Wait(task) returns as soon as that task is finished, so the caller can go
+// on (e.g. show a first frame) while unrelated tasks are still running.
+// With no worker threads, Wait() and Poll() execute queued tasks
+// themselves. Wait() and Poll() must be called from one thread.
+//
+// Timings() reports each task's start / end and a critical-path analysis
+// over the measured durations: the longest dependency chain bounds the
+// init time however many threads there are, and a task's slack is how much
+// longer it could take before it joins that chain.
+// ---------------------------------------------------------------------------
+class TaskGraph {
+public:
+    using TaskFn = std::function<bool()>;
+
+    static constexpr uint32_t kInvalid = ~0u;
+
+    TaskGraph()                 = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    ~TaskGraph() { (void)WaitAll(); } // tasks may reference their owner
+
+    // Waits for a started graph, then forgets every task.
+    void Reset();
+
+    // An empty `fn` is a join point: it succeeds once its dependencies do.
+    // Returns kInvalid (and adds nothing) after Start() or for an unknown
+    // dependency.
+    uint32_t Add(std::string name, TaskFn fn,
+                 std::initializer_list<uint32_t> dependencies = {},
+                 TaskAffinity affinity = TaskAffinity::Any);
+
+    void Start(JobSystem& jobs);
+
+    // Both return whether the task(s) succeeded. Start() must have run.
+    [[nodiscard]] bool Wait(uint32_t task);
+    [[nodiscard]] bool WaitAll();
+
+    // Non-blocking progress for a frame loop: runs ready Main tasks, and
+    // one queued job when the job system has no workers.
+    void Poll();
+
+    [[nodiscard]] bool     IsDone(uint32_t task)    const;
+    [[nodiscard]] bool     Succeeded(uint32_t task) const;
+    [[nodiscard]] bool     AllDone()   const;
+    [[nodiscard]] uint32_t TaskCount() const { return static_cast<uint32_t>(mTasks.size()); }
+
+    // Empty until AllDone().
+    [[nodiscard]] std::vector<TaskTiming> Timings() const;
+    [[nodiscard]] std::string             FormatReport(std::string_view title) const;
+
+private:
+    enum State : uint8_t { kPending, kSucceeded, kFailed };
+
+    struct Task {
+        std::string           name;
+        const char*           zoneName = nullptr;  // name, interned for Profiler
+        TaskFn                fn;
+        TaskAffinity          affinity = TaskAffinity::Any;
+        std::vector<uint32_t> dependencies;
+        std::vector<uint32_t> successors;
+
+        std::atomic<uint32_t> remaining{ 0 };      // unfinished dependencies
+        std::atomic<uint8_t>  state{ kPending };
+        std::atomic<bool>     settled{ false };    // successors launched too
+        JobCounter            counter;             // Any tasks, while queued or running
+        int64_t               startNs = 0;
+        int64_t               endNs   = 0;
+    };
+
+    void Launch(uint32_t task);
+    void Execute(uint32_t task);
+    [[nodiscard]] int64_t Now() const;
+    [[nodiscard]] double  Analyze(std::vector<TaskTiming>& timings) const; // critical path, ms
+
+    std::deque<Task> mTasks; // stable addresses: tasks hold atomics
+    JobSystem*       mJobs    = nullptr;
+    int64_t          mStartNs = 0;
+
+    std::mutex            mMainMutex;
+    std::vector<uint32_t> mMainReady; // Main tasks whose dependencies are done
+};
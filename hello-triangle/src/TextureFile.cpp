@@ -0,0 +1,483 @@
+#include "TextureFile.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace {
+
+// DDS: "DDS " + DDS_HEADER (124 bytes) [+ DDS_HEADER_DXT10 (20 bytes)].
+constexpr char   kDdsMagic[4]     = { 'D', 'D', 'S', ' ' };
+constexpr size_t kDdsHeaderSize   = 124;
+constexpr size_t kDdsDx10Size     = 20;
+constexpr size_t kDdsDataOffset   = 4 + kDdsHeaderSize;
+
+constexpr uint32_t kDdsdCaps        = 0x1;
+constexpr uint32_t kDdsdHeight      = 0x2;
+constexpr uint32_t kDdsdWidth       = 0x4;
+constexpr uint32_t kDdsdPitch       = 0x8;
+constexpr uint32_t kDdsdPixelFormat = 0x1000;
+constexpr uint32_t kDdsdMipMapCount = 0x20000;
+constexpr uint32_t kDdsdLinearSize  = 0x80000;
+
+constexpr uint32_t kDdpfAlphaPixels = 0x1;
+constexpr uint32_t kDdpfFourCC      = 0x4;
+constexpr uint32_t kDdpfRgb         = 0x40;
+constexpr uint32_t kDdpfLuminance   = 0x20000;
+
+constexpr uint32_t kDdsCapsComplex = 0x8;
+constexpr uint32_t kDdsCapsTexture = 0x1000;
+constexpr uint32_t kDdsCapsMipMap  = 0x400000;
+constexpr uint32_t kDdsCaps2Cube   = 0x200;
+constexpr uint32_t kDdsCaps2Faces  = 0xFC00; // +X -X +Y -Y +Z -Z
+constexpr uint32_t kDdsCaps2Volume = 0x200000;
+
+constexpr uint32_t kDx10Texture2D = 3;
+constexpr uint32_t kDx10MiscCube  = 0x4;
+
+// KTX2: 12-byte identifier, 9 u32 header fields, index, level index.
+constexpr uint8_t kKtx2Magic[12]   = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+constexpr size_t  kKtx2IndexOffset = 48;
+constexpr size_t  kKtx2LevelOffset = 80;
+constexpr size_t  kKtx2LevelEntry  = 24; // byte offset, byte length, uncompressed length
+
+// Sanity limits: D3D11's maximum 2D size and array size.
+constexpr uint32_t kMaxDimension = 16384;
+constexpr uint32_t kMaxArraySize = 2048;
+
+void PutU32(std::vector<std::byte>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+void PutU64(std::vector<std::byte>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::byte>(value >> (8 * i)));
+}
+
+uint32_t GetU32(const std::byte* p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return value;
+}
+
+uint64_t GetU64(const std::byte* p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return value;
+}
+
+constexpr uint32_t FourCC(char a, char b, char c, char d) {
+    return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 | uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+}
+
+uint32_t MipExtent(uint32_t extent, uint32_t mip) { return std::max(1u, extent >> mip); }
+
+uint32_t FullMipCount(uint32_t width, uint32_t height) {
+    return static_cast<uint32_t>(std::bit_width(std::max(width, height)));
+}
+
+// Tightly packed size of one subresource.
+uint64_t SubresourceBytes(const DxgiBlockInfo& info, uint32_t width, uint32_t height) {
+    const uint64_t columns = (width + info.blockSize - 1) / info.blockSize;
+    const uint64_t rows    = (height + info.blockSize - 1) / info.blockSize;
+    return columns * rows * info.blockBytes;
+}
+
+// ---------------------------------------------------------------------------
+// Format tables
+// ---------------------------------------------------------------------------
+
+struct FormatEntry {
+    uint32_t dxgi;
+    uint32_t blockSize;
+    uint32_t blockBytes;
+    uint32_t vk; // VkFormat for KTX2; 0 = none
+};
+
+constexpr FormatEntry kFormats[] = {
+    {  2, 1, 16, 109 }, // R32G32B32A32_FLOAT
+    { 10, 1,  8,  97 }, // R16G16B16A16_FLOAT
+    { 11, 1,  8,  91 }, // R16G16B16A16_UNORM
+    { 16, 1,  8, 103 }, // R32G32_FLOAT
+    { 24, 1,  4,  64 }, // R10G10B10A2_UNORM (VK A2B10G10R10_UNORM_PACK32)
+    { 28, 1,  4,  37 }, // R8G8B8A8_UNORM
+    { 29, 1,  4,  43 }, // R8G8B8A8_UNORM_SRGB
+    { 34, 1,  4,  83 }, // R16G16_FLOAT
+    { 41, 1,  4, 100 }, // R32_FLOAT
+    { 49, 1,  2,  16 }, // R8G8_UNORM
+    { 54, 1,  2,  76 }, // R16_FLOAT
+    { 56, 1,  2,  70 }, // R16_UNORM
+    { 61, 1,  1,   9 }, // R8_UNORM
+    { 87, 1,  4,  44 }, // B8G8R8A8_UNORM
+    { 91, 1,  4,  50 }, // B8G8R8A8_UNORM_SRGB
+    { 71, 4,  8, 133 }, // BC1_UNORM (VK BC1_RGBA)
+    { 72, 4,  8, 134 }, // BC1_UNORM_SRGB
+    { 74, 4, 16, 135 }, // BC2_UNORM
+    { 75, 4, 16, 136 }, // BC2_UNORM_SRGB
+    { 77, 4, 16, 137 }, // BC3_UNORM
+    { 78, 4, 16, 138 }, // BC3_UNORM_SRGB
+    { 80, 4,  8, 139 }, // BC4_UNORM
+    { 81, 4,  8, 140 }, // BC4_SNORM
+    { 83, 4, 16, 141 }, // BC5_UNORM
+    { 84, 4, 16, 142 }, // BC5_SNORM
+    { 95, 4, 16, 143 }, // BC6H_UF16
+    { 96, 4, 16, 144 }, // BC6H_SF16
+    { 98, 4, 16, 145 }, // BC7_UNORM
+    { 99, 4, 16, 146 }, // BC7_UNORM_SRGB
+};
+
+const FormatEntry* FindDxgi(uint32_t dxgi) {
+    for (const FormatEntry& e : kFormats)
+        if (e.dxgi == dxgi) return &e;
+    return nullptr;
+}
+
+uint32_t DxgiFromVk(uint32_t vk) {
+    if (vk == 131) return 71; // BC1_RGB_UNORM: no RGB-only BC1 in DXGI
+    if (vk == 132) return 72; // BC1_RGB_SRGB
+    for (const FormatEntry& e : kFormats)
+        if (e.vk == vk) return e.dxgi;
+    return 0;
+}
+
+// DDS_PIXELFORMAT without a DX10 header -> DXGI_FORMAT; 0 when unknown.
+uint32_t DxgiFromLegacy(const std::byte* pf) {
+    const uint32_t flags = GetU32(pf + 4);
+    const uint32_t bits  = GetU32(pf + 12);
+    const uint32_t r     = GetU32(pf + 16);
+    const uint32_t g     = GetU32(pf + 20);
+    const uint32_t b     = GetU32(pf + 24);
+    const uint32_t a     = (flags & kDdpfAlphaPixels) ? GetU32(pf + 28) : 0;
+
+    if (flags & kDdpfFourCC) {
+        switch (GetU32(pf + 8)) {
+        case FourCC('D', 'X', 'T', '1'): return 71;
+        case FourCC('D', 'X', 'T', '2'):
+        case FourCC('D', 'X', 'T', '3'): return 74;
+        case FourCC('D', 'X', 'T', '4'):
+        case FourCC('D', 'X', 'T', '5'): return 77;
+        case FourCC('A', 'T', 'I', '1'):
+        case FourCC('B', 'C', '4', 'U'): return 80;
+        case FourCC('B', 'C', '4', 'S'): return 81;
+        case FourCC('A', 'T', 'I', '2'):
+        case FourCC('B', 'C', '5', 'U'): return 83;
+        case FourCC('B', 'C', '5', 'S'): return 84;
+        // D3DFORMAT values stored in the FourCC field.
+        case 36:  return 11; // A16B16G16R16
+        case 111: return 54; // R16F
+        case 112: return 34; // G16R16F
+        case 113: return 10; // A16B16G16R16F
+        case 114: return 41; // R32F
+        case 115: return 16; // G32R32F
+        case 116: return 2;  // A32B32G32R32F
+        default:  return 0;
+        }
+    }
+    if (flags & kDdpfRgb) {
+        if (bits == 32 && r == 0x000000FF && g == 0x0000FF00 && b == 0x00FF0000) return 28;
+        if (bits == 32 && r == 0x00FF0000 && g == 0x0000FF00 && b == 0x000000FF && a == 0xFF000000) return 87;
+        if (bits == 32 && r == 0x000003FF && g == 0x000FFC00 && b == 0x3FF00000) return 24;
+        return 0;
+    }
+    if (flags & kDdpfLuminance) {
+        if (bits == 8 && r == 0xFF) return 61;
+        if (bits == 16 && r == 0xFFFF) return 56;
+        if (bits == 16 && r == 0x00FF && a == 0xFF00) return 49;
+        return 0;
+    }
+    return 0;
+}
+
+} // namespace
+
+bool GetDxgiBlockInfo(uint32_t dxgiFormat, DxgiBlockInfo& out) {
+    const FormatEntry* e = FindDxgi(dxgiFormat);
+    if (!e) return false;
+    out = { e->blockSize, e->blockBytes };
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// TextureFile
+// ---------------------------------------------------------------------------
+
+bool TextureFile::Open(const std::filesystem::path& path) {
+    Close();
+    if (!mFile.Open(path)) return false;
+    if (OpenMemory(mFile.Bytes())) return true;
+    mFile.Close();
+    return false;
+}
+
+bool TextureFile::OpenMemory(std::span<const std::byte> image) {
+    mSubresources.clear();
+    mMipCount = mArraySize = 0;
+
+    bool ok = false;
+    if (image.size() >= sizeof(kDdsMagic) && std::memcmp(image.data(), kDdsMagic, sizeof(kDdsMagic)) == 0)
+        ok = ParseDds(image);
+    else if (image.size() >= sizeof(kKtx2Magic) && std::memcmp(image.data(), kKtx2Magic, sizeof(kKtx2Magic)) == 0)
+        ok = ParseKtx2(image);
+
+    if (!ok) {
+        mSubresources.clear();
+        mFormat = mWidth = mHeight = mMipCount = mArraySize = 0;
+        mCube   = false;
+    }
+    return ok;
+}
+
+void TextureFile::Close() {
+    mSubresources.clear();
+    mFormat = mWidth = mHeight = mMipCount = mArraySize = 0;
+    mCube   = false;
+    mFile.Close();
+}
+
+uint64_t TextureFile::MipBytes(uint32_t mip) const {
+    uint64_t bytes = 0;
+    for (uint32_t slice = 0; slice < mArraySize; ++slice) bytes += Subresource(mip, slice).data.size();
+    return bytes;
+}
+
+bool TextureFile::SetLayout(uint32_t format, uint32_t width, uint32_t height, uint32_t mipCount,
+                            uint32_t arraySize, bool cube) {
+    DxgiBlockInfo info;
+    if (!GetDxgiBlockInfo(format, info)) return false;
+    if (width == 0 || height == 0 || width > kMaxDimension || height > kMaxDimension) return false;
+    if (mipCount == 0 || mipCount > FullMipCount(width, height))                     return false;
+    if (arraySize == 0 || arraySize > kMaxArraySize * (cube ? 6u : 1u))              return false;
+    if (cube && (width != height || arraySize % 6 != 0))                            return false;
+
+    mFormat    = format;
+    mWidth     = width;
+    mHeight    = height;
+    mMipCount  = mipCount;
+    mArraySize = arraySize;
+    mCube      = cube;
+
+    mSubresources.resize(size_t(mipCount) * arraySize);
+    for (uint32_t slice = 0; slice < arraySize; ++slice) {
+        for (uint32_t mip = 0; mip < mipCount; ++mip) {
+            TextureSubresource& s = mSubresources[size_t(slice) * mipCount + mip];
+            s.width    = MipExtent(width, mip);
+            s.height   = MipExtent(height, mip);
+            s.rowPitch = (s.width + info.blockSize - 1) / info.blockSize * info.blockBytes;
+            s.rowCount = (s.height + info.blockSize - 1) / info.blockSize;
+            s.data     = {};
+        }
+    }
+    return true;
+}
+
+bool TextureFile::ParseDds(std::span<const std::byte> image) {
+    if (image.size() < kDdsDataOffset) return false;
+    const std::byte* h = image.data() + 4;
+    if (GetU32(h) != kDdsHeaderSize) return false;
+
+    const uint32_t flags    = GetU32(h + 4);
+    const uint32_t height   = GetU32(h + 8);
+    const uint32_t width    = GetU32(h + 12);
+    const uint32_t depth    = GetU32(h + 20);
+    const uint32_t mipCount = (flags & kDdsdMipMapCount) ? std::max(1u, GetU32(h + 24)) : 1u;
+    const std::byte* pf     = h + 72;
+    const uint32_t caps2    = GetU32(h + 108);
+
+    uint32_t format    = 0;
+    uint32_t arraySize = 1;
+    bool     cube      = false;
+    size_t   offset    = kDdsDataOffset;
+
+    if ((GetU32(pf + 4) & kDdpfFourCC) && GetU32(pf + 8) == FourCC('D', 'X', '1', '0')) {
+        if (image.size() < kDdsDataOffset + kDdsDx10Size) return false;
+        const std::byte* x = image.data() + kDdsDataOffset;
+        format             = GetU32(x);
+        if (GetU32(x + 4) != kDx10Texture2D) return false;
+        cube      = (GetU32(x + 8) & kDx10MiscCube) != 0;
+        arraySize = GetU32(x + 12);
+        if (arraySize == 0 || arraySize > kMaxArraySize) return false;
+        if (cube) arraySize *= 6;
+        offset += kDdsDx10Size;
+    } else {
+        format = DxgiFromLegacy(pf);
+        if (caps2 & kDdsCaps2Volume) return false;
+        if (caps2 & kDdsCaps2Cube) {
+            if ((caps2 & kDdsCaps2Faces) != kDdsCaps2Faces) return false; // partial cubes
+            cube      = true;
+            arraySize = 6;
+        }
+    }
+    if ((caps2 & kDdsCaps2Volume) || depth > 1) return false;
+    if (!SetLayout(format, width, height, mipCount, arraySize, cube)) return false;
+
+    // Slice-major: every mip of slice 0, then slice 1, ... The D3D
+    // subresource order, so the table is filled front to back.
+    const uint64_t size = image.size();
+    for (TextureSubresource& s : mSubresources) {
+        const uint64_t bytes = uint64_t{ s.rowPitch } * s.rowCount;
+        if (offset > size || bytes > size - offset) return false;
+        s.data = image.subspan(offset, size_t(bytes));
+        offset += size_t(bytes);
+    }
+    mContainer = Container::Dds;
+    return true;
+}
+
+bool TextureFile::ParseKtx2(std::span<const std::byte> image) {
+    if (image.size() < kKtx2LevelOffset) return false;
+    const std::byte* p = image.data();
+
+    const uint32_t vkFormat         = GetU32(p + 12);
+    const uint32_t width            = GetU32(p + 20);
+    const uint32_t height           = std::max(1u, GetU32(p + 24)); // 0 = 1D
+    const uint32_t depth            = GetU32(p + 28);
+    const uint32_t layers           = std::max(1u, GetU32(p + 32)); // 0 = not an array
+    const uint32_t faces            = GetU32(p + 36);
+    const uint32_t levels           = std::max(1u, GetU32(p + 40)); // 0 = generate at load
+    const uint32_t supercompression = GetU32(p + 44);
+
+    if (depth > 1 || supercompression != 0) return false;
+    if (faces != 1 && faces != 6)           return false;
+    if (layers > kMaxArraySize)             return false;
+    if (!SetLayout(DxgiFromVk(vkFormat), width, height, levels, layers * faces, faces == 6)) return false;
+
+    const uint64_t size = image.size();
+    if (uint64_t{ levels } > (size - kKtx2LevelOffset) / kKtx2LevelEntry) return false;
+
+    // Each level is one block: layer 0 faces 0-5, layer 1 faces 0-5, ...;
+    // slice = layer * faces + face, as in D3D.
+    for (uint32_t mip = 0; mip < levels; ++mip) {
+        const std::byte* e      = p + kKtx2LevelOffset + size_t{ mip } * kKtx2LevelEntry;
+        uint64_t         offset = GetU64(e);
+        const uint64_t   length = GetU64(e + 8);
+        if (offset > size || length > size - offset) return false;
+
+        const uint64_t bytes = uint64_t{ Subresource(mip).rowPitch } * Subresource(mip).rowCount;
+        if (length < bytes * mArraySize) return false;
+        for (uint32_t slice = 0; slice < mArraySize; ++slice) {
+            mSubresources[size_t(slice) * mMipCount + mip].data = image.subspan(size_t(offset), size_t(bytes));
+            offset += bytes;
+        }
+    }
+    mContainer = Container::Ktx2;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Writers
+// ---------------------------------------------------------------------------
+
+uint64_t TextureDataBytes(const TextureDesc& desc) {
+    DxgiBlockInfo info;
+    if (!GetDxgiBlockInfo(desc.format, info)) return 0;
+    uint64_t bytes = 0;
+    for (uint32_t mip = 0; mip < desc.mipCount; ++mip)
+        bytes += SubresourceBytes(info, MipExtent(desc.width, mip), MipExtent(desc.height, mip));
+    return bytes * desc.arraySize;
+}
+
+std::vector<std::byte> BuildDds(const TextureDesc& desc, std::span<const std::byte> data) {
+    DxgiBlockInfo info;
+    if (!GetDxgiBlockInfo(desc.format, info)) return {};
+    if (desc.mipCount == 0 || desc.arraySize == 0 || (desc.cube && desc.arraySize % 6 != 0)) return {};
+    if (data.size() != TextureDataBytes(desc)) return {};
+
+    const bool     compressed = info.blockSize > 1;
+    const uint64_t topBytes   = SubresourceBytes(info, desc.width, desc.height);
+    const uint32_t topPitch   = (desc.width + info.blockSize - 1) / info.blockSize * info.blockBytes;
+
+    std::vector<std::byte> out;
+    out.reserve(kDdsDataOffset + kDdsDx10Size + data.size());
+    out.insert(out.end(), reinterpret_cast<const std::byte*>(kDdsMagic),
+               reinterpret_cast<const std::byte*>(kDdsMagic) + sizeof(kDdsMagic));
+
+    PutU32(out, kDdsHeaderSize);
+    PutU32(out, kDdsdCaps | kDdsdHeight | kDdsdWidth | kDdsdPixelFormat | kDdsdMipMapCount |
+                    (compressed ? kDdsdLinearSize : kDdsdPitch));
+    PutU32(out, desc.height);
+    PutU32(out, desc.width);
+    PutU32(out, compressed ? static_cast<uint32_t>(topBytes) : topPitch);
+    PutU32(out, 0); // depth
+    PutU32(out, desc.mipCount);
+    for (int i = 0; i < 11; ++i) PutU32(out, 0); // reserved
+
+    // DDS_PIXELFORMAT: everything goes through the DX10 header.
+    PutU32(out, 32);
+    PutU32(out, kDdpfFourCC);
+    PutU32(out, FourCC('D', 'X', '1', '0'));
+    for (int i = 0; i < 5; ++i) PutU32(out, 0);
+
+    PutU32(out, kDdsCapsTexture | (desc.mipCount > 1 ? kDdsCapsMipMap | kDdsCapsComplex : 0) |
+                    (desc.cube ? kDdsCapsComplex : 0));
+    PutU32(out, desc.cube ? kDdsCaps2Cube | kDdsCaps2Faces : 0);
+    for (int i = 0; i < 3; ++i) PutU32(out, 0); // caps3, caps4, reserved
+
+    PutU32(out, desc.format);
+    PutU32(out, kDx10Texture2D);
+    PutU32(out, desc.cube ? kDx10MiscCube : 0);
+    PutU32(out, desc.cube ? desc.arraySize / 6 : desc.arraySize);
+    PutU32(out, 0); // miscFlags2
+
+    out.insert(out.end(), data.begin(), data.end());
+    return out;
+}
+
+std::vector<std::byte> BuildKtx2(const TextureDesc& desc, std::span<const std::byte> data) {
+    const FormatEntry* format = FindDxgi(desc.format);
+    if (!format || format->vk == 0) return {};
+    if (desc.mipCount == 0 || desc.arraySize == 0 || (desc.cube && desc.arraySize % 6 != 0)) return {};
+    if (data.size() != TextureDataBytes(desc)) return {};
+
+    const DxgiBlockInfo info   = { format->blockSize, format->blockBytes };
+    const uint32_t      faces  = desc.cube ? 6 : 1;
+    const uint32_t      layers = desc.arraySize / faces;
+
+    // Level data aligned to lcm(block bytes, 4), smallest level first as the
+    // spec recommends (a streaming reader gets the tail from the front).
+    const uint64_t align = std::max<uint64_t>(4, info.blockBytes);
+    std::vector<uint64_t> levelOffset(desc.mipCount);
+    std::vector<uint64_t> levelBytes(desc.mipCount);
+    uint64_t              end = kKtx2LevelOffset + uint64_t{ desc.mipCount } * kKtx2LevelEntry;
+    for (uint32_t mip = desc.mipCount; mip-- > 0;) {
+        levelBytes[mip]  = SubresourceBytes(info, MipExtent(desc.width, mip), MipExtent(desc.height, mip)) *
+                          desc.arraySize;
+        end              = (end + align - 1) / align * align;
+        levelOffset[mip] = end;
+        end += levelBytes[mip];
+    }
+
+    std::vector<std::byte> out;
+    out.reserve(size_t(end));
+    out.insert(out.end(), reinterpret_cast<const std::byte*>(kKtx2Magic),
+               reinterpret_cast<const std::byte*>(kKtx2Magic) + sizeof(kKtx2Magic));
+    PutU32(out, format->vk);
+    PutU32(out, 1);                               // typeSize
+    PutU32(out, desc.width);
+    PutU32(out, desc.height);
+    PutU32(out, 0);                               // depth
+    PutU32(out, desc.arraySize > faces ? layers : 0);
+    PutU32(out, faces);
+    PutU32(out, desc.mipCount);
+    PutU32(out, 0);                               // supercompression
+    for (size_t i = out.size(); i < kKtx2LevelOffset; ++i) out.push_back(std::byte{ 0 }); // empty index
+    for (uint32_t mip = 0; mip < desc.mipCount; ++mip) {
+        PutU64(out, levelOffset[mip]);
+        PutU64(out, levelBytes[mip]);
+        PutU64(out, levelBytes[mip]);
+    }
+    out.resize(size_t(end));
+
+    // `data` is slice-major; a KTX2 level holds that mip of every slice.
+    std::vector<uint64_t> mipOffset(desc.mipCount);
+    uint64_t              sliceBytes = 0;
+    for (uint32_t mip = 0; mip < desc.mipCount; ++mip) {
+        mipOffset[mip] = sliceBytes;
+        sliceBytes += levelBytes[mip] / desc.arraySize;
+    }
+    for (uint32_t mip = 0; mip < desc.mipCount; ++mip) {
+        const uint64_t bytes = levelBytes[mip] / desc.arraySize;
+        for (uint32_t slice = 0; slice < desc.arraySize; ++slice)
+            std::memcpy(out.data() + levelOffset[mip] + slice * bytes,
+                        data.data() + slice * sliceBytes + mipOffset[mip], size_t(bytes));
+    }
+    return out;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "MappedFile.h"
+
+// ---------------------------------------------------------------------------
+// Texel layout of a DXGI format: blocks of blockSize x blockSize texels,
+// blockBytes each (uncompressed formats are 1x1 blocks). False for formats
+// TextureFile does not know.
+// ---------------------------------------------------------------------------
+struct DxgiBlockInfo {
+    uint32_t blockSize  = 1;
+    uint32_t blockBytes = 0;
+};
+[[nodiscard]] bool GetDxgiBlockInfo(uint32_t dxgiFormat, DxgiBlockInfo& out);
+
+// One mip of one array slice; `data` points into the file image.
+struct TextureSubresource {
+    uint32_t                   width    = 0;
+    uint32_t                   height   = 0;
+    uint32_t                   rowPitch = 0; // bytes per row of blocks
+    uint32_t                   rowCount = 0; // rows of blocks
+    std::span<const std::byte> data;
+};
+
+// ---------------------------------------------------------------------------
+// TextureFile — a DDS or KTX2 texture, memory-mapped and indexed in place.
+//
+// Open() reads the header and builds a table of subresources that point
+// into the mapping; no texel is copied or even touched, so pages are only
+// faulted in for the mips that are actually uploaded (see TextureStreamer).
+//
+// Supported: 2D textures, arrays and cube maps (a cube is 6 slices per
+// element, D3D order), in the uncompressed and BC formats of
+// GetDxgiBlockInfo(). DDS files may use the DX10 header or the common
+// legacy FourCC / RGBA-mask pixel formats; KTX2 files must not be
+// supercompressed. Volume textures are rejected.
+// ---------------------------------------------------------------------------
+class TextureFile {
+public:
+    enum class Container : uint8_t { Dds, Ktx2 };
+
+    TextureFile() = default;
+    TextureFile(const TextureFile&) = delete;
+    TextureFile& operator=(const TextureFile&) = delete;
+
+    // Maps `path`; any previous file is closed first. Spans handed out
+    // earlier become invalid.
+    [[nodiscard]] bool Open(const std::filesystem::path& path);
+
+    // Uses an image already in memory; `image` must outlive the file.
+    [[nodiscard]] bool OpenMemory(std::span<const std::byte> image);
+
+    void Close();
+
+    [[nodiscard]] Container Type()      const { return mContainer; }
+    [[nodiscard]] uint32_t  Format()    const { return mFormat; } // DXGI_FORMAT
+    [[nodiscard]] uint32_t  Width()     const { return mWidth; }
+    [[nodiscard]] uint32_t  Height()    const { return mHeight; }
+    [[nodiscard]] uint32_t  MipCount()  const { return mMipCount; }
+    [[nodiscard]] uint32_t  ArraySize() const { return mArraySize; } // slices, 6 per cube
+    [[nodiscard]] bool      IsCube()    const { return mCube; }
+
+    // D3D subresource order: mip + slice * MipCount().
+    [[nodiscard]] std::span<const TextureSubresource> Subresources() const { return mSubresources; }
+    [[nodiscard]] const TextureSubresource& Subresource(uint32_t mip, uint32_t slice = 0) const {
+        return mSubresources[size_t(slice) * mMipCount + mip];
+    }
+
+    // Bytes of `mip` over all slices.
+    [[nodiscard]] uint64_t MipBytes(uint32_t mip) const;
+
+private:
+    [[nodiscard]] bool ParseDds(std::span<const std::byte> image);
+    [[nodiscard]] bool ParseKtx2(std::span<const std::byte> image);
+    [[nodiscard]] bool SetLayout(uint32_t format, uint32_t width, uint32_t height, uint32_t mipCount,
+                                 uint32_t arraySize, bool cube);
+
+    MappedFile                      mFile;
+    Container                       mContainer = Container::Dds;
+    uint32_t                        mFormat    = 0;
+    uint32_t                        mWidth     = 0;
+    uint32_t                        mHeight    = 0;
+    uint32_t                        mMipCount  = 0;
+    uint32_t                        mArraySize = 0;
+    bool                            mCube      = false;
+    std::vector<TextureSubresource> mSubresources;
+};
+
+// ---------------------------------------------------------------------------
+// Writers, for tools and synthetic test data. `data` holds every
+// subresource tightly packed in D3D order (all mips of slice 0, then slice
+// 1, ...). Empty on an unknown format or a `data` size that does not match.
+// BuildKtx2() writes the index and level table only (no data format
+// descriptor or key/value data), which is all TextureFile reads.
+// ---------------------------------------------------------------------------
+struct TextureDesc {
+    uint32_t format    = 0; // DXGI_FORMAT
+    uint32_t width     = 0;
+    uint32_t height    = 0;
+    uint32_t mipCount  = 1;
+    uint32_t arraySize = 1; // slices; a multiple of 6 for cubes
+    bool     cube      = false;
+};
+
+// Tightly packed size of all subresources; 0 for an unknown format.
+[[nodiscard]] uint64_t TextureDataBytes(const TextureDesc& desc);
+
+[[nodiscard]] std::vector<std::byte> BuildDds(const TextureDesc& desc, std::span<const std::byte> data);
+[[nodiscard]] std::vector<std::byte> BuildKtx2(const TextureDesc& desc, std::span<const std::byte> data);
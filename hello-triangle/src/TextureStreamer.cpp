@@ -0,0 +1,94 @@
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "TextureFile.h"
+
+uint32_t TextureStreamer::Add(const TextureFile& file) {
+    Texture t;
+    t.file = &file;
+    t.mipBytes.resize(file.MipCount());
+    for (uint32_t mip = 0; mip < file.MipCount(); ++mip) t.mipBytes[mip] = file.MipBytes(mip);
+    t.residentMip = file.MipCount();
+    t.wantedMip   = file.MipCount() > 0 ? file.MipCount() - 1 : 0;
+    mTextures.push_back(std::move(t));
+    return static_cast<uint32_t>(mTextures.size() - 1);
+}
+
+void TextureStreamer::SetWantedMip(uint32_t texture, uint32_t mip) {
+    Texture& t  = mTextures[texture];
+    t.wantedMip = std::min(mip, t.file->MipCount() > 0 ? t.file->MipCount() - 1 : 0);
+}
+
+void TextureStreamer::Update(uint64_t maxLoadBytes, std::vector<StreamRequest>& out) {
+    mEvictHeapBuilt = false;
+    if (mResident > mBudget) (void)MakeRoom(0, out);
+
+    // Min-heap on the size of each texture's next mip: the cheapest loads,
+    // i.e. the coarsest missing mips, go first.
+    mLoadHeap.clear();
+    for (uint32_t i = 0; i < mTextures.size(); ++i) {
+        const Texture& t = mTextures[i];
+        if (t.residentMip > t.wantedMip) mLoadHeap.emplace_back(t.mipBytes[t.residentMip - 1], i);
+    }
+    std::make_heap(mLoadHeap.begin(), mLoadHeap.end(), std::greater<>{});
+
+    uint64_t loaded = 0;
+    while (!mLoadHeap.empty()) {
+        const auto [bytes, i] = mLoadHeap.front();
+        // The heap top is the smallest candidate: if it does not fit,
+        // nothing else does. A mip over the whole limit goes alone.
+        if (loaded > 0 && (loaded >= maxLoadBytes || bytes > maxLoadBytes - loaded)) break;
+        if (!MakeRoom(bytes, out))         break;
+
+        std::pop_heap(mLoadHeap.begin(), mLoadHeap.end(), std::greater<>{});
+        mLoadHeap.pop_back();
+
+        Texture& t = mTextures[i];
+        --t.residentMip;
+        mResident += bytes;
+        loaded += bytes;
+        out.push_back({ StreamRequest::Kind::Load, i, t.residentMip });
+
+        if (t.residentMip > t.wantedMip) {
+            mLoadHeap.emplace_back(t.mipBytes[t.residentMip - 1], i);
+            std::push_heap(mLoadHeap.begin(), mLoadHeap.end(), std::greater<>{});
+        }
+    }
+}
+
+bool TextureStreamer::MakeRoom(uint64_t needed, std::vector<StreamRequest>& out) {
+    if (needed > mBudget) return false;
+    if (mResident <= mBudget - needed) return true;
+
+    // Max-heap on the size of each over-resident texture's finest mip, built
+    // on first use. No texture is both loading and evicting within one
+    // Update(), so entries stay valid while it runs.
+    if (!mEvictHeapBuilt) {
+        mEvictHeap.clear();
+        for (uint32_t i = 0; i < mTextures.size(); ++i) {
+            const Texture& t = mTextures[i];
+            if (t.residentMip < t.wantedMip) mEvictHeap.emplace_back(t.mipBytes[t.residentMip], i);
+        }
+        std::make_heap(mEvictHeap.begin(), mEvictHeap.end());
+        mEvictHeapBuilt = true;
+    }
+
+    while (mResident > mBudget - needed && !mEvictHeap.empty()) {
+        std::pop_heap(mEvictHeap.begin(), mEvictHeap.end());
+        const auto [bytes, i] = mEvictHeap.back();
+        mEvictHeap.pop_back();
+
+        Texture& t = mTextures[i];
+        out.push_back({ StreamRequest::Kind::Evict, i, t.residentMip });
+        ++t.residentMip;
+        mResident -= bytes;
+
+        if (t.residentMip < t.wantedMip) {
+            mEvictHeap.emplace_back(t.mipBytes[t.residentMip], i);
+            std::push_heap(mEvictHeap.begin(), mEvictHeap.end());
+        }
+    }
+    return mResident <= mBudget - needed;
+}
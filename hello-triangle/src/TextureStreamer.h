@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class TextureFile;
+
+// ---------------------------------------------------------------------------
+// TextureStreamer — decides which mips of which textures are resident.
+//
+// Each texture keeps a contiguous resident range [ResidentMip, MipCount):
+// mips arrive from the coarsest up, so the tail is usable (one texel's worth
+// of data) as soon as the first request completes and every later load only
+// sharpens it. The renderer says how sharp each texture should be with
+// SetWantedMip(); Update() turns the difference into load and evict requests:
+//
+//   - loads go smallest-first across all textures, up to `maxLoadBytes` per
+//     call (a single mip over the limit is loaded on its own), so a frame's
+//     upload time stays bounded and many textures get their tails before
+//     any one gets its full-size level
+//   - resident bytes never exceed the budget: when a load does not fit,
+//     mips that are no longer wanted (ResidentMip < WantedMip) are evicted,
+//     largest first; wanted mips are never evicted to make room
+//
+// The streamer only does bookkeeping. The caller executes the requests in
+// order — copy TextureFile::Subresource(mip, slice) for a load, drop the
+// memory for an evict — and clamps sampling to ResidentMip (MinLOD), and
+// the streamer treats them as done once returned.
+// ---------------------------------------------------------------------------
+
+struct StreamRequest {
+    enum class Kind : uint8_t { Load, Evict };
+
+    Kind     kind    = Kind::Load;
+    uint32_t texture = 0; // id from Add()
+    uint32_t mip     = 0;
+};
+
+class TextureStreamer {
+public:
+    explicit TextureStreamer(uint64_t budgetBytes) : mBudget(budgetBytes) {}
+
+    // `file` must stay open while registered. Nothing is resident yet; the
+    // wanted mip starts at the coarsest, so the next Update() loads the tail.
+    [[nodiscard]] uint32_t Add(const TextureFile& file);
+
+    // Clamped to the texture's mip range.
+    void SetWantedMip(uint32_t texture, uint32_t mip);
+
+    // A smaller budget takes effect at the next Update(), as far as
+    // unwanted mips can be evicted.
+    void SetBudget(uint64_t budgetBytes) { mBudget = budgetBytes; }
+
+    // Appends this call's requests to `out`, evictions before the loads they
+    // make room for.
+    void Update(uint64_t maxLoadBytes, std::vector<StreamRequest>& out);
+
+    [[nodiscard]] uint32_t TextureCount()           const { return static_cast<uint32_t>(mTextures.size()); }
+    [[nodiscard]] uint32_t ResidentMip(uint32_t t)  const { return mTextures[t].residentMip; } // MipCount() = none
+    [[nodiscard]] uint32_t WantedMip(uint32_t t)    const { return mTextures[t].wantedMip; }
+    [[nodiscard]] uint64_t ResidentBytes()          const { return mResident; }
+    [[nodiscard]] uint64_t BudgetBytes()            const { return mBudget; }
+
+private:
+    struct Texture {
+        const TextureFile*    file        = nullptr;
+        std::vector<uint64_t> mipBytes; // per mip, all slices
+        uint32_t              residentMip = 0;
+        uint32_t              wantedMip   = 0;
+    };
+
+    // Evicts unwanted mips, largest first, until `needed` more bytes fit.
+    bool MakeRoom(uint64_t needed, std::vector<StreamRequest>& out);
+
+    std::vector<Texture> mTextures;
+    uint64_t             mBudget   = 0;
+    uint64_t             mResident = 0;
+
+    // Scratch heaps, reused across updates: (bytes, texture).
+    std::vector<std::pair<uint64_t, uint32_t>> mLoadHeap;
+    std::vector<std::pair<uint64_t, uint32_t>> mEvictHeap;
+    bool                                       mEvictHeapBuilt = false;
+};
@@ -0,0 +1,299 @@
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+bool TlsfAllocator::Init(uint64_t capacity, uint64_t granularity) {
+    if (!std::has_single_bit(granularity) || capacity < granularity) return false;
+
+    mGranularity     = granularity;
+    mGranularityLog2 = static_cast<uint32_t>(std::countr_zero(granularity));
+    mCapacity        = capacity & ~(granularity - 1);
+    mUsedBytes       = 0;
+    mAllocationCount = 0;
+
+    mFirstBitmap = 0;
+    std::fill(std::begin(mSecondBitmap), std::end(mSecondBitmap), 0u);
+    for (auto& row : mHeads) std::fill(std::begin(row), std::end(row), kNone);
+
+    mBlocks.clear();
+    mFreeNodes = kNone;
+
+    // Node 0 is the physically first block for the allocator's lifetime:
+    // splits keep the front part and merges keep the lower block.
+    const uint32_t root = NewNode();
+    mBlocks[root].offset = 0;
+    mBlocks[root].size   = mCapacity >> mGranularityLog2;
+    InsertFree(root);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Size classes
+// ---------------------------------------------------------------------------
+
+// Class that contains a block of `granules`.
+TlsfAllocator::SizeClass TlsfAllocator::Mapping(uint64_t granules) {
+    if (granules < kSecondLevels) return { 0, static_cast<uint32_t>(granules) };
+
+    const uint32_t msb = static_cast<uint32_t>(std::bit_width(granules)) - 1;
+    return { msb - kSecondLevelBits + 1,
+             static_cast<uint32_t>(granules >> (msb - kSecondLevelBits)) - kSecondLevels };
+}
+
+// Smallest class whose every block holds at least `granules`: round the
+// request up to the next class boundary first.
+TlsfAllocator::SizeClass TlsfAllocator::MappingSearch(uint64_t granules) {
+    if (granules >= kSecondLevels) {
+        const uint32_t msb = static_cast<uint32_t>(std::bit_width(granules)) - 1;
+        granules += (1ull << (msb - kSecondLevelBits)) - 1;
+    }
+    return Mapping(granules);
+}
+
+uint32_t TlsfAllocator::FindFree(SizeClass& sc) const {
+    uint32_t secondMap = mSecondBitmap[sc.first] & (~0u << sc.second);
+    if (secondMap == 0) {
+        const uint64_t firstMap = sc.first + 1 < 64 ? mFirstBitmap & (~0ull << (sc.first + 1)) : 0;
+        if (firstMap == 0) return kNone;
+
+        sc.first  = static_cast<uint32_t>(std::countr_zero(firstMap));
+        secondMap = mSecondBitmap[sc.first];
+    }
+    sc.second = static_cast<uint32_t>(std::countr_zero(secondMap));
+    return mHeads[sc.first][sc.second];
+}
+
+// Slow path: the first free block, from the class of `granules` upwards,
+// that holds `granules` after aligning its start.
+uint32_t TlsfAllocator::FindFitting(uint64_t granules, uint64_t alignGranules) const {
+    const SizeClass lowest = Mapping(granules);
+    for (uint32_t f = lowest.first; f < kFirstLevels; ++f) {
+        uint32_t secondMap = mSecondBitmap[f];
+        if (f == lowest.first) secondMap &= ~0u << lowest.second;
+        for (; secondMap != 0; secondMap &= secondMap - 1) {
+            const uint32_t s = static_cast<uint32_t>(std::countr_zero(secondMap));
+            for (uint32_t b = mHeads[f][s]; b != kNone; b = mBlocks[b].nextFree) {
+                const Block&   block = mBlocks[b];
+                const uint64_t start = (block.offset + alignGranules - 1) & ~(alignGranules - 1);
+                if (start + granules <= block.offset + block.size) return b;
+            }
+        }
+    }
+    return kNone;
+}
+
+void TlsfAllocator::InsertFree(uint32_t block) {
+    Block&          b  = mBlocks[block];
+    const SizeClass sc = Mapping(b.size);
+    uint32_t&       head = mHeads[sc.first][sc.second];
+
+    b.free     = true;
+    b.prevFree = kNone;
+    b.nextFree = head;
+    if (head != kNone) mBlocks[head].prevFree = block;
+    head = block;
+
+    mSecondBitmap[sc.first] |= 1u << sc.second;
+    mFirstBitmap            |= 1ull << sc.first;
+}
+
+void TlsfAllocator::RemoveFree(uint32_t block) {
+    Block&          b  = mBlocks[block];
+    const SizeClass sc = Mapping(b.size);
+
+    if (b.prevFree != kNone) mBlocks[b.prevFree].nextFree = b.nextFree;
+    if (b.nextFree != kNone) mBlocks[b.nextFree].prevFree = b.prevFree;
+
+    uint32_t& head = mHeads[sc.first][sc.second];
+    if (head == block) {
+        head = b.nextFree;
+        if (head == kNone) {
+            mSecondBitmap[sc.first] &= ~(1u << sc.second);
+            if (mSecondBitmap[sc.first] == 0) mFirstBitmap &= ~(1ull << sc.first);
+        }
+    }
+
+    b.free     = false;
+    b.prevFree = kNone;
+    b.nextFree = kNone;
+}
+
+// ---------------------------------------------------------------------------
+// Block nodes
+// ---------------------------------------------------------------------------
+
+uint32_t TlsfAllocator::NewNode() {
+    if (mFreeNodes != kNone) {
+        const uint32_t node = mFreeNodes;
+        mFreeNodes = mBlocks[node].nextFree;
+        mBlocks[node] = Block{};
+        return node;
+    }
+    mBlocks.emplace_back();
+    return static_cast<uint32_t>(mBlocks.size() - 1);
+}
+
+void TlsfAllocator::ReleaseNode(uint32_t node) {
+    mBlocks[node]          = Block{};
+    mBlocks[node].nextFree = mFreeNodes;
+    mFreeNodes             = node;
+}
+
+// Shrinks `block` to `granules` and returns a new node for the remainder.
+uint32_t TlsfAllocator::SplitOff(uint32_t block, uint64_t granules) {
+    const uint32_t tail = NewNode(); // may reallocate mBlocks: index only
+
+    mBlocks[tail].offset   = mBlocks[block].offset + granules;
+    mBlocks[tail].size     = mBlocks[block].size - granules;
+    mBlocks[tail].prevPhys = block;
+    mBlocks[tail].nextPhys = mBlocks[block].nextPhys;
+    if (mBlocks[tail].nextPhys != kNone) mBlocks[mBlocks[tail].nextPhys].prevPhys = tail;
+
+    mBlocks[block].size     = granules;
+    mBlocks[block].nextPhys = tail;
+    return tail;
+}
+
+// Merges physical successor `next` into `block`.
+void TlsfAllocator::Absorb(uint32_t block, uint32_t next) {
+    mBlocks[block].size     += mBlocks[next].size;
+    mBlocks[block].nextPhys  = mBlocks[next].nextPhys;
+    if (mBlocks[block].nextPhys != kNone) mBlocks[mBlocks[block].nextPhys].prevPhys = block;
+    ReleaseNode(next);
+}
+
+// ---------------------------------------------------------------------------
+// Allocate / Free
+// ---------------------------------------------------------------------------
+
+bool TlsfAllocator::Allocate(uint64_t size, uint64_t alignment, TlsfAllocation& out) {
+    if (mCapacity == 0 || size == 0 || size > mCapacity || !std::has_single_bit(alignment))
+        return false;
+
+    const uint64_t granules      = (size + mGranularity - 1) >> mGranularityLog2;
+    const uint64_t alignGranules = std::max(alignment, mGranularity) >> mGranularityLog2;
+
+    // Search for room for the worst-case leading padding as well; when no
+    // class is large enough for that, look for a block that fits as it is.
+    SizeClass      sc    = MappingSearch(granules + alignGranules - 1);
+    uint32_t       block = sc.first < kFirstLevels ? FindFree(sc) : kNone;
+    if (block == kNone) block = FindFitting(granules, alignGranules);
+    if (block == kNone) return false;
+    RemoveFree(block);
+
+    const uint64_t start   = (mBlocks[block].offset + alignGranules - 1) & ~(alignGranules - 1);
+    const uint64_t padding = start - mBlocks[block].offset;
+    if (padding > 0) {
+        // The physical predecessor of a free block is never free, so the
+        // padding block needs no merging.
+        const uint32_t aligned = SplitOff(block, padding);
+        InsertFree(block);
+        block = aligned;
+    }
+    if (mBlocks[block].size > granules) InsertFree(SplitOff(block, granules));
+
+    mUsedBytes += granules << mGranularityLog2;
+    ++mAllocationCount;
+
+    out.offset = start << mGranularityLog2;
+    out.size   = size;
+    out.block  = block;
+    return true;
+}
+
+void TlsfAllocator::Free(const TlsfAllocation& allocation) {
+    uint32_t block = allocation.block;
+    if (block >= mBlocks.size() || mBlocks[block].free || mBlocks[block].size == 0) return;
+
+    mUsedBytes -= mBlocks[block].size << mGranularityLog2;
+    --mAllocationCount;
+
+    const uint32_t next = mBlocks[block].nextPhys;
+    if (next != kNone && mBlocks[next].free) {
+        RemoveFree(next);
+        Absorb(block, next);
+    }
+    const uint32_t prev = mBlocks[block].prevPhys;
+    if (prev != kNone && mBlocks[prev].free) {
+        RemoveFree(prev);
+        Absorb(prev, block);
+        block = prev;
+    }
+    InsertFree(block);
+}
+
+// ---------------------------------------------------------------------------
+// Statistics / validation
+// ---------------------------------------------------------------------------
+
+uint64_t TlsfAllocator::LargestFreeBlock() const {
+    if (mFirstBitmap == 0) return 0;
+
+    // The largest block is somewhere in the highest non-empty class.
+    const uint32_t first  = 63 - static_cast<uint32_t>(std::countl_zero(mFirstBitmap));
+    const uint32_t second = 31 - static_cast<uint32_t>(std::countl_zero(mSecondBitmap[first]));
+
+    uint64_t largest = 0;
+    for (uint32_t b = mHeads[first][second]; b != kNone; b = mBlocks[b].nextFree)
+        largest = std::max(largest, mBlocks[b].size);
+    return largest << mGranularityLog2;
+}
+
+double TlsfAllocator::Fragmentation() const {
+    const uint64_t freeBytes = FreeBytes();
+    if (freeBytes == 0) return 0.0;
+    return 1.0 - static_cast<double>(LargestFreeBlock()) / static_cast<double>(freeBytes);
+}
+
+bool TlsfAllocator::Validate() const {
+    if (mBlocks.empty()) return mCapacity == 0;
+
+    // --- Physical chain ---
+    uint64_t offset     = 0;
+    uint64_t usedBytes  = 0;
+    uint32_t usedCount  = 0;
+    uint32_t freeCount  = 0;
+    uint32_t prev       = kNone;
+    bool     prevFree   = false;
+    for (uint32_t b = 0; b != kNone; b = mBlocks[b].nextPhys) {
+        const Block& block = mBlocks[b];
+        if (block.size == 0 || block.offset != offset || block.prevPhys != prev) return false;
+        if (block.free && prevFree) return false; // unmerged neighbours
+
+        if (block.free) {
+            ++freeCount;
+        } else {
+            ++usedCount;
+            usedBytes += block.size << mGranularityLog2;
+        }
+        offset  += block.size;
+        prev     = b;
+        prevFree = block.free;
+    }
+    if ((offset << mGranularityLog2) != mCapacity) return false;
+    if (usedBytes != mUsedBytes || usedCount != mAllocationCount) return false;
+
+    // --- Size-class lists and bitmaps ---
+    uint32_t listed = 0;
+    for (uint32_t f = 0; f < kFirstLevels; ++f) {
+        const bool firstBit = (mFirstBitmap >> f) & 1;
+        if (firstBit != (mSecondBitmap[f] != 0)) return false;
+
+        for (uint32_t s = 0; s < kSecondLevels; ++s) {
+            const bool secondBit = (mSecondBitmap[f] >> s) & 1;
+            if (secondBit != (mHeads[f][s] != kNone)) return false;
+
+            uint32_t prevInList = kNone;
+            for (uint32_t b = mHeads[f][s]; b != kNone; b = mBlocks[b].nextFree) {
+                const Block&    block = mBlocks[b];
+                const SizeClass sc    = Mapping(block.size);
+                if (!block.free || block.prevFree != prevInList) return false;
+                if (sc.first != f || sc.second != s) return false;
+                if (++listed > freeCount) return false; // also stops cycles
+                prevInList = b;
+            }
+        }
+    }
+    return listed == freeCount;
+}
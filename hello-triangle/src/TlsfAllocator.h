@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// D3D12 placed-resource alignment classes.
+constexpr uint64_t kSmallTexturePlacementAlignment = 4ull << 10;  // D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT
+constexpr uint64_t kDefaultPlacementAlignment      = 64ull << 10; // buffers, textures (D3D12_DEFAULT_...)
+constexpr uint64_t kMsaaPlacementAlignment         = 4ull << 20;  // D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT
+
+// A range handed out by TlsfAllocator.
+struct TlsfAllocation {
+    static constexpr uint32_t kInvalid = ~0u;
+
+    uint64_t offset = 0;
+    uint64_t size   = 0;        // as requested
+    uint32_t block  = kInvalid; // pass back to Free()
+
+    [[nodiscard]] bool IsValid() const { return block != kInvalid; }
+};
+
+// ---------------------------------------------------------------------------
+// TlsfAllocator — Two-Level Segregated Fit allocator over an abstract range
+// [0, capacity), e.g. one ID3D12Heap.
+//
+// Free blocks are kept in kFirstLevels x kSecondLevels size-class lists: the
+// first level is the power of two, the second splits it into 16 linear
+// steps. Two bitmaps locate the smallest non-empty class that is guaranteed
+// to fit with two bit scans, so Allocate() and Free() are O(1) regardless of
+// how many blocks exist. Freed blocks merge with free physical neighbours
+// immediately.
+//
+// That search rounds the request up to a class boundary and reserves the
+// worst-case alignment padding, so it can miss a block that fits exactly or
+// is already aligned — e.g. the whole range at 64 KB alignment. Only then
+// Allocate() walks the lists of the classes below it, first fit.
+//
+// Block metadata lives in a CPU-side node pool (GPU heap memory cannot hold
+// headers). Every offset and size is a multiple of the granularity;
+// alignments above it are met by splitting the leading padding off into its
+// own free block.
+// ---------------------------------------------------------------------------
+class TlsfAllocator {
+public:
+    [[nodiscard]] bool Init(uint64_t capacity, uint64_t granularity = kSmallTexturePlacementAlignment);
+
+    // `alignment` must be a power of two.
+    [[nodiscard]] bool Allocate(uint64_t size, uint64_t alignment, TlsfAllocation& out);
+    void               Free(const TlsfAllocation& allocation);
+
+    // --- Statistics ---
+    [[nodiscard]] uint64_t Capacity()        const { return mCapacity; }
+    [[nodiscard]] uint64_t Granularity()     const { return mGranularity; }
+    [[nodiscard]] uint64_t UsedBytes()       const { return mUsedBytes; } // incl. rounding to granularity
+    [[nodiscard]] uint64_t FreeBytes()       const { return mCapacity - mUsedBytes; }
+    [[nodiscard]] uint32_t AllocationCount() const { return mAllocationCount; }
+    [[nodiscard]] uint64_t LargestFreeBlock() const;
+
+    // 1 - largest free block / free bytes: 0 when all free space is one block.
+    [[nodiscard]] double Fragmentation() const;
+
+    // Walks every block and free list and checks the structural invariants
+    // (contiguity, merging, size classes, bitmaps, byte counts). O(n); for
+    // fuzzing and debugging.
+    [[nodiscard]] bool Validate() const;
+
+private:
+    static constexpr uint32_t kSecondLevelBits = 4;
+    static constexpr uint32_t kSecondLevels    = 1u << kSecondLevelBits;
+    static constexpr uint32_t kFirstLevels     = 64 - kSecondLevelBits + 1;
+    static constexpr uint32_t kNone            = ~0u;
+
+    struct Block {
+        uint64_t offset   = 0; // in granules
+        uint64_t size     = 0; // in granules
+        uint32_t prevPhys = kNone;
+        uint32_t nextPhys = kNone;
+        uint32_t prevFree = kNone; // size-class list links; node free list uses nextFree
+        uint32_t nextFree = kNone;
+        bool     free     = false;
+    };
+
+    struct SizeClass {
+        uint32_t first;
+        uint32_t second;
+    };
+
+    [[nodiscard]] static SizeClass Mapping(uint64_t granules);
+    [[nodiscard]] static SizeClass MappingSearch(uint64_t granules);
+
+    [[nodiscard]] uint32_t FindFree(SizeClass& sc) const;
+    [[nodiscard]] uint32_t FindFitting(uint64_t granules, uint64_t alignGranules) const;
+    void                   InsertFree(uint32_t block);
+    void                   RemoveFree(uint32_t block);
+    [[nodiscard]] uint32_t SplitOff(uint32_t block, uint64_t granules); // returns the tail
+    void                   Absorb(uint32_t block, uint32_t next);        // block += next
+    [[nodiscard]] uint32_t NewNode();
+    void                   ReleaseNode(uint32_t node);
+
+    uint64_t mCapacity        = 0;
+    uint64_t mGranularity     = 0;
+    uint32_t mGranularityLog2 = 0;
+    uint64_t mUsedBytes       = 0;
+    uint32_t mAllocationCount = 0;
+
+    uint64_t mFirstBitmap = 0;
+    uint32_t mSecondBitmap[kFirstLevels] = {};
+    uint32_t mHeads[kFirstLevels][kSecondLevels];
+
+    std::vector<Block> mBlocks;
+    uint32_t           mFreeNodes = kNone;
+};
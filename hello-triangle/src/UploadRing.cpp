@@ -0,0 +1,76 @@
+#include "UploadRing.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+namespace {
+
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+bool UploadRing::Init(void* cpuBase, uint64_t gpuBase, uint64_t capacity) {
+    if (cpuBase == nullptr || capacity == 0) return false;
+
+    mCpuBase    = static_cast<std::byte*>(cpuBase);
+    mGpuBase    = gpuBase;
+    mCapacity   = capacity;
+    mHead       = 0;
+    mTail       = 0;
+    mFrameStart = 0;
+    mFrames.clear();
+
+    mLastFrameBytes    = 0;
+    mPeakFrameBytes    = 0;
+    mHighWater         = 0;
+    mFailedAllocations = 0;
+    return true;
+}
+
+bool UploadRing::Allocate(uint64_t size, UploadAllocation& out, uint64_t alignment) {
+    if (mCapacity == 0 || size == 0 || !std::has_single_bit(alignment)) return false;
+
+    // Align the physical offset; GPU VAs of buffers are 64 KB aligned, so
+    // aligning the offset aligns the address.
+    const uint64_t physical = mHead % mCapacity;
+    uint64_t       offset   = AlignUp(physical, alignment);
+    uint64_t       consumed = (offset - physical) + size;
+
+    if (offset + size > mCapacity) {
+        // Does not fit before the end: skip the tail end and restart at 0.
+        offset   = 0;
+        consumed = (mCapacity - physical) + size;
+    }
+
+    if (BytesInFlight() + consumed > mCapacity) {
+        ++mFailedAllocations; // ring full: the GPU is too far behind
+        return false;
+    }
+
+    mHead += consumed;
+    mHighWater = std::max(mHighWater, BytesInFlight());
+
+    out.cpu    = mCpuBase + offset;
+    out.gpu    = mGpuBase + offset;
+    out.offset = offset;
+    out.size   = size;
+    return true;
+}
+
+void UploadRing::EndFrame(uint64_t fenceValue) {
+    mLastFrameBytes = mHead - mFrameStart;
+    mPeakFrameBytes = std::max(mPeakFrameBytes, mLastFrameBytes);
+
+    mFrames.push_back({ fenceValue, mHead });
+    mFrameStart = mHead;
+}
+
+void UploadRing::Retire(uint64_t completedFenceValue) {
+    while (!mFrames.empty() && mFrames.front().fenceValue <= completedFenceValue) {
+        mTail = mFrames.front().head;
+        mFrames.pop_front();
+    }
+}
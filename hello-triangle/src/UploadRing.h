@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+// A sub-allocation handed out by UploadRing: where the CPU writes and the
+// GPU virtual address the GPU reads the same bytes from.
+struct UploadAllocation {
+    void*    cpu    = nullptr;
+    uint64_t gpu    = 0; // D3D12_GPU_VIRTUAL_ADDRESS
+    uint64_t offset = 0; // byte offset from the start of the ring
+    uint64_t size   = 0;
+};
+
+// ---------------------------------------------------------------------------
+// UploadRing — linear ring allocator over one persistently mapped upload
+// buffer.
+//
+// Allocations are bump-allocated from the head and never freed one by one.
+// EndFrame() tags everything allocated since the previous EndFrame() with the
+// frame's fence value; Retire() moves the tail past every frame whose fence
+// has completed. An allocation never straddles the end of the buffer: if it
+// does not fit, the remainder is skipped and the allocation restarts at 0.
+//
+// The ring only does address arithmetic, so it works with any base address
+// (a real mapped resource, or a plain host buffer with a fake GPU VA).
+// ---------------------------------------------------------------------------
+class UploadRing {
+public:
+    // D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT
+    static constexpr uint64_t kConstantBufferAlignment = 256;
+
+    [[nodiscard]] bool Init(void* cpuBase, uint64_t gpuBase, uint64_t capacity);
+
+    // `alignment` must be a power of two.
+    [[nodiscard]] bool Allocate(uint64_t          size,
+                                UploadAllocation& out,
+                                uint64_t          alignment = kConstantBufferAlignment);
+
+    // Close the current frame; its bytes are reclaimed once `fenceValue` completes.
+    void EndFrame(uint64_t fenceValue);
+
+    // Reclaim every closed frame whose fence value is <= completedFenceValue.
+    void Retire(uint64_t completedFenceValue);
+
+    // --- Statistics ---
+    [[nodiscard]] uint64_t Capacity()          const { return mCapacity; }
+    [[nodiscard]] uint64_t BytesInFlight()     const { return mHead - mTail; }    // open + unretired frames
+    [[nodiscard]] uint64_t FrameBytesUsed()    const { return mHead - mFrameStart; } // open frame, incl. padding
+    [[nodiscard]] uint64_t LastFrameBytes()    const { return mLastFrameBytes; }
+    [[nodiscard]] uint64_t PeakFrameBytes()    const { return mPeakFrameBytes; }
+    [[nodiscard]] uint64_t HighWaterMark()     const { return mHighWater; }       // peak BytesInFlight
+    [[nodiscard]] uint64_t FailedAllocations() const { return mFailedAllocations; }
+
+private:
+    struct FrameMarker {
+        uint64_t fenceValue;
+        uint64_t head; // absolute head position when the frame was closed
+    };
+
+    std::byte* mCpuBase  = nullptr;
+    uint64_t   mGpuBase  = 0;
+    uint64_t   mCapacity = 0;
+
+    // Absolute (monotonic) positions; the physical offset is pos % capacity.
+    uint64_t mHead       = 0;
+    uint64_t mTail       = 0;
+    uint64_t mFrameStart = 0;
+
+    std::deque<FrameMarker> mFrames; // closed, not yet retired, oldest first
+
+    uint64_t mLastFrameBytes    = 0;
+    uint64_t mPeakFrameBytes    = 0;
+    uint64_t mHighWater         = 0;
+    uint64_t mFailedAllocations = 0;
+};
@@ -0,0 +1,243 @@
+#include "UploadScheduler.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t kBufferAlignment = 4;
+
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Bytes a texture subresource takes in staging: every row but the last at
+// the pitch, the last one only its own bytes.
+uint64_t StagedTextureBytes(uint32_t rowBytes, uint32_t rowCount) {
+    const uint64_t pitch = AlignUp(rowBytes, UploadScheduler::kTextureRowAlignment);
+    return pitch * (rowCount - 1) + rowBytes;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// UploadScheduler
+// ---------------------------------------------------------------------------
+
+bool UploadScheduler::Init(ICopyQueue* queue, void* stagingCpu, uint64_t stagingBytes, uint64_t frameBudget) {
+    if (queue == nullptr || frameBudget == 0 || frameBudget > stagingBytes / 2) return false;
+    if (!mRing.Init(stagingCpu, 0, stagingBytes)) return false;
+
+    mQueue       = queue;
+    mFrameBudget = frameBudget;
+    mPending.clear();
+    mBatches.clear();
+    mNextTicket      = 1;
+    mStagedTicket    = 0;
+    mCompletedTicket = 0;
+    // Continue the queue's timeline: fence values must keep increasing.
+    mLastFence      = queue->CompletedValue();
+    mCompletedFence = mLastFence;
+    mPendingBytes   = 0;
+    mLastFrameBytes = 0;
+    mBatchCount = mCopyCount = mMergedCount = 0;
+    return true;
+}
+
+uint64_t UploadScheduler::UploadBuffer(uint64_t destination, uint64_t dstOffset, std::span<const std::byte> data) {
+    if (!mQueue || data.empty()) return 0;
+
+    Request r;
+    r.ticket      = mNextTicket++;
+    r.destination = destination;
+    r.dstOffset   = dstOffset;
+    r.data        = data;
+    mPending.push_back(r);
+    mPendingBytes += data.size();
+    return r.ticket;
+}
+
+uint64_t UploadScheduler::UploadTexture(uint64_t destination, uint32_t subresource, std::span<const std::byte> data,
+                                        uint32_t rowBytes, uint32_t rowCount) {
+    if (!mQueue || rowBytes == 0 || rowCount == 0 || subresource == UploadCopy::kBuffer) return 0;
+    if (data.size() / rowBytes < rowCount) return 0;
+    if (StagedTextureBytes(rowBytes, rowCount) + kTexturePlacementAlignment > mRing.Capacity() / 2) return 0;
+
+    Request r;
+    r.ticket      = mNextTicket++;
+    r.destination = destination;
+    r.subresource = subresource;
+    r.data        = data.first(size_t(rowBytes) * rowCount);
+    r.rowBytes    = rowBytes;
+    r.rowCount    = rowCount;
+    mPending.push_back(r);
+    mPendingBytes += r.data.size();
+    return r.ticket;
+}
+
+uint64_t UploadScheduler::FenceValue(uint64_t ticket) const {
+    if (ticket == 0 || ticket > mStagedTicket) return 0;
+    if (ticket <= mCompletedTicket) return mCompletedFence;
+    for (const Batch& b : mBatches)
+        if (b.lastTicket >= ticket) return b.fenceValue;
+    return 0; // unreachable: staged tickets are in a batch
+}
+
+void UploadScheduler::Retire() {
+    const uint64_t completed = mQueue->CompletedValue();
+    while (!mBatches.empty() && mBatches.front().fenceValue <= completed) {
+        mCompletedTicket = mBatches.front().lastTicket;
+        mCompletedFence  = mBatches.front().fenceValue;
+        mBatches.pop_front();
+    }
+    mRing.Retire(completed);
+}
+
+bool UploadScheduler::StageTexture(const Request& r, uint64_t& budget) {
+    // A subresource cannot be split, so one larger than the budget goes
+    // alone in an otherwise empty batch.
+    const uint64_t bytes = StagedTextureBytes(r.rowBytes, r.rowCount);
+    if (bytes > budget && budget < mFrameBudget) return false;
+
+    UploadAllocation alloc;
+    if (!mRing.Allocate(bytes, alloc, kTexturePlacementAlignment)) return false;
+
+    const uint32_t pitch = static_cast<uint32_t>(AlignUp(r.rowBytes, kTextureRowAlignment));
+    for (uint32_t row = 0; row < r.rowCount; ++row)
+        std::memcpy(static_cast<std::byte*>(alloc.cpu) + size_t(row) * pitch,
+                    r.data.data() + size_t(row) * r.rowBytes, r.rowBytes);
+
+    UploadCopy c;
+    c.destination   = r.destination;
+    c.subresource   = r.subresource;
+    c.stagingOffset = alloc.offset;
+    c.size          = bytes;
+    c.rowBytes      = r.rowBytes;
+    c.rowCount      = r.rowCount;
+    c.rowPitch      = pitch;
+    mCopies.push_back(c);
+
+    budget -= std::min(budget, bytes);
+    return true;
+}
+
+bool UploadScheduler::StageBufferChunk(Request& r, uint64_t& budget) {
+    const uint64_t bytes = std::min<uint64_t>(r.data.size() - r.staged, budget);
+    if (bytes == 0) return false;
+
+    UploadAllocation alloc;
+    if (!mRing.Allocate(bytes, alloc, kBufferAlignment)) return false;
+    std::memcpy(alloc.cpu, r.data.data() + r.staged, size_t(bytes));
+
+    // Coalesce with the previous copy when both sides continue it.
+    if (!mCopies.empty()) {
+        UploadCopy& last = mCopies.back();
+        if (last.subresource == UploadCopy::kBuffer && last.destination == r.destination &&
+            last.dstOffset + last.size == r.dstOffset + r.staged &&
+            last.stagingOffset + last.size == alloc.offset) {
+            last.size += bytes;
+            ++mMergedCount;
+            r.staged += bytes;
+            budget -= bytes;
+            return true;
+        }
+    }
+
+    UploadCopy c;
+    c.destination   = r.destination;
+    c.dstOffset     = r.dstOffset + r.staged;
+    c.stagingOffset = alloc.offset;
+    c.size          = bytes;
+    mCopies.push_back(c);
+
+    r.staged += bytes;
+    budget -= bytes;
+    return true;
+}
+
+bool UploadScheduler::Update() {
+    if (!mQueue) return true;
+    Retire();
+
+    mCopies.clear();
+    uint64_t budget = mFrameBudget;
+    while (!mPending.empty() && budget > 0) {
+        Request& r = mPending.front();
+        if (r.subresource != UploadCopy::kBuffer) {
+            if (!StageTexture(r, budget)) break;
+        } else {
+            if (!StageBufferChunk(r, budget)) break;
+            if (r.staged < r.data.size()) continue; // budget or ring ran out mid-request
+        }
+        mStagedTicket = r.ticket;
+        mPendingBytes -= r.data.size();
+        mPending.pop_front();
+    }
+
+    mLastFrameBytes = mFrameBudget - budget;
+    if (mCopies.empty()) return true;
+
+    // One list, one signal; the ring space is reclaimed by the same fence.
+    if (!mQueue->Execute(mCopies)) return false;
+    const uint64_t fence = mLastFence + 1;
+    if (!mQueue->Signal(fence)) return false;
+    mLastFence = fence;
+    mRing.EndFrame(fence);
+    mBatches.push_back({ fence, mStagedTicket });
+
+    ++mBatchCount;
+    mCopyCount += mCopies.size();
+    return true;
+}
+
+bool UploadScheduler::Finish() {
+    if (!mQueue) return true;
+    while (!mPending.empty() || !mBatches.empty()) {
+        if (!Update()) return false;
+        if (mLastFence > mQueue->CompletedValue()) mQueue->WaitForValue(mLastFence);
+        Retire();
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SimulatedCopyQueue
+// ---------------------------------------------------------------------------
+
+bool SimulatedCopyQueue::Execute(std::span<const UploadCopy> copies) {
+    for (const UploadCopy& c : copies) mPending.push_back({ 0, c });
+    ++mExecuteCount;
+    mCopyCount += copies.size();
+    return true;
+}
+
+bool SimulatedCopyQueue::Signal(uint64_t value) {
+    if (value <= mSignaled) return false; // fence values must increase
+    mSignaled = value;
+    for (auto it = mPending.rbegin(); it != mPending.rend() && it->fenceValue == 0; ++it) it->fenceValue = value;
+
+    if (mRetireLag != ~0ull && value > mRetireLag) {
+        CompleteUpTo(value - mRetireLag);
+    }
+    return true;
+}
+
+void SimulatedCopyQueue::WaitForValue(uint64_t value) { CompleteUpTo(value); }
+
+void SimulatedCopyQueue::CompleteUpTo(uint64_t value) {
+    // The GPU cannot finish work that has not been signalled yet.
+    mCompleted = std::max(mCompleted, std::min(value, mSignaled));
+
+    while (!mPending.empty() && mPending.front().fenceValue != 0 && mPending.front().fenceValue <= mCompleted) {
+        const UploadCopy& c   = mPending.front().copy;
+        std::byte*        dst = reinterpret_cast<std::byte*>(static_cast<uintptr_t>(c.destination));
+        if (c.subresource == UploadCopy::kBuffer) {
+            std::memcpy(dst + c.dstOffset, mStaging + c.stagingOffset, size_t(c.size));
+        } else {
+            for (uint32_t row = 0; row < c.rowCount; ++row)
+                std::memcpy(dst + size_t(row) * c.rowBytes, mStaging + c.stagingOffset + size_t(row) * c.rowPitch,
+                            c.rowBytes);
+        }
+        mPending.pop_front();
+    }
+}
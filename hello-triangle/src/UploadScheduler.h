@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+
+#include "FramePacer.h" // IFenceQueue
+#include "UploadRing.h"
+
+// One copy from the staging buffer into a destination resource.
+struct UploadCopy {
+    static constexpr uint32_t kBuffer = ~0u; // `subresource` of buffer copies
+
+    uint64_t destination   = 0; // opaque resource handle (ID3D12Resource*)
+    uint32_t subresource   = kBuffer;
+    uint64_t dstOffset     = 0; // buffers: byte offset in the destination
+    uint64_t stagingOffset = 0;
+    uint64_t size          = 0; // bytes read from staging
+    uint32_t rowBytes      = 0; // textures: bytes per row of blocks,
+    uint32_t rowCount      = 0; //           rows of blocks
+    uint32_t rowPitch      = 0; //           staging pitch (kTextureRowAlignment multiple)
+};
+
+// ---------------------------------------------------------------------------
+// ICopyQueue — a GPU copy engine as UploadScheduler sees it: a fence
+// timeline (IFenceQueue) plus submission of copy lists.
+//
+// D3D12CopyQueue implements it with a D3D12_COMMAND_LIST_TYPE_COPY queue;
+// SimulatedCopyQueue runs the copies on the CPU so scheduling can be
+// driven and checked without a device.
+// ---------------------------------------------------------------------------
+class ICopyQueue : public IFenceQueue {
+public:
+    // Record `copies` into one command list and submit it. The staging
+    // bytes they read stay untouched until the next Signal() completes.
+    [[nodiscard]] virtual bool Execute(std::span<const UploadCopy> copies) = 0;
+};
+
+// ---------------------------------------------------------------------------
+// UploadScheduler — batched uploads of static data (geometry, textures) into
+// default-heap resources over a copy queue.
+//
+// Upload*() only queues a request and returns its ticket. Update(), once per
+// frame, then
+//   - retires batches whose fence has completed (tickets become complete
+//     and their staging space is reclaimed)
+//   - copies pending requests, oldest first, into the staging ring until
+//     the per-frame budget is used; buffers larger than the budget are
+//     split across frames, a texture subresource goes whole
+//   - submits everything staged as one copy list and one fence signal, with
+//     contiguous copies into the same buffer merged into one command
+//
+// Requests complete in order, so a ticket is complete once the batch holding
+// its last byte is. Before the direct queue first reads a destination it
+// waits (GPU-side) for FenceValue(ticket) on the copy queue's fence; the CPU
+// never blocks, except in Finish().
+// ---------------------------------------------------------------------------
+class UploadScheduler {
+public:
+    // D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT / _PITCH_ALIGNMENT
+    static constexpr uint64_t kTexturePlacementAlignment = 512;
+    static constexpr uint32_t kTextureRowAlignment       = 256;
+
+    // `stagingCpu` is the mapped staging buffer the queue copies from.
+    // `frameBudget` is at most half the staging size, so any request that
+    // fits the budget fits the ring once older batches have retired.
+    [[nodiscard]] bool Init(ICopyQueue* queue, void* stagingCpu, uint64_t stagingBytes, uint64_t frameBudget);
+
+    // Queue `data` for buffer `destination` at `dstOffset`. `data` must stay
+    // valid until the ticket is complete. 0 for empty data.
+    [[nodiscard]] uint64_t UploadBuffer(uint64_t destination, uint64_t dstOffset, std::span<const std::byte> data);
+
+    // Queue one texture subresource: `rowCount` rows of `rowBytes`, tightly
+    // packed in `data`. 0 when the data is short or the staged copy (rows at
+    // kTextureRowAlignment pitch) could never fit the ring.
+    [[nodiscard]] uint64_t UploadTexture(uint64_t destination, uint32_t subresource,
+                                         std::span<const std::byte> data, uint32_t rowBytes, uint32_t rowCount);
+
+    // Once per frame. False when the queue rejects a submission.
+    [[nodiscard]] bool Update();
+
+    // Submit everything pending and block until the copy queue has finished
+    // it (load screens, shutdown).
+    [[nodiscard]] bool Finish();
+
+    [[nodiscard]] bool IsComplete(uint64_t ticket) const { return ticket <= mCompletedTicket; }
+
+    // Copy-queue fence value after which `ticket`'s data is in place; 0
+    // while it is still waiting to be staged.
+    [[nodiscard]] uint64_t FenceValue(uint64_t ticket) const;
+
+    // --- Statistics ---
+    [[nodiscard]] size_t   PendingCount()   const { return mPending.size(); }
+    [[nodiscard]] uint64_t PendingBytes()   const { return mPendingBytes; }
+    [[nodiscard]] uint64_t LastFrameBytes() const { return mLastFrameBytes; }
+    [[nodiscard]] uint64_t BatchCount()     const { return mBatchCount; }     // submissions
+    [[nodiscard]] uint64_t RequestCount()   const { return mNextTicket - 1; }
+    [[nodiscard]] uint64_t CopyCount()      const { return mCopyCount; }      // commands after merging
+    [[nodiscard]] uint64_t MergedCount()    const { return mMergedCount; }    // copies merged away
+
+private:
+    struct Request {
+        uint64_t                   ticket      = 0;
+        uint64_t                   destination = 0;
+        uint32_t                   subresource = UploadCopy::kBuffer;
+        uint64_t                   dstOffset   = 0;
+        std::span<const std::byte> data;
+        uint32_t                   rowBytes    = 0;
+        uint32_t                   rowCount    = 0;
+        uint64_t                   staged      = 0; // buffer bytes already submitted
+    };
+    struct Batch {
+        uint64_t fenceValue = 0;
+        uint64_t lastTicket = 0; // newest request fully staged in or before it
+    };
+
+    void Retire();
+    [[nodiscard]] bool StageTexture(const Request& r, uint64_t& budget);
+    [[nodiscard]] bool StageBufferChunk(Request& r, uint64_t& budget);
+
+    ICopyQueue*             mQueue       = nullptr;
+    UploadRing              mRing;
+    uint64_t                mFrameBudget = 0;
+    std::deque<Request>     mPending;
+    std::deque<Batch>       mBatches;     // submitted, not yet retired, oldest first
+    std::vector<UploadCopy> mCopies;      // this frame's list, capacity reused
+
+    uint64_t mNextTicket      = 1;
+    uint64_t mStagedTicket    = 0; // newest request fully staged
+    uint64_t mCompletedTicket = 0;
+    uint64_t mCompletedFence  = 0;
+    uint64_t mLastFence       = 0;
+
+    uint64_t mPendingBytes   = 0;
+    uint64_t mLastFrameBytes = 0;
+    uint64_t mBatchCount     = 0;
+    uint64_t mCopyCount      = 0;
+    uint64_t mMergedCount    = 0;
+};
+
+// ---------------------------------------------------------------------------
+// SimulatedCopyQueue — CPU stand-in for a copy queue.
+//
+// Destinations are host pointers: a buffer copy lands at destination +
+// dstOffset, a texture copy writes its rows tightly packed (rowBytes apart)
+// at destination, ignoring the subresource index. Copies run when their
+// fence completes, as on a GPU: explicitly through CompleteUpTo(), or once
+// `retireLag` newer signals are queued.
+// ---------------------------------------------------------------------------
+class SimulatedCopyQueue final : public ICopyQueue {
+public:
+    explicit SimulatedCopyQueue(const void* stagingBase, uint64_t retireLag = ~0ull)
+        : mStaging(static_cast<const std::byte*>(stagingBase)), mRetireLag(retireLag) {}
+
+    [[nodiscard]] bool     Execute(std::span<const UploadCopy> copies) override;
+    [[nodiscard]] bool     Signal(uint64_t value) override;
+    [[nodiscard]] uint64_t CompletedValue() const override { return mCompleted; }
+    void                   WaitForValue(uint64_t value) override;
+
+    // Run the copies of every signal <= value.
+    void CompleteUpTo(uint64_t value);
+
+    [[nodiscard]] uint64_t ExecuteCount() const { return mExecuteCount; }
+    [[nodiscard]] uint64_t CopyCount()    const { return mCopyCount; }
+
+private:
+    struct Pending {
+        uint64_t   fenceValue = 0; // 0 until signalled
+        UploadCopy copy;
+    };
+
+    const std::byte*    mStaging   = nullptr;
+    uint64_t            mRetireLag = ~0ull;
+    uint64_t            mSignaled  = 0;
+    uint64_t            mCompleted = 0;
+    std::deque<Pending> mPending;
+    uint64_t            mExecuteCount = 0;
+    uint64_t            mCopyCount    = 0;
+};
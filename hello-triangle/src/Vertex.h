@@ -0,0 +1,12 @@
+#pragma once
+
+// Per-vertex data layout (must match VSInput in vertex.hlsl; D3DApp checks it
+// against the shader's input signature).
+// Kept free of D3D headers so CPU-side code (software backend, mesh tools)
+// can share it.
+struct Vertex {
+    float pos[3]; // xyz  (NDC in Phase 1; world-space from Phase 1-4+)
+    float col[4]; // rgba
+    float uv[2];  // texture coordinates (u=left→right, v=top→bottom in D3D)
+};
+static_assert(sizeof(Vertex) == 36, "Vertex must stay tightly packed (stride 36)");
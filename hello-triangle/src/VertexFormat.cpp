@@ -0,0 +1,303 @@
+#include "VertexFormat.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#include "Simd.h"
+
+#if defined(__F16C__)
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr float kUnorm16Max = 65535.f;
+constexpr float kUnorm8Max  = 255.f;
+constexpr float kHalfUlp    = 1.f / 2048.f; // 2^-11: half rounding error relative to the value
+
+// ---------------------------------------------------------------------------
+// Half floats (round to nearest even; F. Giesen's float_to_half_fast3_rtne)
+// ---------------------------------------------------------------------------
+
+uint16_t FloatToHalf(float value) {
+    constexpr uint32_t kF32Infinity = 255u << 23;
+    constexpr uint32_t kF16Max      = (127u + 16u) << 23;
+    const float        denormMagic  = std::bit_cast<float>(((127u - 15u) + (23u - 10u) + 1u) << 23);
+
+    uint32_t       f    = std::bit_cast<uint32_t>(value);
+    const uint32_t sign = f & 0x80000000u;
+    f ^= sign;
+
+    uint32_t h;
+    if (f >= kF16Max) {
+        h = f > kF32Infinity ? 0x7E00 : 0x7C00; // NaN stays NaN, overflow -> inf
+    } else if (f < (113u << 23)) {
+        // Subnormal half: let the FPU round by adding a magic number.
+        h = std::bit_cast<uint32_t>(std::bit_cast<float>(f) + denormMagic) - std::bit_cast<uint32_t>(denormMagic);
+    } else {
+        const uint32_t mantissaOdd = (f >> 13) & 1;
+        f += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF;
+        f += mantissaOdd;
+        h = f >> 13;
+    }
+    return static_cast<uint16_t>(h | (sign >> 16));
+}
+
+float HalfToFloat(uint16_t h) {
+    constexpr uint32_t kShiftedExp = 0x7C00u << 13;
+    const float        magic       = std::bit_cast<float>(113u << 23);
+
+    uint32_t       o   = (h & 0x7FFFu) << 13;
+    const uint32_t exp = kShiftedExp & o;
+    o += (127u - 15u) << 23;
+    if (exp == kShiftedExp) {
+        o += (128u - 16u) << 23; // inf / NaN
+    } else if (exp == 0) {
+        o += 1u << 23; // zero / subnormal: renormalize
+        o = std::bit_cast<uint32_t>(std::bit_cast<float>(o) - magic);
+    }
+    return std::bit_cast<float>(o | ((h & 0x8000u) << 16));
+}
+
+// Eight floats to eight halves.
+void FloatToHalf8(const float* in, uint16_t* out) {
+#if defined(__F16C__) && HT_SIMD_AVX
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT));
+#else
+    for (int i = 0; i < kSimdWidth; ++i) out[i] = FloatToHalf(in[i]);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// One block of up to eight vertices in structure-of-arrays form
+// ---------------------------------------------------------------------------
+
+struct Block {
+    alignas(32) float pos[3][kSimdWidth];
+    alignas(32) float col[4][kSimdWidth];
+    alignas(32) float uv[2][kSimdWidth];
+};
+
+// Unused lanes repeat the last vertex so every lane holds a finite value.
+void GatherBlock(std::span<const Vertex> vertices, size_t first, Block& b) {
+    for (int lane = 0; lane < kSimdWidth; ++lane) {
+        const Vertex& v = vertices[std::min(first + lane, vertices.size() - 1)];
+        for (int c = 0; c < 3; ++c) b.pos[c][lane] = v.pos[c];
+        for (int c = 0; c < 4; ++c) b.col[c][lane] = v.col[c];
+        for (int c = 0; c < 2; ++c) b.uv[c][lane]  = v.uv[c];
+    }
+}
+
+// round(clamp(x, 0, 1) * maxValue) as integers.
+void QuantizeUnorm(const float* in, float maxValue, int32_t* out) {
+    StoreInt(Clamp(Float8::Load(in), Float8(0.f), Float8(1.f)) * Float8(maxValue), out);
+}
+
+template <class T>
+void Put(std::byte* dst, const T& value) { std::memcpy(dst, &value, sizeof(T)); }
+
+template <class T>
+T Get(const std::byte* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Dequantization
+// ---------------------------------------------------------------------------
+
+PositionDequant ComputePositionDequant(std::span<const Vertex> vertices, PositionEncoding encoding) {
+    PositionDequant d;
+    if (encoding == PositionEncoding::Float3 || vertices.empty()) return d;
+
+    for (int c = 0; c < 3; ++c) {
+        float lo = vertices[0].pos[c], hi = lo;
+        for (const Vertex& v : vertices) {
+            lo = std::min(lo, v.pos[c]);
+            hi = std::max(hi, v.pos[c]);
+        }
+        if (encoding == PositionEncoding::Half4) {
+            d.offset[c] = 0.5f * (lo + hi);
+            d.scale[c]  = 0.5f * (hi - lo);
+        } else {
+            d.offset[c] = lo;
+            d.scale[c]  = hi - lo;
+        }
+        if (!(d.scale[c] > 0.f)) d.scale[c] = 1.f; // flat axis: every vertex stores 0
+    }
+    return d;
+}
+
+Float4x4 DequantMatrix(const PositionDequant& d) {
+    Float4x4 m = MatrixIdentity();
+    for (int c = 0; c < 3; ++c) {
+        m.m[c][c] = d.scale[c];
+        m.m[3][c] = d.offset[c];
+    }
+    return m;
+}
+
+// ---------------------------------------------------------------------------
+// Encode / decode
+// ---------------------------------------------------------------------------
+
+bool EncodeVertices(std::span<const Vertex> vertices, const VertexFormat& format,
+                    const PositionDequant& dequant, std::span<std::byte> out) {
+    const VertexLayout layout = MakeVertexLayout(format);
+    if (out.size() < vertices.size() * layout.stride) return false;
+    if (format.position == PositionEncoding::Float3 && format.color == ColorEncoding::Float4 &&
+        format.texCoord == TexCoordEncoding::Float2) {
+        std::memcpy(out.data(), vertices.data(), vertices.size_bytes());
+        return true;
+    }
+
+    Float8 invScale[3], offset[3];
+    for (int c = 0; c < 3; ++c) {
+        invScale[c] = 1.f / dequant.scale[c];
+        offset[c]   = dequant.offset[c];
+    }
+
+    Block   b;
+    int32_t q[4][kSimdWidth];
+    uint16_t h[4][kSimdWidth];
+
+    for (size_t first = 0; first < vertices.size(); first += kSimdWidth) {
+        GatherBlock(vertices, first, b);
+        const size_t lanes = std::min<size_t>(kSimdWidth, vertices.size() - first);
+
+        // --- Quantize whole components at a time ---
+        if (format.position != PositionEncoding::Float3) {
+            for (int c = 0; c < 3; ++c) {
+                ((Float8::Load(b.pos[c]) - offset[c]) * invScale[c]).Store(b.pos[c]);
+                if (format.position == PositionEncoding::Unorm16x4) QuantizeUnorm(b.pos[c], kUnorm16Max, q[c]);
+                else                                                FloatToHalf8(b.pos[c], h[c]);
+            }
+        }
+        std::byte* dst = out.data() + first * layout.stride;
+        for (size_t lane = 0; lane < lanes; ++lane, dst += layout.stride) {
+            std::byte* p = dst + layout.positionOffset;
+            switch (format.position) {
+            case PositionEncoding::Float3:
+                for (int c = 0; c < 3; ++c) Put(p + 4 * c, vertices[first + lane].pos[c]);
+                break;
+            case PositionEncoding::Half4:
+                for (int c = 0; c < 3; ++c) Put(p + 2 * c, h[c][lane]);
+                Put(p + 6, uint16_t{ 0x3C00 }); // w = 1.0
+                break;
+            case PositionEncoding::Unorm16x4:
+                for (int c = 0; c < 3; ++c) Put(p + 2 * c, static_cast<uint16_t>(q[c][lane]));
+                Put(p + 6, uint16_t{ 0xFFFF }); // w = 1.0
+                break;
+            }
+        }
+
+        if (format.color == ColorEncoding::Unorm8x4) {
+            for (int c = 0; c < 4; ++c) QuantizeUnorm(b.col[c], kUnorm8Max, q[c]);
+        }
+        dst = out.data() + first * layout.stride;
+        for (size_t lane = 0; lane < lanes; ++lane, dst += layout.stride) {
+            std::byte* p = dst + layout.colorOffset;
+            if (format.color == ColorEncoding::Float4) {
+                std::memcpy(p, vertices[first + lane].col, sizeof(Vertex::col));
+            } else {
+                const uint32_t rgba = static_cast<uint32_t>(q[0][lane])       | (static_cast<uint32_t>(q[1][lane]) << 8)
+                                    | (static_cast<uint32_t>(q[2][lane]) << 16) | (static_cast<uint32_t>(q[3][lane]) << 24);
+                Put(p, rgba);
+            }
+        }
+
+        for (int c = 0; c < 2; ++c) {
+            if (format.texCoord == TexCoordEncoding::Unorm16x2) QuantizeUnorm(b.uv[c], kUnorm16Max, q[c]);
+            if (format.texCoord == TexCoordEncoding::Half2)     FloatToHalf8(b.uv[c], h[c]);
+        }
+        dst = out.data() + first * layout.stride;
+        for (size_t lane = 0; lane < lanes; ++lane, dst += layout.stride) {
+            std::byte* p = dst + layout.texCoordOffset;
+            switch (format.texCoord) {
+            case TexCoordEncoding::Float2:
+                std::memcpy(p, vertices[first + lane].uv, sizeof(Vertex::uv));
+                break;
+            case TexCoordEncoding::Half2:
+                Put(p, h[0][lane]);
+                Put(p + 2, h[1][lane]);
+                break;
+            case TexCoordEncoding::Unorm16x2:
+                Put(p, static_cast<uint16_t>(q[0][lane]));
+                Put(p + 2, static_cast<uint16_t>(q[1][lane]));
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool DecodeVertices(std::span<const std::byte> data, const VertexFormat& format,
+                    const PositionDequant& dequant, std::span<Vertex> out) {
+    const VertexLayout layout = MakeVertexLayout(format);
+    if (data.size() < out.size() * layout.stride) return false;
+
+    for (size_t i = 0; i < out.size(); ++i) {
+        const std::byte* src = data.data() + i * layout.stride;
+        Vertex&          v   = out[i];
+
+        const std::byte* p = src + layout.positionOffset;
+        for (int c = 0; c < 3; ++c) {
+            switch (format.position) {
+            case PositionEncoding::Float3:    v.pos[c] = Get<float>(p + 4 * c); break;
+            case PositionEncoding::Half4:     v.pos[c] = HalfToFloat(Get<uint16_t>(p + 2 * c)); break;
+            case PositionEncoding::Unorm16x4: v.pos[c] = Get<uint16_t>(p + 2 * c) / kUnorm16Max; break;
+            }
+            if (format.position != PositionEncoding::Float3) v.pos[c] = v.pos[c] * dequant.scale[c] + dequant.offset[c];
+        }
+
+        p = src + layout.colorOffset;
+        for (int c = 0; c < 4; ++c) {
+            v.col[c] = format.color == ColorEncoding::Float4 ? Get<float>(p + 4 * c)
+                                                             : std::to_integer<uint8_t>(p[c]) / kUnorm8Max;
+        }
+
+        p = src + layout.texCoordOffset;
+        for (int c = 0; c < 2; ++c) {
+            switch (format.texCoord) {
+            case TexCoordEncoding::Float2:    v.uv[c] = Get<float>(p + 4 * c); break;
+            case TexCoordEncoding::Half2:     v.uv[c] = HalfToFloat(Get<uint16_t>(p + 2 * c)); break;
+            case TexCoordEncoding::Unorm16x2: v.uv[c] = Get<uint16_t>(p + 2 * c) / kUnorm16Max; break;
+            }
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Error bounds
+// ---------------------------------------------------------------------------
+
+VertexErrorBounds VertexFormatErrorBounds(const VertexFormat& format, const PositionDequant& dequant,
+                                          float maxTexCoord) {
+    // Float32 arithmetic in the (de)quantization adds a few ulps of the
+    // decoded magnitude on top of the format's own rounding.
+    constexpr float kFloatSlack = 4.f / (1 << 23);
+
+    VertexErrorBounds e;
+    for (int c = 0; c < 3; ++c) {
+        const float magnitude = std::fabs(dequant.offset[c]) + std::fabs(dequant.scale[c]);
+        switch (format.position) {
+        case PositionEncoding::Float3:    e.position[c] = 0.f; break;
+        case PositionEncoding::Half4:     e.position[c] = dequant.scale[c] * kHalfUlp + magnitude * kFloatSlack; break;
+        case PositionEncoding::Unorm16x4: e.position[c] = dequant.scale[c] * 0.5f / kUnorm16Max + magnitude * kFloatSlack; break;
+        }
+    }
+    e.color = format.color == ColorEncoding::Unorm8x4 ? 0.5f / kUnorm8Max + kFloatSlack : 0.f;
+    switch (format.texCoord) {
+    case TexCoordEncoding::Float2:    e.texCoord = 0.f; break;
+    case TexCoordEncoding::Half2:     e.texCoord = maxTexCoord * kHalfUlp; break;
+    case TexCoordEncoding::Unorm16x2: e.texCoord = 0.5f / kUnorm16Max + kFloatSlack; break;
+    }
+    return e;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "CpuMath.h"
+#include "PipelineCache.h" // PipelineInputElement
+#include "Vertex.h"
+
+// ---------------------------------------------------------------------------
+// Packed vertex formats. A VertexFormat picks one encoding per attribute of
+// Vertex; MakeVertexLayout() turns it into the input layout, which is a
+// constexpr PipelineInputElement array that both backends convert to
+// D3D11_/D3D12_INPUT_ELEMENT_DESC. The shader side needs no change: every
+// format decodes to float in the input assembler (a 4-component position
+// format fills the unused w).
+//
+// Positions are quantized relative to the mesh's bounds, and a
+// PositionDequant (scale + offset) restores them. Fold DequantMatrix() into
+// the world matrix so the shader never sees it.
+// ---------------------------------------------------------------------------
+
+enum class PositionEncoding : uint8_t {
+    Float3,    // R32G32B32_FLOAT,    12 bytes, exact
+    Half4,     // R16G16B16A16_FLOAT,  8 bytes, centred on the bounds
+    Unorm16x4, // R16G16B16A16_UNORM,  8 bytes, bounds mapped to [0, 1]
+};
+
+enum class ColorEncoding : uint8_t {
+    Float4,   // R32G32B32A32_FLOAT, 16 bytes
+    Unorm8x4, // R8G8B8A8_UNORM,      4 bytes, clamped to [0, 1]
+};
+
+enum class TexCoordEncoding : uint8_t {
+    Float2,    // R32G32_FLOAT, 8 bytes
+    Half2,     // R16G16_FLOAT, 4 bytes, keeps tiling coordinates outside [0, 1]
+    Unorm16x2, // R16G16_UNORM, 4 bytes, clamped to [0, 1]
+};
+
+struct VertexFormat {
+    PositionEncoding position = PositionEncoding::Float3;
+    ColorEncoding    color    = ColorEncoding::Float4;
+    TexCoordEncoding texCoord = TexCoordEncoding::Float2;
+};
+
+// Byte-for-byte Vertex.
+constexpr VertexFormat kFullVertexFormat = {};
+// 16 bytes: UNORM16 positions, RGBA8 colours, half UVs.
+constexpr VertexFormat kCompactVertexFormat = { PositionEncoding::Unorm16x4, ColorEncoding::Unorm8x4,
+                                                TexCoordEncoding::Half2 };
+
+// ---------------------------------------------------------------------------
+// Layout
+// ---------------------------------------------------------------------------
+
+struct VertexLayout {
+    static constexpr uint32_t kElementCount = 3; // POSITION, COLOR, TEXCOORD
+
+    PipelineInputElement elements[kElementCount];
+    uint32_t             stride         = 0;
+    uint32_t             positionOffset = 0;
+    uint32_t             colorOffset    = 0;
+    uint32_t             texCoordOffset = 0;
+
+    [[nodiscard]] constexpr std::span<const PipelineInputElement> Elements() const { return elements; }
+};
+
+namespace vertex_format_detail {
+
+// DXGI_FORMAT values.
+constexpr uint32_t kR32G32B32A32Float = 2;
+constexpr uint32_t kR32G32B32Float    = 6;
+constexpr uint32_t kR16G16B16A16Float = 10;
+constexpr uint32_t kR16G16B16A16Unorm = 11;
+constexpr uint32_t kR32G32Float       = 16;
+constexpr uint32_t kR8G8B8A8Unorm     = 28;
+constexpr uint32_t kR16G16Float       = 34;
+constexpr uint32_t kR16G16Unorm       = 35;
+
+constexpr uint32_t PositionFormat(PositionEncoding e) {
+    return e == PositionEncoding::Float3 ? kR32G32B32Float
+         : e == PositionEncoding::Half4  ? kR16G16B16A16Float
+                                         : kR16G16B16A16Unorm;
+}
+constexpr uint32_t ColorFormat(ColorEncoding e) {
+    return e == ColorEncoding::Float4 ? kR32G32B32A32Float : kR8G8B8A8Unorm;
+}
+constexpr uint32_t TexCoordFormat(TexCoordEncoding e) {
+    return e == TexCoordEncoding::Float2 ? kR32G32Float
+         : e == TexCoordEncoding::Half2  ? kR16G16Float
+                                         : kR16G16Unorm;
+}
+constexpr uint32_t PositionBytes(PositionEncoding e) { return e == PositionEncoding::Float3 ? 12 : 8; }
+constexpr uint32_t ColorBytes(ColorEncoding e)       { return e == ColorEncoding::Float4 ? 16 : 4; }
+constexpr uint32_t TexCoordBytes(TexCoordEncoding e) { return e == TexCoordEncoding::Float2 ? 8 : 4; }
+
+} // namespace vertex_format_detail
+
+// Per-vertex stream in `inputSlot`, attributes in Vertex order, tightly
+// packed (every packed format is 4-byte aligned).
+constexpr VertexLayout MakeVertexLayout(const VertexFormat& f, uint32_t inputSlot = 0) {
+    using namespace vertex_format_detail;
+    VertexLayout l;
+    l.positionOffset = 0;
+    l.colorOffset    = PositionBytes(f.position);
+    l.texCoordOffset = l.colorOffset + ColorBytes(f.color);
+    l.stride         = l.texCoordOffset + TexCoordBytes(f.texCoord);
+    l.elements[0]    = { "POSITION", 0, PositionFormat(f.position), inputSlot, l.positionOffset, 0, 0 };
+    l.elements[1]    = { "COLOR",    0, ColorFormat(f.color),       inputSlot, l.colorOffset,    0, 0 };
+    l.elements[2]    = { "TEXCOORD", 0, TexCoordFormat(f.texCoord), inputSlot, l.texCoordOffset, 0, 0 };
+    return l;
+}
+
+static_assert(MakeVertexLayout(kFullVertexFormat).stride == sizeof(Vertex));
+static_assert(MakeVertexLayout(kCompactVertexFormat).stride == 16);
+
+// ---------------------------------------------------------------------------
+// Encoding
+// ---------------------------------------------------------------------------
+
+// decoded position = stored value * scale + offset, per axis.
+struct PositionDequant {
+    float scale[3]  = { 1.f, 1.f, 1.f };
+    float offset[3] = { 0.f, 0.f, 0.f };
+};
+
+// The dequantization for `vertices` under `encoding`: identity for Float3,
+// the bounds' centre and half-size for Half4, min and size for Unorm16x4.
+[[nodiscard]] PositionDequant ComputePositionDequant(std::span<const Vertex> vertices, PositionEncoding encoding);
+
+// Row-vector matrix applying `d`; put it in front of the world matrix.
+[[nodiscard]] Float4x4 DequantMatrix(const PositionDequant& d);
+
+// Writes vertices.size() * layout stride bytes. False when `out` is too
+// small. Eight vertices per iteration with Float8 (F16C for the half
+// formats when the build enables it).
+[[nodiscard]] bool EncodeVertices(std::span<const Vertex> vertices, const VertexFormat& format,
+                                  const PositionDequant& dequant, std::span<std::byte> out);
+
+// The inverse, back to float (dequantized positions); for verification.
+[[nodiscard]] bool DecodeVertices(std::span<const std::byte> data, const VertexFormat& format,
+                                  const PositionDequant& dequant, std::span<Vertex> out);
+
+// Largest absolute decode error per attribute that `format` guarantees for
+// the vertices ComputePositionDequant() was run on (UNORM attributes: for
+// values in [0, 1], i.e. after clamping); 0 for float encodings.
+// `maxTexCoord` is the largest |uv| component (half precision is relative).
+struct VertexErrorBounds {
+    float position[3] = {};
+    float color       = 0.f;
+    float texCoord    = 0.f;
+};
+[[nodiscard]] VertexErrorBounds VertexFormatErrorBounds(const VertexFormat& format, const PositionDequant& dequant,
+                                                        float maxTexCoord);
@@ -1,8 +1,13 @@
 #include <windows.h>
+#include <shellapi.h>
 
 #include <cstdint>
+#include <cwchar>
+#include <filesystem>
+#include <vector>
 
 #include "D3DApp.h"
+#include "Profiler.h"
 
 namespace {
 
@@ -34,6 +39,20 @@ struct Timer {
     LARGE_INTEGER mPrev = {};
 };
 
+// `--trace <file.json>`: profile the session and write a Chrome trace on
+// exit. Empty when absent.
+std::filesystem::path TracePath() {
+    int     argc = 0;
+    LPWSTR* argv = ::CommandLineToArgvW(::GetCommandLineW(), &argc);
+
+    std::filesystem::path path;
+    for (int i = 1; argv && i + 1 < argc; ++i) {
+        if (std::wcscmp(argv[i], L"--trace") == 0) path = argv[i + 1];
+    }
+    ::LocalFree(argv);
+    return path;
+}
+
 LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
     switch (msg) {
     case WM_SIZE:
@@ -97,11 +116,22 @@ int WINAPI wWinMain(
     );
     if (!hwnd) return -1;
 
+    // --- Profiling: on before Init() so the init steps are captured ---
+    const std::filesystem::path tracePath = TracePath();
+    std::vector<ProfileZone>    zones;
+    Profiler::SetThreadName("main");
+    Profiler::SetEnabled(!tracePath.empty());
+
     // --- Init D3D11 ---
     D3DApp app;
     gApp = &app;
 
-    if (!app.Init(hwnd, kInitWidth, kInitHeight)) {
+    bool initOk = false;
+    {
+        PROFILE_ZONE("Init");
+        initOk = app.Init(hwnd, kInitWidth, kInitHeight);
+    }
+    if (!initOk) {
         ::MessageBoxW(nullptr, L"Failed to initialize Direct3D 11.", kWindowTitle, MB_ICONERROR);
         return -1;
     }
@@ -121,9 +151,19 @@ int WINAPI wWinMain(
             const float dt = timer.Tick();
             app.Update(dt);
             app.Render();
+            if (Profiler::IsEnabled()) Profiler::Collect(zones); // drain every frame: rings are bounded
+            if (app.InitFailed()) {
+                ::MessageBoxW(hwnd, L"Failed to initialize Direct3D 11.", kWindowTitle, MB_ICONERROR);
+                break;
+            }
         }
     }
 
     gApp = nullptr;
-    return static_cast<int>(msg.wParam);
+
+    if (Profiler::IsEnabled()) {
+        Profiler::Collect(zones);
+        (void)Profiler::WriteChromeTrace(tracePath, zones);
+    }
+    return app.InitFailed() ? -1 : static_cast<int>(msg.wParam);
 }
@@ -0,0 +1,186 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "FrameStats.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "QuadGrid.h"
+#include "SoftwareRenderer.h"
+
+// ---------------------------------------------------------------------------
+// Headless driver for SoftwareRenderer: renders the Phase 1-6 scene on the
+// CPU with a fixed time step, prints per-frame timing and a framebuffer
+// checksum, and optionally writes the last frame as a PPM image and a
+// Chrome trace of every frame's profiler zones.
+//
+// Each frame also runs D3DApp's CPU scene work — QuadGrid culling and
+// batching at the same camera and angle — so the app frame, not only the
+// rasterizer, is measured. The grid is not drawn; the image and checksum
+// are SoftwareRenderer's alone.
+//
+// Doubles as the frame benchmark: no window, no wall-clock input, so two
+// runs (or two commits) render exactly the same frames. --warmup frames are
+// rendered first and not measured; --json then writes the p50/p95/p99/max of
+// every stage over the measured frames (Frame = QuadGrid + Update + Render
+// wall time, the rest from the profiler's zones).
+//
+//   hello-triangle-soft [--frames N] [--warmup N] [--width W] [--height H]
+//                       [--threads N] [--out frame.ppm] [--trace trace.json]
+//                       [--json stats.json]
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct Options {
+    int         frames  = 60;
+    int         warmup  = 0;
+    int         width   = 1280;
+    int         height  = 720;
+    int         threads = 0; // 0 = JobSystem default (hardware threads)
+    const char* out     = nullptr;
+    const char* trace   = nullptr;
+    const char* json    = nullptr;
+};
+
+// Fixed 60 Hz step so every run produces the same frames.
+constexpr float kDt = 1.f / 60.f;
+
+bool ParseOptions(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg   = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if      (std::strcmp(arg, "--frames")  == 0) opt.frames  = std::atoi(value);
+        else if (std::strcmp(arg, "--warmup")  == 0) opt.warmup  = std::atoi(value);
+        else if (std::strcmp(arg, "--width")   == 0) opt.width   = std::atoi(value);
+        else if (std::strcmp(arg, "--height")  == 0) opt.height  = std::atoi(value);
+        else if (std::strcmp(arg, "--threads") == 0) opt.threads = std::atoi(value);
+        else if (std::strcmp(arg, "--out")     == 0) opt.out     = value;
+        else if (std::strcmp(arg, "--trace")   == 0) opt.trace   = value;
+        else if (std::strcmp(arg, "--json")    == 0) opt.json    = value;
+        else return false;
+        ++i;
+    }
+    return opt.frames > 0 && opt.warmup >= 0 && opt.width > 0 && opt.height > 0 && opt.threads >= 0;
+}
+
+bool WriteJson(const char* path, const Options& opt, uint32_t threads, uint64_t checksum,
+               const std::vector<StageStats>& stages) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+
+    std::fprintf(file,
+        "{\n"
+        "  \"benchmark\": \"hello-triangle-soft\",\n"
+        "  \"width\": %d,\n"
+        "  \"height\": %d,\n"
+        "  \"threads\": %u,\n"
+        "  \"dt\": %.9g,\n"
+        "  \"warmupFrames\": %d,\n"
+        "  \"frames\": %d,\n"
+        "  \"checksum\": \"%016llx\",\n"
+        "  \"unit\": \"ms\",\n"
+        "  \"stages\": [\n",
+        opt.width, opt.height, threads, static_cast<double>(kDt), opt.warmup, opt.frames,
+        static_cast<unsigned long long>(checksum));
+    for (size_t i = 0; i < stages.size(); ++i) {
+        const StageStats& s = stages[i];
+        std::fprintf(file,
+            "    { \"name\": \"%s\", \"mean\": %.6f, \"p50\": %.6f, \"p95\": %.6f,"
+            " \"p99\": %.6f, \"max\": %.6f }%s\n",
+            s.name.c_str(), s.mean, s.p50, s.p95, s.p99, s.max, i + 1 < stages.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseOptions(argc, argv, opt)) {
+        std::fprintf(stderr,
+            "usage: hello-triangle-soft [--frames N] [--warmup N] [--width W] [--height H]"
+            " [--threads N] [--out frame.ppm] [--trace trace.json] [--json stats.json]\n");
+        return 2;
+    }
+
+    // Stage times come from the profiler's zones, so it records whenever
+    // they or a trace are asked for.
+    Profiler::SetThreadName("main");
+    Profiler::SetEnabled(opt.trace || opt.json);
+
+    JobSystem jobs;
+    const bool jobsOk = opt.threads > 0 ? jobs.Init(static_cast<uint32_t>(opt.threads - 1))
+                                        : jobs.Init();
+    if (!jobsOk) return 1;
+
+    SoftwareRenderer renderer;
+    if (!renderer.Init(opt.width, opt.height, &jobs)) {
+        std::fprintf(stderr, "Failed to initialize the software renderer.\n");
+        return 1;
+    }
+
+    QuadGrid grid;
+    grid.Init();
+    const Float4x4 viewProj = QuadGrid::ViewProjection(static_cast<float>(opt.width) /
+                                                       static_cast<float>(opt.height));
+    float angle = 0.f;
+
+    using Clock = std::chrono::steady_clock;
+    const auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    FrameStats               stats;
+    std::vector<ProfileZone> frameZones;
+    std::vector<ProfileZone> zones; // every frame's, for --trace
+    double                   totalMs = 0.0;
+    for (int frame = 0; frame < opt.warmup + opt.frames; ++frame) {
+        const auto start = Clock::now();
+        angle += kDt; // D3DApp::Update: 1 radian per second, wrapped
+        if (angle > kTwoPi) angle -= kTwoPi;
+        grid.Update(viewProj, angle);
+        renderer.Update(kDt);
+        renderer.Render();
+        const auto end = Clock::now();
+
+        // Between frames, off the timed section.
+        frameZones.clear();
+        if (Profiler::IsEnabled()) Profiler::Collect(frameZones);
+        if (opt.trace) zones.insert(zones.end(), frameZones.begin(), frameZones.end());
+
+        if (frame < opt.warmup) continue;
+        totalMs += ms(end - start);
+        stats.BeginFrame();
+        stats.Add("Frame", ms(end - start));
+        stats.AddZones(frameZones);
+    }
+    const std::vector<StageStats> stages = stats.Summarize();
+
+    std::printf("%dx%d, %d frames, %u threads, %zu/%u quads visible: %.3f ms/frame, checksum %016llx\n",
+                opt.width, opt.height, opt.frames, jobs.ThreadCount(),
+                grid.VisibleCount(), QuadGrid::kQuadCount, totalMs / opt.frames,
+                static_cast<unsigned long long>(renderer.Checksum()));
+    for (const StageStats& s : stages) {
+        std::printf("  %-14s p50 %8.3f  p95 %8.3f  p99 %8.3f  max %8.3f ms\n",
+                    s.name.c_str(), s.p50, s.p95, s.p99, s.max);
+    }
+
+    if (opt.out && !renderer.WritePpm(opt.out)) {
+        std::fprintf(stderr, "Failed to write %s\n", opt.out);
+        return 1;
+    }
+    if (opt.trace && !Profiler::WriteChromeTrace(opt.trace, zones)) {
+        std::fprintf(stderr, "Failed to write %s\n", opt.trace);
+        return 1;
+    }
+    if (opt.json && !WriteJson(opt.json, opt, jobs.ThreadCount(), renderer.Checksum(), stages)) {
+        std::fprintf(stderr, "Failed to write %s\n", opt.json);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
+#include "MeshPack.h"
+#include "MeshletBuilder.h"
+#include "ObjFile.h"
+
+// ---------------------------------------------------------------------------
+// Converter from OBJ to MeshPack. Each input becomes one mesh named after
+// its file (e.g. "crate.obj"): indexed and reordered with OptimizeMesh(),
+// split into meshlets, and its vertices encoded to the chosen format.
+//
+//   hello-triangle-meshpack [--compact] <out.mpk> <file.obj>...
+//   hello-triangle-meshpack --list <in.mpk>
+//
+// --compact stores kCompactVertexFormat (16 bytes) instead of full Vertex.
+// ---------------------------------------------------------------------------
+
+namespace {
+
+int Pack(const char* out, const VertexFormat& format, int count, char** inputs) {
+    MeshPackBuilder builder;
+    for (int i = 0; i < count; ++i) {
+        const std::filesystem::path path(inputs[i]);
+        MappedFile                  file;
+        std::vector<Vertex>         triangles;
+        if (!file.Open(path)) {
+            std::fprintf(stderr, "cannot read %s\n", inputs[i]);
+            return 1;
+        }
+        const std::span<const std::byte> bytes = file.Bytes();
+        if (!ParseObj({ reinterpret_cast<const char*>(bytes.data()), bytes.size() }, triangles)) {
+            std::fprintf(stderr, "%s is not a valid OBJ file\n", inputs[i]);
+            return 1;
+        }
+
+        std::vector<Vertex>   vertices;
+        std::vector<uint32_t> indices;
+        MeshletMesh           meshlets;
+        OptimizeMesh(triangles, vertices, indices);
+        BuildMeshlets(vertices, indices, meshlets);
+
+        const std::string name = path.filename().string();
+        if (!builder.Add(name, vertices, indices, format, &meshlets)) {
+            std::fprintf(stderr, "cannot add %s (duplicate name?)\n", name.c_str());
+            return 1;
+        }
+    }
+    if (!builder.Write(out)) {
+        std::fprintf(stderr, "cannot write %s\n", out);
+        return 1;
+    }
+    return 0;
+}
+
+int List(const char* path) {
+    MeshPack pack;
+    if (!pack.Open(path)) {
+        std::fprintf(stderr, "%s is not a valid mesh pack\n", path);
+        return 1;
+    }
+    std::printf("%10s %10s %8s %7s  name\n", "vertices", "triangles", "meshlets", "stride");
+    for (uint32_t i = 0; i < pack.MeshCount(); ++i) {
+        const MeshPackMesh& m = pack.Mesh(i);
+        std::printf("%10u %10zu %8zu %7u  %.*s\n", m.vertexCount, m.indices.size() / 3, m.meshlets.size(), m.stride,
+                    static_cast<int>(m.name.size()), m.name.data());
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--list") == 0) return List(argv[2]);
+    if (argc >= 3 && std::strcmp(argv[1], "--compact") == 0)
+        return Pack(argv[2], kCompactVertexFormat, argc - 3, argv + 3);
+    if (argc >= 2 && argv[1][0] != '-') return Pack(argv[1], kFullVertexFormat, argc - 2, argv + 2);
+
+    std::fprintf(stderr,
+        "usage: hello-triangle-meshpack [--compact] <out.mpk> <file.obj>...\n"
+        "       hello-triangle-meshpack --list <in.mpk>\n");
+    return 2;
+}
@@ -0,0 +1,106 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "MappedFile.h"
+#include "ShaderArchive.h"
+#include "ShaderReflection.h"
+
+// ---------------------------------------------------------------------------
+// Archive tool for ShaderArchive files. The build packs each app's compiled
+// shaders with it; entries are named after the input file (e.g. "vertex.cso").
+//
+//   hello-triangle-shaderpack <out.shar> <file>...   pack files
+//   hello-triangle-shaderpack --list <in.shar>       print the index
+//   hello-triangle-shaderpack --reflect <file.cso>   print signatures and cbuffers
+// ---------------------------------------------------------------------------
+
+namespace {
+
+int Pack(const char* out, int count, char** inputs) {
+    ShaderArchiveBuilder builder;
+    for (int i = 0; i < count; ++i) {
+        const std::filesystem::path path(inputs[i]);
+        MappedFile                  file;
+        if (!file.Open(path)) {
+            std::fprintf(stderr, "cannot read %s\n", inputs[i]);
+            return 1;
+        }
+        const std::string name = path.filename().string();
+        if (!builder.Add(name, file.Bytes())) {
+            std::fprintf(stderr, "duplicate entry name %s\n", name.c_str());
+            return 1;
+        }
+    }
+    if (!builder.Write(out)) {
+        std::fprintf(stderr, "cannot write %s\n", out);
+        return 1;
+    }
+    return 0;
+}
+
+int List(const char* path) {
+    ShaderArchive archive;
+    if (!archive.Open(path)) {
+        std::fprintf(stderr, "%s is not a valid shader archive\n", path);
+        return 1;
+    }
+    for (uint32_t i = 0; i < archive.EntryCount(); ++i) {
+        const std::string_view name = archive.Name(i);
+        std::printf("%10zu  %.*s\n", archive.Data(i).size(),
+                    static_cast<int>(name.size()), name.data());
+    }
+    return 0;
+}
+
+void PrintSignature(const char* title, std::span<const SignatureElement> elements) {
+    std::printf("%s\n", title);
+    for (const SignatureElement& e : elements) {
+        std::printf("  v%-2u %-16.*s %u  mask %x  type %u  sv %u\n", e.reg,
+                    static_cast<int>(e.semanticName.size()), e.semanticName.data(), e.semanticIndex,
+                    e.mask, static_cast<unsigned>(e.componentType), e.systemValue);
+    }
+}
+
+int Reflect(const char* path) {
+    MappedFile       file;
+    ShaderReflection reflection;
+    if (!file.Open(path) || !reflection.Parse(file.Bytes())) {
+        std::fprintf(stderr, "%s is not a valid DXBC container\n", path);
+        return 1;
+    }
+
+    std::printf("stage %u, shader model %u.%u\n", static_cast<unsigned>(reflection.Stage()),
+                reflection.ShaderModelMajor(), reflection.ShaderModelMinor());
+    PrintSignature("inputs", reflection.Inputs());
+    PrintSignature("outputs", reflection.Outputs());
+
+    for (const ShaderConstantBuffer& cb : reflection.ConstantBuffers()) {
+        std::printf("cbuffer %.*s : b%u  %u bytes, %u live\n",
+                    static_cast<int>(cb.name.size()), cb.name.data(), cb.bindPoint, cb.size, cb.LiveBytes());
+        for (const ShaderVariable& v : cb.variables) {
+            std::printf("  %4u %4u  %.*s%s\n", v.offset, v.size,
+                        static_cast<int>(v.name.size()), v.name.data(), v.used ? "" : "  (unused)");
+        }
+    }
+    for (const ShaderResourceBinding& r : reflection.Resources()) {
+        std::printf("binding %.*s  type %u  slot %u x%u  space %u\n",
+                    static_cast<int>(r.name.size()), r.name.data(), r.type, r.bindPoint, r.bindCount, r.space);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--list") == 0)    return List(argv[2]);
+    if (argc == 3 && std::strcmp(argv[1], "--reflect") == 0) return Reflect(argv[2]);
+    if (argc >= 2 && argv[1][0] != '-') return Pack(argv[1], argc - 2, argv + 2);
+
+    std::fprintf(stderr,
+        "usage: hello-triangle-shaderpack <out.shar> <file>...\n"
+        "       hello-triangle-shaderpack --list <in.shar>\n"
+        "       hello-triangle-shaderpack --reflect <file.cso>\n");
+    return 2;
+}
@@ -0,0 +1,135 @@
+#include "Test.h"
+
+#include "BlockCompressor.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kSize = 128;
+
+// Gradients, a ripple, hard-edged tiles and mild noise, with an alpha
+// channel that has both ramps and cut-outs — the BlockCompressBench image,
+// smaller, with a fixed LCG for the noise so every standard library sees
+// the same bytes.
+std::vector<std::byte> MakeImage(uint32_t width, uint32_t height) {
+    uint32_t               state = 9;
+    std::vector<std::byte> image(size_t(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const bool tile  = ((x / 11) + (y / 13)) % 5 == 0;
+            const int  px[4] = {
+                tile ? 230 : int(x * 255 / width),
+                tile ? 40 : int(y * 255 / height),
+                int(128 + 90 * std::sin(x * 0.2) * std::cos(y * 0.12)),
+                ((x / 16) + (y / 16)) % 3 == 0 ? 0 : int(255 - (x + y) * 255 / (width + height)),
+            };
+            for (int c = 0; c < 4; ++c) {
+                state       = state * 1664525u + 1013904223u;
+                const int v = c < 3 ? px[c] + int(state >> 29) - 3 : px[c];
+                image[(size_t(y) * width + x) * 4 + c] = static_cast<std::byte>(std::clamp(v, 0, 255));
+            }
+        }
+    }
+    return image;
+}
+
+double Psnr(const std::vector<std::byte>& a, const std::vector<std::byte>& b, int channels) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (int c = 0; c < channels; ++c) {
+            const double d = std::to_integer<int>(a[i + c]) - std::to_integer<int>(b[i + c]);
+            sum += d * d;
+        }
+    }
+    const double mse = sum / (double(a.size() / 4) * channels);
+    return mse == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+struct Case {
+    BcFormat  format;
+    BcQuality quality;
+    double    minRgb; // dB
+    double    minRgba;
+};
+
+// A little below what the encoder reaches today: a regression in endpoint
+// selection, refinement or index search costs more than that.
+constexpr Case kCases[] = {
+    { BcFormat::Bc1, BcQuality::Fast, 35.0, 0.0 },  { BcFormat::Bc1, BcQuality::Quality, 35.5, 0.0 },
+    { BcFormat::Bc3, BcQuality::Fast, 35.0, 36.5 }, { BcFormat::Bc3, BcQuality::Quality, 35.5, 37.0 },
+    { BcFormat::Bc7, BcQuality::Fast, 37.0, 38.5 }, { BcFormat::Bc7, BcQuality::Quality, 37.5, 38.5 },
+};
+
+bool RoundTrip(const std::vector<std::byte>& image, uint32_t width, uint32_t height, BcFormat format,
+               BcQuality quality, std::vector<std::byte>& decoded, JobSystem* jobs = nullptr) {
+    std::vector<std::byte> blocks(BcImageBytes(format, width, height));
+    decoded.assign(image.size(), std::byte{ 0 });
+    return CompressImage(image, width, height, format, quality, blocks, jobs) &&
+           DecompressImage(blocks, width, height, format, decoded);
+}
+
+} // namespace
+
+void RunBlockCompressorTests(TestRunner& runner) {
+    runner.Run("block_compressor/psnr_floor", [&] {
+        const std::vector<std::byte> image = MakeImage(kSize, kSize);
+        std::vector<std::byte>       decoded;
+        double                       fast[3] = {};
+        for (const Case& c : kCases) {
+            if (!CHECK(RoundTrip(image, kSize, kSize, c.format, c.quality, decoded))) continue;
+            const double rgb = Psnr(image, decoded, 3), rgba = Psnr(image, decoded, 4);
+            CHECK(rgb >= c.minRgb);
+            if (c.format != BcFormat::Bc1) CHECK(rgba >= c.minRgba);
+
+            // Quality keeps the best candidate, Fast's among them.
+            const int f = int(c.format);
+            if (c.quality == BcQuality::Fast) fast[f] = rgb;
+            else CHECK(rgb >= fast[f]);
+        }
+    });
+
+    runner.Run("block_compressor/threads_and_edge_blocks", [&] {
+        // Row blocks split over jobs encode exactly as on one thread.
+        const std::vector<std::byte> image = MakeImage(kSize, kSize);
+        JobSystem                    jobs;
+        if (!CHECK(jobs.Init(3))) return;
+        for (const Case& c : kCases) {
+            std::vector<std::byte> single(BcImageBytes(c.format, kSize, kSize)), threaded(single.size());
+            CHECK(CompressImage(image, kSize, kSize, c.format, c.quality, single));
+            CHECK(CompressImage(image, kSize, kSize, c.format, c.quality, threaded, &jobs));
+            CHECK(single == threaded);
+        }
+
+        // Crops to sizes that are not multiples of 4 (edge blocks repeat the
+        // last row / column) keep about the same quality.
+        for (const auto& [width, height] : { std::pair{ 13u, 7u }, std::pair{ 1u, 1u }, std::pair{ 66u, 3u } }) {
+            std::vector<std::byte> odd(size_t(width) * height * 4);
+            for (uint32_t y = 0; y < height; ++y)
+                std::copy_n(image.begin() + ptrdiff_t(y) * kSize * 4, width * 4, odd.begin() + ptrdiff_t(y) * width * 4);
+            std::vector<std::byte>       decoded;
+            for (const Case& c : kCases) {
+                if (!CHECK(RoundTrip(odd, width, height, c.format, c.quality, decoded))) continue;
+                CHECK(Psnr(odd, decoded, 3) >= c.minRgb - 2.0);
+            }
+        }
+
+        // BC1 decodes opaque; short buffers are rejected.
+        std::vector<std::byte> decoded;
+        CHECK(RoundTrip(image, kSize, kSize, BcFormat::Bc1, BcQuality::Fast, decoded));
+        CHECK(std::all_of(decoded.begin(), decoded.end(), [i = size_t{ 0 }](std::byte b) mutable {
+            return i++ % 4 != 3 || b == std::byte{ 255 };
+        }));
+        std::vector<std::byte> blocks(BcImageBytes(BcFormat::Bc7, kSize, kSize) - 1);
+        CHECK(!CompressImage(image, kSize, kSize, BcFormat::Bc7, BcQuality::Fast, blocks));
+        CHECK(!CompressImage(std::span(image).first(image.size() - 1), kSize, kSize, BcFormat::Bc1, BcQuality::Fast,
+                             decoded));
+        CHECK(!DecompressImage(blocks, kSize, kSize, BcFormat::Bc7, decoded));
+        CHECK(BcImageBytes(BcFormat::Bc1, 5, 5) == 4 * 8 && BcImageBytes(BcFormat::Bc7, 4, 4) == 16);
+    });
+}
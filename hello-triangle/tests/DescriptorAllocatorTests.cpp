@@ -0,0 +1,95 @@
+#include "Test.h"
+
+#include "DescriptorAllocator.h"
+
+#include <vector>
+
+void RunDescriptorAllocatorTests(TestRunner& runner) {
+    runner.Run("descriptor_allocator/free_list_reuse", [&] {
+        DescriptorFreeList list;
+        if (!CHECK(list.Init(100, 4))) return;
+
+        // Lowest index first, then kInvalid once full.
+        for (uint32_t i = 0; i < 4; ++i) CHECK(list.Allocate() == 100 + i);
+        CHECK(list.Allocate() == DescriptorFreeList::kInvalid);
+        CHECK(list.LiveCount() == 4);
+
+        // LIFO: the slot freed last comes back first.
+        list.Free(101);
+        list.Free(103);
+        CHECK(list.LiveCount() == 2);
+        CHECK(list.Allocate() == 103 && list.Allocate() == 101);
+        CHECK(list.Allocate() == DescriptorFreeList::kInvalid);
+
+        // Double, foreign and out-of-range frees change nothing.
+        list.Free(102);
+        list.Free(102);
+        list.Free(99);
+        list.Free(104);
+        list.Free(DescriptorFreeList::kInvalid);
+        CHECK(list.LiveCount() == 3);
+        CHECK(list.Allocate() == 102 && list.Allocate() == DescriptorFreeList::kInvalid);
+
+        CHECK(!list.Init(0, 0));
+        CHECK(!list.Init(DescriptorFreeList::kInvalid - 1, 2));
+    });
+
+    runner.Run("descriptor_allocator/persistent_and_transient_regions", [&] {
+        DescriptorAllocator heap;
+        if (!CHECK(heap.Init(8, 32))) return;
+        CHECK(heap.Capacity() == 40);
+
+        // Persistent slots come from [0, 8), transient runs from [8, 40).
+        std::vector<uint32_t> persistent;
+        for (uint32_t i = 0; i < 8; ++i) persistent.push_back(heap.AllocatePersistent());
+        CHECK(persistent.front() == 0 && persistent.back() == 7);
+        CHECK(heap.AllocatePersistent() == DescriptorAllocator::kInvalid);
+        heap.FreePersistent(persistent[3]);
+        CHECK(heap.PersistentLiveCount() == 7 && heap.AllocatePersistent() == persistent[3]);
+
+        uint32_t first = 0;
+        CHECK(heap.AllocateTransient(5, first) && first == 8);
+        CHECK(heap.AllocateTransient(1, first) && first == 13);
+        CHECK(heap.TransientInFlight() == 6);
+
+        CHECK(!heap.AllocateTransient(0, first) && !heap.AllocateTransient(33, first));
+        CHECK(heap.FailedAllocations() == 0); // bad arguments are not "heap full"
+        CHECK(!heap.Init(8, 0) && !heap.Init(0, 32));
+    });
+
+    runner.Run("descriptor_allocator/transient_recycled_by_fence", [&] {
+        DescriptorAllocator heap;
+        if (!CHECK(heap.Init(1, 32))) return;
+
+        // Three frames of 10 slots in flight: only 2 left.
+        uint32_t first = 0;
+        for (uint64_t fence = 1; fence <= 3; ++fence) {
+            CHECK(heap.AllocateTransient(10, first) && first == 1 + (fence - 1) * 10);
+            heap.EndFrame(fence);
+        }
+        CHECK(!heap.AllocateTransient(3, first));
+        CHECK(heap.FailedAllocations() == 1 && heap.TransientInFlight() == 30);
+
+        // Retiring frame 1 frees its 10 slots, but a run never wraps: 3 slots
+        // skip the 2 at the end and start over at the region's first slot.
+        heap.Retire(0);
+        CHECK(heap.TransientInFlight() == 30);
+        heap.Retire(1);
+        CHECK(heap.TransientInFlight() == 20);
+        CHECK(heap.AllocateTransient(3, first) && first == 1);
+        CHECK(heap.TransientInFlight() == 20 + 2 + 3);
+
+        // Frame 2, not yet retired, starts at slot 11: 7 more fit, 8 do not.
+        CHECK(!heap.AllocateTransient(8, first));
+        CHECK(heap.AllocateTransient(7, first) && first == 4);
+        heap.EndFrame(4);
+        CHECK(heap.TransientHighWater() == 32 && heap.TransientInFlight() == 32);
+
+        // Several frames at once; the open frame is never reclaimed.
+        heap.Retire(4);
+        CHECK(heap.TransientInFlight() == 0);
+        CHECK(heap.AllocateTransient(22, first) && first == 11);
+        heap.Retire(~0ull);
+        CHECK(heap.TransientInFlight() == 22 && heap.FailedAllocations() == 2);
+    });
+}
@@ -0,0 +1,116 @@
+#include "Test.h"
+
+#include "FramePacer.h"
+
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kFrames = 64;
+
+// Runs `frames` frames round-robin over the pacer's slots, as D3D12App
+// does with its swap-chain index.
+void RunFrames(FramePacer& pacer, uint32_t frames, uint32_t firstFrame = 0) {
+    for (uint32_t f = firstFrame; f < firstFrame + frames; ++f) {
+        pacer.BeginFrame(f % pacer.SlotCount());
+        CHECK(pacer.EndFrame());
+    }
+}
+
+} // namespace
+
+void RunFramePacerTests(TestRunner& runner) {
+    runner.Run("frame_pacer/no_wait_until_slot_reused", [&] {
+        for (uint32_t slots : { 2u, 3u }) {
+            // A GPU that never finishes on its own: the first pass over the
+            // slots is free, then every slot waits for its previous frame.
+            SimulatedFenceQueue queue;
+            FramePacer          pacer;
+            if (!CHECK(pacer.Init(&queue, slots))) continue;
+            RunFrames(pacer, slots);
+            CHECK(pacer.StallCount() == 0 && queue.WaitCount() == 0);
+            CHECK(pacer.CompletedValue() == 0);
+
+            pacer.BeginFrame(0);
+            CHECK(pacer.StallCount() == 1);
+            CHECK(pacer.CompletedValue() == pacer.SlotFenceValue(0)); // waited for exactly that frame
+            CHECK(pacer.CompletedValue() < pacer.LastSignaledValue());
+        }
+    });
+
+    runner.Run("frame_pacer/stall_when_gpu_lags_frame_count", [&] {
+        for (uint32_t slots : { 2u, 3u }) {
+            for (uint64_t lag = 0; lag <= slots + 1; ++lag) {
+                SimulatedFenceQueue queue(lag);
+                FramePacer          pacer;
+                if (!CHECK(pacer.Init(&queue, slots))) continue;
+                RunFrames(pacer, kFrames);
+
+                // A GPU fewer than `slots` frames behind never blocks the CPU;
+                // from `slots` frames on, every reused slot does.
+                const uint64_t expected = lag < slots ? 0 : kFrames - slots;
+                CHECK(pacer.StallCount() == expected);
+                CHECK(queue.WaitCount() == expected);
+                CHECK(pacer.FrameCount() == kFrames);
+            }
+        }
+    });
+
+    runner.Run("frame_pacer/wait_idle_drains_every_slot", [&] {
+        SimulatedFenceQueue queue;
+        FramePacer          pacer;
+        if (!CHECK(pacer.Init(&queue, 3))) return;
+        RunFrames(pacer, 5);
+
+        pacer.WaitIdle();
+        CHECK(pacer.CompletedValue() == pacer.LastSignaledValue());
+        for (uint32_t s = 0; s < pacer.SlotCount(); ++s) CHECK(pacer.SlotFenceValue(s) <= pacer.CompletedValue());
+
+        // Nothing in flight: the next pass over the slots is free again.
+        const uint64_t stalls = pacer.StallCount();
+        RunFrames(pacer, 3, 5);
+        CHECK(pacer.StallCount() == stalls);
+
+        // Idle twice in a row still signals (and completes) a fresh value.
+        pacer.WaitIdle();
+        const uint64_t idle = pacer.LastSignaledValue();
+        pacer.WaitIdle();
+        CHECK(pacer.LastSignaledValue() == idle + 1 && pacer.CompletedValue() == idle + 1);
+    });
+
+    runner.Run("frame_pacer/fence_values_increase_per_slot", [&] {
+        SimulatedFenceQueue queue(1);
+        FramePacer          pacer;
+        if (!CHECK(pacer.Init(&queue, 3))) return;
+
+        std::vector<uint64_t> previous(pacer.SlotCount(), 0);
+        uint64_t              last = 0;
+        for (uint32_t f = 0; f < kFrames; ++f) {
+            const uint32_t slot = f % pacer.SlotCount();
+            pacer.BeginFrame(slot);
+            if (f % 7 == 6) pacer.WaitIdle(); // resize in the middle of a frame
+            CHECK(pacer.EndFrame());
+
+            CHECK(pacer.SlotFenceValue(slot) > previous[slot]);
+            CHECK(pacer.SlotFenceValue(slot) == pacer.LastSignaledValue());
+            CHECK(pacer.LastSignaledValue() > last);
+            previous[slot] = pacer.SlotFenceValue(slot);
+            last           = pacer.LastSignaledValue();
+        }
+        CHECK(queue.SignaledValue() == pacer.LastSignaledValue());
+    });
+
+    runner.Run("frame_pacer/init_rejects_bad_arguments", [&] {
+        SimulatedFenceQueue queue;
+        FramePacer          pacer;
+        CHECK(!pacer.Init(nullptr, 2));
+        CHECK(!pacer.Init(&queue, 0));
+        CHECK(!pacer.EndFrame());
+
+        // Starts after whatever the queue already completed.
+        CHECK(queue.Signal(5));
+        queue.CompleteUpTo(5);
+        if (!CHECK(pacer.Init(&queue, 2))) return;
+        CHECK(pacer.EndFrame() && pacer.LastSignaledValue() == 6);
+    });
+}
@@ -0,0 +1,144 @@
+#include "Test.h"
+
+#include "JobSystem.h"
+
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Worker counts every case runs with: none (all jobs on the waiting
+// thread), one, and more workers than this machine may have cores.
+constexpr uint32_t kWorkerCounts[] = { 0, 1, 4 };
+
+} // namespace
+
+void RunJobSystemTests(TestRunner& runner) {
+    runner.Run("job_system/nested_parallel_for", [&] {
+        constexpr uint64_t kOuter = 48, kInner = 1000;
+        // sum over i < kOuter, j < kInner of (i * kInner + j) = n(n-1)/2, n = kOuter * kInner
+        constexpr uint64_t kN        = kOuter * kInner;
+        constexpr uint64_t kExpected = kN * (kN - 1) / 2;
+
+        for (uint32_t workers : kWorkerCounts) {
+            JobSystem jobs;
+            if (!CHECK(jobs.Init(workers))) continue;
+
+            std::atomic<uint64_t> sum{ 0 }, chunks{ 0 };
+            jobs.ParallelFor(kOuter, 3, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    jobs.ParallelFor(kInner, 37, [&, i](uint32_t b, uint32_t e) {
+                        uint64_t local = 0;
+                        for (uint32_t j = b; j < e; ++j) local += uint64_t{ i } * kInner + j;
+                        sum.fetch_add(local, std::memory_order_relaxed);
+                        chunks.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            });
+            CHECK(sum.load() == kExpected);
+            CHECK(chunks.load() == kOuter * ((kInner + 36) / 37));
+
+            // Edge cases: nothing to do, and a grain of 0 treated as 1.
+            uint32_t calls = 0;
+            jobs.ParallelFor(0, 8, [&](uint32_t, uint32_t) { ++calls; });
+            CHECK(calls == 0);
+            std::atomic<uint32_t> items{ 0 };
+            jobs.ParallelFor(5, 0, [&](uint32_t b, uint32_t e) { items.fetch_add(e - b); });
+            CHECK(items.load() == 5);
+        }
+    });
+
+    runner.Run("job_system/counter_from_many_producers", [&] {
+        constexpr uint32_t kProducers = 8, kJobsEach = 2000;
+
+        for (uint32_t workers : kWorkerCounts) {
+            JobSystem jobs;
+            if (!CHECK(jobs.Init(workers))) continue;
+
+            // Producers are jobs themselves: each fans out kJobsEach more
+            // onto one shared counter, from whatever thread it runs on.
+            std::atomic<uint64_t> hits{ 0 };
+            JobCounter            counter;
+            for (uint32_t p = 0; p < kProducers; ++p) {
+                jobs.Run([&] {
+                    for (uint32_t k = 0; k < kJobsEach; ++k) {
+                        jobs.Run([&] { hits.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                    }
+                }, &counter);
+            }
+            jobs.Wait(counter);
+            CHECK(counter.IsDone() && counter.Pending() == 0);
+            CHECK(hits.load() == uint64_t{ kProducers } * kJobsEach);
+
+            // The counter is reusable once drained.
+            for (uint32_t k = 0; k < 100; ++k) jobs.Run([&] { hits.fetch_add(1); }, &counter);
+            jobs.Wait(counter);
+            CHECK(hits.load() == uint64_t{ kProducers } * kJobsEach + 100);
+        }
+    });
+
+    runner.Run("job_system/wait_from_external_threads", [&] {
+        constexpr uint32_t kThreads = 4, kJobsEach = 500;
+
+        for (uint32_t workers : kWorkerCounts) {
+            JobSystem jobs;
+            if (!CHECK(jobs.Init(workers))) continue;
+
+            // Plain std::threads (not workers) submit and wait concurrently;
+            // they share deque 0 and help run each other's jobs.
+            std::atomic<uint64_t> hits{ 0 };
+            std::atomic<uint32_t> badIndex{ 0 }, finished{ 0 };
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < kThreads; ++t) {
+                threads.emplace_back([&] {
+                    if (jobs.ThreadIndex() != 0) badIndex.fetch_add(1);
+                    JobCounter counter;
+                    for (uint32_t k = 0; k < kJobsEach; ++k) {
+                        jobs.Run([&] { hits.fetch_add(1, std::memory_order_relaxed); }, &counter);
+                    }
+                    jobs.Wait(counter);
+                    if (counter.IsDone()) finished.fetch_add(1);
+                });
+            }
+            for (std::thread& t : threads) t.join();
+            CHECK(badIndex.load() == 0);
+            CHECK(finished.load() == kThreads);
+            CHECK(hits.load() == uint64_t{ kThreads } * kJobsEach);
+
+            // Worker indices are 1..N, stable per thread.
+            std::atomic<uint32_t> outOfRange{ 0 };
+            jobs.ParallelFor(256, 1, [&](uint32_t, uint32_t) {
+                if (jobs.ThreadIndex() >= jobs.ThreadCount()) outOfRange.fetch_add(1);
+            });
+            CHECK(outOfRange.load() == 0);
+        }
+    });
+
+    runner.Run("job_system/init_shutdown_cycles", [&] {
+        JobSystem jobs;
+        jobs.Shutdown(); // before Init: no-op
+
+        // Not initialised: jobs run inline and counters still balance.
+        uint32_t   inlineRuns = 0;
+        JobCounter counter;
+        jobs.Run([&] { ++inlineRuns; }, &counter);
+        CHECK(inlineRuns == 1 && counter.IsDone());
+
+        for (uint32_t cycle = 0; cycle < 24; ++cycle) {
+            const uint32_t workers = kWorkerCounts[cycle % std::size(kWorkerCounts)];
+            if (!CHECK(jobs.Init(workers))) return;
+            CHECK(!jobs.Init(workers)); // already running
+            CHECK(jobs.ThreadCount() == workers + 1);
+
+            std::atomic<uint32_t> hits{ 0 };
+            for (uint32_t k = 0; k < 200; ++k) jobs.Run([&] { hits.fetch_add(1); }, &counter);
+            if (cycle % 2 == 0) jobs.Wait(counter);
+            // Odd cycles shut down with jobs still queued: Shutdown() runs them.
+            jobs.Shutdown();
+            CHECK(hits.load() == 200 && counter.IsDone());
+            jobs.Shutdown(); // twice: no-op
+        }
+    });
+}
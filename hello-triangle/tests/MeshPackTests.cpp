@@ -0,0 +1,298 @@
+#include "Test.h"
+
+#include "MeshPack.h"
+#include "MeshletBuilder.h"
+#include "ObjFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Offsets into the image (see the layout in MeshPack.h).
+constexpr size_t kHeaderSize = 32;
+constexpr size_t kMeshEntry  = 128;
+constexpr size_t kAlignField = 12;
+
+struct Grid {
+    std::vector<Vertex>   vertices;
+    std::vector<uint32_t> indices;
+    MeshletMesh           meshlets;
+};
+
+// An n x n vertex grid with a bumpy height and a colour / uv ramp: enough
+// triangles for several meshlets.
+Grid MakeGrid(int n) {
+    Grid grid;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            const float u = static_cast<float>(x) / static_cast<float>(n - 1);
+            const float v = static_cast<float>(y) / static_cast<float>(n - 1);
+            grid.vertices.push_back({ { u * 4.f - 2.f, v * 3.f - 1.f, 0.25f * static_cast<float>((x * 7 + y * 3) % 5) },
+                                      { u, v, 1.f - u, 1.f },
+                                      { u * 2.f, v } });
+        }
+    }
+    for (int y = 0; y + 1 < n; ++y) {
+        for (int x = 0; x + 1 < n; ++x) {
+            const uint32_t i = static_cast<uint32_t>(y * n + x);
+            const uint32_t w = static_cast<uint32_t>(n);
+            grid.indices.insert(grid.indices.end(), { i, i + 1, i + w, i + 1, i + w + 1, i + w });
+        }
+    }
+    BuildMeshlets(grid.vertices, grid.indices, grid.meshlets);
+    return grid;
+}
+
+struct Expected {
+    std::string_view name;
+    VertexFormat     format;
+    bool             meshlets;
+};
+
+constexpr Expected kMeshes[] = {
+    { "compact",          kCompactVertexFormat, false },
+    { "compact_meshlets", kCompactVertexFormat, true  },
+    { "full",             kFullVertexFormat,    false },
+    { "full_meshlets",    kFullVertexFormat,    true  },
+};
+
+// Added out of order: the pack sorts by name.
+bool AddAll(MeshPackBuilder& builder, const Grid& grid) {
+    bool ok = true;
+    for (size_t i = std::size(kMeshes); i-- > 0;) {
+        const Expected& e = kMeshes[i];
+        ok = builder.Add(e.name, grid.vertices, grid.indices, e.format, e.meshlets ? &grid.meshlets : nullptr) && ok;
+    }
+    return ok;
+}
+
+template <class T>
+bool SameBytes(std::span<const T> a, const std::vector<T>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size_bytes()) == 0);
+}
+
+// Every field of `mesh` matches what the builder was given for `e`.
+bool Matches(const MeshPackMesh& mesh, const Expected& e, const Grid& grid) {
+    const PositionDequant dequant = ComputePositionDequant(grid.vertices, e.format.position);
+    const uint32_t        stride  = MakeVertexLayout(e.format).stride;
+    std::vector<std::byte> encoded(grid.vertices.size() * stride);
+    if (!EncodeVertices(grid.vertices, e.format, dequant, encoded)) return false;
+
+    bool ok = CHECK(mesh.name == e.name);
+    ok = CHECK(mesh.format.position == e.format.position && mesh.format.color == e.format.color &&
+               mesh.format.texCoord == e.format.texCoord) && ok;
+    ok = CHECK(std::memcmp(&mesh.dequant, &dequant, sizeof(dequant)) == 0) && ok;
+    ok = CHECK(mesh.vertexCount == grid.vertices.size() && mesh.stride == stride) && ok;
+    ok = CHECK(SameBytes(mesh.vertexData, encoded)) && ok;
+    ok = CHECK(SameBytes(mesh.indices, grid.indices)) && ok;
+    ok = CHECK(mesh.boundsMin.x == -2.f && mesh.boundsMin.y == -1.f && mesh.boundsMin.z == 0.f) && ok;
+    ok = CHECK(mesh.boundsMax.x == 2.f && mesh.boundsMax.y == 2.f && mesh.boundsMax.z == 1.f) && ok;
+
+    // Vertices() views full-format data as Vertex, and nothing else.
+    if (e.format.position == PositionEncoding::Float3) ok = CHECK(SameBytes(mesh.Vertices(), grid.vertices)) && ok;
+    else                                               ok = CHECK(mesh.Vertices().empty()) && ok;
+
+    const MeshletMesh none;
+    const MeshletMesh& m = e.meshlets ? grid.meshlets : none;
+    ok = CHECK(SameBytes(mesh.meshlets, m.meshlets) && SameBytes(mesh.meshletBounds, m.bounds)) && ok;
+    ok = CHECK(SameBytes(mesh.meshletVertices, m.vertices) && SameBytes(mesh.meshletTriangles, m.triangles)) && ok;
+    return ok;
+}
+
+void PutU32(std::vector<std::byte>& image, size_t offset, uint32_t value) {
+    std::memcpy(image.data() + offset, &value, sizeof(value));
+}
+
+void PutU64(std::vector<std::byte>& image, size_t offset, uint64_t value) {
+    std::memcpy(image.data() + offset, &value, sizeof(value));
+}
+
+bool Opens(std::span<const std::byte> image) {
+    MeshPack pack;
+    return pack.OpenMemory(image);
+}
+
+} // namespace
+
+void RunMeshPackTests(TestRunner& runner) {
+    const Grid grid = MakeGrid(24);
+
+    runner.Run("mesh_pack/round_trip", [&] {
+        if (!CHECK(grid.meshlets.meshlets.size() > 1)) return;
+        MeshPackBuilder builder;
+        if (!CHECK(AddAll(builder, grid) && builder.MeshCount() == std::size(kMeshes))) return;
+
+        for (const uint32_t alignment : { 4u, 16u, 256u }) {
+            const std::vector<std::byte> image = builder.Build(alignment);
+            MeshPack                     pack;
+            if (!CHECK(pack.OpenMemory(image)) || !CHECK(pack.MeshCount() == std::size(kMeshes))) continue;
+
+            // Ascending names, every section aligned from the image start.
+            for (uint32_t i = 0; i < pack.MeshCount(); ++i) {
+                const MeshPackMesh& mesh = pack.Mesh(i);
+                Matches(mesh, kMeshes[i], grid);
+                for (const void* section : { static_cast<const void*>(mesh.vertexData.data()),
+                                             static_cast<const void*>(mesh.indices.data()),
+                                             static_cast<const void*>(mesh.meshlets.data()) }) {
+                    if (section) CHECK((static_cast<const std::byte*>(section) - image.data()) % alignment == 0);
+                }
+            }
+        }
+
+        // The same meshes in any order build the same image.
+        MeshPackBuilder reversed;
+        for (const Expected& e : kMeshes) {
+            CHECK(reversed.Add(e.name, grid.vertices, grid.indices, e.format, e.meshlets ? &grid.meshlets : nullptr));
+        }
+        CHECK(reversed.Build() == builder.Build());
+
+        // Through a file: written via a temporary, then mapped.
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "hello-triangle-mesh-test.mpak";
+        if (!CHECK(builder.Write(path))) return;
+        CHECK(!std::filesystem::exists(path.string() + ".tmp"));
+        {
+            MeshPack pack;
+            if (CHECK(pack.Open(path)) && CHECK(pack.MeshCount() == std::size(kMeshes))) {
+                for (uint32_t i = 0; i < pack.MeshCount(); ++i) Matches(pack.Mesh(i), kMeshes[i], grid);
+            }
+        }
+        std::filesystem::remove(path);
+
+        // A file that cannot be written leaves nothing behind.
+        const std::filesystem::path missing = path.parent_path() / "hello-triangle-no-such-dir" / "mesh.mpak";
+        CHECK(!builder.Write(missing) && !std::filesystem::exists(missing));
+    });
+
+    runner.Run("mesh_pack/find", [&] {
+        MeshPackBuilder builder;
+        if (!CHECK(AddAll(builder, grid))) return;
+        const std::vector<std::byte> image = builder.Build();
+        MeshPack                     pack;
+        if (!CHECK(pack.OpenMemory(image))) return;
+
+        for (const Expected& e : kMeshes) {
+            const MeshPackMesh* mesh = pack.Find(e.name);
+            CHECK(mesh && mesh->name == e.name);
+        }
+        for (const std::string_view miss : { "", "a", "compac", "compact_", "full_meshletsx", "Full", "zzz" }) {
+            CHECK(pack.Find(miss) == nullptr);
+        }
+
+        // Builder-side rejections: empty and duplicate names, bad indices.
+        const uint32_t outOfRange[] = { 0, 1, static_cast<uint32_t>(grid.vertices.size()) };
+        const uint32_t partial[]    = { 0, 1 };
+        CHECK(!builder.Add("", grid.vertices, grid.indices));
+        CHECK(!builder.Add("full", grid.vertices, grid.indices));
+        CHECK(!builder.Add("bad", grid.vertices, outOfRange) && !builder.Add("bad", grid.vertices, partial));
+        CHECK(builder.Build(2).empty() && builder.Build(12).empty());
+
+        pack.Close();
+        CHECK(pack.MeshCount() == 0 && pack.Find("full") == nullptr);
+    });
+
+    runner.Run("mesh_pack/rejects_corrupt_images", [&] {
+        MeshPackBuilder builder;
+        if (!CHECK(AddAll(builder, grid))) return;
+        const std::vector<std::byte> image = builder.Build();
+        if (!CHECK(Opens(image))) return;
+
+        // Truncated anywhere: the last section ends at the end of the image.
+        bool truncatedOk = true;
+        for (size_t size = 0; size < image.size(); ++size) {
+            truncatedOk = !Opens(std::span(image).first(size)) && truncatedOk;
+        }
+        CHECK(truncatedOk);
+
+        const auto corrupt = [&](auto&& edit) {
+            std::vector<std::byte> copy = image;
+            edit(copy);
+            return !Opens(copy);
+        };
+        const size_t entry0 = kHeaderSize;
+        const size_t entry1 = kHeaderSize + kMeshEntry;
+
+        CHECK(corrupt([](auto& c) { c[0] = std::byte{ 'X' }; }));    // magic
+        CHECK(corrupt([](auto& c) { PutU32(c, 4, 99); }));           // version
+        CHECK(corrupt([](auto& c) { PutU32(c, 8, 0x10000000); }));   // mesh count
+
+        // Unsorted (entries 0 and 1 swap names) and duplicate names.
+        CHECK(corrupt([&](auto& c) {
+            std::swap_ranges(c.begin() + entry0, c.begin() + entry0 + 8, c.begin() + entry1);
+        }));
+        CHECK(corrupt([&](auto& c) { std::copy_n(c.begin() + entry0, 8, c.begin() + entry1); }));
+        CHECK(corrupt([&](auto& c) { PutU32(c, entry0 + 4, 0); })); // empty name
+
+        // Sections and names outside the image, or misaligned inside it.
+        const uint64_t past = (image.size() + 15) & ~uint64_t{ 15 };
+        CHECK(corrupt([&](auto& c) { PutU64(c, entry0 + 80, past); }));
+        CHECK(corrupt([&](auto& c) { PutU64(c, entry0 + 88, ~uint64_t{ 0 } & ~uint64_t{ 15 }); }));
+        CHECK(corrupt([&](auto& c) { PutU64(c, entry0 + 80, 4); }));
+        CHECK(corrupt([&](auto& c) { PutU32(c, entry0 + 8, 0xFFFFFFFF); })); // vertex count
+        CHECK(corrupt([&](auto& c) { PutU32(c, entry0 + 12, 3 * 0x0FFFFFFF); }));
+        CHECK(corrupt([&](auto& c) { PutU32(c, entry0 + 12, 2); }));          // not whole triangles
+        CHECK(corrupt([&](auto& c) { c[entry0 + 28] = std::byte{ 9 }; }));    // position encoding
+        CHECK(corrupt([&](auto& c) { PutU64(c, 24, image.size()); }));        // names size
+
+        // Alignment below 4 (every offset is still a multiple of it), and
+        // not a power of two.
+        CHECK(corrupt([](auto& c) { PutU32(c, kAlignField, 1); }));
+        CHECK(corrupt([](auto& c) { PutU32(c, kAlignField, 2); }));
+        CHECK(corrupt([](auto& c) { PutU32(c, kAlignField, 0); }));
+        CHECK(corrupt([](auto& c) { PutU32(c, kAlignField, 24); }));
+
+        // The image itself must start 4-byte aligned; 4 is enough.
+        std::vector<std::byte> shifted(image.size() + 4);
+        for (const size_t shift : { 1u, 2u, 3u, 4u }) {
+            const std::span<std::byte> moved(shifted.data() + shift, image.size());
+            std::copy(image.begin(), image.end(), moved.begin());
+            CHECK(Opens(moved) == (shift == 4));
+        }
+    });
+
+    runner.Run("mesh_pack/parse_obj", [&] {
+        std::vector<Vertex> out;
+
+        // A quad with relative (negative) indices, texture coordinates and
+        // vertex colours: fan-triangulated, winding reversed, v flipped.
+        const char* quad = "# comment\n"
+                           "v 0 0 0 1 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                           "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                           "vn 0 0 1\n"
+                           "g quad\nusemtl none\n"
+                           "f -4/-4/1 -3/-3/1 -2/-2/1 -1/-1/1\n";
+        if (!CHECK(ParseObj(quad, out)) || !CHECK(out.size() == 6)) return;
+        const float expected[6][2] = { { 0, 0 }, { 1, 1 }, { 1, 0 }, { 0, 0 }, { 0, 1 }, { 1, 1 } };
+        for (size_t i = 0; i < 6; ++i) {
+            CHECK(out[i].pos[0] == expected[i][0] && out[i].pos[1] == expected[i][1]);
+            CHECK(out[i].uv[0] == expected[i][0] && out[i].uv[1] == 1.f - expected[i][1]);
+        }
+        CHECK(out[0].col[0] == 1.f && out[0].col[1] == 0.f && out[0].col[3] == 1.f); // red
+        CHECK(out[1].col[0] == 1.f && out[1].col[1] == 1.f && out[1].col[2] == 1.f); // white default
+
+        // Absolute and relative references mean the same vertices; a
+        // pentagon with v//vn references gives three triangles.
+        std::vector<Vertex> absolute, relative;
+        CHECK(ParseObj("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n", absolute));
+        CHECK(ParseObj("v 0 0 0\nv 1 0 0\nv 1 1 0\nf -3 -2 -1\n", relative));
+        CHECK(absolute.size() == 3 && relative.size() == 3 &&
+              std::memcmp(absolute.data(), relative.data(), sizeof(Vertex) * 3) == 0);
+        out.clear();
+        CHECK(ParseObj("v 0 0 0\nv 1 0 0\nv 2 1 0\nv 1 2 0\nv 0 1 0\nf 1//1 2//1 3//1 4//1 5//1\n", out));
+        CHECK(out.size() == 9 && out[3].pos[0] == 0.f && out[4].pos[0] == 1.f && out[5].pos[0] == 2.f);
+
+        // Malformed faces and numbers fail; the triangles before the bad line stay.
+        const char* prefix = "v 0 0 0\nv 1 0 0\nv 1 1 0\nvt 0 0\nf 1 2 3\n";
+        for (const char* bad : { "f 1 2\n", "f 1 2 4\n", "f 0 1 2\n", "f -4 1 2\n", "f 1 x 2\n", "f 1/2 2 3\n",
+                                 "f 1/1/ 2/x 3\n", "f\n", "v 1 2\n", "v 1 2 3 0.5\n", "vt 0.5\n", "v 1e 2 3\n" }) {
+            out.clear();
+            CHECK(!ParseObj(std::string(prefix) + bad + "f 1 2 3\n", out));
+            CHECK(out.size() == 3);
+        }
+    });
+}
@@ -0,0 +1,236 @@
+#include "Test.h"
+
+#include "PipelineCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kFloat2 = 16; // DXGI_FORMAT_R32G32_FLOAT
+constexpr uint32_t kFloat3 = 6;  // DXGI_FORMAT_R32G32B32_FLOAT
+constexpr uint32_t kRgba8  = 28; // DXGI_FORMAT_R8G8B8A8_UNORM
+constexpr uint32_t kD32    = 40; // DXGI_FORMAT_D32_FLOAT
+
+constexpr std::byte kVs[] = { std::byte{ 0x44 }, std::byte{ 0x58 }, std::byte{ 0x42 }, std::byte{ 0x43 }, std::byte{ 1 } };
+constexpr std::byte kPs[] = { std::byte{ 0x44 }, std::byte{ 0x58 }, std::byte{ 0x42 }, std::byte{ 0x43 }, std::byte{ 2 } };
+
+constexpr PipelineInputElement kLayout[] = {
+    { "POSITION", 0, kFloat3, 0, 0 },
+    { "NORMAL", 0, kFloat3, 0, 12 },
+    { "TEXCOORD", 0, kFloat2, 0, 24 },
+};
+
+GraphicsPipelineDesc MakeDesc(std::span<const PipelineInputElement> layout = kLayout) {
+    GraphicsPipelineDesc d;
+    d.rootSignature    = 0x1234;
+    d.vs               = kVs;
+    d.ps               = kPs;
+    d.inputLayout      = layout;
+    d.numRenderTargets = 1;
+    d.rtvFormats[0]    = kRgba8;
+    d.dsvFormat        = kD32;
+    return d;
+}
+
+uint64_t HashOf(auto&& feed) {
+    PipelineHasher h;
+    feed(h);
+    return h.Value();
+}
+
+std::vector<std::byte> Blob(std::initializer_list<uint8_t> bytes) {
+    std::vector<std::byte> out;
+    for (uint8_t b : bytes) out.push_back(std::byte{ b });
+    return out;
+}
+
+void PutU32(std::vector<std::byte>& image, size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; ++i) image[offset + i] = static_cast<std::byte>(value >> (8 * i));
+}
+
+// Recomputes the trailing checksum so a test reaches the field it edited.
+void Reseal(std::vector<std::byte>& image) {
+    PipelineHasher h;
+    h.AddBytes(image.data(), image.size() - 8);
+    const uint64_t sum = h.Value();
+    for (int i = 0; i < 8; ++i) image[image.size() - 8 + i] = static_cast<std::byte>(sum >> (8 * i));
+}
+
+} // namespace
+
+void RunPipelineCacheTests(TestRunner& runner) {
+    runner.Run("pipeline_cache/hasher_byte_stream", [&] {
+        // Reference FNV-1a 64 values.
+        CHECK(PipelineHasher{}.Value() == 0xcbf29ce484222325ull);
+        CHECK(HashOf([](PipelineHasher& h) { h.AddBytes("a", 1); }) == 0xaf63dc4c8601ec8cull);
+        CHECK(HashOf([](PipelineHasher& h) { h.AddBytes("foobar", 6); }) == 0x85944171f73967e8ull);
+
+        // Integers go in little-endian whatever the host.
+        const uint8_t le[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        CHECK(HashOf([](PipelineHasher& h) { h.AddU32(0x04030201u); }) ==
+              HashOf([&](PipelineHasher& h) { h.AddBytes(le, 4); }));
+        CHECK(HashOf([](PipelineHasher& h) { h.AddU64(0x0807060504030201ull); }) ==
+              HashOf([&](PipelineHasher& h) { h.AddBytes(le, 8); }));
+
+        // Strings are length-prefixed.
+        CHECK(HashOf([](PipelineHasher& h) { h.AddString("ab"); h.AddString("c"); }) !=
+              HashOf([](PipelineHasher& h) { h.AddString("a"); h.AddString("bc"); }));
+    });
+
+    runner.Run("pipeline_cache/float_folding", [&] {
+        const float nan  = std::numeric_limits<float>::quiet_NaN();
+        const float snan = std::numeric_limits<float>::signaling_NaN();
+        auto        f    = [](float v) { return HashOf([v](PipelineHasher& h) { h.AddFloat(v); }); };
+
+        CHECK(f(-0.f) == f(0.f));
+        CHECK(f(nan) == f(-nan) && f(nan) == f(snan));
+        CHECK(f(std::bit_cast<float>(0x7fc01234u)) == f(nan)); // NaN payloads too
+        CHECK(f(1.f) != f(-1.f) && f(0.f) != f(nan));
+
+        GraphicsPipelineDesc a = MakeDesc(), b = MakeDesc();
+        a.depthBiasClamp       = 0.f;
+        b.depthBiasClamp       = -0.f;
+        a.slopeScaledDepthBias = -0.f;
+        CHECK(HashGraphicsPipeline(a) == HashGraphicsPipeline(b));
+        b.slopeScaledDepthBias = 0.5f;
+        CHECK(HashGraphicsPipeline(a) != HashGraphicsPipeline(b));
+    });
+
+    runner.Run("pipeline_cache/key_ignores_declaration_order", [&] {
+        const uint64_t key = HashGraphicsPipeline(MakeDesc());
+
+        // Same elements in another order, append-aligned offsets and other
+        // semantic case: same pipeline, same key.
+        const PipelineInputElement reordered[] = { kLayout[2], kLayout[0], kLayout[1] };
+        CHECK(HashGraphicsPipeline(MakeDesc(reordered)) == key);
+        const PipelineInputElement appended[] = {
+            { "position", 0, kFloat3, 0, 0 },
+            { "Normal", 0, kFloat3, 0, kAppendAlignedElement },
+            { "TexCoord", 0, kFloat2, 0, kAppendAlignedElement },
+        };
+        CHECK(HashGraphicsPipeline(MakeDesc(appended)) == key);
+
+        // State a disabled feature or an unused target does not read.
+        GraphicsPipelineDesc d = MakeDesc();
+        d.blend[0].srcBlend    = 5;
+        d.blend[0].logicOp     = 7;
+        d.blend[3].blendEnable = true; // only target 0 without independent blend
+        d.rtvFormats[5]        = kRgba8;
+        d.frontFace.passOp     = 3;
+        d.stencilReadMask      = 0x0F;
+        d.inputLayout          = reordered;
+        CHECK(HashGraphicsPipeline(d) == key);
+        d.depthEnable = false;
+        d.depthFunc   = 4;
+        const uint64_t noDepth = HashGraphicsPipeline(d);
+        d.depthWriteMask = 0;
+        CHECK(HashGraphicsPipeline(d) == noDepth && noDepth != key);
+
+        // Anything the driver compiles against changes it.
+        const auto changed = [&](auto edit) {
+            GraphicsPipelineDesc e = MakeDesc();
+            edit(e);
+            return HashGraphicsPipeline(e) != key;
+        };
+        CHECK(changed([](GraphicsPipelineDesc& e) { e.rootSignature = 0x1235; }));
+        CHECK(changed([](GraphicsPipelineDesc& e) { e.vs = std::span(kVs).first(4); }));
+        CHECK(changed([](GraphicsPipelineDesc& e) { e.vs = kPs; e.ps = kVs; }));
+        CHECK(changed([](GraphicsPipelineDesc& e) { e.cullMode = 1; }));
+        CHECK(changed([](GraphicsPipelineDesc& e) { e.blend[0].blendEnable = true; }));
+        CHECK(changed([](GraphicsPipelineDesc& e) { e.rtvFormats[0] = kRgba8 + 1; }));
+        CHECK(changed([](GraphicsPipelineDesc& e) { e.inputLayout = std::span(kLayout).first(2); }));
+
+        // The same description keys the same on every build and platform;
+        // this value only changes along with kPipelineKeyVersion.
+        static_assert(kPipelineKeyVersion == 1);
+        CHECK(key == 0xea3e44108327986eull);
+    });
+
+    runner.Run("pipeline_cache/image_round_trip", [&] {
+        PipelineCache cache;
+        cache.Store(3, Blob({ 1, 2, 3 }));
+        cache.Store(1, Blob({ 9, 9, 9, 9, 9, 9, 9, 9, 9 }));
+        cache.Store(2, {});
+        const std::vector<std::byte> image = cache.Serialize(42);
+        CHECK(image.size() % 8 == 0);
+        CHECK(cache.Serialize(42) == image); // deterministic
+
+        PipelineCache loaded;
+        if (!CHECK(loaded.Deserialize(image, 42))) return;
+        CHECK(loaded.EntryCount() == 3 && !loaded.Dirty());
+        CHECK(std::ranges::equal(loaded.Find(3), Blob({ 1, 2, 3 })));
+        CHECK(loaded.Find(1).size() == 9 && loaded.Find(2).empty() && loaded.Find(4).empty());
+        CHECK(loaded.Serialize(42) == image);
+
+        // Through the file system, replacing an older image.
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "hello-triangle-pso-test.bin";
+        CHECK(loaded.Save(path, 7));
+        loaded.Erase(1);
+        CHECK(loaded.Dirty() && loaded.Save(path, 7) && !loaded.Dirty());
+        PipelineCache fromDisk;
+        CHECK(fromDisk.Load(path, 7) && fromDisk.EntryCount() == 2 && fromDisk.Find(1).empty());
+        CHECK(!std::filesystem::exists(path.string() + ".tmp"));
+        std::filesystem::remove(path);
+        CHECK(!fromDisk.Load(path, 7) && fromDisk.EntryCount() == 0);
+
+        // A failed save keeps the cache dirty for the next attempt.
+        const std::filesystem::path missing = path.parent_path() / "hello-triangle-no-such-dir" / "pso.bin";
+        loaded.Erase(3);
+        CHECK(!loaded.Save(missing, 7) && loaded.Dirty() && !std::filesystem::exists(missing));
+    });
+
+    runner.Run("pipeline_cache/stale_images_rejected", [&] {
+        PipelineCache cache;
+        cache.Store(5, Blob({ 1, 2, 3, 4, 5 }));
+        const std::vector<std::byte> image = cache.Serialize(42);
+
+        // Every rejection leaves the cache empty, never half loaded.
+        const auto rejected = [&](std::span<const std::byte> bytes, uint64_t deviceId = 42) {
+            PipelineCache c;
+            c.Store(99, Blob({ 1 }));
+            return !c.Deserialize(bytes, deviceId) && c.EntryCount() == 0;
+        };
+
+        // Another adapter or driver.
+        CHECK(rejected(image, 43));
+
+        // A format version this build does not know, checksum intact.
+        for (uint32_t version : { PipelineCache::kFormatVersion - 1, PipelineCache::kFormatVersion + 1 }) {
+            std::vector<std::byte> other = image;
+            PutU32(other, 4, version);
+            Reseal(other);
+            CHECK(rejected(other));
+        }
+
+        // Truncated anywhere, or any byte changed.
+        for (size_t size = 0; size < image.size(); ++size) CHECK(rejected(std::span(image).first(size)));
+        for (size_t i = 0; i < image.size(); ++i) {
+            std::vector<std::byte> corrupt = image;
+            corrupt[i] ^= std::byte{ 0x10 };
+            CHECK(rejected(corrupt));
+        }
+
+        // Structurally bad but correctly checksummed: a count past the end,
+        // a size past the end, a duplicate key.
+        std::vector<std::byte> bad = image;
+        PutU32(bad, 16, 2);
+        Reseal(bad);
+        CHECK(rejected(bad));
+        bad = image;
+        PutU32(bad, 32, 64);
+        Reseal(bad);
+        CHECK(rejected(bad));
+
+        cache.Store(6, Blob({ 7 }));
+        bad = cache.Serialize(42);
+        std::memcpy(bad.data() + 24 + 16 + 8, bad.data() + 24, 8); // second key := first
+        Reseal(bad);
+        CHECK(rejected(bad));
+    });
+}
@@ -0,0 +1,194 @@
+#include "Test.h"
+
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr TextureDesc kTarget = { 1280, 720, 1, 1, 28 }; // DXGI_FORMAT_R8G8B8A8_UNORM
+
+bool Contains(std::span<const uint32_t> passes, uint32_t pass) {
+    return std::find(passes.begin(), passes.end(), pass) != passes.end();
+}
+
+bool Equals(std::span<const uint32_t> passes, std::initializer_list<uint32_t> expected) {
+    return std::equal(passes.begin(), passes.end(), expected.begin(), expected.end());
+}
+
+bool Equals(std::span<const ResourceHandle> resources, std::initializer_list<ResourceHandle> expected) {
+    return std::equal(resources.begin(), resources.end(), expected.begin(), expected.end(),
+                      [](ResourceHandle a, ResourceHandle b) { return a.index == b.index; });
+}
+
+} // namespace
+
+void RunRenderGraphTests(TestRunner& runner) {
+    runner.Run("render_graph/culls_dead_passes", [&] {
+        RenderGraph           graph;
+        std::vector<uint32_t> executed;
+        const auto record = [&](uint32_t pass) { return [&executed, pass] { executed.push_back(pass); }; };
+
+        const ResourceHandle backBuffer = graph.ImportTexture("BackBuffer", kTarget);
+        ResourceHandle       gbuffer, debugView, scratch;
+        const uint32_t gbufferPass = graph.AddPass("GBuffer", [&](RenderGraphBuilder& b) {
+            gbuffer = b.Write(b.CreateTexture("GBuffer", kTarget));
+        }, record(0));
+        const uint32_t debugPass = graph.AddPass("Debug", [&](RenderGraphBuilder& b) {
+            b.Read(gbuffer);
+            debugView = b.Write(b.CreateTexture("DebugView", kTarget)); // never read
+        }, record(1));
+        const uint32_t lightingPass = graph.AddPass("Lighting", [&](RenderGraphBuilder& b) {
+            b.Read(gbuffer);
+            b.Write(backBuffer);
+        }, record(2));
+        const uint32_t unusedPass = graph.AddPass("Unused", [&](RenderGraphBuilder& b) {
+            scratch = b.Write(b.CreateBuffer("Scratch", { 4096 }));
+        }, record(3));
+        const uint32_t readbackPass = graph.AddPass("Readback", [&](RenderGraphBuilder& b) {
+            b.Read(gbuffer, ResourceUsage::CopySource);
+            b.SetSideEffect();
+        }, record(4));
+        if (!CHECK(graph.Compile())) return;
+
+        // The producer of the imported back buffer and its input survive, as
+        // does the side-effect pass; the passes nobody reads from do not.
+        CHECK(!graph.IsCulled(gbufferPass) && !graph.IsCulled(lightingPass) && !graph.IsCulled(readbackPass));
+        CHECK(graph.IsCulled(debugPass) && graph.IsCulled(unusedPass));
+        CHECK(graph.CulledPassCount() == 2);
+        CHECK(Equals(graph.Schedule(), { gbufferPass, lightingPass, readbackPass }));
+
+        graph.Execute();
+        CHECK(Equals(executed, { 0, 2, 4 }));
+
+        // A culled pass's transients are never allocated.
+        CHECK(!graph.Lifetime(debugView).IsUsed() && !graph.Lifetime(scratch).IsUsed());
+    });
+
+    runner.Run("render_graph/write_after_read", [&] {
+        RenderGraph          graph;
+        const ResourceHandle output = graph.ImportTexture("Output", kTarget);
+        const ResourceHandle other  = graph.ImportTexture("Other", kTarget);
+        ResourceHandle       scratch;
+
+        const uint32_t produce = graph.AddPass("Produce", [&](RenderGraphBuilder& b) {
+            scratch = b.Write(b.CreateTexture("Scratch", kTarget));
+        });
+        const uint32_t consume = graph.AddPass("Consume", [&](RenderGraphBuilder& b) {
+            b.Read(scratch);
+            b.Write(output);
+        });
+        const uint32_t independent = graph.AddPass("Independent", [&](RenderGraphBuilder& b) {
+            b.Write(other);
+        });
+        // Reuses the scratch texture: it must wait for Consume's read.
+        const uint32_t overwrite = graph.AddPass("Overwrite", [&](RenderGraphBuilder& b) {
+            b.Write(scratch, ResourceUsage::UnorderedAccess);
+            b.SetSideEffect();
+        });
+        if (!CHECK(graph.Compile())) return;
+
+        CHECK(Equals(graph.Dependencies(consume), { produce }));
+        CHECK(Contains(graph.Dependencies(overwrite), consume));  // write after read
+        CHECK(Contains(graph.Dependencies(overwrite), produce));  // write after write
+        CHECK(graph.Dependencies(independent).empty());
+
+        // One level per step of the chain; the independent pass shares level
+        // 0 with Produce and follows it (declaration order).
+        CHECK(graph.PassLevel(produce) == 0 && graph.PassLevel(independent) == 0);
+        CHECK(graph.PassLevel(consume) == 1 && graph.PassLevel(overwrite) == 2);
+        CHECK(graph.LevelCount() == 3);
+        CHECK(Equals(graph.Schedule(), { produce, independent, consume, overwrite }));
+    });
+
+    runner.Run("render_graph/imported_never_culled", [&] {
+        RenderGraph          graph;
+        const ResourceHandle history = graph.ImportTexture("History", kTarget);
+        const ResourceHandle stats   = graph.ImportBuffer("Stats", { 256 });
+
+        // Reading an imported resource nobody wrote is fine: it has contents.
+        ResourceHandle resolved;
+        const uint32_t resolve = graph.AddPass("Resolve", [&](RenderGraphBuilder& b) {
+            b.Read(history);
+            resolved = b.Write(b.CreateTexture("Resolved", kTarget));
+        });
+        // Nothing reads Stats or History afterwards, yet both writers survive.
+        const uint32_t count = graph.AddPass("Count", [&](RenderGraphBuilder& b) {
+            b.Read(resolved);
+            b.Write(stats, ResourceUsage::UnorderedAccess);
+        });
+        const uint32_t store = graph.AddPass("StoreHistory", [&](RenderGraphBuilder& b) {
+            b.Read(resolved);
+            b.Write(history);
+        });
+        if (!CHECK(graph.Compile())) return;
+
+        CHECK(graph.CulledPassCount() == 0);
+        CHECK(Equals(graph.Schedule(), { resolve, count, store }));
+        CHECK(graph.IsImported(history) && graph.IsImported(stats) && !graph.IsImported(resolved));
+        CHECK(!graph.IsTexture(stats) && graph.GetBufferDesc(stats).size == 256);
+
+        // Imported resources are tracked but never handed out as transients.
+        CHECK(graph.Lifetime(history).first == 0 && graph.Lifetime(history).last == 2);
+        for (uint32_t pos = 0; pos < graph.Schedule().size(); ++pos) {
+            for (const ResourceHandle r : graph.FirstUses(pos)) CHECK(!graph.IsImported(r));
+            for (const ResourceHandle r : graph.LastUses(pos))  CHECK(!graph.IsImported(r));
+        }
+
+        // A transient read before any write has undefined contents.
+        graph.Reset();
+        graph.AddPass("ReadUndefined", [&](RenderGraphBuilder& b) {
+            b.Read(b.CreateTexture("Undefined", kTarget));
+            b.SetSideEffect();
+        });
+        CHECK(!graph.Compile());
+
+        graph.Reset();
+        graph.AddPass("BadHandle", [&](RenderGraphBuilder& b) { b.Read(ResourceHandle{ 7 }); });
+        CHECK(!graph.Compile());
+    });
+
+    runner.Run("render_graph/lifetimes", [&] {
+        // depth -> color -> blur -> compose (reads blur and depth) -> back buffer
+        RenderGraph          graph;
+        const ResourceHandle backBuffer = graph.ImportTexture("BackBuffer", kTarget);
+        ResourceHandle       depth, color, blur;
+
+        graph.AddPass("Depth", [&](RenderGraphBuilder& b) {
+            depth = b.Write(b.CreateTexture("Depth", kTarget), ResourceUsage::DepthWrite);
+        });
+        graph.AddPass("Color", [&](RenderGraphBuilder& b) {
+            b.Read(depth, ResourceUsage::DepthRead);
+            color = b.Write(b.CreateTexture("Color", kTarget));
+        });
+        graph.AddPass("Blur", [&](RenderGraphBuilder& b) {
+            b.Read(color);
+            blur = b.Write(b.CreateTexture("Blur", kTarget), ResourceUsage::UnorderedAccess);
+        });
+        graph.AddPass("Compose", [&](RenderGraphBuilder& b) {
+            b.Read(blur);
+            b.Read(depth);
+            b.Write(backBuffer);
+        });
+        if (!CHECK(graph.Compile())) return;
+        if (!CHECK(Equals(graph.Schedule(), { 0, 1, 2, 3 }))) return;
+
+        const auto lifetime = [&](ResourceHandle r, uint32_t first, uint32_t last) {
+            return graph.Lifetime(r).first == first && graph.Lifetime(r).last == last;
+        };
+        CHECK(lifetime(depth, 0, 3));
+        CHECK(lifetime(color, 1, 2));
+        CHECK(lifetime(blur, 2, 3));
+
+        CHECK(Equals(graph.FirstUses(0), { depth }) && Equals(graph.FirstUses(1), { color }));
+        CHECK(Equals(graph.FirstUses(2), { blur }) && graph.FirstUses(3).empty());
+        CHECK(graph.LastUses(0).empty() && graph.LastUses(1).empty());
+        CHECK(Equals(graph.LastUses(2), { color }) && Equals(graph.LastUses(3), { depth, blur }));
+
+        // Compiling again gives the same result.
+        const uint32_t edges = graph.EdgeCount();
+        CHECK(graph.Compile() && graph.EdgeCount() == edges && lifetime(depth, 0, 3));
+    });
+}
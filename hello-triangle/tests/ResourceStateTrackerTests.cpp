@@ -0,0 +1,217 @@
+#include "Test.h"
+
+#include "ResourceStateTracker.h"
+
+#include <span>
+
+namespace {
+
+using Barrier = ResourceBarrierDesc;
+
+constexpr uint32_t kAll = ResourceStateTracker::kAllSubresources;
+constexpr uint32_t kSrv = kResourceStateNonPixelShaderResource | kResourceStatePixelShaderResource;
+
+// The tracker never dereferences resources; any distinct address will do.
+int gTexture, gBuffer;
+
+bool IsTransition(const Barrier& b, void* resource, uint32_t subresource, uint32_t before, uint32_t after,
+                  BarrierSplit split = BarrierSplit::None) {
+    return b.type == Barrier::Type::Transition && b.resource == resource && b.subresource == subresource &&
+           b.before == before && b.after == after && b.split == split;
+}
+
+} // namespace
+
+void RunResourceStateTrackerTests(TestRunner& runner) {
+    runner.Run("resource_state_tracker/fold_repeated_transitions", [&] {
+        ResourceStateTracker t;
+        const uint32_t       id = t.Register(&gTexture, 1, kResourceStateCopyDest);
+
+        // COPY_DEST -> SRV -> RT -> UAV in one batch is one barrier.
+        t.Transition(id, kSrv);
+        t.Transition(id, kResourceStateRenderTarget);
+        t.Transition(id, kResourceStateUnorderedAccess);
+        std::span<const Barrier> batch = t.Flush();
+        if (CHECK(batch.size() == 1))
+            CHECK(IsTransition(batch[0], &gTexture, kAll, kResourceStateCopyDest, kResourceStateUnorderedAccess));
+        CHECK(t.State(id) == kResourceStateUnorderedAccess);
+        CHECK(t.MergedCount() == 2 && t.RequestCount() == 3);
+
+        // Nothing queued: an empty batch, not counted as a flush.
+        CHECK(t.Flush().empty());
+        CHECK(t.FlushCount() == 1 && t.BarrierCount() == 1);
+
+        // Requests are per batch: the same transition after a flush is new.
+        t.Transition(id, kResourceStateCopySource);
+        CHECK(t.Flush().size() == 1);
+    });
+
+    runner.Run("resource_state_tracker/round_trip_dropped", [&] {
+        ResourceStateTracker t;
+        const uint32_t       tex = t.Register(&gTexture, 1, kResourceStateRenderTarget);
+        const uint32_t       buf = t.Register(&gBuffer, 1, kResourceStateCopyDest);
+
+        t.Transition(tex, kSrv);
+        t.Transition(buf, kResourceStateVertexAndConstantBuffer);
+        t.Transition(tex, kResourceStateRenderTarget); // back where it started
+        std::span<const Barrier> batch = t.Flush();
+        if (CHECK(batch.size() == 1))
+            CHECK(IsTransition(batch[0], &gBuffer, kAll, kResourceStateCopyDest, kResourceStateVertexAndConstantBuffer));
+        CHECK(t.State(tex) == kResourceStateRenderTarget);
+
+        // After a dropped round trip the next request queues afresh.
+        t.Transition(tex, kSrv);
+        t.Transition(tex, kResourceStateRenderTarget);
+        t.Transition(tex, kResourceStateCopySource);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 1))
+            CHECK(IsTransition(batch[0], &gTexture, kAll, kResourceStateRenderTarget, kResourceStateCopySource));
+
+        // Same state: elided, nothing queued.
+        t.Transition(tex, kResourceStateCopySource);
+        CHECK(t.Flush().empty());
+        CHECK(t.ElidedCount() == 1);
+    });
+
+    runner.Run("resource_state_tracker/subresource_divergence", [&] {
+        ResourceStateTracker t;
+        const uint32_t       id = t.Register(&gTexture, 4, kSrv);
+
+        // Mip 2 alone goes to RT: one barrier for that subresource.
+        t.Transition(id, kResourceStateRenderTarget, 2);
+        std::span<const Barrier> batch = t.Flush();
+        if (CHECK(batch.size() == 1)) CHECK(IsTransition(batch[0], &gTexture, 2, kSrv, kResourceStateRenderTarget));
+        CHECK(t.State(id, 1) == kSrv && t.State(id, 2) == kResourceStateRenderTarget);
+
+        // The whole resource back to SRV while they differ: only mip 2 moves.
+        t.Transition(id, kSrv);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 1)) CHECK(IsTransition(batch[0], &gTexture, 2, kResourceStateRenderTarget, kSrv));
+
+        // Converged again: one ALL_SUBRESOURCES barrier.
+        t.Transition(id, kResourceStateCopyDest);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 1)) CHECK(IsTransition(batch[0], &gTexture, kAll, kSrv, kResourceStateCopyDest));
+
+        // Diverged subresources going to one state: one barrier each for
+        // those that need it.
+        t.Transition(id, kResourceStateCopySource, 0);
+        t.Transition(id, kResourceStateCopySource, 3);
+        CHECK(t.Flush().size() == 2);
+        t.Transition(id, kResourceStateUnorderedAccess);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 4)) {
+            CHECK(IsTransition(batch[0], &gTexture, 0, kResourceStateCopySource, kResourceStateUnorderedAccess));
+            CHECK(IsTransition(batch[1], &gTexture, 1, kResourceStateCopyDest, kResourceStateUnorderedAccess));
+            CHECK(IsTransition(batch[3], &gTexture, 3, kResourceStateCopySource, kResourceStateUnorderedAccess));
+        }
+        for (uint32_t s = 0; s < 4; ++s) CHECK(t.State(id, s) == kResourceStateUnorderedAccess);
+
+        // Out-of-range subresources are ignored.
+        t.Transition(id, kResourceStateCopyDest, 4);
+        CHECK(t.Flush().empty());
+    });
+
+    runner.Run("resource_state_tracker/split_barriers", [&] {
+        ResourceStateTracker t;
+        const uint32_t       id = t.Register(&gTexture, 1, kResourceStateRenderTarget);
+
+        t.BeginTransition(id, kSrv);
+        std::span<const Barrier> batch = t.Flush();
+        if (CHECK(batch.size() == 1))
+            CHECK(IsTransition(batch[0], &gTexture, kAll, kResourceStateRenderTarget, kSrv, BarrierSplit::BeginOnly));
+        CHECK(t.HasPendingSplit(id));
+        CHECK(t.State(id) == kResourceStateRenderTarget); // still "before" in flight
+
+        // A repeated begin to the same target is elided.
+        t.BeginTransition(id, kSrv);
+        CHECK(t.Flush().empty());
+
+        // The next Transition to the target only ends the split.
+        t.Transition(id, kSrv);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 1))
+            CHECK(IsTransition(batch[0], &gTexture, kAll, kResourceStateRenderTarget, kSrv, BarrierSplit::EndOnly));
+        CHECK(!t.HasPendingSplit(id) && t.State(id) == kSrv);
+
+        // To another state: END_ONLY first, then a full barrier on from there.
+        t.BeginTransition(id, kResourceStateCopySource);
+        CHECK(t.Flush().size() == 1);
+        t.Transition(id, kResourceStateCopyDest);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 2)) {
+            CHECK(IsTransition(batch[0], &gTexture, kAll, kSrv, kResourceStateCopySource, BarrierSplit::EndOnly));
+            CHECK(IsTransition(batch[1], &gTexture, kAll, kResourceStateCopySource, kResourceStateCopyDest));
+        }
+
+        // A begin to a different target ends the first split and begins anew.
+        t.BeginTransition(id, kSrv);
+        t.BeginTransition(id, kResourceStateRenderTarget);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 3)) {
+            CHECK(batch[0].split == BarrierSplit::BeginOnly && batch[0].after == kSrv);
+            CHECK(batch[1].split == BarrierSplit::EndOnly && batch[1].after == kSrv);
+            CHECK(IsTransition(batch[2], &gTexture, kAll, kSrv, kResourceStateRenderTarget, BarrierSplit::BeginOnly));
+        }
+    });
+
+    runner.Run("resource_state_tracker/read_state_combining", [&] {
+        ResourceStateTracker t;
+        const uint32_t       id = t.Register(&gBuffer, 1, kResourceStateGenericRead);
+
+        // Every read-only state within GENERIC_READ is already satisfied.
+        t.Transition(id, kResourceStateVertexAndConstantBuffer);
+        t.Transition(id, kResourceStateIndexBuffer);
+        t.Transition(id, kSrv);
+        t.Transition(id, kResourceStateCopySource);
+        CHECK(t.Flush().empty());
+        CHECK(t.ElidedCount() == 4 && t.State(id) == kResourceStateGenericRead);
+
+        // Reads outside the combination, writes and COMMON need a barrier.
+        t.Transition(id, kResourceStateDepthRead);
+        CHECK(t.Flush().size() == 1);
+        t.Transition(id, kResourceStateCommon);
+        CHECK(t.Flush().size() == 1);
+
+        // A combined SRV state satisfies each half but not a wider read.
+        const uint32_t tex = t.Register(&gTexture, 1, kSrv);
+        t.Transition(tex, kResourceStatePixelShaderResource);
+        t.Transition(tex, kResourceStateNonPixelShaderResource);
+        CHECK(t.Flush().empty());
+        t.Transition(tex, kResourceStatePixelShaderResource | kResourceStateCopySource);
+        CHECK(t.Flush().size() == 1);
+
+        // A write state never satisfies a read contained in its bits.
+        const uint32_t rt = t.Register(&gTexture, 1, kResourceStateRenderTarget | kResourceStateCopySource);
+        t.Transition(rt, kResourceStateCopySource);
+        CHECK(t.Flush().size() == 1);
+    });
+
+    runner.Run("resource_state_tracker/uav_barriers", [&] {
+        ResourceStateTracker t;
+        const uint32_t       id = t.Register(&gBuffer, 1, kResourceStateUnorderedAccess);
+
+        t.UavBarrier(id);
+        std::span<const Barrier> batch = t.Flush();
+        if (CHECK(batch.size() == 1)) CHECK(batch[0].type == Barrier::Type::Uav && batch[0].resource == &gBuffer);
+
+        // A transition queued before a UAV barrier stays separate from the
+        // one requested after it: the order of the three is kept.
+        t.Transition(id, kResourceStateCopySource);
+        t.UavBarrier(id);
+        t.Transition(id, kResourceStateUnorderedAccess);
+        batch = t.Flush();
+        if (CHECK(batch.size() == 3)) {
+            CHECK(IsTransition(batch[0], &gBuffer, kAll, kResourceStateUnorderedAccess, kResourceStateCopySource));
+            CHECK(batch[1].type == Barrier::Type::Uav);
+            CHECK(IsTransition(batch[2], &gBuffer, kAll, kResourceStateCopySource, kResourceStateUnorderedAccess));
+        }
+
+        // Unregistered ids are ignored; the id is reused by the next Register.
+        t.Unregister(id);
+        t.UavBarrier(id);
+        t.Transition(id, kResourceStateCopyDest);
+        CHECK(t.Flush().empty());
+        CHECK(t.Register(&gTexture, 1, kResourceStateCommon) == id);
+    });
+}
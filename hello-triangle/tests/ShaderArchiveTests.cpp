@@ -0,0 +1,149 @@
+#include "Test.h"
+
+#include "ShaderArchive.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Shader {
+    std::string            name;
+    std::vector<std::byte> data;
+};
+
+// Names chosen to sit next to each other byte-wise: prefixes, case and
+// punctuation, so the binary search has neighbours to get wrong.
+std::vector<Shader> MakeShaders() {
+    const char* names[] = { "sky.ps", "Mesh.vs", "mesh.ps", "mesh.vs", "mesh.vs.skinned", "post/bloom.ps",
+                            "post/tonemap.ps", "a", "ui.vs", "ui.ps", "mesh", "z" };
+    std::vector<Shader> shaders;
+    uint32_t            seed = 7;
+    for (const char* name : names) {
+        Shader s{ name, std::vector<std::byte>(1 + (seed % 300)) };
+        for (std::byte& b : s.data) b = static_cast<std::byte>(seed = seed * 1103515245u + 12345u);
+        shaders.push_back(std::move(s));
+    }
+    return shaders;
+}
+
+bool AddAll(ShaderArchiveBuilder& builder, const std::vector<Shader>& shaders) {
+    bool ok = true;
+    for (const Shader& s : shaders) ok = builder.Add(s.name, s.data) && ok;
+    return ok;
+}
+
+} // namespace
+
+void RunShaderArchiveTests(TestRunner& runner) {
+    runner.Run("shader_archive/round_trip", [&] {
+        const std::vector<Shader> shaders = MakeShaders();
+        ShaderArchiveBuilder      builder;
+        if (!CHECK(AddAll(builder, shaders))) return;
+
+        for (uint32_t alignment : { 1u, 4u, 64u, 4096u }) {
+            const std::vector<std::byte> image = builder.Build(alignment);
+            ShaderArchive                archive;
+            if (!CHECK(archive.OpenMemory(image))) continue;
+            CHECK(archive.EntryCount() == shaders.size());
+
+            // Sorted byte-wise, every blob aligned from the image start.
+            for (uint32_t i = 0; i < archive.EntryCount(); ++i) {
+                if (i > 0) CHECK(archive.Name(i - 1) < archive.Name(i));
+                CHECK((archive.Data(i).data() - image.data()) % alignment == 0);
+            }
+            // Found by name, byte for byte, pointing into the image.
+            for (const Shader& s : shaders) {
+                const std::span<const std::byte> data = archive.Find(s.name);
+                CHECK(std::ranges::equal(data, s.data));
+                CHECK(data.data() >= image.data() && data.data() + data.size() <= image.data() + image.size());
+            }
+        }
+
+        // The image depends on the set of entries, not the insertion order.
+        std::vector<Shader> reversed = shaders;
+        std::reverse(reversed.begin(), reversed.end());
+        ShaderArchiveBuilder other;
+        CHECK(AddAll(other, reversed));
+        CHECK(other.Build() == builder.Build());
+
+        // Through a mapped file.
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "hello-triangle-shar-test.bin";
+        CHECK(builder.Write(path));
+        ShaderArchive archive;
+        if (CHECK(archive.Open(path))) {
+            CHECK(std::ranges::equal(archive.Find("post/bloom.ps"), shaders[5].data));
+            archive.Close();
+            CHECK(archive.EntryCount() == 0 && archive.Find("post/bloom.ps").empty());
+        }
+        std::filesystem::remove(path);
+        CHECK(!archive.Open(path));
+
+        // A file that cannot be written leaves nothing behind.
+        const std::filesystem::path missing = path.parent_path() / "hello-triangle-no-such-dir" / "shaders.bin";
+        CHECK(!builder.Write(missing) && !std::filesystem::exists(missing));
+    });
+
+    runner.Run("shader_archive/lookup_miss", [&] {
+        const std::vector<Shader> shaders = MakeShaders();
+        ShaderArchiveBuilder      builder;
+        CHECK(AddAll(builder, shaders));
+        const std::vector<std::byte> image = builder.Build();
+        ShaderArchive                archive;
+        if (!CHECK(archive.OpenMemory(image))) return;
+
+        // Before the first, after the last, between neighbours, a prefix of
+        // a name, a name extended, other case, and the empty name.
+        for (const char* name : { "", "0", "zz", "{", "mesh.", "mesh.v", "mesh.vs.", "mesh.vs.skinne",
+                                  "MESH.VS", "post", "post/", "sky", "ui.vs2" })
+            CHECK(archive.Find(name).empty());
+        CHECK(archive.Name(archive.EntryCount()).empty() && archive.Data(archive.EntryCount()).empty());
+
+        // An archive with no entries, or with a single one.
+        ShaderArchiveBuilder empty;
+        const std::vector<std::byte> emptyImage = empty.Build();
+        ShaderArchive                none;
+        CHECK(none.OpenMemory(emptyImage) && none.EntryCount() == 0 && none.Find("a").empty());
+
+        ShaderArchiveBuilder single;
+        CHECK(single.Add("m", shaders[0].data));
+        const std::vector<std::byte> singleImage = single.Build();
+        ShaderArchive                one;
+        CHECK(one.OpenMemory(singleImage));
+        CHECK(!one.Find("m").empty() && one.Find("a").empty() && one.Find("n").empty());
+    });
+
+    runner.Run("shader_archive/malformed_rejected", [&] {
+        ShaderArchiveBuilder builder;
+        CHECK(AddAll(builder, MakeShaders()));
+        CHECK(!builder.Add("mesh.vs", {}) && !builder.Add("", {})); // duplicate, empty name
+        CHECK(builder.Build(3).empty() && builder.Build(0).empty());
+
+        const std::vector<std::byte> image = builder.Build();
+        ShaderArchive                archive;
+
+        // The last blob ends the image: every shorter prefix is cut somewhere.
+        for (size_t size = 0; size < image.size(); ++size) CHECK(!archive.OpenMemory(std::span(image).first(size)));
+        CHECK(archive.EntryCount() == 0);
+
+        // Index out of order: two entries swapped.
+        std::vector<std::byte> bad = image;
+        std::swap_ranges(bad.begin() + 32, bad.begin() + 56, bad.begin() + 56);
+        CHECK(!archive.OpenMemory(bad));
+
+        // Version, alignment and a blob off its alignment.
+        bad    = image;
+        bad[4] = std::byte{ 2 };
+        CHECK(!archive.OpenMemory(bad));
+        bad     = image;
+        bad[12] = std::byte{ 48 };
+        CHECK(!archive.OpenMemory(bad));
+        bad     = image;
+        bad[40] = static_cast<std::byte>(static_cast<uint8_t>(bad[40]) + 4);
+        CHECK(!archive.OpenMemory(bad));
+
+        CHECK(archive.OpenMemory(image) && archive.EntryCount() == 12);
+    });
+}
@@ -0,0 +1,293 @@
+#include "Test.h"
+
+#include "InstanceBatcher.h"
+#include "ShaderReflection.h"
+#include "Vertex.h"
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <vector>
+
+// tests/data/vertex.cso and pixel.cso carry the reflection chunks fxc emits
+// for shaders/vertex.hlsl (vs_5_0) and shaders/pixel.hlsl (ps_5_0): RDEF
+// (RD11), ISGN, OSGN and a SHEX chunk with the version token and a bare
+// `ret`. No instructions and a zero digest, so they are small and need no
+// Windows SDK, but D3D would not create a shader from them.
+
+namespace {
+
+// The C++ mirrors D3DApp checks against the same shaders.
+struct PerViewCB {
+    float viewProjMatrix[4][4];
+};
+struct PerFrameCB {
+    float time;
+    float deltaTime;
+};
+
+constexpr MirrorField kVertexFields[] = {
+    { "POSITION", offsetof(Vertex, pos), sizeof(Vertex::pos) },
+    { "COLOR",    offsetof(Vertex, col), sizeof(Vertex::col) },
+    { "TEXCOORD", offsetof(Vertex, uv),  sizeof(Vertex::uv)  },
+};
+constexpr MirrorField kInstanceFields[] = {
+    { "INSTANCE_WORLD",  offsetof(InstanceData, world[0]), sizeof(InstanceData::world[0]) },
+    { "INSTANCE_WORLD1", offsetof(InstanceData, world[1]), sizeof(InstanceData::world[1]) },
+    { "INSTANCE_WORLD2", offsetof(InstanceData, world[2]), sizeof(InstanceData::world[2]) },
+    { "INSTANCE_TINT",   offsetof(InstanceData, tint),     sizeof(InstanceData::tint) },
+};
+constexpr MirrorField kPerViewFields[] = {
+    { "viewProjMatrix", offsetof(PerViewCB, viewProjMatrix), sizeof(PerViewCB::viewProjMatrix) },
+};
+constexpr MirrorField kPerFrameFields[] = {
+    { "time",      offsetof(PerFrameCB, time),      sizeof(PerFrameCB::time) },
+    { "deltaTime", offsetof(PerFrameCB, deltaTime), sizeof(PerFrameCB::deltaTime) },
+};
+
+constexpr uint32_t kFloat2 = 16; // DXGI_FORMAT_R32G32_FLOAT
+constexpr uint32_t kFloat3 = 6;  // DXGI_FORMAT_R32G32B32_FLOAT
+constexpr uint32_t kFloat4 = 2;  // DXGI_FORMAT_R32G32B32A32_FLOAT
+
+uint32_t GetU32(std::span<const std::byte> bytes, size_t offset) {
+    uint32_t value = 0;
+    std::memcpy(&value, bytes.data() + offset, 4);
+    return value;
+}
+
+void SetU32(std::span<std::byte> bytes, size_t offset, uint32_t value) {
+    std::memcpy(bytes.data() + offset, &value, 4);
+}
+
+// Offset of the payload of the first chunk `fourcc`; 0 when there is none.
+size_t FindChunk(std::span<const std::byte> container, const char (&fourcc)[5]) {
+    const uint32_t count = GetU32(container, 28);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t offset = GetU32(container, 32 + size_t{ i } * 4);
+        if (std::memcmp(container.data() + offset, fourcc, 4) == 0) return offset + 8;
+    }
+    return 0;
+}
+
+// Every view the reflection hands out points into `container`.
+bool ViewsInside(const ShaderReflection& r, std::span<const std::byte> container) {
+    const auto* begin  = reinterpret_cast<const char*>(container.data());
+    const auto* end    = begin + container.size();
+    const auto  inside = [&](std::string_view s) {
+        return s.empty() || (s.data() >= begin && s.data() + s.size() < end);
+    };
+    for (const SignatureElement& e : r.Inputs())  if (!inside(e.semanticName)) return false;
+    for (const SignatureElement& e : r.Outputs()) if (!inside(e.semanticName)) return false;
+    for (const ShaderResourceBinding& b : r.Resources()) if (!inside(b.name)) return false;
+    for (const ShaderConstantBuffer& cb : r.ConstantBuffers()) {
+        if (!inside(cb.name)) return false;
+        for (const ShaderVariable& v : cb.variables) if (!inside(v.name)) return false;
+    }
+    return true;
+}
+
+bool IsEmpty(const ShaderReflection& r) {
+    return r.Stage() == ShaderStage::Unknown && r.Inputs().empty() && r.Outputs().empty() &&
+           r.ConstantBuffers().empty() && r.Resources().empty();
+}
+
+} // namespace
+
+void RunShaderReflectionTests(TestRunner& runner) {
+    const std::vector<std::byte> vs = ReadTestData("vertex.cso");
+    const std::vector<std::byte> ps = ReadTestData("pixel.cso");
+
+    runner.Run("shader_reflection/parse_vertex", [&] {
+        ShaderReflection r;
+        if (!CHECK(r.Parse(vs))) return;
+        CHECK(r.Stage() == ShaderStage::Vertex);
+        CHECK(r.ShaderModelMajor() == 5 && r.ShaderModelMinor() == 0);
+
+        if (CHECK(r.Inputs().size() == 7)) {
+            CHECK(r.Inputs()[0].semanticName == "POSITION" && r.Inputs()[0].mask == 0x7);
+            CHECK(r.Inputs()[4].semanticName == "INSTANCE_WORLD" && r.Inputs()[4].semanticIndex == 1);
+            CHECK(r.Inputs()[6].reg == 6 && r.Inputs()[6].componentType == SignatureComponent::Float32);
+        }
+        if (CHECK(r.Outputs().size() == 3)) {
+            CHECK(r.Outputs()[0].semanticName == "SV_Position" && r.Outputs()[0].systemValue == 1);
+        }
+
+        const ShaderConstantBuffer* perView = r.FindConstantBuffer("PerView");
+        if (!CHECK(perView != nullptr)) return;
+        CHECK(perView->size == 64 && perView->bindPoint == 0);
+        if (CHECK(perView->variables.size() == 1)) {
+            const ShaderVariable& v = perView->variables[0];
+            CHECK(v.name == "viewProjMatrix" && v.offset == 0 && v.size == 64 && v.used);
+        }
+        CHECK(r.FindConstantBuffer("PerFrame") == nullptr);
+        // Names are NUL-terminated in place, ready for D3D.
+        CHECK(perView->name.data()[perView->name.size()] == '\0');
+    });
+
+    runner.Run("shader_reflection/parse_pixel", [&] {
+        ShaderReflection r;
+        if (!CHECK(r.Parse(ps))) return;
+        CHECK(r.Stage() == ShaderStage::Pixel);
+        CHECK(r.Inputs().size() == 3);
+        if (CHECK(r.Outputs().size() == 1)) {
+            CHECK(r.Outputs()[0].semanticName == "SV_Target" && r.Outputs()[0].systemValue == 64);
+        }
+
+        if (CHECK(r.Resources().size() == 3)) {
+            CHECK(r.Resources()[0].name == "gSampler" && r.Resources()[0].type == 3);
+            CHECK(r.Resources()[1].name == "gAlbedo" && r.Resources()[1].type == 2 &&
+                  r.Resources()[1].bindPoint == 0 && r.Resources()[1].bindCount == 1);
+        }
+        const ShaderConstantBuffer* perFrame = r.FindConstantBuffer("PerFrame");
+        if (!CHECK(perFrame != nullptr)) return;
+        CHECK(perFrame->size == 16 && perFrame->bindPoint == 1);
+        const ShaderVariable* time      = perFrame->FindVariable("time");
+        const ShaderVariable* deltaTime = perFrame->FindVariable("deltaTime");
+        CHECK(time != nullptr && time->used && time->offset == 0);
+        CHECK(deltaTime != nullptr && !deltaTime->used && deltaTime->offset == 4);
+        CHECK(perFrame->FindVariable("missing") == nullptr);
+    });
+
+    runner.Run("shader_reflection/live_bytes", [&] {
+        ShaderReflection r;
+        if (CHECK(r.Parse(vs))) CHECK(r.FindConstantBuffer("PerView")->LiveBytes() == 64);
+        // deltaTime is declared but never read: only `time` has to be uploaded.
+        if (CHECK(r.Parse(ps))) CHECK(r.FindConstantBuffer("PerFrame")->LiveBytes() == 4);
+
+        ShaderConstantBuffer cb;
+        cb.size = 48;
+        CHECK(cb.LiveBytes() == 0);
+        cb.variables = { { "a", 0, 16, false }, { "b", 16, 12, true }, { "c", 32, 16, false } };
+        CHECK(cb.LiveBytes() == 28);
+        cb.variables[2].used = true;
+        CHECK(cb.LiveBytes() == 48);
+    });
+
+    runner.Run("shader_reflection/build_input_layout", [&] {
+        ShaderReflection r;
+        if (!CHECK(r.Parse(vs))) return;
+
+        std::vector<PipelineInputElement> layout;
+        if (!CHECK(r.BuildInputLayout(layout, 0, "INSTANCE_", 1))) return;
+        if (!CHECK(layout.size() == 7)) return;
+
+        struct Expected { std::string_view name; uint32_t index, format, slot, offset; };
+        constexpr Expected kExpected[] = {
+            { "POSITION",       0, kFloat3, 0, 0 },
+            { "COLOR",          0, kFloat4, 0, 12 },
+            { "TEXCOORD",       0, kFloat2, 0, 28 },
+            { "INSTANCE_WORLD", 0, kFloat4, 1, 0 },
+            { "INSTANCE_WORLD", 1, kFloat4, 1, 16 },
+            { "INSTANCE_WORLD", 2, kFloat4, 1, 32 },
+            { "INSTANCE_TINT",  0, kFloat4, 1, 48 },
+        };
+        for (size_t i = 0; i < layout.size(); ++i) {
+            const PipelineInputElement& e = layout[i];
+            const Expected&             x = kExpected[i];
+            CHECK(e.semanticName == x.name && e.semanticIndex == x.index);
+            CHECK(e.format == x.format && e.inputSlot == x.slot && e.alignedByteOffset == x.offset);
+            CHECK(e.inputSlotClass == x.slot && e.instanceDataStepRate == x.slot);
+        }
+
+        // Without a prefix everything is one per-vertex stream.
+        if (CHECK(r.BuildInputLayout(layout, 2)) && CHECK(layout.size() == 7)) {
+            CHECK(layout[6].inputSlot == 2 && layout[6].inputSlotClass == 0);
+            CHECK(layout[6].alignedByteOffset == 36 + 48);
+        }
+    });
+
+    runner.Run("shader_reflection/matches_mirror", [&] {
+        ShaderReflection vsr, psr;
+        if (!CHECK(vsr.Parse(vs)) || !CHECK(psr.Parse(ps))) return;
+
+        std::vector<PipelineInputElement> layout;
+        if (!CHECK(vsr.BuildInputLayout(layout, 0, "INSTANCE_", 1))) return;
+        CHECK(MatchesMirror(layout, kVertexFields, sizeof(Vertex)));
+        CHECK(MatchesMirror(layout, kInstanceFields, sizeof(InstanceData), 1));
+        CHECK(!MatchesMirror(layout, kVertexFields, sizeof(Vertex), 1));           // wrong slot
+        CHECK(!MatchesMirror(layout, std::span(kVertexFields).first(2), sizeof(Vertex))); // missing field
+        CHECK(!MatchesMirror(layout, kVertexFields, sizeof(Vertex) - 4));           // stride too small
+
+        MirrorField shifted[std::size(kVertexFields)];
+        std::copy(std::begin(kVertexFields), std::end(kVertexFields), shifted);
+        shifted[1].offset += 4;
+        CHECK(!MatchesMirror(layout, shifted, sizeof(Vertex)));
+
+        const ShaderConstantBuffer& perView  = *vsr.FindConstantBuffer("PerView");
+        const ShaderConstantBuffer& perFrame = *psr.FindConstantBuffer("PerFrame");
+        CHECK(MatchesMirror(perView, kPerViewFields, sizeof(PerViewCB)));
+        CHECK(MatchesMirror(perFrame, kPerFrameFields, sizeof(PerFrameCB)));
+        CHECK(!MatchesMirror(perFrame, std::span(kPerFrameFields).first(1), sizeof(PerFrameCB)));
+        CHECK(!MatchesMirror(perFrame, kPerFrameFields, 4));  // struct ends inside deltaTime
+        CHECK(!MatchesMirror(perFrame, kPerFrameFields, 32)); // larger than the cbuffer
+        CHECK(!MatchesMirror(perView, kPerFrameFields, sizeof(PerFrameCB)));
+    });
+
+    runner.Run("shader_reflection/truncated", [&] {
+        for (const std::vector<std::byte>* bytes : { &vs, &ps }) {
+            const std::span<const std::byte> full(*bytes);
+            uint32_t                         accepted = 0;
+            for (size_t n = 0; n < full.size(); ++n) {
+                ShaderReflection r;
+                accepted += r.Parse(full.first(n));
+                CHECK(IsEmpty(r));
+            }
+            CHECK(accepted == 0);
+
+            // Trailing bytes past the declared size are ignored.
+            std::vector<std::byte> padded(*bytes);
+            padded.resize(padded.size() + 64, std::byte{ 0xCD });
+            ShaderReflection exact, r;
+            CHECK(exact.Parse(*bytes) && r.Parse(padded));
+            CHECK(r.Inputs().size() == exact.Inputs().size() && r.Stage() == exact.Stage());
+        }
+    });
+
+    runner.Run("shader_reflection/bit_flipped", [&] {
+        // Every single-bit corruption either parses or is rejected as a
+        // whole; what parses only refers to bytes of the container.
+        for (const std::vector<std::byte>* bytes : { &vs, &ps }) {
+            std::vector<std::byte> flipped(*bytes);
+            uint32_t               escaped = 0;
+            for (size_t bit = 0; bit < flipped.size() * 8; ++bit) {
+                flipped[bit / 8] ^= std::byte(1u << (bit % 8));
+                ShaderReflection r;
+                if (r.Parse(flipped) ? !ViewsInside(r, flipped) : !IsEmpty(r)) ++escaped;
+                flipped[bit / 8] ^= std::byte(1u << (bit % 8));
+            }
+            CHECK(escaped == 0);
+        }
+
+        // Corrupt offsets and sizes the parser must catch.
+        const auto rejects = [&](auto&& corrupt) {
+            std::vector<std::byte> bad(vs);
+            corrupt(std::span<std::byte>(bad));
+            ShaderReflection r;
+            return !r.Parse(bad) && IsEmpty(r);
+        };
+        const size_t rdef = FindChunk(vs, "RDEF");
+        const size_t isgn = FindChunk(vs, "ISGN");
+        if (!CHECK(rdef != 0 && isgn != 0)) return;
+
+        CHECK(rejects([&](std::span<std::byte> b) { b[0] = std::byte{ 'X' }; }));                  // magic
+        CHECK(rejects([&](std::span<std::byte> b) { SetU32(b, 24, uint32_t(b.size()) + 1); }));     // total size
+        CHECK(rejects([&](std::span<std::byte> b) { SetU32(b, 28, 0x10000); }));                    // chunk count
+        CHECK(rejects([&](std::span<std::byte> b) { SetU32(b, 32, uint32_t(b.size()) - 4); }));     // chunk offset
+        CHECK(rejects([&](std::span<std::byte> b) { SetU32(b, rdef - 4, 0x7FFFFFFF); }));           // chunk size
+        CHECK(rejects([&](std::span<std::byte> b) { SetU32(b, isgn, 0x1000); }));                   // element count
+        CHECK(rejects([&](std::span<std::byte> b) { SetU32(b, isgn + 8, 0xFFFF); }));               // name offset
+        CHECK(rejects([&](std::span<std::byte> b) {                                                 // unterminated name
+            const size_t names = isgn + GetU32(b, isgn + 8);
+            std::memset(b.data() + names, 'A', GetU32(b, isgn - 4) - (names - isgn));
+        }));
+        CHECK(rejects([&](std::span<std::byte> b) {                                                 // variable past the cbuffer
+            const size_t var = rdef + GetU32(b, rdef + GetU32(b, rdef + 4) + 8);
+            SetU32(b, var + 8, 68);
+        }));
+
+        // A rejected container does not poison the next Parse().
+        ShaderReflection r;
+        CHECK(!r.Parse(std::span(vs).first(40)));
+        CHECK(r.Parse(vs) && r.Inputs().size() == 7);
+    });
+}
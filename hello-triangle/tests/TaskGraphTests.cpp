@@ -0,0 +1,208 @@
+#include "Test.h"
+
+#include "JobSystem.h"
+#include "TaskGraph.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Worker counts every case runs with unless it needs workers: none (all
+// tasks run inside Wait()), one, and more workers than this machine may
+// have cores.
+constexpr uint32_t kWorkerCounts[] = { 0, 1, 4 };
+
+// A task that records the order it ran in.
+TaskGraph::TaskFn Recorder(std::atomic<uint32_t>& sequence, uint32_t& slot) {
+    return [&sequence, &slot] {
+        slot = sequence.fetch_add(1) + 1;
+        return true;
+    };
+}
+
+} // namespace
+
+void RunTaskGraphTests(TestRunner& runner) {
+    runner.Run("task_graph/diamond", [&] {
+        for (uint32_t workers : kWorkerCounts) {
+            JobSystem jobs;
+            if (!CHECK(jobs.Init(workers))) continue;
+
+            // a -> (b, c) -> d, plus a join point after d.
+            std::atomic<uint32_t> sequence{ 0 };
+            uint32_t              order[4] = {};
+            TaskGraph             graph;
+            const uint32_t a    = graph.Add("a", Recorder(sequence, order[0]));
+            const uint32_t b    = graph.Add("b", Recorder(sequence, order[1]), { a });
+            const uint32_t c    = graph.Add("c", Recorder(sequence, order[2]), { a, a }); // duplicates count once
+            const uint32_t d    = graph.Add("d", Recorder(sequence, order[3]), { b, c });
+            const uint32_t join = graph.Add("join", {}, { d });
+            if (!CHECK(graph.TaskCount() == 5)) continue;
+
+            graph.Start(jobs);
+            CHECK(graph.WaitAll() && graph.AllDone() && graph.Succeeded(join));
+            CHECK(order[0] == 1 && order[1] > order[0] && order[2] > order[0]);
+            CHECK(order[3] == 4 && sequence.load() == 4);
+
+            // The sink and the root are on every path, so on the critical one.
+            const std::vector<TaskTiming> timings = graph.Timings();
+            if (!CHECK(timings.size() == 5)) continue;
+            CHECK(timings[a].critical && timings[d].critical && timings[join].critical);
+            CHECK(timings[d].start >= timings[b].end && timings[d].start >= timings[c].end);
+            CHECK(!graph.FormatReport("diamond").empty());
+        }
+    });
+
+    runner.Run("task_graph/failure_skips_dependants", [&] {
+        for (uint32_t workers : kWorkerCounts) {
+            JobSystem jobs;
+            if (!CHECK(jobs.Init(workers))) continue;
+
+            std::atomic<int>  ran{ 0 };
+            std::atomic<bool> skippedRan{ false };
+            const auto        ok = [&ran] {
+                ran.fetch_add(1);
+                return true;
+            };
+
+            // root -> fails -> skipped -> joined
+            //      -> sibling ------------^
+            //                 -> other
+            TaskGraph      graph;
+            const uint32_t root    = graph.Add("root", ok);
+            const uint32_t fails   = graph.Add("fails", [&ran] { ran.fetch_add(1); return false; }, { root });
+            const uint32_t skipped = graph.Add("skipped", [&skippedRan] { return skippedRan = true; }, { fails });
+            const uint32_t sibling = graph.Add("sibling", ok, { root });
+            const uint32_t joined  = graph.Add("joined", {}, { skipped, sibling });
+            const uint32_t other   = graph.Add("other", ok, { sibling });
+
+            graph.Start(jobs);
+            CHECK(!graph.WaitAll() && graph.AllDone());
+            CHECK(graph.Succeeded(root) && graph.Succeeded(sibling) && graph.Succeeded(other));
+            CHECK(!graph.Succeeded(fails) && !graph.Succeeded(skipped) && !graph.Succeeded(joined));
+            CHECK(graph.IsDone(skipped) && graph.IsDone(joined));
+            CHECK(ran.load() == 4 && !skippedRan.load());
+            CHECK(graph.Wait(sibling) && !graph.Wait(joined)); // settled: no re-run
+
+            const std::vector<TaskTiming> timings = graph.Timings();
+            CHECK(timings.size() == 6 && timings[root].succeeded && !timings[skipped].succeeded);
+        }
+    });
+
+    runner.Run("task_graph/wait_returns_early", [&] {
+        using namespace std::chrono_literals;
+        for (uint32_t workers : { 1u, 4u }) {
+            JobSystem jobs;
+            if (!CHECK(jobs.Init(workers))) continue;
+
+            // The slow task is queued first, so a worker takes it; it is held
+            // until the waited-for chain is done (bounded, so a failure here
+            // cannot hang the suite).
+            std::atomic<bool> release{ false };
+            TaskGraph         graph;
+            const uint32_t slow = graph.Add("slow", [&release] {
+                const auto deadline = std::chrono::steady_clock::now() + 5s;
+                while (!release.load() && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+                return release.load();
+            });
+            const uint32_t first  = graph.Add("first", [] { return true; });
+            const uint32_t second = graph.Add("second", [] { return true; }, { first });
+
+            graph.Start(jobs);
+            CHECK(graph.Wait(second) && graph.IsDone(first));
+            CHECK(!graph.IsDone(slow) && !graph.AllDone());
+            CHECK(graph.Timings().empty()); // only once everything is done
+
+            release.store(true);
+            CHECK(graph.WaitAll() && graph.Succeeded(slow));
+        }
+    });
+
+    runner.Run("task_graph/main_affinity", [&] {
+        const std::thread::id self = std::this_thread::get_id();
+        for (uint32_t workers : kWorkerCounts) {
+            JobSystem jobs;
+            if (!CHECK(jobs.Init(workers))) continue;
+
+            std::atomic<int> offThread{ 0 };
+            const auto       onMain = [&] {
+                if (std::this_thread::get_id() != self) offThread.fetch_add(1);
+                return true;
+            };
+
+            // any -> main -> any -> main, and a Main root nobody waits for.
+            TaskGraph      graph;
+            const uint32_t loose = graph.Add("loose", onMain, {}, TaskAffinity::Main);
+            const uint32_t load  = graph.Add("load", [] { return true; });
+            const uint32_t swap  = graph.Add("swap", onMain, { load }, TaskAffinity::Main);
+            const uint32_t build = graph.Add("build", [] { return true; }, { swap });
+            const uint32_t show  = graph.Add("show", onMain, { build }, TaskAffinity::Main);
+
+            // Main tasks only run inside Wait() (for the waited task) and Poll().
+            graph.Start(jobs);
+            CHECK(graph.Wait(show) && graph.IsDone(swap));
+            CHECK(!graph.IsDone(loose));
+            for (int i = 0; i < 1000 && !graph.IsDone(loose); ++i) graph.Poll();
+            CHECK(graph.Succeeded(loose) && graph.WaitAll());
+            CHECK(offThread.load() == 0);
+        }
+    });
+
+    runner.Run("task_graph/poll_without_workers", [&] {
+        JobSystem jobs;
+        if (!CHECK(jobs.Init(0))) return;
+
+        const std::thread::id self = std::this_thread::get_id();
+        std::atomic<int>      count{ 0 }, offThread{ 0 };
+        const auto            task = [&] {
+            count.fetch_add(1);
+            if (std::this_thread::get_id() != self) offThread.fetch_add(1);
+            return true;
+        };
+
+        TaskGraph      graph;
+        const uint32_t a = graph.Add("a", task);
+        const uint32_t b = graph.Add("b", task, { a }, TaskAffinity::Main);
+        const uint32_t c = graph.Add("c", task, { a });
+        graph.Add("d", task, { b, c });
+
+        // Nothing runs until the frame loop polls.
+        graph.Start(jobs);
+        CHECK(!graph.IsDone(a) && count.load() == 0);
+
+        int polls = 0;
+        for (; polls < 100 && !graph.AllDone(); ++polls) graph.Poll();
+        CHECK(graph.AllDone() && graph.WaitAll());
+        CHECK(count.load() == 4 && offThread.load() == 0);
+        CHECK(polls >= 3); // one queued job per Poll(), Main tasks as they get ready
+    });
+
+    runner.Run("task_graph/invalid_adds", [&] {
+        TaskGraph      graph;
+        const uint32_t a = graph.Add("a", [] { return true; });
+        CHECK(a == 0);
+
+        // Unknown dependencies: this task's own index and beyond.
+        CHECK(graph.Add("self", [] { return true; }, { 1 }) == TaskGraph::kInvalid);
+        CHECK(graph.Add("later", [] { return true; }, { a, 7 }) == TaskGraph::kInvalid);
+        CHECK(graph.Add("none", [] { return true; }, { TaskGraph::kInvalid }) == TaskGraph::kInvalid);
+        CHECK(graph.TaskCount() == 1);
+
+        // Not started yet: nothing to wait for.
+        CHECK(!graph.Wait(a) && !graph.AllDone() && graph.Timings().empty());
+
+        JobSystem jobs;
+        if (!CHECK(jobs.Init(1))) return;
+        graph.Start(jobs);
+        CHECK(graph.Add("after", [] { return true; }) == TaskGraph::kInvalid);
+        CHECK(graph.TaskCount() == 1 && graph.WaitAll());
+        CHECK(!graph.Wait(5) && !graph.IsDone(5) && !graph.Succeeded(5));
+
+        // Reset() makes the graph buildable again.
+        graph.Reset();
+        CHECK(graph.TaskCount() == 0 && graph.Add("again", [] { return true; }) == 0);
+    });
+}
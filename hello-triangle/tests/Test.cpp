@@ -0,0 +1,54 @@
+#include "Test.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+std::atomic<uint32_t> gCaseFailures{ 0 };
+
+} // namespace
+
+bool TestCheck(bool ok, const char* expr, const char* file, int line) {
+    if (!ok) {
+        gCaseFailures.fetch_add(1, std::memory_order_relaxed);
+        std::printf("    %s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+    return ok;
+}
+
+std::vector<std::byte> ReadTestData(std::string_view name) {
+    const std::string path = std::string(HELLO_TRIANGLE_TEST_DATA_DIR) + "/" + std::string(name);
+    std::ifstream     file(path, std::ios::binary);
+    if (!file) {
+        std::printf("    cannot read %s\n", path.c_str());
+        return {};
+    }
+    const std::vector<char> text{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    std::vector<std::byte>  bytes(text.size());
+    for (size_t i = 0; i < text.size(); ++i) bytes[i] = static_cast<std::byte>(text[i]);
+    return bytes;
+}
+
+void TestRunner::Begin() {
+    gCaseFailures.store(0, std::memory_order_relaxed);
+}
+
+void TestRunner::End(std::string_view name) {
+    const uint32_t failures = gCaseFailures.load(std::memory_order_relaxed);
+    std::printf("%-56s %s\n", std::string(name).c_str(), failures == 0 ? "ok" : "FAILED");
+    std::fflush(stdout);
+    if (failures == 0) ++mPassed;
+    else               ++mFailed;
+}
+
+int TestRunner::Finish() const {
+    std::printf("\n%u passed, %u failed\n", mPassed, mFailed);
+    if (mPassed + mFailed == 0) {
+        std::printf("no test matches '%s'\n", mFilter.c_str());
+        return 1;
+    }
+    return mFailed == 0 ? 0 : 1;
+}
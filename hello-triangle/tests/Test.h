@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Minimal unit-test harness, the counterpart of bench/Bench.h.
+//
+// Run() calls one test case; CHECK() inside it records a failure (with the
+// expression and location) and lets the case continue, so one run reports
+// every broken check. CHECK() returns the condition, for cases that cannot
+// go on after a failed precondition:
+//   if (!CHECK(reflection.Parse(bytes))) return;
+// Checks may come from any thread. Names are "suite/case" and matched
+// against an optional substring filter; ctest runs one suite per test.
+// ---------------------------------------------------------------------------
+class TestRunner {
+public:
+    explicit TestRunner(std::string filter) : mFilter(std::move(filter)) {}
+
+    [[nodiscard]] bool Enabled(std::string_view name) const {
+        return mFilter.empty() || name.find(mFilter) != std::string_view::npos;
+    }
+
+    template <class Fn>
+    void Run(std::string_view name, Fn&& body) {
+        if (!Enabled(name)) return;
+        Begin();
+        body();
+        End(name);
+    }
+
+    // Prints the summary. 0 when every case passed and at least one ran (a
+    // filter that matches nothing is a typo, not a pass).
+    [[nodiscard]] int Finish() const;
+
+private:
+    void Begin();
+    void End(std::string_view name);
+
+    std::string mFilter;
+    uint32_t    mPassed = 0;
+    uint32_t    mFailed = 0;
+};
+
+bool TestCheck(bool ok, const char* expr, const char* file, int line);
+
+#define CHECK(expr) TestCheck(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+// Contents of a file in tests/data; empty when it cannot be read.
+[[nodiscard]] std::vector<std::byte> ReadTestData(std::string_view name);
+
+// --- Suites (one translation unit each) ---
+void RunShaderReflectionTests(TestRunner& runner);
+void RunVertexFormatTests(TestRunner& runner);
+void RunResourceStateTrackerTests(TestRunner& runner);
+void RunFramePacerTests(TestRunner& runner);
+void RunUploadRingTests(TestRunner& runner);
+void RunJobSystemTests(TestRunner& runner);
+void RunUploadSchedulerTests(TestRunner& runner);
+void RunDescriptorAllocatorTests(TestRunner& runner);
+void RunPipelineCacheTests(TestRunner& runner);
+void RunShaderArchiveTests(TestRunner& runner);
+void RunBlockCompressorTests(TestRunner& runner);
+void RunTextureFileTests(TestRunner& runner);
+void RunTextureStreamerTests(TestRunner& runner);
+void RunTlsfAllocatorTests(TestRunner& runner);
+void RunSoftwareRendererTests(TestRunner& runner);
+void RunRenderGraphTests(TestRunner& runner);
+void RunMeshPackTests(TestRunner& runner);
+void RunTaskGraphTests(TestRunner& runner);
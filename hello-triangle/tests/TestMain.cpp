@@ -0,0 +1,33 @@
+#include "Test.h"
+
+#include <cstdio>
+
+// Usage: hello-triangle-tests [name-filter]
+// Exits with 1 when a check failed or nothing matched the filter.
+int main(int argc, char** argv) {
+    if (argc > 2) {
+        std::fprintf(stderr, "usage: hello-triangle-tests [name-filter]\n");
+        return 2;
+    }
+    TestRunner runner(argc == 2 ? argv[1] : "");
+
+    RunShaderReflectionTests(runner);
+    RunVertexFormatTests(runner);
+    RunResourceStateTrackerTests(runner);
+    RunFramePacerTests(runner);
+    RunUploadRingTests(runner);
+    RunJobSystemTests(runner);
+    RunUploadSchedulerTests(runner);
+    RunDescriptorAllocatorTests(runner);
+    RunPipelineCacheTests(runner);
+    RunShaderArchiveTests(runner);
+    RunBlockCompressorTests(runner);
+    RunTextureFileTests(runner);
+    RunTextureStreamerTests(runner);
+    RunTlsfAllocatorTests(runner);
+    RunSoftwareRendererTests(runner);
+    RunRenderGraphTests(runner);
+    RunMeshPackTests(runner);
+    RunTaskGraphTests(runner);
+    return runner.Finish();
+}
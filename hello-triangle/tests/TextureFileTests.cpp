@@ -0,0 +1,169 @@
+#include "Test.h"
+
+#include "TextureFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRgba8 = 28; // DXGI_FORMAT_R8G8B8A8_UNORM
+constexpr uint32_t kBc1   = 71;
+constexpr uint32_t kBc3   = 77;
+constexpr uint32_t kBc7   = 98;
+
+std::vector<std::byte> FakeTexels(size_t size, uint32_t seed) {
+    std::vector<std::byte> bytes(size);
+    uint32_t               state = seed * 2654435761u + 1;
+    for (std::byte& b : bytes) {
+        state = state * 1664525u + 1013904223u;
+        b     = static_cast<std::byte>(state >> 24);
+    }
+    return bytes;
+}
+
+TextureDesc Desc(uint32_t format, uint32_t width, uint32_t height, uint32_t mipCount, uint32_t arraySize = 1,
+                 bool cube = false) {
+    TextureDesc d;
+    d.format    = format;
+    d.width     = width;
+    d.height    = height;
+    d.mipCount  = mipCount;
+    d.arraySize = arraySize;
+    d.cube      = cube;
+    return d;
+}
+
+// Uncompressed with every mip down to 1x1, block sizes that are not
+// multiples of 4, a cube map and an array.
+const TextureDesc kDescs[] = {
+    Desc(kRgba8, 64, 32, 7),
+    Desc(kBc1, 30, 18, 5),
+    Desc(kBc7, 16, 16, 5, 6, true),
+    Desc(kBc3, 8, 12, 2, 3),
+};
+
+// `file` describes `desc`, and its subresources are `data` cut in D3D order.
+bool Matches(const TextureFile& file, const TextureDesc& desc, const std::vector<std::byte>& data) {
+    DxgiBlockInfo info;
+    if (!GetDxgiBlockInfo(desc.format, info)) return false;
+    bool ok = CHECK(file.Format() == desc.format && file.Width() == desc.width && file.Height() == desc.height);
+    ok      = CHECK(file.MipCount() == desc.mipCount && file.ArraySize() == desc.arraySize) && ok;
+    ok      = CHECK(file.IsCube() == desc.cube && file.Subresources().size() == desc.mipCount * desc.arraySize) && ok;
+    if (!ok) return false;
+
+    size_t   offset = 0;
+    uint64_t total  = 0;
+    for (uint32_t slice = 0; slice < desc.arraySize; ++slice) {
+        for (uint32_t mip = 0; mip < desc.mipCount; ++mip) {
+            const TextureSubresource& s      = file.Subresource(mip, slice);
+            const uint32_t            width  = std::max(1u, desc.width >> mip);
+            const uint32_t            height = std::max(1u, desc.height >> mip);
+            ok = CHECK(s.width == width && s.height == height) && ok;
+            ok = CHECK(s.rowPitch == (width + info.blockSize - 1) / info.blockSize * info.blockBytes) && ok;
+            ok = CHECK(s.rowCount == (height + info.blockSize - 1) / info.blockSize) && ok;
+            ok = CHECK(s.data.size() == size_t(s.rowPitch) * s.rowCount &&
+                       std::equal(s.data.begin(), s.data.end(), data.begin() + ptrdiff_t(offset))) && ok;
+            offset += s.data.size();
+        }
+    }
+    for (uint32_t mip = 0; mip < desc.mipCount; ++mip) total += file.MipBytes(mip);
+    return CHECK(offset == data.size() && total == data.size()) && ok;
+}
+
+} // namespace
+
+void RunTextureFileTests(TestRunner& runner) {
+    runner.Run("texture_file/dds_and_ktx2_round_trip", [&] {
+        uint32_t seed = 1;
+        for (const TextureDesc& desc : kDescs) {
+            const std::vector<std::byte> data = FakeTexels(TextureDataBytes(desc), seed++);
+            const std::vector<std::byte> dds  = BuildDds(desc, data);
+            const std::vector<std::byte> ktx2 = BuildKtx2(desc, data);
+
+            TextureFile file;
+            if (CHECK(file.OpenMemory(dds))) {
+                CHECK(file.Type() == TextureFile::Container::Dds);
+                CHECK(Matches(file, desc, data));
+            }
+            if (CHECK(file.OpenMemory(ktx2))) {
+                CHECK(file.Type() == TextureFile::Container::Ktx2);
+                CHECK(Matches(file, desc, data));
+            }
+        }
+
+        // Through a mapped file.
+        const TextureDesc            desc = kDescs[1];
+        const std::vector<std::byte> data = FakeTexels(TextureDataBytes(desc), 9);
+        const std::filesystem::path  path = std::filesystem::temp_directory_path() / "hello-triangle-texture-test.dds";
+        {
+            const std::vector<std::byte> dds = BuildDds(desc, data);
+            std::FILE*                   f   = std::fopen(path.string().c_str(), "wb");
+            if (!CHECK(f != nullptr)) return;
+            CHECK(std::fwrite(dds.data(), 1, dds.size(), f) == dds.size());
+            std::fclose(f);
+        }
+        TextureFile file;
+        if (CHECK(file.Open(path))) CHECK(Matches(file, desc, data));
+        file.Close();
+        CHECK(file.Subresources().empty());
+        std::filesystem::remove(path);
+        CHECK(!file.Open(path));
+    });
+
+    runner.Run("texture_file/legacy_dds_header", [&] {
+        // BuildDds() always writes DX10; the same file with a 'DXT1' FourCC
+        // and no DX10 header is what most tools still emit.
+        const TextureDesc            desc = Desc(kBc1, 32, 32, 6);
+        const std::vector<std::byte> data = FakeTexels(TextureDataBytes(desc), 3);
+        std::vector<std::byte>       dds  = BuildDds(desc, data);
+        if (!CHECK(dds.size() == 148 + data.size())) return;
+        std::memcpy(dds.data() + 84, "DXT1", 4);
+        dds.erase(dds.begin() + 128, dds.begin() + 148);
+
+        TextureFile file;
+        if (CHECK(file.OpenMemory(dds))) CHECK(Matches(file, desc, data));
+        std::memcpy(dds.data() + 84, "DXT9", 4);
+        CHECK(!file.OpenMemory(dds));
+    });
+
+    runner.Run("texture_file/truncated_and_bad_headers", [&] {
+        const TextureDesc            desc = kDescs[2];
+        const std::vector<std::byte> data = FakeTexels(TextureDataBytes(desc), 5);
+
+        // The last subresource ends either image: every shorter prefix is
+        // missing part of a header, the level index or the texels.
+        for (const std::vector<std::byte>& image : { BuildDds(desc, data), BuildKtx2(desc, data) }) {
+            TextureFile file;
+            if (!CHECK(!image.empty() && file.OpenMemory(image))) continue;
+            for (size_t size = 0; size < image.size(); ++size) {
+                if (!CHECK(!file.OpenMemory(std::span(image).first(size)))) break;
+            }
+            CHECK(file.Subresources().empty() && file.MipCount() == 0); // nothing half parsed
+        }
+
+        // Unknown format, data of the wrong size, a cube without 6 faces.
+        CHECK(BuildDds(Desc(12345, 4, 4, 1), data).empty());
+        CHECK(BuildKtx2(Desc(kBc1, 4, 4, 1), data).empty());
+        CHECK(BuildDds(Desc(kBc7, 16, 16, 5, 5, true), data).empty());
+        CHECK(TextureDataBytes(Desc(12345, 4, 4, 1)) == 0);
+
+        std::vector<std::byte> dds = BuildDds(desc, data);
+        TextureFile            file;
+        std::vector<std::byte> bad = dds;
+        bad[0]                     = std::byte{ 'X' };
+        CHECK(!file.OpenMemory(bad));
+        bad = dds;
+        bad[4] = std::byte{ 125 }; // header size
+        CHECK(!file.OpenMemory(bad));
+        bad = dds;
+        bad[24] = std::byte{ 2 }; // depth: volume
+        CHECK(!file.OpenMemory(bad));
+        bad = dds;
+        bad[28] = std::byte{ 6 }; // more mips than a 16x16 has
+        CHECK(!file.OpenMemory(bad));
+    });
+}
@@ -0,0 +1,178 @@
+#include "Test.h"
+
+#include "TextureFile.h"
+#include "TextureStreamer.h"
+
+#include <bit>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kBc1 = 71;
+
+// Textures of 2^n x 2^n BC1 with a full chain; texel bytes are never read.
+struct Library {
+    explicit Library(std::initializer_list<uint32_t> sizes) {
+        for (uint32_t size : sizes) {
+            TextureDesc desc;
+            desc.format   = kBc1;
+            desc.width    = size;
+            desc.height   = size;
+            desc.mipCount = std::bit_width(size);
+            images.push_back(BuildDds(desc, std::vector<std::byte>(TextureDataBytes(desc))));
+            files.push_back(std::make_unique<TextureFile>());
+            ok = files.back()->OpenMemory(images.back()) && ok;
+        }
+    }
+
+    std::vector<std::vector<std::byte>>       images;
+    std::vector<std::unique_ptr<TextureFile>> files;
+    bool                                      ok = true;
+};
+
+// Replays requests the way the renderer executes them and checks each one
+// keeps every texture's resident range contiguous: a load adds the mip just
+// above the range, an evict drops its finest mip.
+struct Residency {
+    explicit Residency(const Library& library) {
+        for (const auto& file : library.files) residentMip.push_back(file->MipCount());
+        lib = &library;
+    }
+
+    bool Apply(const std::vector<StreamRequest>& requests, size_t first = 0) {
+        bool ok = true;
+        for (size_t i = first; i < requests.size(); ++i) {
+            const StreamRequest& r   = requests[i];
+            uint32_t&            mip = residentMip[r.texture];
+            if (r.kind == StreamRequest::Kind::Load) {
+                ok = CHECK(r.mip + 1 == mip) && ok;
+                bytes += lib->files[r.texture]->MipBytes(r.mip);
+                mip = r.mip;
+            } else {
+                ok = CHECK(r.mip == mip) && ok;
+                bytes -= lib->files[r.texture]->MipBytes(r.mip);
+                mip = r.mip + 1;
+            }
+        }
+        return ok;
+    }
+
+    const Library*        lib = nullptr;
+    std::vector<uint32_t> residentMip;
+    uint64_t              bytes = 0;
+};
+
+} // namespace
+
+void RunTextureStreamerTests(TestRunner& runner) {
+    runner.Run("texture_streamer/coarsest_mip_first", [&] {
+        Library lib({ 256, 64, 1024 });
+        if (!CHECK(lib.ok)) return;
+        TextureStreamer streamer(~0ull);
+        Residency       residency(lib);
+        for (const auto& file : lib.files) CHECK(streamer.Add(*file) == streamer.TextureCount() - 1);
+
+        // The first update loads every tail (the 1x1 mip) and nothing else.
+        std::vector<StreamRequest> requests;
+        streamer.Update(~0ull, requests);
+        if (CHECK(requests.size() == 3)) CHECK(residency.Apply(requests));
+        for (uint32_t t = 0; t < 3; ++t) CHECK(streamer.ResidentMip(t) == lib.files[t]->MipCount() - 1);
+
+        // Full resolution wanted: within each call loads go smallest first
+        // across textures, and a call stays within its byte limit unless a
+        // single mip is over it.
+        for (uint32_t t = 0; t < 3; ++t) streamer.SetWantedMip(t, 0);
+        constexpr uint64_t kLimit = 64u << 10;
+        for (int frame = 0; frame < 64; ++frame) {
+            requests.clear();
+            streamer.Update(kLimit, requests);
+            if (requests.empty()) break;
+            CHECK(residency.Apply(requests));
+
+            uint64_t frameBytes = 0, previous = 0;
+            for (const StreamRequest& r : requests) {
+                const uint64_t bytes = lib.files[r.texture]->MipBytes(r.mip);
+                CHECK(r.kind == StreamRequest::Kind::Load && bytes >= previous);
+                previous = bytes;
+                frameBytes += bytes;
+            }
+            CHECK(frameBytes <= kLimit || requests.size() == 1);
+            CHECK(streamer.ResidentBytes() == residency.bytes);
+        }
+        for (uint32_t t = 0; t < 3; ++t) CHECK(streamer.ResidentMip(t) == 0);
+
+        // Wanted mips are clamped to the chain.
+        streamer.SetWantedMip(1, 99);
+        CHECK(streamer.WantedMip(1) == lib.files[1]->MipCount() - 1);
+    });
+
+    runner.Run("texture_streamer/residency_within_budget", [&] {
+        Library lib({ 512, 512, 512, 512 });
+        if (!CHECK(lib.ok)) return;
+
+        // Room for two full chains and everything but mip 0 of the others.
+        uint64_t chain = 0;
+        for (uint32_t mip = 0; mip < lib.files[0]->MipCount(); ++mip) chain += lib.files[0]->MipBytes(mip);
+        const uint64_t  top = lib.files[0]->MipBytes(0);
+        TextureStreamer streamer(chain * 4 - top * 2);
+        Residency       residency(lib);
+        for (const auto& file : lib.files) (void)streamer.Add(*file);
+
+        std::vector<StreamRequest> requests;
+        const auto                 frames = [&](int count) {
+            for (int frame = 0; frame < count; ++frame) {
+                const size_t first = requests.size();
+                streamer.Update(32u << 10, requests);
+                CHECK(residency.Apply(requests, first));
+                CHECK(streamer.ResidentBytes() == residency.bytes);
+                CHECK(streamer.ResidentBytes() <= streamer.BudgetBytes());
+                for (uint32_t t = 0; t < streamer.TextureCount(); ++t)
+                    CHECK(streamer.ResidentMip(t) == residency.residentMip[t]);
+            }
+        };
+
+        // Everyone wants full resolution: loads stop at the budget, and
+        // since every resident mip is wanted nothing is evicted.
+        for (uint32_t t = 0; t < 4; ++t) streamer.SetWantedMip(t, 0);
+        frames(64);
+        for (const StreamRequest& r : requests) CHECK(r.kind == StreamRequest::Kind::Load);
+        CHECK(streamer.ResidentBytes() == streamer.BudgetBytes());
+        CHECK(streamer.ResidentMip(0) == 0 && streamer.ResidentMip(1) == 0);
+        CHECK(streamer.ResidentMip(2) == 1 && streamer.ResidentMip(3) == 1);
+
+        // Textures 0 and 1 move away: their fine mips make room for 2 and 3,
+        // evicted finest first.
+        streamer.SetWantedMip(0, 3);
+        streamer.SetWantedMip(1, 3);
+        requests.clear();
+        frames(64);
+        bool sawEvict = false;
+        for (const StreamRequest& r : requests) {
+            if (r.kind == StreamRequest::Kind::Evict) {
+                sawEvict = true;
+                CHECK(r.texture <= 1 && r.mip < 3);
+            }
+        }
+        CHECK(sawEvict);
+        CHECK(streamer.ResidentMip(2) == 0 && streamer.ResidentMip(3) == 0);
+        CHECK(streamer.ResidentMip(0) == 1 && streamer.ResidentMip(1) == 1);
+
+        // A smaller budget: only unwanted mips go, so residency stays above
+        // it until the wanted mips are lowered too.
+        streamer.SetBudget(chain);
+        requests.clear();
+        streamer.Update(32u << 10, requests);
+        CHECK(residency.Apply(requests));
+        for (const StreamRequest& r : requests) CHECK(r.kind == StreamRequest::Kind::Evict && r.texture <= 1);
+        CHECK(streamer.ResidentMip(0) == 3 && streamer.ResidentMip(1) == 3);
+        CHECK(streamer.ResidentBytes() > streamer.BudgetBytes());
+
+        for (uint32_t t = 0; t < 4; ++t) streamer.SetWantedMip(t, 2);
+        requests.clear();
+        frames(4);
+        CHECK(streamer.ResidentMip(0) == 2 && streamer.ResidentMip(1) == 2);
+        // Mip 1 of 2 and 3 is no longer wanted but still fits: it stays.
+        CHECK(streamer.ResidentMip(2) == 1 && streamer.ResidentMip(3) == 1);
+    });
+}
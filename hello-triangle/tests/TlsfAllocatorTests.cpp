@@ -0,0 +1,141 @@
+#include "Test.h"
+
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kMiB = 1ull << 20;
+
+constexpr uint64_t kAlignments[] = { kSmallTexturePlacementAlignment, kDefaultPlacementAlignment,
+                                     kMsaaPlacementAlignment };
+
+struct Live {
+    TlsfAllocation allocation;
+    uint64_t       alignment;
+};
+
+// Every live range is aligned, inside the heap and disjoint from the others.
+bool Disjoint(std::vector<Live> live, uint64_t capacity) {
+    std::sort(live.begin(), live.end(),
+              [](const Live& a, const Live& b) { return a.allocation.offset < b.allocation.offset; });
+    bool     ok  = true;
+    uint64_t end = 0;
+    for (const Live& l : live) {
+        const TlsfAllocation& a = l.allocation;
+        ok  = CHECK(a.offset % l.alignment == 0 && a.offset >= end && a.offset + a.size <= capacity) && ok;
+        end = a.offset + a.size;
+    }
+    return ok;
+}
+
+} // namespace
+
+void RunTlsfAllocatorTests(TestRunner& runner) {
+    runner.Run("tlsf_allocator/exact_capacity_aligned", [&] {
+        // A request that fills the whole heap fits at offset 0 whatever its
+        // alignment: what a dedicated or freshly added heap block relies on.
+        for (const uint64_t capacity : { 1 * kMiB, 3 * kMiB, 64 * kMiB, 100 * kMiB, kMiB + 12 * 1024 }) {
+            for (const uint64_t alignment : kAlignments) {
+                TlsfAllocator  tlsf;
+                TlsfAllocation a;
+                if (!CHECK(tlsf.Init(capacity))) continue;
+                if (!CHECK(tlsf.Allocate(capacity, alignment, a))) continue;
+                CHECK(a.offset == 0 && tlsf.FreeBytes() == 0 && tlsf.Validate());
+
+                TlsfAllocation none;
+                CHECK(!tlsf.Allocate(4096, kSmallTexturePlacementAlignment, none));
+                tlsf.Free(a);
+                CHECK(tlsf.LargestFreeBlock() == capacity && tlsf.Validate());
+            }
+        }
+
+        // The rest of a heap after a small block, at an aligned start.
+        TlsfAllocator  tlsf;
+        TlsfAllocation small, rest, none;
+        if (!CHECK(tlsf.Init(16 * kMiB))) return;
+        CHECK(tlsf.Allocate(4096, kSmallTexturePlacementAlignment, small));
+        CHECK(tlsf.Allocate(16 * kMiB - kDefaultPlacementAlignment, kDefaultPlacementAlignment, rest));
+        CHECK(rest.offset == kDefaultPlacementAlignment);
+        CHECK(!tlsf.Allocate(64 * 1024, kDefaultPlacementAlignment, none)); // only the padding is left
+        CHECK(tlsf.Allocate(60 * 1024, kSmallTexturePlacementAlignment, none) && none.offset == 4096);
+        CHECK(tlsf.FreeBytes() == 0 && tlsf.Validate());
+
+        // Too large, zero and bad alignments.
+        CHECK(!tlsf.Allocate(0, 4096, none) && !tlsf.Allocate(4096, 3 * 4096, none));
+        TlsfAllocator other;
+        CHECK(other.Init(kMiB) && !other.Allocate(kMiB + 1, 4096, none));
+    });
+
+    runner.Run("tlsf_allocator/free_coalesces", [&] {
+        TlsfAllocator tlsf;
+        if (!CHECK(tlsf.Init(kMiB))) return;
+
+        TlsfAllocation a, b, c, d;
+        CHECK(tlsf.Allocate(256 * 1024, 4096, a) && tlsf.Allocate(256 * 1024, 4096, b));
+        CHECK(tlsf.Allocate(256 * 1024, 4096, c) && tlsf.Allocate(256 * 1024, 4096, d));
+        CHECK(a.offset == 0 && b.offset == 256 * 1024 && c.offset == 512 * 1024 && d.offset == 768 * 1024);
+
+        // Freed apart: two holes. Freeing the block between them (and then
+        // the last one) merges everything back into one block.
+        tlsf.Free(a);
+        tlsf.Free(c);
+        CHECK(tlsf.LargestFreeBlock() == 256 * 1024 && tlsf.Fragmentation() == 0.5 && tlsf.Validate());
+        tlsf.Free(b);
+        CHECK(tlsf.LargestFreeBlock() == 768 * 1024 && tlsf.Validate());
+        TlsfAllocation big;
+        CHECK(tlsf.Allocate(768 * 1024, kDefaultPlacementAlignment, big) && big.offset == 0);
+        tlsf.Free(big);
+        tlsf.Free(d);
+        CHECK(tlsf.LargestFreeBlock() == kMiB && tlsf.AllocationCount() == 0 && tlsf.UsedBytes() == 0);
+
+        // A second Free() of the same range is ignored.
+        tlsf.Free(d);
+        CHECK(tlsf.Validate() && tlsf.FreeBytes() == kMiB);
+    });
+
+    runner.Run("tlsf_allocator/random_sequences", [&] {
+        constexpr uint64_t kCapacity = 64 * kMiB;
+        uint64_t           state     = 0x9E3779B97F4A7C15ull;
+        const auto         next      = [&state] {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+
+        for (int round = 0; round < 4; ++round) {
+            TlsfAllocator tlsf;
+            if (!CHECK(tlsf.Init(kCapacity))) return;
+            std::vector<Live> live;
+            uint64_t          failures = 0;
+
+            for (int step = 0; step < 4000; ++step) {
+                if (!live.empty() && next() % 100 < 45) {
+                    const size_t victim = next() % live.size();
+                    tlsf.Free(live[victim].allocation);
+                    live[victim] = live.back();
+                    live.pop_back();
+                } else {
+                    const uint64_t r         = next();
+                    const uint64_t alignment = kAlignments[r % 16 == 0 ? 2 : r % 3 == 0 ? 0 : 1];
+                    const uint64_t size      = 1 + (r >> 8) % (r % 16 == 0 ? 8 * kMiB : 512 * 1024);
+                    Live           l         = { {}, alignment };
+                    if (tlsf.Allocate(size, alignment, l.allocation)) live.push_back(l);
+                    else ++failures;
+                }
+                if (step % 200 == 0 && !(CHECK(tlsf.Validate()) && Disjoint(live, kCapacity))) return;
+            }
+            CHECK(tlsf.Validate() && Disjoint(live, kCapacity));
+            CHECK(tlsf.AllocationCount() == live.size());
+            CHECK(failures < 4000); // the heap is not simply always full
+
+            // Freeing the survivors coalesces back into the whole heap.
+            for (const Live& l : live) tlsf.Free(l.allocation);
+            CHECK(tlsf.Validate() && tlsf.UsedBytes() == 0);
+            CHECK(tlsf.LargestFreeBlock() == kCapacity && tlsf.Fragmentation() == 0.0);
+        }
+    });
+}
@@ -0,0 +1,157 @@
+#include "Test.h"
+
+#include "UploadRing.h"
+
+#include <cstddef>
+
+namespace {
+
+constexpr uint64_t kCapacity = 4096;
+constexpr uint64_t kGpuBase  = 0x7F0000010000ull; // buffers are 64 KB aligned
+
+// Stands in for the persistently mapped upload heap (which is page aligned).
+struct alignas(4096) RingMemory {
+    std::byte bytes[kCapacity];
+};
+
+uint64_t CpuOffset(const RingMemory& memory, const UploadAllocation& a) {
+    return static_cast<uint64_t>(static_cast<const std::byte*>(a.cpu) - memory.bytes);
+}
+
+} // namespace
+
+void RunUploadRingTests(TestRunner& runner) {
+    runner.Run("upload_ring/constant_buffer_alignment", [&] {
+        RingMemory memory;
+        UploadRing ring;
+        if (!CHECK(ring.Init(memory.bytes, kGpuBase, kCapacity))) return;
+
+        uint64_t end = 0;
+        for (uint64_t size : { 1u, 64u, 255u, 256u, 257u, 100u }) {
+            UploadAllocation a;
+            if (!CHECK(ring.Allocate(size, a))) break;
+            CHECK(reinterpret_cast<uintptr_t>(a.cpu) % UploadRing::kConstantBufferAlignment == 0);
+            CHECK(a.gpu % UploadRing::kConstantBufferAlignment == 0);
+            CHECK(CpuOffset(memory, a) == a.offset && a.gpu - kGpuBase == a.offset);
+            CHECK(a.offset >= end && a.size == size); // no overlap with the previous one
+            end = a.offset + a.size;
+        }
+
+        // Smaller power-of-two alignments pack tighter; others are rejected.
+        UploadAllocation a, b;
+        CHECK(ring.Allocate(4, a, 16) && ring.Allocate(4, b, 16));
+        CHECK(a.offset % 16 == 0 && b.offset == a.offset + 16);
+        CHECK(!ring.Allocate(4, a, 24));
+        CHECK(!ring.Allocate(0, a));
+        CHECK(ring.FailedAllocations() == 0); // bad arguments are not "ring full"
+    });
+
+    runner.Run("upload_ring/wrap_around", [&] {
+        RingMemory memory;
+        UploadRing ring;
+        if (!CHECK(ring.Init(memory.bytes, kGpuBase, kCapacity))) return;
+
+        UploadAllocation a;
+        CHECK(ring.Allocate(3072, a) && a.offset == 0);
+        ring.EndFrame(1);
+        ring.Retire(1);
+        CHECK(ring.BytesInFlight() == 0);
+
+        // 1024 bytes left before the end: a 1536-byte allocation skips them
+        // and restarts at 0, and the skipped bytes count as in flight.
+        CHECK(ring.Allocate(1536, a) && a.offset == 0);
+        CHECK(a.cpu == memory.bytes && a.gpu == kGpuBase);
+        CHECK(ring.BytesInFlight() == 1024 + 1536);
+        CHECK(ring.FrameBytesUsed() == 1024 + 1536);
+
+        // Continues after it; a fit right up to the end does not wrap.
+        CHECK(ring.Allocate(512, a) && a.offset == 1536);
+        ring.EndFrame(2);
+        ring.Retire(2);
+        CHECK(ring.Allocate(2048, a) && a.offset == 2048);
+        CHECK(ring.Allocate(256, a) && a.offset == 0);
+    });
+
+    runner.Run("upload_ring/retire_reclaims_by_fence", [&] {
+        RingMemory memory;
+        UploadRing ring;
+        if (!CHECK(ring.Init(memory.bytes, kGpuBase, kCapacity))) return;
+
+        UploadAllocation a;
+        for (uint64_t fence = 1; fence <= 3; ++fence) {
+            CHECK(ring.Allocate(1024, a));
+            ring.EndFrame(fence);
+        }
+        CHECK(ring.BytesInFlight() == 3072);
+
+        ring.Retire(0);
+        CHECK(ring.BytesInFlight() == 3072);
+        ring.Retire(1);
+        CHECK(ring.BytesInFlight() == 2048);
+        ring.Retire(1); // idempotent
+        CHECK(ring.BytesInFlight() == 2048);
+        ring.Retire(3); // several frames at once
+        CHECK(ring.BytesInFlight() == 0);
+
+        // The open frame is not reclaimed, whatever the fence.
+        CHECK(ring.Allocate(512, a));
+        ring.Retire(~0ull);
+        CHECK(ring.BytesInFlight() == 512);
+    });
+
+    runner.Run("upload_ring/full_ring_fails", [&] {
+        RingMemory memory;
+        UploadRing ring;
+        if (!CHECK(ring.Init(memory.bytes, kGpuBase, kCapacity))) return;
+
+        UploadAllocation a;
+        for (int i = 0; i < 4; ++i) CHECK(ring.Allocate(1024, a));
+        ring.EndFrame(1);
+
+        // Full until fence 1 completes; a failure changes nothing.
+        CHECK(!ring.Allocate(1, a));
+        CHECK(!ring.Allocate(kCapacity + 1, a));
+        CHECK(ring.FailedAllocations() == 2);
+        CHECK(ring.BytesInFlight() == kCapacity && ring.FrameBytesUsed() == 0);
+
+        ring.Retire(1);
+        CHECK(ring.Allocate(kCapacity, a) && a.offset == 0);
+
+        // Wrapping must not overwrite the unretired tail either.
+        ring.EndFrame(2);
+        ring.Retire(2);
+        CHECK(ring.Allocate(3072, a));
+        ring.EndFrame(3);
+        CHECK(ring.Allocate(512, a) && a.offset == 3072);
+        CHECK(!ring.Allocate(1024, a)); // 512 left at the end, tail at 0
+        CHECK(ring.FailedAllocations() == 3);
+    });
+
+    runner.Run("upload_ring/frame_statistics", [&] {
+        RingMemory memory;
+        UploadRing ring;
+        if (!CHECK(ring.Init(memory.bytes, kGpuBase, kCapacity))) return;
+
+        UploadAllocation a;
+        CHECK(ring.Allocate(100, a) && ring.Allocate(100, a)); // 256 + 100, padding included
+        CHECK(ring.FrameBytesUsed() == 356);
+        ring.EndFrame(1);
+        CHECK(ring.LastFrameBytes() == 356 && ring.FrameBytesUsed() == 0);
+
+        CHECK(ring.Allocate(1000, a)); // 156 padding to the next 256
+        ring.EndFrame(2);
+        CHECK(ring.LastFrameBytes() == 1156 && ring.PeakFrameBytes() == 1156);
+        CHECK(ring.HighWaterMark() == 1512);
+
+        ring.Retire(2);
+        CHECK(ring.Allocate(16, a));
+        ring.EndFrame(3);
+        CHECK(ring.LastFrameBytes() == 16 + 24 && ring.PeakFrameBytes() == 1156);
+        CHECK(ring.HighWaterMark() == 1512); // a peak, not the current value
+
+        // Init() starts over.
+        CHECK(ring.Init(memory.bytes, kGpuBase, kCapacity));
+        CHECK(ring.HighWaterMark() == 0 && ring.PeakFrameBytes() == 0 && ring.BytesInFlight() == 0);
+        CHECK(!ring.Init(nullptr, kGpuBase, kCapacity) && !ring.Init(memory.bytes, kGpuBase, 0));
+    });
+}
@@ -0,0 +1,226 @@
+#include "Test.h"
+
+#include "UploadScheduler.h"
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t kStagingBytes = 64u << 10;
+constexpr uint64_t kFrameBudget  = 4u << 10;
+
+std::vector<std::byte> Pattern(size_t size, uint32_t seed) {
+    std::vector<std::byte> bytes(size);
+    uint32_t               state = seed * 2654435761u + 1;
+    for (std::byte& b : bytes) {
+        state = state * 1664525u + 1013904223u;
+        b     = static_cast<std::byte>(state >> 24);
+    }
+    return bytes;
+}
+
+uint64_t Handle(std::vector<std::byte>& destination) {
+    return reinterpret_cast<uintptr_t>(destination.data());
+}
+
+// Scheduler over a simulated copy engine `retireLag` signals behind.
+struct Fixture {
+    explicit Fixture(uint64_t retireLag = ~0ull) : staging(kStagingBytes), queue(staging.data(), retireLag) {}
+
+    [[nodiscard]] bool Init(uint64_t budget = kFrameBudget) {
+        return scheduler.Init(&queue, staging.data(), staging.size(), budget);
+    }
+
+    std::vector<std::byte> staging;
+    SimulatedCopyQueue     queue;
+    UploadScheduler        scheduler;
+};
+
+} // namespace
+
+void RunUploadSchedulerTests(TestRunner& runner) {
+    runner.Run("upload_scheduler/buffer_split_across_frames", [&] {
+        Fixture f;
+        if (!CHECK(f.Init())) return;
+
+        const std::vector<std::byte> source = Pattern(10000, 1);
+        std::vector<std::byte>       buffer(source.size());
+        const uint64_t               ticket = f.scheduler.UploadBuffer(Handle(buffer), 0, source);
+        CHECK(ticket != 0 && f.scheduler.PendingBytes() == source.size());
+
+        // 4096 + 4096 + 1808 bytes, one batch per frame; the ticket has no
+        // fence until its last byte is staged.
+        const uint64_t expected[] = { 4096, 4096, 1808 };
+        for (uint64_t bytes : expected) {
+            CHECK(f.scheduler.FenceValue(ticket) == 0);
+            CHECK(f.scheduler.Update());
+            CHECK(f.scheduler.LastFrameBytes() == bytes);
+        }
+        CHECK(f.scheduler.BatchCount() == 3 && f.queue.ExecuteCount() == 3);
+        CHECK(f.scheduler.PendingCount() == 0 && f.scheduler.PendingBytes() == 0);
+        CHECK(f.scheduler.FenceValue(ticket) == 3);
+        CHECK(!f.scheduler.IsComplete(ticket));
+
+        // Complete once the batch holding the last chunk has.
+        f.queue.CompleteUpTo(2);
+        CHECK(f.scheduler.Update() && !f.scheduler.IsComplete(ticket));
+        f.queue.CompleteUpTo(3);
+        CHECK(f.scheduler.Update() && f.scheduler.IsComplete(ticket));
+        CHECK(buffer == source);
+
+        // Nothing pending: no empty submissions.
+        CHECK(f.scheduler.Update() && f.scheduler.BatchCount() == 3);
+    });
+
+    runner.Run("upload_scheduler/contiguous_copies_merge", [&] {
+        Fixture f;
+        if (!CHECK(f.Init())) return;
+
+        const std::vector<std::byte> source = Pattern(16 * 128, 2);
+        std::vector<std::byte>       a(source.size()), b(source.size());
+
+        // 16 contiguous pieces of one buffer: one copy command.
+        for (uint32_t i = 0; i < 16; ++i)
+            CHECK(f.scheduler.UploadBuffer(Handle(a), i * 128, std::span(source).subspan(i * 128, 128)) != 0);
+        CHECK(f.scheduler.Update());
+        CHECK(f.scheduler.CopyCount() == 1 && f.scheduler.MergedCount() == 15);
+
+        // A gap in the destination, another destination, or a texture in
+        // between each start a new command.
+        const std::vector<std::byte> texels = Pattern(64, 3);
+        std::vector<std::byte>       texture(texels.size());
+        CHECK(f.scheduler.UploadBuffer(Handle(b), 0, std::span(source).first(128)) != 0);
+        CHECK(f.scheduler.UploadBuffer(Handle(b), 256, std::span(source).subspan(256, 128)) != 0);
+        CHECK(f.scheduler.UploadBuffer(Handle(a), 0, std::span(source).first(128)) != 0);
+        CHECK(f.scheduler.UploadTexture(Handle(texture), 0, texels, 16, 4) != 0);
+        CHECK(f.scheduler.UploadBuffer(Handle(a), 128, std::span(source).subspan(128, 128)) != 0);
+        CHECK(f.scheduler.Update());
+        CHECK(f.scheduler.CopyCount() == 1 + 5 && f.scheduler.MergedCount() == 15);
+        CHECK(f.queue.CopyCount() == f.scheduler.CopyCount());
+
+        CHECK(f.scheduler.Finish());
+        CHECK(a == source && texture == texels);
+        CHECK(std::memcmp(b.data() + 256, source.data() + 256, 128) == 0);
+    });
+
+    runner.Run("upload_scheduler/large_texture_goes_alone", [&] {
+        Fixture f;
+        if (!CHECK(f.Init())) return;
+
+        // 64 rows of 128 bytes at a 256-byte pitch: 16256 staged bytes,
+        // four times the budget.
+        const std::vector<std::byte> texels = Pattern(64 * 128, 4);
+        const std::vector<std::byte> small  = Pattern(1000, 5);
+        std::vector<std::byte>       texture(texels.size()), before(small.size()), after(small.size());
+
+        const uint64_t t0 = f.scheduler.UploadBuffer(Handle(before), 0, small);
+        const uint64_t t1 = f.scheduler.UploadTexture(Handle(texture), 2, texels, 128, 64);
+        const uint64_t t2 = f.scheduler.UploadBuffer(Handle(after), 0, small);
+        if (!CHECK(t0 != 0 && t1 != 0 && t2 != 0)) return;
+
+        // Frame 1: the buffer; the texture does not fit what is left.
+        CHECK(f.scheduler.Update() && f.queue.CopyCount() == 1);
+        CHECK(f.scheduler.FenceValue(t0) == 1 && f.scheduler.FenceValue(t1) == 0);
+        // Frame 2: the texture, alone, over budget.
+        CHECK(f.scheduler.Update() && f.queue.CopyCount() == 2);
+        CHECK(f.scheduler.FenceValue(t1) == 2 && f.scheduler.FenceValue(t2) == 0);
+        CHECK(f.scheduler.LastFrameBytes() == kFrameBudget);
+        // Frame 3: what was queued after it.
+        CHECK(f.scheduler.Update() && f.queue.CopyCount() == 3 && f.scheduler.FenceValue(t2) == 3);
+
+        CHECK(f.scheduler.Finish());
+        CHECK(texture == texels && before == small && after == small);
+
+        // Too large for the ring to ever hold, or data shorter than the
+        // rows: rejected up front.
+        const std::vector<std::byte> huge(256 * 128);
+        CHECK(f.scheduler.UploadTexture(Handle(texture), 0, huge, 256, 128) == 0);
+        CHECK(f.scheduler.UploadTexture(Handle(texture), 0, std::span(texels).first(100), 16, 7) == 0);
+        CHECK(f.scheduler.UploadTexture(Handle(texture), UploadCopy::kBuffer, texels, 16, 4) == 0);
+    });
+
+    runner.Run("upload_scheduler/ticket_and_fence_order", [&] {
+        Fixture f(2);
+        if (!CHECK(f.Init())) return;
+
+        std::vector<std::vector<std::byte>> sources, destinations;
+        std::vector<uint64_t>               tickets;
+        for (uint32_t i = 0; i < 40; ++i) {
+            sources.push_back(Pattern(300 + 517 * (i % 9), 10 + i));
+            destinations.emplace_back(sources.back().size());
+        }
+        for (uint32_t i = 0; i < 40; ++i) tickets.push_back(f.scheduler.UploadBuffer(Handle(destinations[i]), 0, sources[i]));
+        CHECK(tickets.front() == 1 && f.scheduler.RequestCount() == 40);
+
+        // Tickets are issued, staged and completed in order.
+        auto checkOrder = [&] {
+            uint64_t previousFence = 0;
+            bool     complete      = true;
+            for (size_t i = 0; i < tickets.size(); ++i) {
+                CHECK(tickets[i] == i + 1);
+                const uint64_t fence = f.scheduler.FenceValue(tickets[i]);
+                if (i > 0) CHECK(previousFence == 0 ? fence == 0 : fence == 0 || fence >= previousFence);
+                previousFence = fence;
+
+                const bool done = f.scheduler.IsComplete(tickets[i]);
+                CHECK(complete || !done);
+                complete = done;
+                // Complete means the bytes are in place and its fence passed.
+                if (done) CHECK(destinations[i] == sources[i] && fence <= f.queue.CompletedValue());
+            }
+        };
+        while (f.scheduler.PendingCount() > 0) {
+            CHECK(f.scheduler.Update());
+            checkOrder();
+        }
+        // The last batches only complete two signals later: Finish() waits.
+        CHECK(!f.scheduler.IsComplete(tickets.back()));
+        CHECK(f.scheduler.Finish());
+        checkOrder();
+        CHECK(f.scheduler.IsComplete(tickets.back()));
+        CHECK(!f.scheduler.IsComplete(tickets.back() + 1));
+        CHECK(f.scheduler.FenceValue(0) == 0);
+    });
+
+    runner.Run("upload_scheduler/finish_leaves_bytes_in_place", [&] {
+        Fixture f;
+        if (!CHECK(f.Init(1u << 10))) return;
+
+        // Buffers of odd sizes at odd offsets, textures whose rows are not a
+        // multiple of the pitch; all bytes must arrive after Finish().
+        std::vector<std::vector<std::byte>> sources;
+        for (uint32_t i = 0; i < 12; ++i) sources.push_back(Pattern(1 + 701 * i, 100 + i));
+        std::vector<std::byte> buffer(64u << 10);
+        std::vector<std::byte> expected(buffer.size());
+        uint64_t               offset = 3;
+        for (const std::vector<std::byte>& s : sources) {
+            CHECK(f.scheduler.UploadBuffer(Handle(buffer), offset, s) != 0);
+            std::memcpy(expected.data() + offset, s.data(), s.size());
+            offset += s.size() + 13;
+        }
+
+        const std::vector<std::byte> texels = Pattern(37 * 20, 200);
+        std::vector<std::byte>       texture(texels.size());
+        CHECK(f.scheduler.UploadTexture(Handle(texture), 1, texels, 37, 20) != 0);
+
+        CHECK(f.scheduler.Finish());
+        CHECK(buffer == expected);
+        CHECK(texture == texels);
+        CHECK(f.scheduler.PendingCount() == 0 && f.scheduler.IsComplete(f.scheduler.RequestCount()));
+        CHECK(f.scheduler.BatchCount() > 1);
+
+        // Finish() with nothing queued returns at once.
+        const uint64_t batches = f.scheduler.BatchCount();
+        CHECK(f.scheduler.Finish() && f.scheduler.BatchCount() == batches);
+
+        // Bad arguments.
+        UploadScheduler s;
+        CHECK(!s.Init(nullptr, f.staging.data(), kStagingBytes, kFrameBudget));
+        CHECK(!s.Init(&f.queue, f.staging.data(), kStagingBytes, kStagingBytes / 2 + 1));
+        CHECK(s.UploadBuffer(Handle(buffer), 0, sources[1]) == 0); // not initialised
+        CHECK(f.scheduler.UploadBuffer(Handle(buffer), 0, {}) == 0);
+    });
+}
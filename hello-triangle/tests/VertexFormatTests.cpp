@@ -0,0 +1,186 @@
+#include "Test.h"
+
+#include "VertexFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Host stand-ins with the members of D3D11_INPUT_ELEMENT_DESC and
+// D3D12_INPUT_ELEMENT_DESC; the enums are distinct types, as in the SDK.
+enum DxgiFormat : int {};
+enum D3D11Classification : int {};
+enum D3D12Classification : int {};
+
+struct D3D11InputElementDesc {
+    const char*         SemanticName;
+    uint32_t            SemanticIndex;
+    DxgiFormat          Format;
+    uint32_t            InputSlot;
+    uint32_t            AlignedByteOffset;
+    D3D11Classification InputSlotClass;
+    uint32_t            InstanceDataStepRate;
+};
+struct D3D12InputElementDesc {
+    const char*         SemanticName;
+    uint32_t            SemanticIndex;
+    DxgiFormat          Format;
+    uint32_t            InputSlot;
+    uint32_t            AlignedByteOffset;
+    D3D12Classification InputSlotClass;
+    uint32_t            InstanceDataStepRate;
+};
+
+// Every combination of encodings.
+std::vector<VertexFormat> AllFormats() {
+    std::vector<VertexFormat> formats;
+    for (auto p : { PositionEncoding::Float3, PositionEncoding::Half4, PositionEncoding::Unorm16x4 })
+        for (auto c : { ColorEncoding::Float4, ColorEncoding::Unorm8x4 })
+            for (auto t : { TexCoordEncoding::Float2, TexCoordEncoding::Half2, TexCoordEncoding::Unorm16x2 })
+                formats.push_back({ p, c, t });
+    return formats;
+}
+
+// Bytes of one encoded attribute, from the format documentation.
+uint32_t ExpectedStride(const VertexFormat& f) {
+    const uint32_t position = f.position == PositionEncoding::Float3 ? 12 : 8;
+    const uint32_t color    = f.color == ColorEncoding::Float4 ? 16 : 4;
+    const uint32_t texCoord = f.texCoord == TexCoordEncoding::Float2 ? 8 : 4;
+    return position + color + texCoord;
+}
+
+// Scattered vertices plus the corners of their bounds and the UV/colour
+// extremes, the values most likely to hit a rounding edge.
+std::vector<Vertex> MakeVertices() {
+    std::mt19937                          rng(5);
+    std::uniform_real_distribution<float> pos(-60.f, 140.f), unit(0.f, 1.f), uv(0.f, 6.f);
+    std::vector<Vertex>                   v(2045);
+    for (Vertex& x : v) {
+        x = { { pos(rng), pos(rng) * 0.01f, pos(rng) + 1000.f },
+              { unit(rng), unit(rng), unit(rng), unit(rng) },
+              { uv(rng), uv(rng) } };
+    }
+    v.push_back({ { -60.f, -0.6f, 940.f }, { 0.f, 0.f, 0.f, 0.f }, { 0.f, 0.f } });
+    v.push_back({ { 140.f, 1.4f, 1140.f }, { 1.f, 1.f, 1.f, 1.f }, { 1.f, 1.f } });
+    v.push_back({ { 40.f, 0.4f, 1040.f }, { 0.5f, 0.25f, 0.75f, 1.f }, { 6.f, 0.5f } });
+    return v;
+}
+
+} // namespace
+
+void RunVertexFormatTests(TestRunner& runner) {
+    runner.Run("vertex_format/stride_and_bytes_saved", [&] {
+        for (const VertexFormat& f : AllFormats()) {
+            const VertexLayout layout = MakeVertexLayout(f);
+            CHECK(layout.stride == ExpectedStride(f));
+            CHECK(layout.stride % 4 == 0);
+
+            // Tightly packed in Vertex order, each element its format's size.
+            uint32_t offset = 0;
+            for (const PipelineInputElement& e : layout.Elements()) {
+                CHECK(e.alignedByteOffset == offset);
+                offset += VertexFormatBytes(e.format);
+            }
+            CHECK(offset == layout.stride);
+            CHECK(layout.elements[0].semanticName == "POSITION" && layout.positionOffset == 0);
+            CHECK(layout.elements[1].semanticName == "COLOR" && layout.colorOffset == layout.elements[1].alignedByteOffset);
+            CHECK(layout.elements[2].semanticName == "TEXCOORD" && layout.texCoordOffset == layout.elements[2].alignedByteOffset);
+
+            // The encoded size is exactly stride per vertex.
+            const std::vector<Vertex> vertices(7);
+            std::vector<std::byte>    out(vertices.size() * layout.stride);
+            CHECK(EncodeVertices(vertices, f, {}, out));
+            out.pop_back();
+            CHECK(!EncodeVertices(vertices, f, {}, out));
+        }
+        CHECK(MakeVertexLayout(kFullVertexFormat).stride == sizeof(Vertex));
+        // 36 -> 16 bytes: 20 saved per vertex, 55.6%.
+        CHECK(sizeof(Vertex) - MakeVertexLayout(kCompactVertexFormat).stride == 20);
+    });
+
+    runner.Run("vertex_format/max_error_within_bound", [&] {
+        const std::vector<Vertex> vertices = MakeVertices();
+        float                     maxTexCoord = 0.f;
+        for (const Vertex& v : vertices) maxTexCoord = std::max({ maxTexCoord, std::fabs(v.uv[0]), std::fabs(v.uv[1]) });
+
+        std::vector<std::byte> encoded(vertices.size() * sizeof(Vertex));
+        std::vector<Vertex>    decoded(vertices.size());
+        for (const VertexFormat& f : AllFormats()) {
+            const PositionDequant   dequant = ComputePositionDequant(vertices, f.position);
+            const VertexErrorBounds bounds  = VertexFormatErrorBounds(f, dequant, maxTexCoord);
+            if (!CHECK(EncodeVertices(vertices, f, dequant, encoded)) ||
+                !CHECK(DecodeVertices(encoded, f, dequant, decoded)))
+                continue;
+
+            float position[3] = {}, color = 0.f, texCoord = 0.f;
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                const Vertex& in  = vertices[i];
+                const Vertex& out = decoded[i];
+                for (int c = 0; c < 3; ++c) position[c] = std::max(position[c], std::fabs(in.pos[c] - out.pos[c]));
+                for (int c = 0; c < 4; ++c) color = std::max(color, std::fabs(in.col[c] - out.col[c]));
+                for (int c = 0; c < 2; ++c) {
+                    // UNORM16 UVs are defined for [0, 1]; the tiled ones clamp.
+                    const float expected = f.texCoord == TexCoordEncoding::Unorm16x2
+                                         ? std::clamp(in.uv[c], 0.f, 1.f) : in.uv[c];
+                    texCoord = std::max(texCoord, std::fabs(expected - out.uv[c]));
+                }
+            }
+            for (int c = 0; c < 3; ++c) CHECK(position[c] <= bounds.position[c]);
+            CHECK(color <= bounds.color);
+            CHECK(texCoord <= bounds.texCoord);
+
+            // Float encodings are exact; the bounds of the others are not slack
+            // by orders of magnitude.
+            if (f.position == PositionEncoding::Float3) CHECK(bounds.position[0] == 0.f && position[0] == 0.f);
+            else                                        CHECK(position[0] > 0.25f * bounds.position[0]);
+            if (f.color == ColorEncoding::Float4) CHECK(color == 0.f);
+            else                                  CHECK(color > 0.25f * bounds.color);
+        }
+    });
+
+    runner.Run("vertex_format/dequant_matrix", [&] {
+        const std::vector<Vertex> vertices = MakeVertices();
+        const PositionDequant     d        = ComputePositionDequant(vertices, PositionEncoding::Unorm16x4);
+        const Float4x4            m        = DequantMatrix(d);
+        // UNORM16: stored 0 is the lower bound of each axis.
+        for (int c = 0; c < 3; ++c) {
+            CHECK(m.m[3][c] == d.offset[c] && m.m[c][c] == d.scale[c]);
+            CHECK(d.offset[c] == std::min_element(vertices.begin(), vertices.end(), [c](const Vertex& a, const Vertex& b) {
+                return a.pos[c] < b.pos[c];
+            })->pos[c]);
+        }
+        // A flat axis keeps a usable scale.
+        const std::vector<Vertex> flat(3, Vertex{ { 1.f, 2.f, 3.f }, {}, {} });
+        const PositionDequant     f = ComputePositionDequant(flat, PositionEncoding::Half4);
+        CHECK(f.scale[0] == 1.f && f.offset[0] == 1.f && f.offset[2] == 3.f);
+    });
+
+    runner.Run("vertex_format/d3d11_d3d12_descs_match", [&] {
+        for (const VertexFormat& f : AllFormats()) {
+            // Slot 0 packed vertices plus a per-instance stream, as D3DApp builds it.
+            const VertexLayout                layout = MakeVertexLayout(f);
+            std::vector<PipelineInputElement> elements(layout.Elements().begin(), layout.Elements().end());
+            elements.push_back({ "INSTANCE_TINT", 0, 2, 1, 48, 1, 1 });
+
+            const auto d3d11 = MakeInputElementDescs<D3D11InputElementDesc>(elements);
+            const auto d3d12 = MakeInputElementDescs<D3D12InputElementDesc>(elements);
+            if (!CHECK(d3d11.size() == elements.size() && d3d12.size() == elements.size())) continue;
+            for (size_t i = 0; i < elements.size(); ++i) {
+                const PipelineInputElement&  e = elements[i];
+                const D3D11InputElementDesc& a = d3d11[i];
+                const D3D12InputElementDesc& b = d3d12[i];
+                CHECK(std::strcmp(a.SemanticName, b.SemanticName) == 0 && a.SemanticName == e.semanticName);
+                CHECK(a.SemanticIndex == b.SemanticIndex && a.SemanticIndex == e.semanticIndex);
+                CHECK(a.Format == b.Format && uint32_t(a.Format) == e.format);
+                CHECK(a.InputSlot == b.InputSlot && a.InputSlot == e.inputSlot);
+                CHECK(a.AlignedByteOffset == b.AlignedByteOffset && a.AlignedByteOffset == e.alignedByteOffset);
+                CHECK(int(a.InputSlotClass) == int(b.InputSlotClass) && uint32_t(a.InputSlotClass) == e.inputSlotClass);
+                CHECK(a.InstanceDataStepRate == b.InstanceDataStepRate && a.InstanceDataStepRate == e.instanceDataStepRate);
+            }
+        }
+    });
+}